@@ -5,7 +5,9 @@
  * BCE SRS v1.3 — All external entry points.
  *
  * This header is the ONLY file application code needs to include.
- * All functions use static internal state — no heap allocation after BCE_Init().
+ * The unqualified functions operate on a static default instance; the *H
+ * variants take an explicit handle created in caller-provided storage.
+ * No heap allocation after BCE_Init() / BCE_Create().
  */
 
 #pragma once
@@ -13,6 +15,8 @@
 #include "bce_types.h"
 #include "bce_config.h"
 
+#include <cstddef>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -27,6 +31,42 @@ extern "C" {
  */
 void BCE_Init(void);
 
+// ---------------------------------------------------------------------------
+// Instances
+// ---------------------------------------------------------------------------
+
+/** Opaque engine instance. Each instance holds its own complete state. */
+typedef struct BCE_Instance* BCE_Handle;
+
+/** Bytes of storage required by BCE_Create(). */
+size_t BCE_InstanceSize(void);
+
+/** Required alignment of the storage passed to BCE_Create(). */
+size_t BCE_InstanceAlign(void);
+
+/**
+ * Construct and initialize an engine in caller-provided storage.
+ * @param storage  At least BCE_InstanceSize() bytes, aligned to BCE_InstanceAlign().
+ * @param size     Size of storage in bytes.
+ * @return Handle for the *H functions, or NULL if storage is too small or misaligned.
+ */
+BCE_Handle BCE_Create(void* storage, size_t size);
+
+/**
+ * Destroy an instance created by BCE_Create(). The storage remains owned by
+ * the caller and may be reused. The default handle is never destroyed.
+ */
+void BCE_Destroy(BCE_Handle h);
+
+/** Handle of the default instance used by the unqualified functions. */
+BCE_Handle BCE_GetDefaultHandle(void);
+
+/**
+ * Static RAM of one instance by subsystem, plus the process-wide state all
+ * instances share. Fixed by the build configuration, so it needs no handle.
+ */
+void BCE_GetMemoryReport(BCE_MemoryReport* out);
+
 // ---------------------------------------------------------------------------
 // Sensor Ingestion — SRS §7
 // ---------------------------------------------------------------------------
@@ -38,6 +78,77 @@ void BCE_Init(void);
  */
 void BCE_Update(const SensorFrame* frame);
 
+/**
+ * Feed a burst of IMU samples, e.g. one FIFO read, then run the rest of the
+ * pipeline once as BCE_Update would. Each sample steps the AHRS by its own
+ * timestamp; non-finite samples are skipped. Magnetometer, barometer and
+ * LRF data still arrive through BCE_Update.
+ */
+void BCE_UpdateIMUBurst(const ImuSample* samples, int count);
+
+// Event-driven ingestion for drivers that deliver sensors asynchronously.
+// Each call feeds one sensor, but only re-solves (or, in split mode,
+// publishes a snapshot) when the event can change the solution:
+// - an LRF reading, accepted or rejected
+// - an atmosphere change past the baro deadbands
+// - a configuration setter called since the last solve
+// - pitch, roll or heading moved by BCE_EVENT_PITCH_DELTA_RAD /
+//   BCE_EVENT_ROLL_DELTA_RAD / BCE_EVENT_HEADING_DELTA_DEG
+// - a range going stale, or an AHRS stability, mag or invalid-input flag
+//   flipping
+// Any other sample leaves the published solution as it is. The calls may be
+// mixed with BCE_Update, which always solves. The recorder logs each event
+// as a frame with only that sensor valid.
+
+/** One IMU sample; mag is the matching magnetometer reading (µT) or NULL. */
+void BCE_UpdateIMU(const ImuSample* sample, const float mag[3]);
+
+/** One barometer reading; humidity 0.0–1.0, or negative if not measured. */
+void BCE_UpdateBaro(uint64_t timestamp_us, float pressure_pa, float temperature_c, float humidity);
+
+/** One LRF reading taken at timestamp_us; confidence 0.0 = not provided. */
+void BCE_UpdateLRF(uint64_t timestamp_us, float range_m, float confidence);
+
+// ---------------------------------------------------------------------------
+// Split Pipeline (dual-core)
+// ---------------------------------------------------------------------------
+
+/**
+ * Enable/disable split-pipeline mode. Default is off.
+ * When enabled, BCE_Update only runs AHRS fusion, atmosphere and LRF
+ * filtering and publishes a snapshot of the result; BCE_ServiceSolver runs
+ * the state machine and trajectory solve against the latest snapshot. The
+ * two may run concurrently on different cores (one caller each). All other
+ * setters must be called while neither is running.
+ */
+void BCE_SetSplitPipelineMode(bool enabled);
+
+/**
+ * Solve the most recent snapshot published by BCE_Update. Snapshots
+ * superseded before the solver got to them are skipped. Also the only safe
+ * context for BCE_ComputeHoldTable / BCE_RunDispersion / BCE_GetSensitivity
+ * in split mode.
+ * @return true if a new snapshot was solved; false if none was pending or
+ *         split-pipeline mode is off.
+ */
+bool BCE_ServiceSolver(void);
+
+/**
+ * Time-sliced BCE_ServiceSolver for cooperative schedulers, e.g. a single
+ * core that interleaves BCE_Update with display work. Solves the most recent
+ * snapshot, but a zero recompute or trajectory integration is spread over as
+ * many calls as it needs, each returning after roughly budget_us (at least
+ * BCE_STEP_SOLVE_SLICE_STEPS integration steps run per call). Meanwhile the
+ * last complete solution stays published with BCE_Diag::SOLUTION_PENDING
+ * set. The result is identical to BCE_ServiceSolver's. The launch-angle
+ * cache is not consulted, since one lookup may integrate several
+ * trajectories. Requires split-pipeline mode.
+ * @return true if this call finished a solve and published it; false while
+ *         one is pending, if no new snapshot was waiting, or if split-pipeline
+ *         mode is off.
+ */
+bool BCE_StepSolve(uint32_t budget_us);
+
 // ---------------------------------------------------------------------------
 // Manual Inputs — SRS §8
 // ---------------------------------------------------------------------------
@@ -52,6 +163,21 @@ void BCE_SetBulletProfile(const BulletProfile* profile);
  */
 void BCE_SetZeroConfig(const ZeroConfig* config);
 
+/**
+ * Load the Cd-vs-Mach curve used by DragModel::CUSTOM (e.g. a manufacturer
+ * Doppler curve). Needs 2..BCE_CUSTOM_DRAG_MAX_POINTS points with Mach
+ * strictly increasing and Mach, Cd finite and non-negative; the points are
+ * copied and resampled into a static uniform-Mach table. The curve is
+ * shared by all instances; engines using CUSTOM re-zero on their next
+ * update, and report BCE_Fault::NO_DRAG_CURVE until a curve is loaded.
+ * Call while no solve is running. The load is refused while any instance
+ * is in split-pipeline mode, whose solver may be mid-integration on
+ * another core: leave split mode, load, then re-enter it.
+ * @return false if the points are invalid or an instance is split (the
+ *         previous curve is kept)
+ */
+bool BCE_SetCustomDragCurve(const DragPoint* points, int n);
+
 /**
  * Set manual wind. Persists until changed.
  * @param speed_ms   Wind speed in m/s
@@ -59,6 +185,17 @@ void BCE_SetZeroConfig(const ZeroConfig* config);
  */
 void BCE_SetWindManual(float speed_ms, float heading_deg);
 
+/**
+ * Set target motion for moving-target lead. Persists until changed or
+ * BCE_Init. The holds then aim at the predicted impact point (lead included)
+ * and the lead_* solution fields report the lead part. BCE_Diag::LEAD_UNRESOLVED
+ * marks a lead whose impact range ran past the tabulated trajectory or
+ * whose TOF did not settle within BCE_LEAD_MAX_ITERATIONS.
+ * @param speed_ms    Target speed in m/s; <= 0 or non-finite = stationary
+ * @param heading_deg Direction the target moves, degrees true
+ */
+void BCE_SetTargetMotion(float speed_ms, float heading_deg);
+
 /**
  * Set latitude for Coriolis/Eötvös correction.
  * Pass NAN or do not call to leave Coriolis disabled.
@@ -92,6 +229,34 @@ void BCE_SetIMUBias(const float accel_bias[3], const float gyro_bias[3]);
  */
 void BCE_SetMagCalibration(const float hard_iron[3], const float soft_iron[9]);
 
+/**
+ * Start fitting hard/soft-iron calibration on the device from the raw
+ * magnetometer readings BCE_Update / BCE_UpdateIMU receive; rotate the
+ * device through as many orientations as possible. The recursive
+ * least-squares fit costs O(1) time and memory per reading and keeps no
+ * readings. Restarts any fit in progress; the calibration in use is kept
+ * until a commit. Call from the context that feeds the magnetometer.
+ */
+void BCE_StartMagCalibration(void);
+
+/** Stop fitting without changing the calibration in use. */
+void BCE_CancelMagCalibration(void);
+
+/**
+ * Progress of the streaming fit: readings used, direction coverage, fitted
+ * field and the calibration a commit would apply. Safe from any context.
+ */
+void BCE_GetMagCalibrationStatus(BCE_MagCalStatus* out);
+
+/**
+ * Swap the fitted calibration in and stop fitting. The swap is atomic and
+ * does not block the update path, so this may run on another core while
+ * BCE_Update keeps going.
+ * @return false if the fit is not ready (see BCE_MagCalStatus::ready); the
+ *         calibration in use is unchanged and fitting continues
+ */
+bool BCE_CommitMagCalibration(void);
+
 /**
  * Capture current gyroscope readings to establish a bias offset.
  * The rifle must be held perfectly still for ~1 second.
@@ -142,18 +307,190 @@ void BCE_SetMagDeclination(float declination_deg);
  */
 void BCE_SetExternalReferenceMode(bool enabled);
 
+/**
+ * Select the trajectory integrator. Default is RK4.
+ * DORMAND_PRINCE uses embedded error control with tolerance_m as the
+ * absolute per-step position tolerance (≤ 0 selects the default).
+ * RK4_RANGE steps in downrange distance (at most BCE_RANGE_STEP_M, ending on
+ * every trajectory table record); tolerance_m is ignored. RK4 zero solves first
+ * converge on RK4_RANGE (BCE_ZERO_COARSE_PASS), then refine with RK4.
+ * Triggers zero recomputation.
+ */
+void BCE_SetIntegrator(IntegratorMethod method, float tolerance_m);
+
+/**
+ * Set every integrator parameter at once: the method and tolerance of
+ * BCE_SetIntegrator plus the RK4 step heuristic (step_scale_m / speed, capped
+ * at max_step_m, transonic_dt_s inside Mach 0.9–1.2) and the RK4_RANGE step.
+ * Fields ≤ 0 take their bce_config.h default; nullptr restores all defaults.
+ * Settings are usually found per cartridge by integrator_tune and stored in
+ * the profile DB, which BCE_SelectProfile applies. Triggers zero recomputation.
+ */
+void BCE_SetIntegratorTuning(const IntegratorTuning* tuning);
+
+/**
+ * Set how far the solver tabulates the trajectory on each integration.
+ * Range-only changes within the horizon are answered from the table without
+ * re-integrating; targets past it tabulate to the range limit. Values < 1 m
+ * restore the default, an automatic horizon: BCE_TRAJ_HORIZON_MARGIN_M past
+ * the target, doubling each time a range-only change runs past the table.
+ */
+void BCE_SetTrajectoryHorizon(float horizon_m);
+
+/**
+ * Limit this engine to ranges up to max_range_m (clamped to BCE_MAX_RANGE_M;
+ * values < 1 m restore it). LRF readings and zero ranges past the limit are
+ * rejected like out-of-range input, and no integration or table fill goes
+ * beyond it. Static RAM is sized by BCE_MAX_RANGE_M at build time; this only
+ * bounds the work. Triggers zero recomputation when the limit changes.
+ */
+void BCE_SetMaxRange(float max_range_m);
+
+/**
+ * Enable/disable the launch-angle cache. Default is off.
+ * When enabled, trajectories are integrated for launch angles on a
+ * BCE_ANGLE_CACHE_STEP_RAD grid and each solve interpolates across the grid
+ * angles around zero angle + bore pitch, so tilting the rifle for uphill or
+ * downhill shots only integrates when the bore reaches a new grid angle.
+ * Bullet, atmosphere or wind changes rebuild the cache.
+ */
+void BCE_SetAngleCacheMode(bool enabled);
+
+// ---------------------------------------------------------------------------
+// Persistent State
+// ---------------------------------------------------------------------------
+
+/**
+ * Largest blob BCE_SaveState can write, in bytes. include_trajectory adds
+ * the trajectory table saved every BCE_STATE_TRAJ_STEP_M (about 5 KB).
+ */
+size_t BCE_GetStateSize(bool include_trajectory);
+
+/**
+ * Serialize the derived solver state for NVS/flash: the zero angle together
+ * with the bullet, atmosphere and zero fingerprint it was solved for, and
+ * optionally the current trajectory table at reduced resolution.
+ * @return Bytes written, or 0 if no zero has been solved since the inputs
+ *         last changed or size is too small.
+ */
+size_t BCE_SaveState(void* buf, size_t size, bool include_trajectory);
+
+/**
+ * Restore a blob written by BCE_SaveState, typically at boot after BCE_Init
+ * and the profile / zero setters. The next solve adopts the saved zero
+ * without re-running the zero solve if its fingerprint matches the live
+ * inputs, and otherwise warm-starts the solve from it. A saved trajectory
+ * is reused while the launch angle and inputs still match. buf needs no
+ * particular alignment.
+ * @return false (engine unchanged) if the blob is truncated, from another
+ *         firmware layout or fails its CRC-32.
+ */
+bool BCE_RestoreState(const void* buf, size_t size);
+
+// ---------------------------------------------------------------------------
+// Profile Database
+// ---------------------------------------------------------------------------
+
+/**
+ * Bind a packed cartridge/gun database ("BCEP", profile/profile_db.h; the
+ * profile_pack tool builds one from the GUI's JSON profile library). It is
+ * read in place, so it can live in flash or a memory-mapped file; it must
+ * stay valid and unchanged while bound. Checked once here. NULL unbinds,
+ * and so does BCE_Init().
+ * @param data  4-byte aligned
+ * @return false (the previous database stays bound) if data is not a valid
+ *         database: wrong magic or version, truncated, or failing its CRC-32.
+ */
+bool BCE_SetProfileDb(const void* data, size_t size);
+
+/**
+ * Switch to a cartridge and/or gun of the bound database by name: a hashed
+ * lookup, with no parsing and no copies beyond the profile itself. The
+ * cartridge sets BC, BC bands, drag model, muzzle velocity, mass, caliber
+ * and length, plus its integrator settings if it was tuned (see
+ * BCE_SetIntegratorTuning); the gun sets barrel length, MV adjustment, twist
+ * and the zero config. Fields the selection does not cover keep their current values,
+ * and the result applies like BCE_SetBulletProfile / BCE_SetZeroConfig.
+ * @param cartridge  Cartridge name, or NULL to keep the current one
+ * @param gun        Gun name, or NULL to keep the current one
+ * @return false (nothing changed) if both are NULL, a name is not in the
+ *         database, or no database is bound.
+ */
+bool BCE_SelectProfile(const char* cartridge, const char* gun);
+
 // ---------------------------------------------------------------------------
 // Output — SRS §12
 // ---------------------------------------------------------------------------
 
 /**
- * Retrieve the latest firing solution.
- * @param out  Pointer to caller-owned FiringSolution struct to fill.
+ * Retrieve the latest firing solution. Safe to call from any thread; the
+ * copy is never torn by a concurrent solve.
+ * @param out  Pointer to caller-owned FiringSolution struct to fill (NULL
+ *             only queries the generation).
+ * @return Generation of the copied solution. It advances only when the
+ *         published contents change, so an unchanged value means the
+ *         caller's previous copy is still current.
+ */
+uint32_t BCE_GetSolution(FiringSolution* out);
+
+/**
+ * Generation of the latest published solution, without copying it.
+ * BCE_Init() publishes a new (IDLE) generation too.
+ */
+uint32_t BCE_GetSolutionGeneration(void);
+
+/**
+ * Call fn instead of polling whenever the published solution changes
+ * materially:
+ * - the mode, fault flags or diag flags change, or
+ * - hold_elevation_moa or hold_windage_moa moves by more than epsilon_moa
+ *   from the last solution fn was given.
+ * With epsilon_moa ≤ 0, every published change counts. fn gets the current
+ * solution once right away. Later calls run on the publishing context:
+ * BCE_Update and friends, or BCE_ServiceSolver / BCE_StepSolve in split mode.
+ * The solution is already visible to BCE_GetSolution by then. fn must return
+ * quickly and must not call back into the engine, except for the getters.
+ * NULL unregisters, and so does BCE_Init().
  */
-void BCE_GetSolution(FiringSolution* out);
+void BCE_SetSolutionCallback(BCE_SolutionCallback fn, void* user, float epsilon_moa);
 
 /**
- * Get the current engine operating mode.
+ * Read-only view of the trajectory table behind the current solution, for
+ * plotting the real path without extra solves or copies. Record i lies
+ * i * BCE_TRAJ_TABLE_STRIDE_M meters downrange; drop and windage are the
+ * solver's raw values, not yet referred to the sight line.
+ * The records are the engine's own static storage: the next solve that
+ * re-integrates (a new zero, atmosphere or wind, a range past the tabulated
+ * extent, BCE_ComputeHoldTable) overwrites them in place. *generation
+ * advances whenever that happens, so a consumer that keeps derived data
+ * compares generations instead of re-reading the table. Not synchronized:
+ * read it on the context that drives the engine.
+ * @param points      Set to the first record (NULL when unavailable).
+ * @param count       Set to the number of records (0 when unavailable).
+ * @param generation  Set to the table generation. Any pointer may be NULL.
+ * @return false when there is no current trajectory, e.g. before the first
+ *         solution, while a split-mode job is integrating, or always with
+ *         BCE_TRAJ_TABLE_COMPACT (the table holds encoded records).
+ */
+bool BCE_GetTrajectoryView(const TrajectoryPoint** points, int* count, uint32_t* generation);
+
+/**
+ * Compute a holdover table (DOPE card) for several ranges in one
+ * integration pass, using the current zero, atmosphere, wind and attitude.
+ * Each entry is post-processed exactly like the live solution (sight line,
+ * Coriolis, spin drift, cant and offsets). Entries that cannot be solved are
+ * written with solution_mode = FAULT and the reason in fault_flags.
+ * @param ranges  Slant ranges in meters.
+ * @param n       Number of ranges (and of entries in out).
+ * @param out     Caller-owned array of n FiringSolution structs to fill.
+ * @return Number of entries with solution_mode = SOLUTION_READY.
+ */
+int BCE_ComputeHoldTable(const float* ranges, int n, FiringSolution* out);
+
+/**
+ * Get the current engine operating mode. In split-pipeline mode this (and
+ * the two flag getters below) reads the published solution, so any thread
+ * may call it.
  */
 BCE_Mode BCE_GetMode(void);
 
@@ -167,6 +504,156 @@ uint32_t BCE_GetFaultFlags(void);
  */
 uint32_t BCE_GetDiagFlags(void);
 
+/**
+ * Get solver effort counters (solution cache hits/misses).
+ * @param out  Pointer to caller-owned BCE_SolverDiagnostics struct to fill.
+ */
+void BCE_GetSolverDiagnostics(BCE_SolverDiagnostics* out);
+
+/**
+ * Get per-stage timing and solver effort counters for the last BCE_Update
+ * plus worst cases since BCE_Init(). Requires a BCE_ENABLE_PROFILING build;
+ * otherwise fills the struct with zeros (enabled = 0).
+ * @param out  Pointer to caller-owned BCE_PerfStats struct to fill.
+ */
+void BCE_GetPerfStats(BCE_PerfStats* out);
+
+// ---------------------------------------------------------------------------
+// Dispersion (Monte Carlo)
+// ---------------------------------------------------------------------------
+
+/**
+ * Set the input uncertainties for dispersion estimates and reseed the
+ * sampler. Clears any accumulated statistics.
+ */
+void BCE_SetUncertainty(const BCE_UncertaintyConfig* config);
+
+/**
+ * Run samples more Monte Carlo trajectories around the current solution and
+ * fold them into the streamed statistics. Call repeatedly (e.g. a few dozen
+ * samples per frame) to refine the estimate without blocking. Statistics
+ * restart automatically when the nominal solution's inputs change; pitch
+ * and range noise within the BCE_DISPERSION_RESTART_* tolerances does not.
+ * Does nothing unless the mode is SOLUTION_READY.
+ * @return Samples accumulated for the current solution.
+ */
+uint32_t BCE_RunDispersion(int samples);
+
+/**
+ * Get the impact ellipse and hit probability accumulated so far.
+ * @param out  Pointer to caller-owned BCE_DispersionStats struct to fill.
+ */
+void BCE_GetDispersion(BCE_DispersionStats* out);
+
+// ---------------------------------------------------------------------------
+// Sensitivities
+// ---------------------------------------------------------------------------
+
+/**
+ * First-order change of the current solution per unit change of range,
+ * muzzle velocity, BC and wind, for wind calls and error budgets: a 1σ
+ * input error moves the hold by about partial × σ. One integration of the
+ * trajectory and its variational equations replaces the perturbed
+ * re-solves a finite difference would need; call on demand, not per frame.
+ * The bore stays at its current angle, as in BCE_RunDispersion.
+ * @param out  Pointer to caller-owned BCE_Sensitivity struct to fill
+ *             (zeroed when there is no solution).
+ * @return false unless the mode is SOLUTION_READY and the target is reached.
+ */
+bool BCE_GetSensitivity(BCE_Sensitivity* out);
+
+// ---------------------------------------------------------------------------
+// Input Recorder
+// ---------------------------------------------------------------------------
+
+/**
+ * Enable/disable input recording. Default is off. While on, every
+ * BCE_Update frame is appended to an in-engine ring buffer in the packed
+ * "BCEF" stream format (recorder/frame_codec.h), preceded on start by the
+ * stream header, bullet profile, zero config and integrator; later changes
+ * to those are recorded in order. IMU bursts and other setters are not
+ * recorded. Re-enabling starts a new stream in the same ring.
+ */
+void BCE_SetRecorderMode(bool enabled);
+
+/**
+ * Drain up to size bytes of the recorded stream into buf, e.g. to write
+ * them to flash or a UART. Safe to call from another task or core while
+ * BCE_Update runs, from one caller at a time; never blocks.
+ * @return Bytes copied (0 when nothing is pending)
+ */
+size_t BCE_ReadRecorder(uint8_t* buf, size_t size);
+
+/**
+ * Records dropped since BCE_Init() because the ring was full. After a drop
+ * the stream resumes with the configuration and a key frame, so it stays
+ * decodable with a gap.
+ */
+uint32_t BCE_GetRecorderDropped(void);
+
+// ---------------------------------------------------------------------------
+// Handle-based API
+// ---------------------------------------------------------------------------
+// Each function behaves like its unqualified counterpart above, applied to
+// the given instance. A NULL handle is ignored (getters return IDLE / 0).
+
+void BCE_InitH(BCE_Handle h);
+void BCE_UpdateH(BCE_Handle h, const SensorFrame* frame);
+void BCE_UpdateIMUBurstH(BCE_Handle h, const ImuSample* samples, int count);
+void BCE_UpdateIMUH(BCE_Handle h, const ImuSample* sample, const float mag[3]);
+void BCE_UpdateBaroH(BCE_Handle h, uint64_t timestamp_us, float pressure_pa, float temperature_c,
+                     float humidity);
+void BCE_UpdateLRFH(BCE_Handle h, uint64_t timestamp_us, float range_m, float confidence);
+void BCE_SetSplitPipelineModeH(BCE_Handle h, bool enabled);
+bool BCE_ServiceSolverH(BCE_Handle h);
+bool BCE_StepSolveH(BCE_Handle h, uint32_t budget_us);
+void BCE_SetBulletProfileH(BCE_Handle h, const BulletProfile* profile);
+void BCE_SetZeroConfigH(BCE_Handle h, const ZeroConfig* config);
+void BCE_SetWindManualH(BCE_Handle h, float speed_ms, float heading_deg);
+void BCE_SetTargetMotionH(BCE_Handle h, float speed_ms, float heading_deg);
+void BCE_SetLatitudeH(BCE_Handle h, float latitude_deg);
+void BCE_SetDefaultOverridesH(BCE_Handle h, const BCE_DefaultOverrides* defaults);
+void BCE_SetIMUBiasH(BCE_Handle h, const float accel_bias[3], const float gyro_bias[3]);
+void BCE_SetMagCalibrationH(BCE_Handle h, const float hard_iron[3], const float soft_iron[9]);
+void BCE_StartMagCalibrationH(BCE_Handle h);
+void BCE_CancelMagCalibrationH(BCE_Handle h);
+void BCE_GetMagCalibrationStatusH(BCE_Handle h, BCE_MagCalStatus* out);
+bool BCE_CommitMagCalibrationH(BCE_Handle h);
+void BCE_CalibrateGyroH(BCE_Handle h);
+void BCE_SetBoresightOffsetH(BCE_Handle h, const BoresightOffset* offset);
+void BCE_SetReticleMechanicalOffsetH(BCE_Handle h, float vertical_moa, float horizontal_moa);
+void BCE_CalibrateBaroH(BCE_Handle h);
+void BCE_SetAHRSAlgorithmH(BCE_Handle h, AHRS_Algorithm algo);
+void BCE_SetMagDeclinationH(BCE_Handle h, float declination_deg);
+void BCE_SetExternalReferenceModeH(BCE_Handle h, bool enabled);
+void BCE_SetIntegratorH(BCE_Handle h, IntegratorMethod method, float tolerance_m);
+void BCE_SetIntegratorTuningH(BCE_Handle h, const IntegratorTuning* tuning);
+void BCE_SetTrajectoryHorizonH(BCE_Handle h, float horizon_m);
+void BCE_SetMaxRangeH(BCE_Handle h, float max_range_m);
+void BCE_SetAngleCacheModeH(BCE_Handle h, bool enabled);
+size_t BCE_SaveStateH(BCE_Handle h, void* buf, size_t size, bool include_trajectory);
+bool BCE_RestoreStateH(BCE_Handle h, const void* buf, size_t size);
+bool BCE_SetProfileDbH(BCE_Handle h, const void* data, size_t size);
+bool BCE_SelectProfileH(BCE_Handle h, const char* cartridge, const char* gun);
+uint32_t BCE_GetSolutionH(BCE_Handle h, FiringSolution* out);
+uint32_t BCE_GetSolutionGenerationH(BCE_Handle h);
+void BCE_SetSolutionCallbackH(BCE_Handle h, BCE_SolutionCallback fn, void* user, float epsilon_moa);
+bool BCE_GetTrajectoryViewH(BCE_Handle h, const TrajectoryPoint** points, int* count,
+                            uint32_t* generation);
+int BCE_ComputeHoldTableH(BCE_Handle h, const float* ranges, int n, FiringSolution* out);
+BCE_Mode BCE_GetModeH(BCE_Handle h);
+uint32_t BCE_GetFaultFlagsH(BCE_Handle h);
+uint32_t BCE_GetDiagFlagsH(BCE_Handle h);
+void BCE_GetSolverDiagnosticsH(BCE_Handle h, BCE_SolverDiagnostics* out);
+void BCE_GetPerfStatsH(BCE_Handle h, BCE_PerfStats* out);
+void BCE_SetUncertaintyH(BCE_Handle h, const BCE_UncertaintyConfig* config);
+uint32_t BCE_RunDispersionH(BCE_Handle h, int samples);
+void BCE_GetDispersionH(BCE_Handle h, BCE_DispersionStats* out);
+bool BCE_GetSensitivityH(BCE_Handle h, BCE_Sensitivity* out);
+void BCE_SetRecorderModeH(BCE_Handle h, bool enabled);
+size_t BCE_ReadRecorderH(BCE_Handle h, uint8_t* buf, size_t size);
+uint32_t BCE_GetRecorderDroppedH(BCE_Handle h);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
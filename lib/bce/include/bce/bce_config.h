@@ -22,10 +22,47 @@
 // ---------------------------------------------------------------------------
 // Maximum trajectory range (meters) — SRS §6
 // ---------------------------------------------------------------------------
+// Sizes the trajectory table, the launch-angle cache and the saved state, so
+// a build for short-range rifles can lower it (e.g. -DBCE_MAX_RANGE_M=800)
+// to shrink static RAM; BCE_SetMaxRange bounds one engine further at run
+// time without changing its size.
+#ifndef BCE_MAX_RANGE_M
 #define BCE_MAX_RANGE_M 2500
+#endif
+
+static_assert(BCE_MAX_RANGE_M >= 100, "BCE_MAX_RANGE_M must be at least 100 m");
+
+// Velocity-banded BC: lower-velocity bands a BulletProfile may add below
+// its primary bc (BulletProfile::bc_bands)
+#ifndef BCE_MAX_BC_BANDS
+#define BCE_MAX_BC_BANDS 4
+#endif
 
-// Trajectory table size: 1-meter resolution from 0 to BCE_MAX_RANGE_M
-#define BCE_TRAJ_TABLE_SIZE (BCE_MAX_RANGE_M + 1)
+// Compact trajectory table: 8-byte fixed-point records (uint16 drop,
+// windage, velocity, TOF with per-table scales; energy recomputed) instead
+// of 20-byte float records. Adds ~0.005–0.01 MOA of drop quantization.
+// Implies a 5 m stride unless one is given: 501 records = 4 KB, against
+// 50 KB for the float table at 1 m.
+#ifndef BCE_TRAJ_TABLE_COMPACT
+#define BCE_TRAJ_TABLE_COMPACT 0
+#endif
+
+// Trajectory table stride (meters between stored records). Ranges between
+// records are recovered by cubic Hermite interpolation, so coarser strides
+// trade a few bytes of SRAM per record for no loss of hold accuracy.
+#ifndef BCE_TRAJ_TABLE_STRIDE_M
+#if BCE_TRAJ_TABLE_COMPACT
+#define BCE_TRAJ_TABLE_STRIDE_M 5
+#else
+#define BCE_TRAJ_TABLE_STRIDE_M 1
+#endif
+#endif
+
+static_assert(BCE_TRAJ_TABLE_STRIDE_M >= 1 && BCE_MAX_RANGE_M % BCE_TRAJ_TABLE_STRIDE_M == 0,
+              "BCE_TRAJ_TABLE_STRIDE_M must evenly divide BCE_MAX_RANGE_M");
+
+// Trajectory table size: one record per stride from 0 to BCE_MAX_RANGE_M
+#define BCE_TRAJ_TABLE_SIZE (BCE_MAX_RANGE_M / BCE_TRAJ_TABLE_STRIDE_M + 1)
 
 // ---------------------------------------------------------------------------
 // ISA Standard Atmosphere Defaults — SRS §5.1
@@ -37,6 +74,13 @@ constexpr float BCE_DEFAULT_HUMIDITY       = 0.50f;
 constexpr float BCE_DEFAULT_WIND_SPEED_MS  = 0.0f;
 constexpr float BCE_DEFAULT_WIND_HEADING   = 0.0f;
 
+// Baro deadbands: readings within these of the last accepted one are sensor
+// noise and leave the atmosphere (and its generation) unchanged. 2 Pa moves
+// density by ~2e-5 of itself, far inside the solution-cache hysteresis.
+constexpr float BCE_ATMO_PRESSURE_DEADBAND_PA   = 2.0f;
+constexpr float BCE_ATMO_TEMPERATURE_DEADBAND_C = 0.02f;
+constexpr float BCE_ATMO_HUMIDITY_DEADBAND      = 0.002f;
+
 // ---------------------------------------------------------------------------
 // Physical Constants
 // ---------------------------------------------------------------------------
@@ -81,12 +125,26 @@ constexpr float BCE_MM_TO_M      = 0.001f;
 // AHRS Configuration
 // ---------------------------------------------------------------------------
 
-// Sliding window size for static/dynamic detection (samples)
-constexpr int BCE_AHRS_STATIC_WINDOW = 64;
+// Sliding window size for static/dynamic detection (samples). The detector
+// costs O(1) per sample at any size; IMUs running at 400–800 Hz want
+// 256–512 to gate over a comparable stretch of time. 4 bytes per sample for
+// each channel.
+#ifndef BCE_AHRS_STATIC_WINDOW
+#define BCE_AHRS_STATIC_WINDOW 64
+#endif
 
 // Accel variance threshold for static detection (m/s²)²
 constexpr float BCE_AHRS_STATIC_THRESHOLD = 0.05f;
 
+// Optional gyro channel for static detection: RMS bias-corrected rotation
+// rate over the window must also stay below this (rad/s), so a slow steady
+// pan does not count as static. 0 = accel variance only (default).
+constexpr float BCE_AHRS_STATIC_GYRO_RMS_RADS = 0.0f;
+
+// Samples fused per AHRSManager::updateBurst() call; longer IMU bursts are
+// split into chunks of this size (bounds the per-chunk stack arrays)
+constexpr int BCE_AHRS_BURST_MAX = 32;
+
 // Default Madgwick beta gain
 constexpr float BCE_MADGWICK_DEFAULT_BETA = 0.1f;
 
@@ -102,6 +160,15 @@ constexpr uint32_t BCE_LRF_STALE_US = 2000000; // 2 seconds
 // Minimum accepted LRF confidence when provided (0.0 means unknown/unprovided)
 constexpr float BCE_LRF_MIN_CONFIDENCE = 0.50f;
 
+// ---------------------------------------------------------------------------
+// Event-driven ingestion (BCE_UpdateIMU / BCE_UpdateBaro / BCE_UpdateLRF)
+// ---------------------------------------------------------------------------
+// An IMU sample re-solves only once pitch, roll or heading has moved this far
+// from the last solved snapshot (or a fault-relevant state flipped)
+constexpr float BCE_EVENT_PITCH_DELTA_RAD = 0.0005f;  // 0.5 mrad
+constexpr float BCE_EVENT_ROLL_DELTA_RAD = 0.001f;    // ~0.06°
+constexpr float BCE_EVENT_HEADING_DELTA_DEG = 0.1f;
+
 // ---------------------------------------------------------------------------
 // Solver Configuration
 // ---------------------------------------------------------------------------
@@ -120,6 +187,23 @@ constexpr float BCE_BALLISTIC_DRAG_CONSTANT = 900.0f;
 constexpr float BCE_EXTERNAL_REFERENCE_DRAG_SCALE = 0.84f;
 constexpr float BCE_DEFAULT_DRAG_REFERENCE_SCALE = 1.0f;
 
+// Mach spacing of the uniform drag tables resampled from the G1–G8 data at
+// compile time. Every source breakpoint lies on this grid, so the uniform
+// lookup reproduces the reference interpolation to float rounding.
+constexpr float BCE_DRAG_MACH_STEP = 0.005f;
+
+// Custom drag curve (DragModel::CUSTOM): at most BCE_CUSTOM_DRAG_MAX_POINTS
+// source breakpoints, resampled onto the same uniform grid up to
+// BCE_CUSTOM_DRAG_MAX_MACH (Cd is held constant above it). Both buffers are
+// static: ~1 KB for the source points plus ~4 KB for the uniform curve.
+#ifndef BCE_CUSTOM_DRAG_MAX_POINTS
+#define BCE_CUSTOM_DRAG_MAX_POINTS 128
+#endif
+constexpr float BCE_CUSTOM_DRAG_MAX_MACH = 5.0f;
+constexpr int BCE_CUSTOM_DRAG_SAMPLES =
+    static_cast<int>(BCE_CUSTOM_DRAG_MAX_MACH / BCE_DRAG_MACH_STEP + 0.5f) + 1;
+static_assert(BCE_CUSTOM_DRAG_MAX_POINTS >= 2, "A custom drag curve needs at least two points");
+
 // Maximum solver iterations (safety limit)
 constexpr uint32_t BCE_MAX_SOLVER_ITERATIONS = 500000;
 
@@ -130,17 +214,163 @@ constexpr float BCE_DT_MAX = 0.001f;    // 1 ms
 // Maximum downrange distance advanced per integration step (meters)
 constexpr float BCE_MAX_STEP_DISTANCE_M = 0.25f;
 
-// Zero-angle binary search tolerance (meters of drop at zero range)
+// RK4 step outside the transonic band: dt = BCE_RK4_STEP_SCALE_M / speed
+// (seconds). Inside Mach 0.9–1.2 RK4 steps BCE_DT_MIN. These and the
+// constants below are defaults; IntegratorTuning (BCE_SetIntegratorTuning,
+// per cartridge in the profile DB) overrides them at run time.
+constexpr float BCE_RK4_STEP_SCALE_M = 0.5f;
+
+// Dormand–Prince 5(4) integrator: default absolute position tolerance per
+// step (meters) and the longest downrange step it may take
+constexpr float BCE_RK45_DEFAULT_TOLERANCE_M = 1.0e-5f;
+constexpr float BCE_RK45_MAX_STEP_DISTANCE_M = 25.0f;
+
+// Range-domain RK4: longest downrange step (meters). Steps divide the table
+// stride evenly, so every record lands on a step end.
+#ifndef BCE_RANGE_STEP_M
+#define BCE_RANGE_STEP_M 5.0f
+#endif
+static_assert(BCE_RANGE_STEP_M > 0.0f, "BCE_RANGE_STEP_M must be positive");
+
+// Zero-angle solver tolerance (meters of drop at zero range)
 constexpr float BCE_ZERO_TOLERANCE_M = 0.001f;
 
-// Zero-angle max iterations
+// Zero-angle max iterations (bracketed Illinois fallback)
 constexpr uint32_t BCE_ZERO_MAX_ITERATIONS = 50;
 
+// Warm-started secant phase: probe offset from the initial guess and the
+// iteration budget before falling back to the bracketed solve
+constexpr float BCE_ZERO_SECANT_STEP_RAD = 0.0005f;
+constexpr uint32_t BCE_ZERO_SECANT_MAX_ITERATIONS = 8;
+
+// Coarse zero pass: RK4 zero solves bracket and converge on the range-domain
+// RK4 (BCE_RANGE_STEP_M steps) first, then refine with RK4 from that angle
+// and its secant slope, which typically takes one or two full-fidelity
+// integrations. 0 = full-fidelity search only.
+#ifndef BCE_ZERO_COARSE_PASS
+#define BCE_ZERO_COARSE_PASS 1
+#endif
+
+// Integration steps BCE_StepSolve runs between deadline checks. Smaller
+// slices overrun the budget by less and check the clock more often.
+constexpr uint32_t BCE_STEP_SOLVE_SLICE_STEPS = 64;
+
+// Trajectories integrated in lockstep by the batch solver. Sized so the
+// per-lane state arrays fill whole SIMD registers (8 floats = one AVX2 lane).
+#ifndef BCE_BATCH_LANES
+#define BCE_BATCH_LANES 8
+#endif
+
+// Moving-target lead: fixed-point iterations of the impact range over the
+// trajectory table, stopping once the TOF moves by less than the tolerance.
+// Each pass shortens the TOF error by about target speed / bullet speed.
+constexpr uint32_t BCE_LEAD_MAX_ITERATIONS = 6;
+constexpr float BCE_LEAD_TOF_TOLERANCE_S = 0.0001f;
+
 // Thresholds for triggering zero-angle recomputation when atmosphere changes
 constexpr float BCE_ZERO_RECOMPUTE_BC_FACTOR_DELTA = 0.0015f;
 constexpr float BCE_ZERO_RECOMPUTE_DENSITY_DELTA = 0.005f;
 constexpr float BCE_ZERO_RECOMPUTE_SOS_DELTA = 0.75f;
 
+// ---------------------------------------------------------------------------
+// Math
+// ---------------------------------------------------------------------------
+
+// 1 = use the reduced-cost approximations in math/fast_math.h for sqrt,
+// 1/sqrt, pow and exp in the solver and atmosphere and for asin/atan2 in the
+// AHRS angle getters and normalizations. 0 = std:: throughout (default).
+#ifndef BCE_FAST_MATH
+#define BCE_FAST_MATH 0
+#endif
+
+// ---------------------------------------------------------------------------
+// Dispersion (Monte Carlo)
+// ---------------------------------------------------------------------------
+
+// Range 1σ as a fraction of range for an LRF reading with confidence 0,
+// scaled by (1 - confidence). Readings without a confidence add no term.
+constexpr float BCE_DISPERSION_LRF_SIGMA_FRACTION = 0.01f;
+
+// Seed used when BCE_UncertaintyConfig::seed is 0
+constexpr uint32_t BCE_DISPERSION_DEFAULT_SEED = 0x9E3779B9u;
+
+// Statistics keep accumulating while the launch angle stays within this of
+// the nominal they started from (a few times hand-held pitch noise; the
+// incline term barely moves over 0.3°) and the range within this fraction
+// of it. Any change to the trajectory shape (wind, atmosphere, bullet)
+// restarts them.
+constexpr float BCE_DISPERSION_RESTART_ANGLE_RAD = 0.005f;
+constexpr float BCE_DISPERSION_RESTART_RANGE_FRACTION = 0.01f;
+
+// ---------------------------------------------------------------------------
+// Solution Cache
+// ---------------------------------------------------------------------------
+
+// Quantization steps for the SolverParams fingerprint. If every quantized
+// input matches the last solve, the cached SolverResult is reused and the
+// trajectory is not re-integrated.
+constexpr float BCE_SOLUTION_CACHE_RANGE_QUANT_M     = 0.1f;
+constexpr float BCE_SOLUTION_CACHE_ANGLE_QUANT_RAD   = 0.00001f; // 0.01 mrad
+constexpr float BCE_SOLUTION_CACHE_WIND_QUANT_MS     = 0.05f;
+constexpr float BCE_SOLUTION_CACHE_AZIMUTH_QUANT_RAD = 0.001f;   // 1 mrad (Coriolis only)
+
+// Atmosphere-derived inputs are compared against the values the cached
+// result was computed for (hysteresis, not per-frame deltas).
+constexpr float BCE_SOLUTION_CACHE_BC_DELTA      = 0.0001f;
+constexpr float BCE_SOLUTION_CACHE_DENSITY_DELTA = 0.0005f; // kg/m³
+constexpr float BCE_SOLUTION_CACHE_SOS_DELTA     = 0.05f;   // m/s
+
+// Automatic trajectory horizon (no BCE_SetTrajectoryHorizon): each
+// integration tabulates this far past the target, so a tilt or wind change
+// costs an integration to about the target rather than to BCE_MAX_RANGE_M.
+// Every range-only change that runs past the table doubles the margin, so a
+// ranging shooter soon re-integrates no more than a steady one.
+constexpr float BCE_TRAJ_HORIZON_MARGIN_M = 100.0f;
+
+// ---------------------------------------------------------------------------
+// Launch-Angle Cache
+// ---------------------------------------------------------------------------
+
+// With the cache enabled (BCE_SetAngleCacheMode), trajectories are integrated
+// for launch angles on a uniform grid and each solve interpolates across the
+// four grid angles around the bore. Slots hold one coarse table per grid
+// angle (BCE_ANGLE_CACHE_RANGE_STEP_M between records); the default six
+// slots span 2.5° of tilt before a new grid angle must be integrated.
+constexpr float BCE_ANGLE_CACHE_STEP_RAD = 0.5f * BCE_DEG_TO_RAD;
+
+#ifndef BCE_ANGLE_CACHE_SLOTS
+#define BCE_ANGLE_CACHE_SLOTS 6
+#endif
+
+#ifndef BCE_ANGLE_CACHE_RANGE_STEP_M
+#define BCE_ANGLE_CACHE_RANGE_STEP_M 10
+#endif
+
+static_assert(BCE_ANGLE_CACHE_SLOTS >= 4,
+              "BCE_ANGLE_CACHE_SLOTS must cover the four-angle interpolation stencil");
+static_assert(BCE_ANGLE_CACHE_RANGE_STEP_M >= 1 && BCE_MAX_RANGE_M % BCE_ANGLE_CACHE_RANGE_STEP_M == 0,
+              "BCE_ANGLE_CACHE_RANGE_STEP_M must evenly divide BCE_MAX_RANGE_M");
+
+#define BCE_ANGLE_CACHE_TABLE_SIZE (BCE_MAX_RANGE_M / BCE_ANGLE_CACHE_RANGE_STEP_M + 1)
+
+// ---------------------------------------------------------------------------
+// Persistent State
+// ---------------------------------------------------------------------------
+
+// Blob identification for BCE_SaveState / BCE_RestoreState. Bump the
+// version whenever the saved layout or its meaning changes.
+constexpr uint32_t BCE_STATE_MAGIC   = 0x53454342u; // "BCES"
+constexpr uint32_t BCE_STATE_VERSION = 4;
+
+// Spacing of the trajectory records written by BCE_SaveState. The full
+// table is rebuilt between them by cubic Hermite interpolation on restore.
+#ifndef BCE_STATE_TRAJ_STEP_M
+#define BCE_STATE_TRAJ_STEP_M 10
+#endif
+
+static_assert(BCE_STATE_TRAJ_STEP_M >= 1 && BCE_MAX_RANGE_M % BCE_STATE_TRAJ_STEP_M == 0,
+              "BCE_STATE_TRAJ_STEP_M must evenly divide BCE_MAX_RANGE_M");
+
 // ---------------------------------------------------------------------------
 // Magnetometer Configuration
 // ---------------------------------------------------------------------------
@@ -148,3 +378,72 @@ constexpr float BCE_ZERO_RECOMPUTE_SOS_DELTA = 0.75f;
 // Expected Earth field magnitude range (µT)
 constexpr float BCE_MAG_MIN_FIELD_UT = 20.0f;
 constexpr float BCE_MAG_MAX_FIELD_UT = 70.0f;
+
+// Streaming hard/soft-iron fit (BCE_StartMagCalibration): a recursive
+// least-squares ellipsoid fit over raw readings, O(1) time and memory per
+// sample. Readings are scaled by BCE_MAG_CAL_SCALE_UT so the normalized
+// ellipsoid is near the unit sphere. A reading is used only once it is
+// BCE_MAG_CAL_MIN_STEP_UT from the last one used (holding still adds
+// nothing); once BCE_MAG_CAL_MIN_SAMPLES are in, readings whose normalized
+// fit error exceeds BCE_MAG_CAL_MAX_ERROR (about twice the relative radius
+// error) are rejected as disturbances. A commit needs that many samples,
+// BCE_MAG_CAL_MIN_COVERAGE of the 24 direction cells visited, a fitted field
+// inside BCE_MAG_MIN/MAX_FIELD_UT and axes within BCE_MAG_CAL_MAX_AXIS_RATIO.
+// BCE_MAG_CAL_FORGETTING < 1 lets the fit track slowly changing iron.
+constexpr float    BCE_MAG_CAL_SCALE_UT       = 50.0f;
+constexpr float    BCE_MAG_CAL_MIN_STEP_UT    = 2.0f;
+constexpr uint32_t BCE_MAG_CAL_MIN_SAMPLES    = 100;
+constexpr float    BCE_MAG_CAL_MAX_ERROR      = 0.3f;
+constexpr float    BCE_MAG_CAL_MIN_COVERAGE   = 0.75f;
+constexpr float    BCE_MAG_CAL_MAX_AXIS_RATIO = 2.0f;
+constexpr float    BCE_MAG_CAL_FORGETTING     = 1.0f;
+constexpr float    BCE_MAG_CAL_RLS_INIT       = 100.0f; // initial covariance diagonal
+
+// ---------------------------------------------------------------------------
+// Profiling
+// ---------------------------------------------------------------------------
+
+// Opt-in per-stage timing and solver effort counters, read through
+// BCE_GetPerfStats(). When 0 the instrumentation compiles out entirely.
+#ifndef BCE_ENABLE_PROFILING
+#define BCE_ENABLE_PROFILING 0
+#endif
+
+// ---------------------------------------------------------------------------
+// Input Recorder
+// ---------------------------------------------------------------------------
+
+// Packed SensorFrame stream identification (BCE_ReadRecorder output). Bump
+// the version whenever the encoding changes.
+constexpr uint32_t BCE_FRAME_LOG_MAGIC   = 0x46454342u; // "BCEF"
+constexpr uint32_t BCE_FRAME_LOG_VERSION = 1;
+
+// Ring buffer between BCE_Update and the BCE_ReadRecorder drain (bytes,
+// power of two). A packed frame is typically 50–60 bytes at 100 Hz.
+#ifndef BCE_RECORDER_BUFFER_BYTES
+#define BCE_RECORDER_BUFFER_BYTES 8192
+#endif
+
+static_assert(BCE_RECORDER_BUFFER_BYTES >= 256 &&
+              (BCE_RECORDER_BUFFER_BYTES & (BCE_RECORDER_BUFFER_BYTES - 1)) == 0,
+              "BCE_RECORDER_BUFFER_BYTES must be a power of two of at least 256");
+
+// ---------------------------------------------------------------------------
+// Profile Database
+// ---------------------------------------------------------------------------
+
+// Packed cartridge/gun database identification (BCE_SetProfileDb input).
+// Bump the version whenever the record layout changes.
+constexpr uint32_t BCE_PROFILE_DB_MAGIC   = 0x50454342u; // "BCEP"
+constexpr uint32_t BCE_PROFILE_DB_VERSION = 2;
+
+// ---------------------------------------------------------------------------
+// Memory Budget
+// ---------------------------------------------------------------------------
+
+// Static RAM one engine instance may take (bytes, BCE_InstanceSize()). When
+// non-zero the build fails if the configuration exceeds it; the
+// per-subsystem split is reported by BCE_GetMemoryReport().
+#ifndef BCE_ENGINE_RAM_BUDGET_BYTES
+#define BCE_ENGINE_RAM_BUDGET_BYTES 0
+#endif
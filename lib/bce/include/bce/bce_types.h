@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "bce_config.h"
 #include <cstdint>
 
 // ---------------------------------------------------------------------------
@@ -30,6 +31,7 @@ namespace BCE_Fault {
     constexpr uint32_t ZERO_UNSOLVABLE = (1u << 4);
     constexpr uint32_t AHRS_UNSTABLE   = (1u << 5);
     constexpr uint32_t SENSOR_INVALID  = (1u << 6);
+    constexpr uint32_t NO_DRAG_CURVE   = (1u << 7);  // DragModel::CUSTOM with no curve loaded
 } // namespace BCE_Fault
 
 // ---------------------------------------------------------------------------
@@ -45,6 +47,8 @@ namespace BCE_Diag {
     constexpr uint32_t DEFAULT_WIND       = (1u << 5);
     constexpr uint32_t MAG_SUPPRESSED     = (1u << 6);
     constexpr uint32_t LRF_STALE          = (1u << 7);
+    constexpr uint32_t SOLUTION_PENDING   = (1u << 8);  // BCE_StepSolve still working; last complete solution shown
+    constexpr uint32_t LEAD_UNRESOLVED    = (1u << 9);  // Lead clamped at the tabulated extent or not converged
 } // namespace BCE_Diag
 
 // ---------------------------------------------------------------------------
@@ -58,7 +62,16 @@ enum class DragModel : uint8_t {
     G5 = 5,
     G6 = 6,
     G7 = 7,
-    G8 = 8
+    G8 = 8,
+    CUSTOM = 9  // BCE_SetCustomDragCurve() curve; BCE_Fault::NO_DRAG_CURVE until one is set
+};
+
+// ---------------------------------------------------------------------------
+// Drag Curve Point — one (Mach, Cd) breakpoint of a drag table
+// ---------------------------------------------------------------------------
+struct DragPoint {
+    float mach;
+    float cd;
 };
 
 // ---------------------------------------------------------------------------
@@ -69,6 +82,27 @@ enum class AHRS_Algorithm : uint8_t {
     MAHONY   = 1
 };
 
+// ---------------------------------------------------------------------------
+// Trajectory Integrator Selection
+// ---------------------------------------------------------------------------
+enum class IntegratorMethod : uint8_t {
+    RK4            = 0,  // Fixed-heuristic step RK4 (legacy default)
+    DORMAND_PRINCE = 1,  // Error-controlled Dormand–Prince 5(4)
+    RK4_RANGE      = 2   // RK4 in downrange distance, steps end on table records
+};
+
+// Run-time integrator settings (BCE_SetIntegratorTuning, or per cartridge in
+// the profile DB). Fields ≤ 0 take the bce_config.h default, so a
+// zero-initialized tuning is the legacy RK4.
+struct IntegratorTuning {
+    IntegratorMethod method;
+    float tolerance_m;           // DORMAND_PRINCE per-step position tolerance (BCE_RK45_DEFAULT_TOLERANCE_M)
+    float step_scale_m;          // RK4: dt = step_scale_m / speed outside Mach 0.9–1.2 (BCE_RK4_STEP_SCALE_M)
+    float max_step_m;            // RK4: longest downrange step; DORMAND_PRINCE: first step (BCE_MAX_STEP_DISTANCE_M)
+    float transonic_dt_s;        // RK4: step inside Mach 0.9–1.2 (BCE_DT_MIN)
+    float range_step_m;          // RK4_RANGE: longest downrange step (BCE_RANGE_STEP_M)
+};
+
 // ---------------------------------------------------------------------------
 // SensorFrame — SRS §7
 // ---------------------------------------------------------------------------
@@ -103,6 +137,15 @@ struct SensorFrame {
     bool  encoder_valid;
 };
 
+// ---------------------------------------------------------------------------
+// ImuSample — one entry of an IMU FIFO burst (BCE_UpdateIMUBurst)
+// ---------------------------------------------------------------------------
+struct ImuSample {
+    uint64_t timestamp_us;             // microseconds since boot
+    float accel_x, accel_y, accel_z;   // m/s²
+    float gyro_x, gyro_y, gyro_z;      // rad/s
+};
+
 // ---------------------------------------------------------------------------
 // Default Overrides — SRS §5.2
 // ---------------------------------------------------------------------------
@@ -127,12 +170,20 @@ struct BCE_DefaultOverrides {
     float latitude_deg;
 };
 
+// ---------------------------------------------------------------------------
+// BC Band — one velocity segment of a multi-BC bullet data sheet
+// ---------------------------------------------------------------------------
+struct BCBand {
+    float bc;                 // applies below below_velocity_ms ...
+    float below_velocity_ms;  // ... down to the next band's threshold (m/s)
+};
+
 // ---------------------------------------------------------------------------
 // Bullet Profile — SRS §8
 // ---------------------------------------------------------------------------
 struct BulletProfile {
     float     bc;                     // Ballistic coefficient
-    DragModel drag_model;             // G1–G8
+    DragModel drag_model;             // G1–G8 or CUSTOM
     float     muzzle_velocity_ms;     // m/s
     float     barrel_length_in;       // inches
     float     mv_adjustment_factor;   // fps per inch deviation from 24"
@@ -140,6 +191,12 @@ struct BulletProfile {
     float     length_mm;              // mm
     float     caliber_inches;         // inches
     float     twist_rate_inches;      // signed: positive = RH, negative = LH
+
+    // Optional velocity bands (data-sheet multi-BC): bc applies above
+    // bc_bands[0].below_velocity_ms, each band below its threshold. Thresholds
+    // must descend; bands from the first invalid one on are ignored.
+    BCBand    bc_bands[BCE_MAX_BC_BANDS];
+    uint8_t   bc_band_count;          // 0 = bc at every velocity
 };
 
 // ---------------------------------------------------------------------------
@@ -179,6 +236,157 @@ struct FiringSolution {
     float heading_deg_true;          // True heading from AHRS + mag
 
     float air_density_kgm3;          // Computed air density
+
+    // Moving target (BCE_SetTargetMotion): the holds above include the lead.
+    // Zero, and lead_range_m = range_m, for a stationary target.
+    float lead_elevation_moa;        // Elevation lead for the range change during flight
+    float lead_windage_moa;          // Windage lead: crossing motion plus wind drift change
+    float lead_range_m;              // Target range at impact
+};
+
+// Called with each materially changed solution (BCE_SetSolutionCallback)
+typedef void (*BCE_SolutionCallback)(const FiringSolution* solution, void* user);
+
+// ---------------------------------------------------------------------------
+// Trajectory record — one per BCE_TRAJ_TABLE_STRIDE_M meters of downrange
+// travel in the solver's table (BCE_GetTrajectoryView)
+// ---------------------------------------------------------------------------
+struct TrajectoryPoint {
+    float drop_m;           // Vertical drop from bore line (m, negative = below)
+    float windage_m;        // Lateral deflection (m, positive = right)
+    float velocity_ms;      // Velocity at this range
+    float tof_s;            // Time of flight to this range (seconds)
+    float energy_j;         // Kinetic energy at this range (joules)
+};
+
+// ---------------------------------------------------------------------------
+// Solver Diagnostics — informational effort counters, reset by BCE_Init()
+// ---------------------------------------------------------------------------
+struct BCE_SolverDiagnostics {
+    uint32_t solution_cache_hits;     // Solves answered from the cached result
+    uint32_t solution_cache_misses;   // Solves that ran a full integration
+    uint32_t trajectory_table_hits;   // Range-only changes sampled from the trajectory table
+    uint32_t zero_iterations;         // Full-fidelity integrations used by the most recent zero solve
+    uint32_t angle_cache_hits;        // Solves interpolated across cached launch angles
+    uint32_t angle_cache_fills;       // Grid launch angles integrated into the angle cache
+    uint32_t zero_coarse_iterations;  // Coarse-pass integrations used by the most recent zero solve
+    uint32_t lead_iterations;         // Table samples used by the most recent moving-target lead
+    uint32_t trajectory_extent_m;     // Range the most recent trajectory integration tabulated to
+};
+
+// ---------------------------------------------------------------------------
+// Performance Stats — populated only when built with BCE_ENABLE_PROFILING
+// ---------------------------------------------------------------------------
+namespace BCE_PerfStage {
+    constexpr uint32_t AHRS       = 0;  // IMU/mag ingestion + AHRS filter
+    constexpr uint32_t ATMOSPHERE = 1;  // Baro ingestion + atmosphere update
+    constexpr uint32_t LRF        = 2;  // Range ingestion + filter
+    constexpr uint32_t ZERO       = 3;  // Zero-angle recompute
+    constexpr uint32_t SOLVE      = 4;  // State machine + trajectory + corrections (excl. zero)
+    constexpr uint32_t COUNT      = 5;
+}
+
+struct BCE_PerfStats {
+    uint32_t enabled;                                 // 1 if built with BCE_ENABLE_PROFILING
+    uint32_t tick_hz;                                 // Tick rate of all *_ticks fields
+    uint32_t frame_count;                             // BCE_Update calls since BCE_Init() (split mode: solver services)
+
+    // Last frame
+    uint32_t frame_ticks;
+    uint32_t stage_ticks[BCE_PerfStage::COUNT];
+    uint32_t integration_steps;                       // Integrator steps (all integrations)
+    uint32_t drag_lookups;                            // Drag deceleration evaluations
+    uint32_t zero_iterations;                         // Zero-solver integrations (0 if no recompute)
+
+    // Worst case since BCE_Init()
+    uint32_t frame_ticks_max;
+    uint32_t stage_ticks_max[BCE_PerfStage::COUNT];
+};
+
+// ---------------------------------------------------------------------------
+// Dispersion (Monte Carlo) — input sigmas and streamed impact statistics
+// ---------------------------------------------------------------------------
+struct BCE_UncertaintyConfig {
+    float    mv_sigma_ms;             // Muzzle velocity 1σ (m/s)
+    float    bc_sigma_fraction;       // BC 1σ as a fraction of BC (0.01 = 1 %)
+    float    wind_speed_sigma_ms;     // Wind speed 1σ (m/s)
+    float    wind_heading_sigma_deg;  // Wind heading 1σ (degrees)
+    float    range_sigma_m;           // Range 1σ (m), combined with the LRF confidence term
+    float    density_sigma_fraction;  // Air density 1σ as a fraction of density
+    float    target_radius_m;         // Radius of the hit circle at the target (m)
+    uint32_t seed;                    // Sampler seed (0 = fixed default)
+};
+
+struct BCE_DispersionStats {
+    uint32_t sample_count;            // Samples accumulated for the current solution
+
+    // Impact offset from the point of aim (MOA, + = high / right)
+    float mean_elevation_moa;
+    float mean_windage_moa;
+    float sigma_elevation_moa;
+    float sigma_windage_moa;
+
+    // 1σ impact ellipse: semi-axes and orientation of the major axis
+    // (degrees counter-clockwise from the windage axis)
+    float ellipse_major_moa;
+    float ellipse_minor_moa;
+    float ellipse_angle_deg;
+
+    float target_radius_moa;          // Hit circle radius at the nominal range
+    float hit_probability;            // Fraction of samples inside the hit circle
+};
+
+// ---------------------------------------------------------------------------
+// Sensitivities — first-order change of the solution per unit of one input,
+// with the bore held at its current angle (the rifle keeps its zero)
+// ---------------------------------------------------------------------------
+struct BCE_HoldPartials {
+    float elevation_moa;              // d(hold_elevation_moa)
+    float windage_moa;                // d(hold_windage_moa)
+    float tof_ms;                     // d(tof_ms)
+    float velocity_ms;                // d(velocity_at_target_ms)
+};
+
+struct BCE_Sensitivity {
+    BCE_HoldPartials range;           // per meter of target range
+    BCE_HoldPartials muzzle_velocity; // per m/s
+    BCE_HoldPartials bc;              // per unit fractional BC change (× 0.01 for 1 %)
+    BCE_HoldPartials crosswind;       // per m/s, positive = right-to-left
+    BCE_HoldPartials headwind;        // per m/s, positive = into shooter
+};
+
+// ---------------------------------------------------------------------------
+// Memory Report — static RAM of one engine instance by subsystem, fixed by
+// the build configuration (BCE_MAX_RANGE_M, table and cache settings)
+// ---------------------------------------------------------------------------
+struct BCE_MemoryReport {
+    uint32_t instance_bytes;          // BCE_InstanceSize(): trajectory_table_bytes..engine_bytes
+    uint32_t trajectory_table_bytes;  // solver trajectory table (BCE_TRAJ_TABLE_SIZE records)
+    uint32_t solver_bytes;            // rest of the solver: integration and zero-search state
+    uint32_t angle_cache_bytes;       // launch-angle cache tables
+    uint32_t ahrs_bytes;              // AHRS filters and static-detection windows
+    uint32_t sensor_bytes;            // magnetometer calibration and fit, atmosphere, wind
+    uint32_t dispersion_bytes;        // Monte Carlo sampler and statistics
+    uint32_t recorder_bytes;          // input recorder ring (BCE_RECORDER_BUFFER_BYTES)
+    uint32_t engine_bytes;            // engine state: solutions, snapshots, caches, inputs
+    uint32_t shared_bytes;            // process-wide, once for all instances (custom drag curve)
+    uint32_t max_range_m;             // BCE_MAX_RANGE_M the tables are sized for
+};
+
+// ---------------------------------------------------------------------------
+// Streaming Magnetometer Calibration — progress of the on-device
+// hard/soft-iron fit (BCE_StartMagCalibration)
+// ---------------------------------------------------------------------------
+struct BCE_MagCalStatus {
+    uint32_t samples;            // readings folded into the fit
+    uint32_t rejected;           // implausible or disturbed readings skipped
+    float coverage;              // visited fraction of the 24 direction cells (0–1)
+    float field_ut;              // fitted field strength, 0 until it is an ellipsoid
+    float residual_ut;           // approximate RMS distance of readings from the fit
+    float hard_iron[3];          // calibration a commit would apply
+    float soft_iron[9];
+    bool collecting;             // readings are being folded in
+    bool ready;                  // BCE_CommitMagCalibration would succeed
 };
 
 // ---------------------------------------------------------------------------
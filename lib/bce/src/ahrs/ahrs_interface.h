@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "../math/fast_math.h"
 #include <cstdint>
 #include <cmath>
 
@@ -15,9 +16,9 @@ struct Quaternion {
     float w, x, y, z;
 
     void normalize() {
-        float norm = std::sqrt(w * w + x * x + y * y + z * z);
-        if (norm > 0.0f) {
-            float inv = 1.0f / norm;
+        float norm2 = w * w + x * x + y * y + z * z;
+        if (norm2 > 0.0f) {
+            float inv = bceRsqrt(norm2);
             w *= inv;
             x *= inv;
             y *= inv;
@@ -58,7 +59,7 @@ public:
         float sinp = 2.0f * (q.w * q.y - q.z * q.x);
         if (sinp > 1.0f) sinp = 1.0f;
         if (sinp < -1.0f) sinp = -1.0f;
-        return std::asin(sinp);
+        return bceAsin(sinp);
     }
 
     /** Roll angle in radians (right wing down positive). */
@@ -66,7 +67,7 @@ public:
         Quaternion q = getQuaternion();
         float sinr_cosp = 2.0f * (q.w * q.x + q.y * q.z);
         float cosr_cosp = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
-        return std::atan2(sinr_cosp, cosr_cosp);
+        return bceAtan2(sinr_cosp, cosr_cosp);
     }
 
     /** Yaw angle in radians (clockwise from north positive). */
@@ -74,6 +75,6 @@ public:
         Quaternion q = getQuaternion();
         float siny_cosp = 2.0f * (q.w * q.z + q.x * q.y);
         float cosy_cosp = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
-        return std::atan2(siny_cosp, cosy_cosp);
+        return bceAtan2(siny_cosp, cosy_cosp);
     }
 };
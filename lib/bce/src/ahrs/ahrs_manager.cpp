@@ -10,9 +10,10 @@
 void AHRSManager::init() {
     madgwick_.reset();
     mahony_.reset();
-    std::memset(accel_mag_buf_, 0, sizeof(accel_mag_buf_));
-    buf_index_ = 0;
+    accel_mag_stats_.reset();
+    gyro_mag_stats_.reset();
     sample_count_ = 0;
+    static_gyro_rms_ = BCE_AHRS_STATIC_GYRO_RMS_RADS;
     is_static_ = false;
     std::memset(accel_bias_, 0, sizeof(accel_bias_));
     std::memset(gyro_bias_, 0, sizeof(gyro_bias_));
@@ -50,7 +51,47 @@ void AHRSManager::update(float ax, float ay, float az,
     activeFilter()->update(ax, ay, az, gx, gy, gz, mx, my, mz, use_mag, dt);
 
     // Update static detection
-    updateStaticDetection(ax, ay, az);
+    if (pushStaticSample(ax, ay, az, gx, gy, gz)) {
+        is_static_ = false;
+    } else {
+        evaluateStaticDetection();
+    }
+}
+
+void AHRSManager::updateBurst(const ImuSample* samples, const float* dt, int count) {
+    if (!samples || !dt || count <= 0) return;
+
+    float accel[BCE_AHRS_BURST_MAX][3];
+    float gyro[BCE_AHRS_BURST_MAX][3];
+    bool warming = false;
+    for (int start = 0; start < count; start += BCE_AHRS_BURST_MAX) {
+        int n = count - start;
+        if (n > BCE_AHRS_BURST_MAX) n = BCE_AHRS_BURST_MAX;
+
+        for (int i = 0; i < n; ++i) {
+            const ImuSample& s = samples[start + i];
+            accel[i][0] = s.accel_x - accel_bias_[0];
+            accel[i][1] = s.accel_y - accel_bias_[1];
+            accel[i][2] = s.accel_z - accel_bias_[2];
+            gyro[i][0] = s.gyro_x - gyro_bias_[0];
+            gyro[i][1] = s.gyro_y - gyro_bias_[1];
+            gyro[i][2] = s.gyro_z - gyro_bias_[2];
+            warming = pushStaticSample(accel[i][0], accel[i][1], accel[i][2],
+                                       gyro[i][0], gyro[i][1], gyro[i][2]);
+        }
+
+        if (algorithm_ == AHRS_Algorithm::MAHONY) {
+            mahony_.updateBurst(accel, gyro, dt + start, n);
+        } else {
+            madgwick_.updateBurst(accel, gyro, dt + start, n);
+        }
+    }
+
+    if (warming) {
+        is_static_ = false;
+    } else {
+        evaluateStaticDetection();
+    }
 }
 
 void AHRSManager::setAccelBias(const float bias[3]) {
@@ -87,31 +128,25 @@ float AHRSManager::getYaw() const {
     return const_cast<AHRS_Interface*>(activeFilter())->getYaw();
 }
 
-void AHRSManager::updateStaticDetection(float ax, float ay, float az) {
-    float mag = std::sqrt(ax * ax + ay * ay + az * az);
-    accel_mag_buf_[buf_index_] = mag;
-    buf_index_ = (buf_index_ + 1) % BCE_AHRS_STATIC_WINDOW;
+bool AHRSManager::pushStaticSample(float ax, float ay, float az,
+                                   float gx, float gy, float gz) {
+    accel_mag_stats_.push(std::sqrt(ax * ax + ay * ay + az * az));
+    gyro_mag_stats_.push(std::sqrt(gx * gx + gy * gy + gz * gz));
 
     if (sample_count_ < static_cast<uint32_t>(BCE_AHRS_STATIC_WINDOW)) {
         sample_count_++;
-        is_static_ = false;
-        return;
-    }
-
-    // Compute mean
-    float sum = 0.0f;
-    for (int i = 0; i < BCE_AHRS_STATIC_WINDOW; ++i) {
-        sum += accel_mag_buf_[i];
+        return true;
     }
-    float mean = sum / static_cast<float>(BCE_AHRS_STATIC_WINDOW);
+    return false;
+}
 
-    // Compute variance
-    float var = 0.0f;
-    for (int i = 0; i < BCE_AHRS_STATIC_WINDOW; ++i) {
-        float diff = accel_mag_buf_[i] - mean;
-        var += diff * diff;
+void AHRSManager::evaluateStaticDetection() {
+    bool still = accel_mag_stats_.variance() < BCE_AHRS_STATIC_THRESHOLD;
+    if (still && static_gyro_rms_ > 0.0f) {
+        // Mean square rate = variance + mean², over the same window
+        float mean = gyro_mag_stats_.mean();
+        float mean_sq = gyro_mag_stats_.variance() + mean * mean;
+        still = mean_sq < static_gyro_rms_ * static_gyro_rms_;
     }
-    var /= static_cast<float>(BCE_AHRS_STATIC_WINDOW);
-
-    is_static_ = (var < BCE_AHRS_STATIC_THRESHOLD);
+    is_static_ = still;
 }
@@ -3,13 +3,15 @@
  * @brief AHRS manager — owns both filters, handles bias, and static detection.
  *
  * Wraps the selectable filter behind a unified interface with bias correction,
- * static/dynamic detection via accel variance, and quaternion snapshot support.
+ * static/dynamic detection via accel variance (optionally gyro rate too), and
+ * quaternion snapshot support.
  */
 
 #pragma once
 
 #include "madgwick.h"
 #include "mahony.h"
+#include "sliding_variance.h"
 #include "bce/bce_config.h"
 #include "bce/bce_types.h"
 
@@ -26,6 +28,14 @@ public:
                 float mx, float my, float mz,
                 bool use_mag, float dt);
 
+    /**
+     * Feed a burst of raw IMU samples (no magnetometer), dt[i] seconds each.
+     * The active filter is selected once per BCE_AHRS_BURST_MAX-sample chunk
+     * and static detection is re-evaluated once at the end; attitude is the
+     * same as feeding the samples one by one through update().
+     */
+    void updateBurst(const ImuSample* samples, const float* dt, int count);
+
     void setAccelBias(const float bias[3]);
     void setGyroBias(const float bias[3]);
 
@@ -34,6 +44,12 @@ public:
      */
     void captureGyroBias(float gx, float gy, float gz);
 
+    /**
+     * Also require the window's RMS rotation rate (rad/s) to stay below
+     * rms_rad_s for static detection. ≤ 0 disables the gyro channel.
+     */
+    void setStaticGyroThreshold(float rms_rad_s) { static_gyro_rms_ = rms_rad_s; }
+
     Quaternion getQuaternion() const;
     float getPitch() const;
     float getRoll() const;
@@ -55,13 +71,16 @@ private:
     float accel_bias_[3] = {0, 0, 0};
     float gyro_bias_[3]  = {0, 0, 0};
 
-    // Static detection ring buffer
-    float accel_mag_buf_[BCE_AHRS_STATIC_WINDOW] = {};
-    int buf_index_ = 0;
+    // Static detection: running statistics of |accel| and |gyro|
+    SlidingVariance<BCE_AHRS_STATIC_WINDOW> accel_mag_stats_;
+    SlidingVariance<BCE_AHRS_STATIC_WINDOW> gyro_mag_stats_;
     uint32_t sample_count_ = 0;
+    float static_gyro_rms_ = BCE_AHRS_STATIC_GYRO_RMS_RADS;
     bool is_static_ = false;
 
     AHRS_Interface* activeFilter();
     const AHRS_Interface* activeFilter() const;
-    void updateStaticDetection(float ax, float ay, float az);
+    /** Record one sample's magnitudes; true while the window is still filling. */
+    bool pushStaticSample(float ax, float ay, float az, float gx, float gy, float gz);
+    void evaluateStaticDetection();
 };
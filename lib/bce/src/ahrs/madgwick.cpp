@@ -4,6 +4,7 @@
  */
 
 #include "madgwick.h"
+#include "../math/fast_math.h"
 #include <cmath>
 
 void MadgwickFilter::update(float ax, float ay, float az,
@@ -19,18 +20,18 @@ void MadgwickFilter::update(float ax, float ay, float az,
     float qDot3 = 0.5f * ( q0 * gz + q1 * gy - q2 * gx);
 
     // Normalize accelerometer
-    float a_norm = std::sqrt(ax * ax + ay * ay + az * az);
-    if (a_norm > 0.001f) {
-        float a_inv = 1.0f / a_norm;
+    float a_norm2 = ax * ax + ay * ay + az * az;
+    if (a_norm2 > 1e-6f) {
+        float a_inv = bceRsqrt(a_norm2);
         ax *= a_inv;
         ay *= a_inv;
         az *= a_inv;
 
         if (use_mag) {
             // Normalize magnetometer
-            float m_norm = std::sqrt(mx * mx + my * my + mz * mz);
-            if (m_norm > 0.001f) {
-                float m_inv = 1.0f / m_norm;
+            float m_norm2 = mx * mx + my * my + mz * mz;
+            if (m_norm2 > 1e-6f) {
+                float m_inv = bceRsqrt(m_norm2);
                 mx *= m_inv;
                 my *= m_inv;
                 mz *= m_inv;
@@ -58,7 +59,7 @@ void MadgwickFilter::update(float ax, float ay, float az,
                 float hy = 2.0f * mx * (q1q2 + q0q3) +
                            my * (q0q0 - q1q1 + q2q2 - q3q3) +
                            2.0f * mz * (q2q3 - q0q1);
-                float _2bx = std::sqrt(hx * hx + hy * hy);
+                float _2bx = bceSqrt(hx * hx + hy * hy);
                 float _2bz = 2.0f * mx * (q1q3 - q0q2) +
                               2.0f * my * (q2q3 + q0q1) +
                               mz * (q0q0 - q1q1 - q2q2 + q3q3);
@@ -88,9 +89,9 @@ void MadgwickFilter::update(float ax, float ay, float az,
                             _2bx * q1 * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
 
                 // Normalize gradient step
-                float s_norm = std::sqrt(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
-                if (s_norm > 0.001f) {
-                    float s_inv = 1.0f / s_norm;
+                float s_norm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+                if (s_norm2 > 1e-6f) {
+                    float s_inv = bceRsqrt(s_norm2);
                     s0 *= s_inv;
                     s1 *= s_inv;
                     s2 *= s_inv;
@@ -124,9 +125,9 @@ void MadgwickFilter::update(float ax, float ay, float az,
             float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
             float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
 
-            float s_norm = std::sqrt(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
-            if (s_norm > 0.001f) {
-                float s_inv = 1.0f / s_norm;
+            float s_norm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+            if (s_norm2 > 1e-6f) {
+                float s_inv = bceRsqrt(s_norm2);
                 s0 *= s_inv;
                 s1 *= s_inv;
                 s2 *= s_inv;
@@ -153,3 +154,13 @@ void MadgwickFilter::update(float ax, float ay, float az,
     q_.z = q3;
     q_.normalize();
 }
+
+void MadgwickFilter::updateBurst(const float (*accel)[3], const float (*gyro)[3],
+                                 const float* dt, int count) {
+    // Qualified call: bound statically and inlined with use_mag = false
+    for (int i = 0; i < count; ++i) {
+        MadgwickFilter::update(accel[i][0], accel[i][1], accel[i][2],
+                                gyro[i][0], gyro[i][1], gyro[i][2],
+                                0.0f, 0.0f, 0.0f, false, dt[i]);
+    }
+}
@@ -4,6 +4,7 @@
  */
 
 #include "mahony.h"
+#include "../math/fast_math.h"
 #include <cmath>
 
 void MahonyFilter::update(float ax, float ay, float az,
@@ -16,9 +17,9 @@ void MahonyFilter::update(float ax, float ay, float az,
     float ex = 0.0f, ey = 0.0f, ez = 0.0f;
 
     // Normalize accelerometer
-    float a_norm = std::sqrt(ax * ax + ay * ay + az * az);
-    if (a_norm > 0.001f) {
-        float a_inv = 1.0f / a_norm;
+    float a_norm2 = ax * ax + ay * ay + az * az;
+    if (a_norm2 > 1e-6f) {
+        float a_inv = bceRsqrt(a_norm2);
         ax *= a_inv;
         ay *= a_inv;
         az *= a_inv;
@@ -35,9 +36,9 @@ void MahonyFilter::update(float ax, float ay, float az,
     }
 
     if (use_mag) {
-        float m_norm = std::sqrt(mx * mx + my * my + mz * mz);
-        if (m_norm > 0.001f) {
-            float m_inv = 1.0f / m_norm;
+        float m_norm2 = mx * mx + my * my + mz * mz;
+        if (m_norm2 > 1e-6f) {
+            float m_inv = bceRsqrt(m_norm2);
             mx *= m_inv;
             my *= m_inv;
             mz *= m_inv;
@@ -45,7 +46,7 @@ void MahonyFilter::update(float ax, float ay, float az,
             // Reference direction of Earth's magnetic field (rotate mag to Earth frame)
             float hx = 2.0f * (mx * (0.5f - q2 * q2 - q3 * q3) + my * (q1 * q2 - q0 * q3) + mz * (q1 * q3 + q0 * q2));
             float hy = 2.0f * (mx * (q1 * q2 + q0 * q3) + my * (0.5f - q1 * q1 - q3 * q3) + mz * (q2 * q3 - q0 * q1));
-            float bx = std::sqrt(hx * hx + hy * hy);
+            float bx = bceSqrt(hx * hx + hy * hy);
             float bz = 2.0f * (mx * (q1 * q3 - q0 * q2) + my * (q2 * q3 + q0 * q1) + mz * (0.5f - q1 * q1 - q2 * q2));
 
             // Estimated magnetic field direction from quaternion
@@ -92,3 +93,13 @@ void MahonyFilter::update(float ax, float ay, float az,
     q_.z = q3;
     q_.normalize();
 }
+
+void MahonyFilter::updateBurst(const float (*accel)[3], const float (*gyro)[3],
+                               const float* dt, int count) {
+    // Qualified call: bound statically and inlined with use_mag = false
+    for (int i = 0; i < count; ++i) {
+        MahonyFilter::update(accel[i][0], accel[i][1], accel[i][2],
+                              gyro[i][0], gyro[i][1], gyro[i][2],
+                              0.0f, 0.0f, 0.0f, false, dt[i]);
+    }
+}
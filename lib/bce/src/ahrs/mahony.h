@@ -11,7 +11,7 @@
 #include "ahrs_interface.h"
 #include "bce/bce_config.h"
 
-class MahonyFilter : public AHRS_Interface {
+class MahonyFilter final : public AHRS_Interface {
 public:
     MahonyFilter() { reset(); }
 
@@ -22,6 +22,14 @@ public:
                 float mx, float my, float mz,
                 bool use_mag, float dt) override;
 
+    /**
+     * IMU-only update for count samples (bias-corrected), dt[i] seconds
+     * each. Same result as count update() calls with use_mag = false, minus
+     * the per-sample virtual dispatch.
+     */
+    void updateBurst(const float (*accel)[3], const float (*gyro)[3],
+                     const float* dt, int count);
+
     void reset() override {
         q_ = {1.0f, 0.0f, 0.0f, 0.0f};
         integral_fb_x_ = 0.0f;
@@ -0,0 +1,85 @@
+/**
+ * @file sliding_variance.h
+ * @brief O(1) mean and variance over the last N samples.
+ *
+ * Each push updates a sliding Welford estimate (add the new sample, remove
+ * the one N samples back) in constant time, independent of N. Float
+ * rounding in the remove step would slowly accumulate, so a second Welford
+ * accumulator runs over each pass of the ring from scratch; when the ring
+ * wraps it covers exactly the current window and replaces the sliding
+ * estimate. Error is therefore bounded by one window's worth of updates,
+ * without ever rescanning the buffer. Samples are kept relative to the first
+ * one pushed, so a large constant offset (gravity) costs no precision.
+ */
+
+#pragma once
+
+template <int N>
+class SlidingVariance {
+    static_assert(N >= 2, "SlidingVariance window must hold at least two samples");
+
+public:
+    void reset() {
+        for (float& x : buf_) x = 0.0f;
+        head_ = 0;
+        count_ = 0;
+        shift_ = 0.0f;
+        mean_ = m2_ = 0.0f;
+        pass_n_ = 0;
+        pass_mean_ = pass_m2_ = 0.0f;
+    }
+
+    /** Add x, dropping the sample N pushes back once the window is full. */
+    void push(float x) {
+        if (count_ == 0) shift_ = x;
+        x -= shift_;
+        if (count_ < N) {
+            count_++;
+            float d = x - mean_;
+            mean_ += d / static_cast<float>(count_);
+            m2_ += d * (x - mean_);
+        } else {
+            float old = buf_[head_];
+            float mean = mean_ + (x - old) * (1.0f / static_cast<float>(N));
+            m2_ += (x - old) * ((x - mean) + (old - mean_));
+            if (m2_ < 0.0f) m2_ = 0.0f;
+            mean_ = mean;
+        }
+        buf_[head_] = x;
+
+        pass_n_++;
+        float d = x - pass_mean_;
+        pass_mean_ += d / static_cast<float>(pass_n_);
+        pass_m2_ += d * (x - pass_mean_);
+
+        if (++head_ == N) {
+            // This pass visited every slot: it is the window, exactly
+            head_ = 0;
+            mean_ = pass_mean_;
+            m2_ = pass_m2_;
+            pass_n_ = 0;
+            pass_mean_ = pass_m2_ = 0.0f;
+        }
+    }
+
+    /** True once N samples have been pushed. */
+    bool full() const { return count_ >= N; }
+
+    float mean() const { return shift_ + mean_; }
+
+    /** Population variance of the samples in the window (0 if empty). */
+    float variance() const {
+        return (count_ > 0) ? m2_ / static_cast<float>(count_) : 0.0f;
+    }
+
+private:
+    float buf_[N] = {};
+    int head_ = 0;
+    int count_ = 0;      // samples in the window, saturating at N
+    float shift_ = 0.0f; // first sample; buf_ and the estimates are relative to it
+    float mean_ = 0.0f;  // sliding estimate
+    float m2_ = 0.0f;
+    int pass_n_ = 0;     // from-scratch accumulator over this pass of the ring
+    float pass_mean_ = 0.0f;
+    float pass_m2_ = 0.0f;
+};
@@ -16,6 +16,7 @@
  */
 
 #include "atmosphere.h"
+#include "../math/fast_math.h"
 #include <cmath>
 
 // Imperial conversion factors (internal use only for reference formulas)
@@ -31,6 +32,10 @@ void Atmosphere::init() {
     altitude_m_      = BCE_DEFAULT_ALTITUDE_M;
     baro_offset_pa_  = 0.0f;
 
+    pressure_deadband_pa_   = BCE_ATMO_PRESSURE_DEADBAND_PA;
+    temperature_deadband_c_ = BCE_ATMO_TEMPERATURE_DEADBAND_C;
+    humidity_deadband_      = BCE_ATMO_HUMIDITY_DEADBAND;
+
     has_baro_pressure_    = false;
     has_baro_temperature_ = false;
     has_baro_humidity_    = false;
@@ -39,26 +44,29 @@ void Atmosphere::init() {
     has_override_temp_      = false;
     has_override_humidity_  = false;
     had_invalid_input_      = false;
-    zero_recompute_hint_    = false;
-    last_bc_factor_         = 1.0f;
 
-    recompute();
-    last_bc_factor_ = correctBC(1.0f);
+    markChanged();
+    derive();
     zero_recompute_hint_ = false;
 }
 
 bool Atmosphere::consumeZeroRecomputeHint() {
+    derive();
     bool pending = zero_recompute_hint_;
     zero_recompute_hint_ = false;
     return pending;
 }
 
+void Atmosphere::setDeadbands(float pressure_pa, float temperature_c, float humidity) {
+    auto sanitize = [](float v) { return (std::isfinite(v) && v > 0.0f) ? v : 0.0f; };
+    pressure_deadband_pa_ = sanitize(pressure_pa);
+    temperature_deadband_c_ = sanitize(temperature_c);
+    humidity_deadband_ = sanitize(humidity);
+}
+
 void Atmosphere::updateFromBaro(float pressure_pa, float temperature_c, float humidity) {
     had_invalid_input_ = false;
 
-    has_baro_pressure_ = true;
-    has_baro_temperature_ = true;
-
     // Apply calibration offset
     float corrected_pressure = pressure_pa + baro_offset_pa_;
     if (!std::isfinite(corrected_pressure)) {
@@ -73,7 +81,6 @@ void Atmosphere::updateFromBaro(float pressure_pa, float temperature_c, float hu
         corrected_pressure = 120000.0f;
         had_invalid_input_ = true;
     }
-    pressure_pa_ = corrected_pressure;
 
     float safe_temp = temperature_c;
     if (!std::isfinite(safe_temp)) {
@@ -88,26 +95,44 @@ void Atmosphere::updateFromBaro(float pressure_pa, float temperature_c, float hu
         safe_temp = 80.0f;
         had_invalid_input_ = true;
     }
-    temperature_c_ = safe_temp;
 
+    bool humidity_sample = false;
+    float safe_humidity = humidity_;
     if (humidity >= 0.0f && humidity <= 1.0f) {
-        has_baro_humidity_ = true;
-        humidity_ = humidity;
+        humidity_sample = true;
+        safe_humidity = humidity;
     } else if (humidity >= 0.0f) {
         had_invalid_input_ = true;
-        has_baro_humidity_ = true;
+        humidity_sample = true;
         if (std::isfinite(humidity)) {
             if (humidity < 0.0f) {
-                humidity_ = 0.0f;
+                safe_humidity = 0.0f;
             } else if (humidity > 1.0f) {
-                humidity_ = 1.0f;
+                safe_humidity = 1.0f;
             }
         } else {
-            humidity_ = BCE_DEFAULT_HUMIDITY;
+            safe_humidity = BCE_DEFAULT_HUMIDITY;
         }
     }
 
-    recompute();
+    // Within every deadband of the accepted reading (and no source switch
+    // from defaults to sensor): noise, nothing to recompute
+    const bool first = !has_baro_pressure_ || !has_baro_temperature_ ||
+                       (humidity_sample && !has_baro_humidity_);
+    if (!first &&
+        std::fabs(corrected_pressure - pressure_pa_) <= pressure_deadband_pa_ &&
+        std::fabs(safe_temp - temperature_c_) <= temperature_deadband_c_ &&
+        std::fabs(safe_humidity - humidity_) <= humidity_deadband_) {
+        return;
+    }
+
+    has_baro_pressure_ = true;
+    has_baro_temperature_ = true;
+    if (humidity_sample) has_baro_humidity_ = true;
+    pressure_pa_ = corrected_pressure;
+    temperature_c_ = safe_temp;
+    humidity_ = safe_humidity;
+    markChanged();
 }
 
 void Atmosphere::applyDefaults(const BCE_DefaultOverrides& ovr) {
@@ -134,21 +159,17 @@ void Atmosphere::applyDefaults(const BCE_DefaultOverrides& ovr) {
             humidity_ = ovr.humidity_fraction;
         }
     }
-    recompute();
+    markChanged();
 }
 
 void Atmosphere::calibrateBaro() {
     // Store offset so current pressure reads as standard sea-level
     // This is a simplistic field calibration
     baro_offset_pa_ = BCE_STD_PRESSURE_PA - (pressure_pa_ - baro_offset_pa_);
-    recompute();
+    markChanged();
 }
 
-void Atmosphere::recompute() {
-    float prev_density = air_density_;
-    float prev_sos = speed_of_sound_;
-    float prev_bc_factor = last_bc_factor_;
-
+void Atmosphere::markChanged() {
     // Update diagnostic flags
     diag_flags_ = 0;
     if (!has_baro_pressure_ && !has_override_pressure_) {
@@ -164,6 +185,21 @@ void Atmosphere::recompute() {
         diag_flags_ |= BCE_Diag::DEFAULT_ALTITUDE;
     }
 
+    // Inputs the derivation will have to clamp (overrides are not sanitized
+    // on entry)
+    state_invalid_ = !std::isfinite(pressure_pa_) || pressure_pa_ < 1000.0f ||
+                     !std::isfinite(humidity_) || humidity_ < 0.0f || humidity_ > 1.0f;
+
+    generation_++;
+    dirty_ = true;
+}
+
+void Atmosphere::recomputeDerived() const {
+    dirty_ = false;
+    float prev_density = air_density_;
+    float prev_sos = speed_of_sound_;
+    float prev_bc_factor = bc_factor_;
+
     // Temperature in Kelvin
     float T_kelvin = temperature_c_ + BCE_KELVIN_OFFSET;
     if (T_kelvin < 1.0f) T_kelvin = 1.0f; // safety
@@ -171,52 +207,50 @@ void Atmosphere::recompute() {
     float pressure_pa = pressure_pa_;
     if (!std::isfinite(pressure_pa) || pressure_pa < 1000.0f) {
         pressure_pa = 1000.0f;
-        had_invalid_input_ = true;
     }
 
     float humidity = humidity_;
-    if (!std::isfinite(humidity)) {
-        humidity = BCE_DEFAULT_HUMIDITY;
-        had_invalid_input_ = true;
-    }
-    if (humidity < 0.0f) {
-        humidity = 0.0f;
-        had_invalid_input_ = true;
-    }
-    if (humidity > 1.0f) {
-        humidity = 1.0f;
-        had_invalid_input_ = true;
-    }
+    if (!std::isfinite(humidity)) humidity = BCE_DEFAULT_HUMIDITY;
+    if (humidity < 0.0f) humidity = 0.0f;
+    if (humidity > 1.0f) humidity = 1.0f;
 
     // Virtual temperature accounting for humidity
     // Vapor pressure (Buck equation approximation)
-    float e_sat = 611.21f * std::exp((18.678f - temperature_c_ / 234.5f) *
-                                      (temperature_c_ / (257.14f + temperature_c_)));
+    float e_sat = 611.21f * bceExp((18.678f - temperature_c_ / 234.5f) *
+                                  (temperature_c_ / (257.14f + temperature_c_)));
     float e_vapor = humidity * e_sat;
 
     // Virtual temperature: Tv = T * (1 + 0.378 * e / P)
     float T_virtual = T_kelvin * (1.0f + 0.378f * e_vapor / pressure_pa);
     if (!std::isfinite(T_virtual) || T_virtual < 1.0f) {
         T_virtual = 1.0f;
-        had_invalid_input_ = true;
     }
 
     // Air density via ideal gas law with virtual temperature
     air_density_ = pressure_pa / (BCE_R_DRY_AIR * T_virtual);
 
     // Speed of sound (approximation for moist air)
-    speed_of_sound_ = 20.05f * std::sqrt(T_virtual);
+    speed_of_sound_ = 20.05f * bceSqrt(T_virtual);
 
-    float current_bc_factor = correctBC(1.0f);
-    if (std::fabs(current_bc_factor - prev_bc_factor) >= BCE_ZERO_RECOMPUTE_BC_FACTOR_DELTA ||
+    bc_factor_ = computeBCFactor();
+    if (std::fabs(bc_factor_ - prev_bc_factor) >= BCE_ZERO_RECOMPUTE_BC_FACTOR_DELTA ||
         std::fabs(air_density_ - prev_density) >= BCE_ZERO_RECOMPUTE_DENSITY_DELTA ||
         std::fabs(speed_of_sound_ - prev_sos) >= BCE_ZERO_RECOMPUTE_SOS_DELTA) {
         zero_recompute_hint_ = true;
     }
-    last_bc_factor_ = current_bc_factor;
 }
 
 float Atmosphere::correctBC(float bc_standard) const {
+    derive();
+    float bc_corrected = bc_standard * bc_factor_;
+
+    // Never let BC go below a minimum reasonable value
+    if (bc_corrected < 0.01f) bc_corrected = 0.01f;
+
+    return bc_corrected;
+}
+
+float Atmosphere::computeBCFactor() const {
     // Convert to imperial for reference formula compatibility
     float alt_ft   = altitude_m_ * M_TO_FT;
     float press_inhg = pressure_pa_ * PA_TO_INHG;
@@ -247,10 +281,5 @@ float Atmosphere::correctBC(float bc_standard) const {
     float FR = 1.0f + 0.00002f * (humidity_pct - 50.0f);
 
     // Combined correction: BC_corrected = BC × FA × (1 + FT - FP) × FR
-    float bc_corrected = bc_standard * FA * (1.0f + FT - FP) * FR;
-
-    // Never let BC go below a minimum reasonable value
-    if (bc_corrected < 0.01f) bc_corrected = 0.01f;
-
-    return bc_corrected;
+    return FA * (1.0f + FT - FP) * FR;
 }
@@ -8,6 +8,11 @@
  * pressure, humidity) using reference Army Metro / Litz formulas.
  * Imperial conversions are performed internally for compatibility with
  * the reference drag model.
+ *
+ * Inputs are accepted lazily: a baro reading within the deadbands of the
+ * last accepted one (sensor noise) changes nothing. An accepted change
+ * bumps getGeneration() and marks the derived quantities (density, speed
+ * of sound, BC factor) stale; they are recomputed on first access.
  */
 
 #pragma once
@@ -37,15 +42,28 @@ public:
      */
     void calibrateBaro();
 
+    /**
+     * Set the baro deadbands: readings that move pressure, temperature and
+     * humidity by no more than these from the last accepted reading are
+     * ignored. 0 accepts every change. Defaults: BCE_ATMO_*_DEADBAND.
+     */
+    void setDeadbands(float pressure_pa, float temperature_c, float humidity);
+
+    /**
+     * Counter bumped whenever the accepted inputs change; equal generations
+     * guarantee identical derived quantities.
+     */
+    uint32_t getGeneration() const { return generation_; }
+
     /**
      * Get current air density (kg/m³).
      */
-    float getAirDensity() const { return air_density_; }
+    float getAirDensity() const { derive(); return air_density_; }
 
     /**
      * Get current speed of sound (m/s).
      */
-    float getSpeedOfSound() const { return speed_of_sound_; }
+    float getSpeedOfSound() const { derive(); return speed_of_sound_; }
 
     /**
      * Get pressure (Pa).
@@ -85,7 +103,7 @@ public:
      * True if the most recent baro update contained non-physical inputs
      * that were sanitized.
      */
-    bool hadInvalidInput() const { return had_invalid_input_; }
+    bool hadInvalidInput() const { return had_invalid_input_ || state_invalid_; }
 
     /**
      * True if atmosphere changed enough to justify zero-angle recomputation.
@@ -99,11 +117,13 @@ private:
     float humidity_        = BCE_DEFAULT_HUMIDITY;
     float altitude_m_      = BCE_DEFAULT_ALTITUDE_M;
 
-    float air_density_     = BCE_STD_AIR_DENSITY;
-    float speed_of_sound_  = BCE_SPEED_OF_SOUND_15C;
-
     float baro_offset_pa_  = 0.0f;  // calibration offset
 
+    float pressure_deadband_pa_   = BCE_ATMO_PRESSURE_DEADBAND_PA;
+    float temperature_deadband_c_ = BCE_ATMO_TEMPERATURE_DEADBAND_C;
+    float humidity_deadband_      = BCE_ATMO_HUMIDITY_DEADBAND;
+    uint32_t generation_ = 0;
+
     bool  has_baro_pressure_   = false;
     bool  has_baro_temperature_ = false;
     bool  has_baro_humidity_   = false;
@@ -111,12 +131,25 @@ private:
     bool  has_override_pressure_ = false;
     bool  has_override_temp_     = false;
     bool  has_override_humidity_ = false;
-    bool  had_invalid_input_     = false;
-    bool  zero_recompute_hint_   = false;
-
-    float last_bc_factor_        = 1.0f;
+    bool  had_invalid_input_     = false;  // last baro sample was sanitized
+    bool  state_invalid_         = false;  // accepted state needed sanitizing
 
     uint32_t diag_flags_ = 0;
 
-    void recompute();
+    // Derived from the accepted inputs on first access after a change
+    mutable bool  dirty_               = true;
+    mutable float air_density_         = BCE_STD_AIR_DENSITY;
+    mutable float speed_of_sound_      = BCE_SPEED_OF_SOUND_15C;
+    mutable float bc_factor_           = 1.0f;
+    mutable bool  zero_recompute_hint_ = false;
+
+    /** Accept the current inputs: refresh flags, bump the generation, mark derived stale. */
+    void markChanged();
+
+    void derive() const {
+        if (dirty_) recomputeDerived();
+    }
+    void recomputeDerived() const;
+    /** FA × (1 + FT − FP) × FR for the current inputs. */
+    float computeBCFactor() const;
 };
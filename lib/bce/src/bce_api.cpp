@@ -1,110 +1,578 @@
 /**
  * @file bce_api.cpp
- * @brief C-linkage API implementation — wraps the BCE_Engine singleton.
+ * @brief C-linkage API implementation — wraps BCE_Engine instances.
  *
- * All functions operate on a single static BCE_Engine instance.
+ * Each handle is a BCE_Engine constructed in caller-provided storage. The
+ * legacy unqualified functions operate on a single static default instance.
  * Zero heap allocation after init.
  */
 
 #include "bce/bce_api.h"
 #include "engine/bce_engine.h"
+#include "drag/drag_model.h"
 
-// Single static engine instance — no heap
-static BCE_Engine s_engine;
+#include <cstdint>
+#include <new>
+
+struct BCE_Instance {
+    BCE_Engine engine;
+};
+
+// Default instance behind the legacy API — no heap
+static BCE_Instance s_default;
 
 extern "C" {
 
+// ---------------------------------------------------------------------------
+// Instances
+// ---------------------------------------------------------------------------
+
+size_t BCE_InstanceSize(void) {
+    return sizeof(BCE_Instance);
+}
+
+size_t BCE_InstanceAlign(void) {
+    return alignof(BCE_Instance);
+}
+
+BCE_Handle BCE_Create(void* storage, size_t size) {
+    if (!storage || size < sizeof(BCE_Instance)) return nullptr;
+    if (reinterpret_cast<uintptr_t>(storage) % alignof(BCE_Instance) != 0) return nullptr;
+
+    BCE_Instance* h = new (storage) BCE_Instance();
+    h->engine.init();
+    return h;
+}
+
+void BCE_Destroy(BCE_Handle h) {
+    if (!h || h == &s_default) return;
+    h->~BCE_Instance();
+}
+
+BCE_Handle BCE_GetDefaultHandle(void) {
+    return &s_default;
+}
+
+void BCE_GetMemoryReport(BCE_MemoryReport* out) {
+    BCE_Engine::getMemoryReport(out);
+}
+
+// ---------------------------------------------------------------------------
+// Handle-based API
+// ---------------------------------------------------------------------------
+
+void BCE_InitH(BCE_Handle h) {
+    if (!h) return;
+    h->engine.init();
+}
+
+void BCE_UpdateH(BCE_Handle h, const SensorFrame* frame) {
+    if (!h) return;
+    h->engine.update(frame);
+}
+
+void BCE_UpdateIMUBurstH(BCE_Handle h, const ImuSample* samples, int count) {
+    if (!h) return;
+    h->engine.updateIMUBurst(samples, count);
+}
+
+void BCE_UpdateIMUH(BCE_Handle h, const ImuSample* sample, const float mag[3]) {
+    if (!h) return;
+    h->engine.updateIMU(sample, mag);
+}
+
+void BCE_UpdateBaroH(BCE_Handle h, uint64_t timestamp_us, float pressure_pa, float temperature_c,
+                     float humidity) {
+    if (!h) return;
+    h->engine.updateBaro(timestamp_us, pressure_pa, temperature_c, humidity);
+}
+
+void BCE_UpdateLRFH(BCE_Handle h, uint64_t timestamp_us, float range_m, float confidence) {
+    if (!h) return;
+    h->engine.updateLRF(timestamp_us, range_m, confidence);
+}
+
+void BCE_SetSplitPipelineModeH(BCE_Handle h, bool enabled) {
+    if (!h) return;
+    h->engine.setSplitPipeline(enabled);
+}
+
+bool BCE_ServiceSolverH(BCE_Handle h) {
+    if (!h) return false;
+    return h->engine.serviceSolver();
+}
+
+bool BCE_StepSolveH(BCE_Handle h, uint32_t budget_us) {
+    if (!h) return false;
+    return h->engine.stepSolve(budget_us);
+}
+
+void BCE_SetBulletProfileH(BCE_Handle h, const BulletProfile* profile) {
+    if (!h) return;
+    h->engine.setBulletProfile(profile);
+}
+
+void BCE_SetZeroConfigH(BCE_Handle h, const ZeroConfig* config) {
+    if (!h) return;
+    h->engine.setZeroConfig(config);
+}
+
+void BCE_SetWindManualH(BCE_Handle h, float speed_ms, float heading_deg) {
+    if (!h) return;
+    h->engine.setWindManual(speed_ms, heading_deg);
+}
+
+void BCE_SetTargetMotionH(BCE_Handle h, float speed_ms, float heading_deg) {
+    if (!h) return;
+    h->engine.setTargetMotion(speed_ms, heading_deg);
+}
+
+void BCE_SetLatitudeH(BCE_Handle h, float latitude_deg) {
+    if (!h) return;
+    h->engine.setLatitude(latitude_deg);
+}
+
+void BCE_SetDefaultOverridesH(BCE_Handle h, const BCE_DefaultOverrides* defaults) {
+    if (!h) return;
+    h->engine.setDefaultOverrides(defaults);
+}
+
+void BCE_SetIMUBiasH(BCE_Handle h, const float accel_bias[3], const float gyro_bias[3]) {
+    if (!h) return;
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    h->engine.setIMUBias(accel_bias ? accel_bias : zero,
+                         gyro_bias ? gyro_bias : zero);
+}
+
+void BCE_SetMagCalibrationH(BCE_Handle h, const float hard_iron[3], const float soft_iron[9]) {
+    if (!h) return;
+    const float zero_hi[3] = {0.0f, 0.0f, 0.0f};
+    const float identity_si[9] = {1.0f, 0.0f, 0.0f,
+                                  0.0f, 1.0f, 0.0f,
+                                  0.0f, 0.0f, 1.0f};
+    h->engine.setMagCalibration(hard_iron ? hard_iron : zero_hi,
+                                soft_iron ? soft_iron : identity_si);
+}
+
+void BCE_StartMagCalibrationH(BCE_Handle h) {
+    if (!h) return;
+    h->engine.startMagCalibration();
+}
+
+void BCE_CancelMagCalibrationH(BCE_Handle h) {
+    if (!h) return;
+    h->engine.cancelMagCalibration();
+}
+
+void BCE_GetMagCalibrationStatusH(BCE_Handle h, BCE_MagCalStatus* out) {
+    if (!h) return;
+    h->engine.getMagCalibrationStatus(out);
+}
+
+bool BCE_CommitMagCalibrationH(BCE_Handle h) {
+    if (!h) return false;
+    return h->engine.commitMagCalibration();
+}
+
+void BCE_CalibrateGyroH(BCE_Handle h) {
+    if (!h) return;
+    h->engine.calibrateGyro();
+}
+
+void BCE_SetBoresightOffsetH(BCE_Handle h, const BoresightOffset* offset) {
+    if (!h || !offset) return;
+    h->engine.setBoresightOffset(offset->vertical_moa, offset->horizontal_moa);
+}
+
+void BCE_SetReticleMechanicalOffsetH(BCE_Handle h, float vertical_moa, float horizontal_moa) {
+    if (!h) return;
+    h->engine.setReticleOffset(vertical_moa, horizontal_moa);
+}
+
+void BCE_CalibrateBaroH(BCE_Handle h) {
+    if (!h) return;
+    h->engine.calibrateBaro();
+}
+
+void BCE_SetAHRSAlgorithmH(BCE_Handle h, AHRS_Algorithm algo) {
+    if (!h) return;
+    h->engine.setAHRSAlgorithm(algo);
+}
+
+void BCE_SetMagDeclinationH(BCE_Handle h, float declination_deg) {
+    if (!h) return;
+    h->engine.setMagDeclination(declination_deg);
+}
+
+void BCE_SetExternalReferenceModeH(BCE_Handle h, bool enabled) {
+    if (!h) return;
+    h->engine.setExternalReferenceMode(enabled);
+}
+
+void BCE_SetIntegratorH(BCE_Handle h, IntegratorMethod method, float tolerance_m) {
+    if (!h) return;
+    h->engine.setIntegrator(method, tolerance_m);
+}
+
+void BCE_SetIntegratorTuningH(BCE_Handle h, const IntegratorTuning* tuning) {
+    if (!h) return;
+    h->engine.setIntegratorTuning(tuning);
+}
+
+void BCE_SetTrajectoryHorizonH(BCE_Handle h, float horizon_m) {
+    if (!h) return;
+    h->engine.setTrajectoryHorizon(horizon_m);
+}
+
+void BCE_SetMaxRangeH(BCE_Handle h, float max_range_m) {
+    if (!h) return;
+    h->engine.setMaxRange(max_range_m);
+}
+
+void BCE_SetAngleCacheModeH(BCE_Handle h, bool enabled) {
+    if (!h) return;
+    h->engine.setAngleCache(enabled);
+}
+
+size_t BCE_SaveStateH(BCE_Handle h, void* buf, size_t size, bool include_trajectory) {
+    if (!h) return 0;
+    return h->engine.saveState(buf, size, include_trajectory);
+}
+
+bool BCE_RestoreStateH(BCE_Handle h, const void* buf, size_t size) {
+    if (!h) return false;
+    return h->engine.restoreState(buf, size);
+}
+
+bool BCE_SetProfileDbH(BCE_Handle h, const void* data, size_t size) {
+    if (!h) return false;
+    return h->engine.setProfileDb(data, size);
+}
+
+bool BCE_SelectProfileH(BCE_Handle h, const char* cartridge, const char* gun) {
+    if (!h) return false;
+    return h->engine.selectProfile(cartridge, gun);
+}
+
+uint32_t BCE_GetSolutionH(BCE_Handle h, FiringSolution* out) {
+    if (!h) return 0;
+    return h->engine.getSolution(out);
+}
+
+uint32_t BCE_GetSolutionGenerationH(BCE_Handle h) {
+    if (!h) return 0;
+    return h->engine.getSolutionGeneration();
+}
+
+void BCE_SetSolutionCallbackH(BCE_Handle h, BCE_SolutionCallback fn, void* user, float epsilon_moa) {
+    if (!h) return;
+    h->engine.setSolutionCallback(fn, user, epsilon_moa);
+}
+
+bool BCE_GetTrajectoryViewH(BCE_Handle h, const TrajectoryPoint** points, int* count,
+                            uint32_t* generation) {
+    if (!h) return false;
+    return h->engine.getTrajectoryView(points, count, generation);
+}
+
+int BCE_ComputeHoldTableH(BCE_Handle h, const float* ranges, int n, FiringSolution* out) {
+    if (!h) return 0;
+    return h->engine.computeHoldTable(ranges, n, out);
+}
+
+BCE_Mode BCE_GetModeH(BCE_Handle h) {
+    if (!h) return BCE_Mode::IDLE;
+    return h->engine.getMode();
+}
+
+uint32_t BCE_GetFaultFlagsH(BCE_Handle h) {
+    if (!h) return 0;
+    return h->engine.getFaultFlags();
+}
+
+uint32_t BCE_GetDiagFlagsH(BCE_Handle h) {
+    if (!h) return 0;
+    return h->engine.getDiagFlags();
+}
+
+void BCE_GetSolverDiagnosticsH(BCE_Handle h, BCE_SolverDiagnostics* out) {
+    if (!h) return;
+    h->engine.getSolverDiagnostics(out);
+}
+
+void BCE_GetPerfStatsH(BCE_Handle h, BCE_PerfStats* out) {
+    if (!h) return;
+    h->engine.getPerfStats(out);
+}
+
+void BCE_SetUncertaintyH(BCE_Handle h, const BCE_UncertaintyConfig* config) {
+    if (!h) return;
+    h->engine.setUncertainty(config);
+}
+
+uint32_t BCE_RunDispersionH(BCE_Handle h, int samples) {
+    if (!h) return 0;
+    return h->engine.runDispersion(samples);
+}
+
+void BCE_GetDispersionH(BCE_Handle h, BCE_DispersionStats* out) {
+    if (!h) return;
+    h->engine.getDispersion(out);
+}
+
+bool BCE_GetSensitivityH(BCE_Handle h, BCE_Sensitivity* out) {
+    if (!h) return false;
+    return h->engine.getSensitivity(out);
+}
+
+void BCE_SetRecorderModeH(BCE_Handle h, bool enabled) {
+    if (!h) return;
+    h->engine.setRecorder(enabled);
+}
+
+size_t BCE_ReadRecorderH(BCE_Handle h, uint8_t* buf, size_t size) {
+    if (!h) return 0;
+    return h->engine.readRecorder(buf, size);
+}
+
+uint32_t BCE_GetRecorderDroppedH(BCE_Handle h) {
+    if (!h) return 0;
+    return h->engine.getRecorderDropped();
+}
+
+// ---------------------------------------------------------------------------
+// Legacy API — default instance
+// ---------------------------------------------------------------------------
+
 void BCE_Init(void) {
-    s_engine.init();
+    BCE_InitH(&s_default);
 }
 
 void BCE_Update(const SensorFrame* frame) {
-    s_engine.update(frame);
+    BCE_UpdateH(&s_default, frame);
+}
+
+void BCE_UpdateIMUBurst(const ImuSample* samples, int count) {
+    BCE_UpdateIMUBurstH(&s_default, samples, count);
+}
+
+void BCE_UpdateIMU(const ImuSample* sample, const float mag[3]) {
+    BCE_UpdateIMUH(&s_default, sample, mag);
+}
+
+void BCE_UpdateBaro(uint64_t timestamp_us, float pressure_pa, float temperature_c, float humidity) {
+    BCE_UpdateBaroH(&s_default, timestamp_us, pressure_pa, temperature_c, humidity);
+}
+
+void BCE_UpdateLRF(uint64_t timestamp_us, float range_m, float confidence) {
+    BCE_UpdateLRFH(&s_default, timestamp_us, range_m, confidence);
+}
+
+void BCE_SetSplitPipelineMode(bool enabled) {
+    BCE_SetSplitPipelineModeH(&s_default, enabled);
+}
+
+bool BCE_ServiceSolver(void) {
+    return BCE_ServiceSolverH(&s_default);
+}
+
+bool BCE_StepSolve(uint32_t budget_us) {
+    return BCE_StepSolveH(&s_default, budget_us);
 }
 
 void BCE_SetBulletProfile(const BulletProfile* profile) {
-    s_engine.setBulletProfile(profile);
+    BCE_SetBulletProfileH(&s_default, profile);
 }
 
 void BCE_SetZeroConfig(const ZeroConfig* config) {
-    s_engine.setZeroConfig(config);
+    BCE_SetZeroConfigH(&s_default, config);
+}
+
+bool BCE_SetCustomDragCurve(const DragPoint* points, int n) {
+    // The curve is process-wide and read without locking by every solve
+    if (BCE_Engine::anySplitPipeline()) return false;
+    return DragModelLookup::setCustomCurve(points, n);
 }
 
 void BCE_SetWindManual(float speed_ms, float heading_deg) {
-    s_engine.setWindManual(speed_ms, heading_deg);
+    BCE_SetWindManualH(&s_default, speed_ms, heading_deg);
+}
+
+void BCE_SetTargetMotion(float speed_ms, float heading_deg) {
+    BCE_SetTargetMotionH(&s_default, speed_ms, heading_deg);
 }
 
 void BCE_SetLatitude(float latitude_deg) {
-    s_engine.setLatitude(latitude_deg);
+    BCE_SetLatitudeH(&s_default, latitude_deg);
 }
 
 void BCE_SetDefaultOverrides(const BCE_DefaultOverrides* defaults) {
-    s_engine.setDefaultOverrides(defaults);
+    BCE_SetDefaultOverridesH(&s_default, defaults);
 }
 
 void BCE_SetIMUBias(const float accel_bias[3], const float gyro_bias[3]) {
-    const float zero[3] = {0.0f, 0.0f, 0.0f};
-    s_engine.setIMUBias(accel_bias ? accel_bias : zero,
-                        gyro_bias ? gyro_bias : zero);
+    BCE_SetIMUBiasH(&s_default, accel_bias, gyro_bias);
 }
 
 void BCE_SetMagCalibration(const float hard_iron[3], const float soft_iron[9]) {
-    const float zero_hi[3] = {0.0f, 0.0f, 0.0f};
-    const float identity_si[9] = {1.0f, 0.0f, 0.0f,
-                                  0.0f, 1.0f, 0.0f,
-                                  0.0f, 0.0f, 1.0f};
-    s_engine.setMagCalibration(hard_iron ? hard_iron : zero_hi,
-                               soft_iron ? soft_iron : identity_si);
+    BCE_SetMagCalibrationH(&s_default, hard_iron, soft_iron);
+}
+
+void BCE_StartMagCalibration(void) {
+    BCE_StartMagCalibrationH(&s_default);
+}
+
+void BCE_CancelMagCalibration(void) {
+    BCE_CancelMagCalibrationH(&s_default);
+}
+
+void BCE_GetMagCalibrationStatus(BCE_MagCalStatus* out) {
+    BCE_GetMagCalibrationStatusH(&s_default, out);
+}
+
+bool BCE_CommitMagCalibration(void) {
+    return BCE_CommitMagCalibrationH(&s_default);
 }
 
 void DOPE_CalibrateGyro(void) {
-    s_engine.calibrateGyro();
+    BCE_CalibrateGyroH(&s_default);
 }
 
 void BCE_SetBoresightOffset(const BoresightOffset* offset) {
-    if (!offset) return;
-    s_engine.setBoresightOffset(offset->vertical_moa, offset->horizontal_moa);
+    BCE_SetBoresightOffsetH(&s_default, offset);
 }
 
 void BCE_SetReticleMechanicalOffset(float vertical_moa, float horizontal_moa) {
-    s_engine.setReticleOffset(vertical_moa, horizontal_moa);
+    BCE_SetReticleMechanicalOffsetH(&s_default, vertical_moa, horizontal_moa);
 }
 
 void BCE_CalibrateBaro(void) {
-    s_engine.calibrateBaro();
+    BCE_CalibrateBaroH(&s_default);
 }
 
 void BCE_CalibrateGyro(void) {
     // Compatibility alias for legacy integrations.
-    s_engine.calibrateGyro();
+    BCE_CalibrateGyroH(&s_default);
 }
 
 void BCE_SetAHRSAlgorithm(AHRS_Algorithm algo) {
-    s_engine.setAHRSAlgorithm(algo);
+    BCE_SetAHRSAlgorithmH(&s_default, algo);
 }
 
 void BCE_SetMagDeclination(float declination_deg) {
-    s_engine.setMagDeclination(declination_deg);
+    BCE_SetMagDeclinationH(&s_default, declination_deg);
 }
 
 void BCE_SetExternalReferenceMode(bool enabled) {
-    s_engine.setExternalReferenceMode(enabled);
+    BCE_SetExternalReferenceModeH(&s_default, enabled);
+}
+
+void BCE_SetIntegrator(IntegratorMethod method, float tolerance_m) {
+    BCE_SetIntegratorH(&s_default, method, tolerance_m);
+}
+
+void BCE_SetIntegratorTuning(const IntegratorTuning* tuning) {
+    BCE_SetIntegratorTuningH(&s_default, tuning);
+}
+
+void BCE_SetTrajectoryHorizon(float horizon_m) {
+    BCE_SetTrajectoryHorizonH(&s_default, horizon_m);
+}
+
+void BCE_SetMaxRange(float max_range_m) {
+    BCE_SetMaxRangeH(&s_default, max_range_m);
+}
+
+void BCE_SetAngleCacheMode(bool enabled) {
+    BCE_SetAngleCacheModeH(&s_default, enabled);
+}
+
+size_t BCE_GetStateSize(bool include_trajectory) {
+    return BCE_Engine::getStateSize(include_trajectory);
+}
+
+size_t BCE_SaveState(void* buf, size_t size, bool include_trajectory) {
+    return BCE_SaveStateH(&s_default, buf, size, include_trajectory);
+}
+
+bool BCE_RestoreState(const void* buf, size_t size) {
+    return BCE_RestoreStateH(&s_default, buf, size);
+}
+
+bool BCE_SetProfileDb(const void* data, size_t size) {
+    return BCE_SetProfileDbH(&s_default, data, size);
+}
+
+bool BCE_SelectProfile(const char* cartridge, const char* gun) {
+    return BCE_SelectProfileH(&s_default, cartridge, gun);
 }
 
-void BCE_GetSolution(FiringSolution* out) {
-    s_engine.getSolution(out);
+uint32_t BCE_GetSolution(FiringSolution* out) {
+    return BCE_GetSolutionH(&s_default, out);
+}
+
+uint32_t BCE_GetSolutionGeneration(void) {
+    return BCE_GetSolutionGenerationH(&s_default);
+}
+
+void BCE_SetSolutionCallback(BCE_SolutionCallback fn, void* user, float epsilon_moa) {
+    BCE_SetSolutionCallbackH(&s_default, fn, user, epsilon_moa);
+}
+
+bool BCE_GetTrajectoryView(const TrajectoryPoint** points, int* count, uint32_t* generation) {
+    return BCE_GetTrajectoryViewH(&s_default, points, count, generation);
+}
+
+int BCE_ComputeHoldTable(const float* ranges, int n, FiringSolution* out) {
+    return BCE_ComputeHoldTableH(&s_default, ranges, n, out);
 }
 
 BCE_Mode BCE_GetMode(void) {
-    return s_engine.getMode();
+    return BCE_GetModeH(&s_default);
 }
 
 uint32_t BCE_GetFaultFlags(void) {
-    return s_engine.getFaultFlags();
+    return BCE_GetFaultFlagsH(&s_default);
 }
 
 uint32_t BCE_GetDiagFlags(void) {
-    return s_engine.getDiagFlags();
+    return BCE_GetDiagFlagsH(&s_default);
+}
+
+void BCE_GetSolverDiagnostics(BCE_SolverDiagnostics* out) {
+    BCE_GetSolverDiagnosticsH(&s_default, out);
+}
+
+void BCE_GetPerfStats(BCE_PerfStats* out) {
+    BCE_GetPerfStatsH(&s_default, out);
+}
+
+void BCE_SetUncertainty(const BCE_UncertaintyConfig* config) {
+    BCE_SetUncertaintyH(&s_default, config);
+}
+
+uint32_t BCE_RunDispersion(int samples) {
+    return BCE_RunDispersionH(&s_default, samples);
+}
+
+void BCE_GetDispersion(BCE_DispersionStats* out) {
+    BCE_GetDispersionH(&s_default, out);
+}
+
+bool BCE_GetSensitivity(BCE_Sensitivity* out) {
+    return BCE_GetSensitivityH(&s_default, out);
+}
+
+void BCE_SetRecorderMode(bool enabled) {
+    BCE_SetRecorderModeH(&s_default, enabled);
+}
+
+size_t BCE_ReadRecorder(uint8_t* buf, size_t size) {
+    return BCE_ReadRecorderH(&s_default, buf, size);
+}
+
+uint32_t BCE_GetRecorderDropped(void) {
+    return BCE_GetRecorderDroppedH(&s_default);
 }
 
 } // extern "C"
@@ -0,0 +1,91 @@
+/**
+ * @file dispersion.cpp
+ * @brief Monte Carlo sampler and streaming statistics implementation.
+ */
+
+#include "dispersion.h"
+#include "bce/bce_config.h"
+#include <cmath>
+#include <cstring>
+
+void DispersionSampler::seed(uint32_t seed) {
+    state_ = (seed != 0) ? seed : BCE_DISPERSION_DEFAULT_SEED;
+    has_spare_ = false;
+}
+
+float DispersionSampler::uniform() {
+    // xorshift32 — never yields 0 from a non-zero state
+    uint32_t x = state_;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state_ = x;
+    return static_cast<float>((x >> 8) + 1u) * (1.0f / 16777216.0f);
+}
+
+float DispersionSampler::gaussian() {
+    if (has_spare_) {
+        has_spare_ = false;
+        return spare_;
+    }
+    float r = std::sqrt(-2.0f * std::log(uniform()));
+    float theta = 2.0f * BCE_PI * uniform();
+    spare_ = r * std::sin(theta);
+    has_spare_ = true;
+    return r * std::cos(theta);
+}
+
+void DispersionAccumulator::reset() {
+    count_ = 0;
+    hits_ = 0;
+    mean_elev_ = 0.0f;
+    mean_wind_ = 0.0f;
+    m2_elev_ = 0.0f;
+    m2_wind_ = 0.0f;
+    c_ew_ = 0.0f;
+}
+
+void DispersionAccumulator::add(float elevation_moa, float windage_moa, bool hit) {
+    count_++;
+    if (hit) hits_++;
+
+    const float n = static_cast<float>(count_);
+    float de = elevation_moa - mean_elev_;
+    float dw = windage_moa - mean_wind_;
+    mean_elev_ += de / n;
+    mean_wind_ += dw / n;
+    m2_elev_ += de * (elevation_moa - mean_elev_);
+    m2_wind_ += dw * (windage_moa - mean_wind_);
+    c_ew_ += de * (windage_moa - mean_wind_);
+}
+
+void DispersionAccumulator::getStats(BCE_DispersionStats* out) const {
+    if (!out) return;
+    std::memset(out, 0, sizeof(*out));
+
+    out->sample_count = count_;
+    if (count_ == 0) return;
+
+    out->mean_elevation_moa = mean_elev_;
+    out->mean_windage_moa = mean_wind_;
+    out->hit_probability = static_cast<float>(hits_) / static_cast<float>(count_);
+    if (count_ < 2) return;
+
+    // Sample covariance, x = windage, y = elevation
+    const float inv = 1.0f / static_cast<float>(count_ - 1);
+    float var_w = m2_wind_ * inv;
+    float var_e = m2_elev_ * inv;
+    float cov = c_ew_ * inv;
+    out->sigma_elevation_moa = std::sqrt(var_e);
+    out->sigma_windage_moa = std::sqrt(var_w);
+
+    // Eigen-decomposition of the symmetric 2×2 covariance
+    float half_sum = 0.5f * (var_w + var_e);
+    float half_diff = 0.5f * (var_w - var_e);
+    float root = std::sqrt(half_diff * half_diff + cov * cov);
+    float major = half_sum + root;
+    float minor = half_sum - root;
+    out->ellipse_major_moa = std::sqrt(major > 0.0f ? major : 0.0f);
+    out->ellipse_minor_moa = std::sqrt(minor > 0.0f ? minor : 0.0f);
+    out->ellipse_angle_deg = 0.5f * std::atan2(2.0f * cov, var_w - var_e) * BCE_RAD_TO_DEG;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file dispersion.h
+ * @brief Monte Carlo sampling and streaming impact statistics.
+ *
+ * DispersionSampler draws reproducible standard-normal deviates (xorshift32
+ * + Box–Muller). DispersionAccumulator folds impact offsets into running
+ * means and a 2×2 covariance with Welford's update, so statistics refine
+ * sample by sample without storing the samples.
+ */
+
+#pragma once
+
+#include "bce/bce_types.h"
+#include <cstdint>
+
+class DispersionSampler {
+public:
+    /** Restart the sequence. seed 0 selects BCE_DISPERSION_DEFAULT_SEED. */
+    void seed(uint32_t seed);
+
+    /** Uniform deviate in (0, 1]. */
+    float uniform();
+
+    /** Standard normal deviate (mean 0, σ 1). */
+    float gaussian();
+
+private:
+    uint32_t state_ = 1;
+    float spare_ = 0.0f;
+    bool has_spare_ = false;
+};
+
+class DispersionAccumulator {
+public:
+    void reset();
+
+    /**
+     * Add one impact.
+     * @param elevation_moa  Vertical offset from the point of aim (+ = high)
+     * @param windage_moa    Horizontal offset from the point of aim (+ = right)
+     * @param hit            Impact lies inside the hit circle
+     */
+    void add(float elevation_moa, float windage_moa, bool hit);
+
+    uint32_t getCount() const { return count_; }
+
+    /** Fill the statistics; target_radius_moa is left 0 for the caller. */
+    void getStats(BCE_DispersionStats* out) const;
+
+private:
+    uint32_t count_ = 0;
+    uint32_t hits_ = 0;
+    float mean_elev_ = 0.0f;
+    float mean_wind_ = 0.0f;
+    float m2_elev_ = 0.0f;  // Σ (e - mean_e)²
+    float m2_wind_ = 0.0f;  // Σ (w - mean_w)²
+    float c_ew_ = 0.0f;     // Σ (e - mean_e)(w - mean_w)
+};
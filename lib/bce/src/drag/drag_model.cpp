@@ -5,10 +5,49 @@
 
 #include "drag_model.h"
 #include "drag_tables.h"
+#include "drag_tables_uniform.h"
 #include "bce/bce_config.h"
 #include <cmath>
+#include <cstring>
+
+namespace {
+
+// DragModel::CUSTOM: the source points (for the reference path) and their
+// uniform resampling (for the hot path)
+struct CustomCurve {
+    DragPoint points[BCE_CUSTOM_DRAG_MAX_POINTS];
+    int point_count;
+    float cd[BCE_CUSTOM_DRAG_SAMPLES];
+    int size;     // uniform samples in use; 0 = no curve loaded
+    uint32_t id;
+};
+
+CustomCurve s_custom = {};
+
+} // namespace
 
 float DragModelLookup::getCd(DragModel model, float mach) {
+    return lookupCd(getCurve(model), mach);
+}
+
+DragCurve DragModelLookup::getCurve(DragModel model) {
+    switch (model) {
+        case DragModel::G1: return {G1_UNIFORM.cd, G1_UNIFORM_SIZE};
+        case DragModel::G2: return {G2_UNIFORM.cd, G2_UNIFORM_SIZE};
+        case DragModel::G3: return {G3_UNIFORM.cd, G3_UNIFORM_SIZE};
+        case DragModel::G4: return {G4_UNIFORM.cd, G4_UNIFORM_SIZE};
+        case DragModel::G5: return {G5_UNIFORM.cd, G5_UNIFORM_SIZE};
+        case DragModel::G6: return {G6_UNIFORM.cd, G6_UNIFORM_SIZE};
+        case DragModel::G7: return {G7_UNIFORM.cd, G7_UNIFORM_SIZE};
+        case DragModel::G8: return {G8_UNIFORM.cd, G8_UNIFORM_SIZE};
+        case DragModel::CUSTOM:
+            if (s_custom.size > 0) return {s_custom.cd, s_custom.size};
+            return {G1_UNIFORM.cd, G1_UNIFORM_SIZE};
+        default:            return {G1_UNIFORM.cd, G1_UNIFORM_SIZE};
+    }
+}
+
+float DragModelLookup::getCdReference(DragModel model, float mach) {
     if (mach < 0.0f) mach = 0.0f;
 
     switch (model) {
@@ -20,6 +59,9 @@ float DragModelLookup::getCd(DragModel model, float mach) {
         case DragModel::G6: return interpolate(G6_TABLE, G6_TABLE_SIZE, mach);
         case DragModel::G7: return interpolate(G7_TABLE, G7_TABLE_SIZE, mach);
         case DragModel::G8: return interpolate(G8_TABLE, G8_TABLE_SIZE, mach);
+        case DragModel::CUSTOM:
+            if (s_custom.size > 0) return interpolate(s_custom.points, s_custom.point_count, mach);
+            return interpolate(G1_TABLE, G1_TABLE_SIZE, mach);
         default:            return interpolate(G1_TABLE, G1_TABLE_SIZE, mach);
     }
 }
@@ -92,3 +134,107 @@ float DragModelLookup::getDeceleration(float velocity_ms, float speed_of_sound,
 
     return decel;
 }
+
+DragContext DragModelLookup::makeContext(DragModel model, float speed_of_sound,
+                                         float bc_corrected, float air_density,
+                                         float drag_scale) {
+    DragContext ctx;
+    ctx.curve = getCurve(model);
+    ctx.inv_speed_of_sound = (speed_of_sound > 0.0f) ? 1.0f / speed_of_sound : 0.0f;
+
+    // Same formula as getDeceleration(), with the per-trajectory constants
+    // folded into one coefficient
+    if (bc_corrected < 0.001f) {
+        ctx.coefficient = 0.0f;
+    } else {
+        float density_ratio = air_density / BCE_STD_AIR_DENSITY;
+        ctx.coefficient = (density_ratio * drag_scale) /
+                          (bc_corrected * BCE_BALLISTIC_DRAG_CONSTANT);
+    }
+
+    ctx.band = 0;
+    ctx.band_count = 0;
+    ctx.band_floor_ms = 0.0f;
+    ctx.band_ceiling_ms = INFINITY;
+    ctx.band_coefficient[0] = ctx.coefficient;
+    return ctx;
+}
+
+void DragModelLookup::setBands(DragContext& ctx, const float* velocity_ms, const float* ratio,
+                               int count) {
+    // Fold each band's BC into its coefficient; a band whose ratio or
+    // threshold is unusable ends the list
+    const float primary = ctx.band_coefficient[0];
+    int n = 0;
+    if (velocity_ms && ratio) {
+        for (int i = 0; i < count && i < BCE_MAX_BC_BANDS; ++i) {
+            if (!(ratio[i] > 0.0f) || !std::isfinite(ratio[i])) break;
+            if (!(velocity_ms[i] > 0.0f) || !std::isfinite(velocity_ms[i])) break;
+            if (i > 0 && !(velocity_ms[i] < velocity_ms[i - 1])) break;
+            ctx.band_velocity_ms[i] = velocity_ms[i];
+            ctx.band_coefficient[i + 1] = primary / ratio[i];
+            n++;
+        }
+    }
+    ctx.band_count = n;
+    ctx.band = 0;
+    ctx.coefficient = primary;
+    ctx.band_floor_ms = (n > 0) ? ctx.band_velocity_ms[0] : 0.0f;
+    ctx.band_ceiling_ms = INFINITY;
+}
+
+void DragModelLookup::selectBand(DragContext& ctx, float velocity_ms) {
+    int b = ctx.band;
+    while (b < ctx.band_count && velocity_ms < ctx.band_velocity_ms[b]) b++;
+    while (b > 0 && velocity_ms >= ctx.band_velocity_ms[b - 1]) b--;
+    ctx.band = b;
+    ctx.coefficient = ctx.band_coefficient[b];
+    ctx.band_floor_ms = (b < ctx.band_count) ? ctx.band_velocity_ms[b] : 0.0f;
+    ctx.band_ceiling_ms = (b > 0) ? ctx.band_velocity_ms[b - 1] : INFINITY;
+}
+
+bool DragModelLookup::setCustomCurve(const DragPoint* points, int n) {
+    if (!points || n < 2 || n > BCE_CUSTOM_DRAG_MAX_POINTS) return false;
+    for (int i = 0; i < n; ++i) {
+        if (!std::isfinite(points[i].mach) || !std::isfinite(points[i].cd)) return false;
+        if (points[i].mach < 0.0f || points[i].cd < 0.0f) return false;
+        if (i > 0 && !(points[i].mach > points[i - 1].mach)) return false;
+    }
+
+    std::memcpy(s_custom.points, points, static_cast<size_t>(n) * sizeof(DragPoint));
+    s_custom.point_count = n;
+
+    // Same sampling as DragUniform::resample, extended by one sample when the
+    // last point is off the grid and truncated to the static buffer
+    int size = static_cast<int>(points[n - 1].mach / BCE_DRAG_MACH_STEP + 0.5f) + 1;
+    if (static_cast<float>(size - 1) * BCE_DRAG_MACH_STEP < points[n - 1].mach) size++;
+    if (size > BCE_CUSTOM_DRAG_SAMPLES) size = BCE_CUSTOM_DRAG_SAMPLES;
+    if (size < 2) size = 2;
+    for (int i = 0; i < size; ++i) {
+        s_custom.cd[i] = interpolate(points, n, static_cast<float>(i) * BCE_DRAG_MACH_STEP);
+    }
+
+    // FNV-1a over the resampled curve; never 0, which means "no curve"
+    uint32_t id = 2166136261u;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(s_custom.cd);
+    for (size_t i = 0; i < static_cast<size_t>(size) * sizeof(float); ++i) {
+        id = (id ^ bytes[i]) * 16777619u;
+    }
+    s_custom.id = (id != 0) ? id : 1u;
+    s_custom.size = size;
+    return true;
+}
+
+void DragModelLookup::clearCustomCurve() {
+    s_custom.size = 0;
+    s_custom.point_count = 0;
+    s_custom.id = 0;
+}
+
+uint32_t DragModelLookup::getCustomCurveId() {
+    return s_custom.id;
+}
+
+size_t DragModelLookup::getCustomCurveBytes() {
+    return sizeof(s_custom);
+}
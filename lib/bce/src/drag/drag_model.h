@@ -2,24 +2,88 @@
  * @file drag_model.h
  * @brief Drag coefficient lookup from standard G-model tables.
  *
- * Uses piecewise linear interpolation on the (Mach, Cd) table for
- * the selected drag model. Binary search for O(log n) Mach lookup.
+ * The hot path indexes compile-time resampled uniform-Mach tables in O(1).
+ * The original piecewise linear interpolation on the (Mach, Cd) tables
+ * (binary search, O(log n)) remains available as the reference path.
+ *
+ * DragModel::CUSTOM reads a process-wide curve loaded by setCustomCurve(),
+ * resampled at load time onto the same uniform grid, so its lookups cost
+ * the same as the built-in tables. The curve is shared by every engine
+ * instance; load it while no solve is running (BCE_SetCustomDragCurve
+ * refuses while any instance is in split-pipeline mode).
  */
 
 #pragma once
 
+#include "bce/bce_config.h"
 #include "bce/bce_types.h"
+#include <cstddef>
+
+/**
+ * View of a uniform-Mach drag curve: cd[i] is the Cd at Mach i × BCE_DRAG_MACH_STEP.
+ */
+struct DragCurve {
+    const float* cd;
+    int size;
+};
+
+/**
+ * Per-solve drag state. Everything in the retardation formula that is
+ * constant over a trajectory (table selection, 1/SoS, BC, density ratio,
+ * drag scale and the ballistic constant) is resolved once by makeContext().
+ */
+struct DragContext {
+    DragCurve curve;
+    float inv_speed_of_sound;  // 1/SoS (s/m), for Mach = v × inv_speed_of_sound
+    float coefficient;         // decel = coefficient × Cd × v²; 0 disables drag
+
+    // Velocity-banded BC (setBands). Band 0 is the primary BC; coefficient
+    // belongs to the active band, valid while band_floor_ms ≤ v < band_ceiling_ms.
+    int band;
+    int band_count;            // bands below the primary one
+    float band_floor_ms;
+    float band_ceiling_ms;
+    float band_coefficient[BCE_MAX_BC_BANDS + 1];
+    float band_velocity_ms[BCE_MAX_BC_BANDS]; // band i + 1 applies below entry i
+};
 
 class DragModelLookup {
 public:
     /**
      * Look up drag coefficient for a given Mach number and drag model.
-     * @param model  G1–G8 drag model
+     * @param model  G1–G8 or CUSTOM drag model
      * @param mach   Mach number (≥ 0)
      * @return Drag coefficient Cd
      */
     static float getCd(DragModel model, float mach);
 
+    /**
+     * Reference Cd lookup: binary search + linear interpolation on the
+     * source (Mach, Cd) tables. Used to validate the uniform tables.
+     */
+    static float getCdReference(DragModel model, float mach);
+
+    /** Resolve the uniform-Mach curve for a drag model. */
+    static DragCurve getCurve(DragModel model);
+
+    /** O(1) Cd lookup on a uniform-Mach curve (one multiply, truncate, lerp). */
+    static float lookupCd(const DragCurve& curve, float mach) {
+        if (!(mach > 0.0f)) return curve.cd[0];
+        float idx = mach * (1.0f / BCE_DRAG_MACH_STEP);
+        int i = static_cast<int>(idx);
+        if (i >= curve.size - 1) return curve.cd[curve.size - 1];
+        float frac = idx - static_cast<float>(i);
+        return curve.cd[i] + frac * (curve.cd[i + 1] - curve.cd[i]);
+    }
+
+    /** dCd/dMach of lookupCd(): the slope of the segment holding mach. */
+    static float lookupCdSlope(const DragCurve& curve, float mach) {
+        if (!(mach > 0.0f)) return 0.0f;
+        int i = static_cast<int>(mach * (1.0f / BCE_DRAG_MACH_STEP));
+        if (i >= curve.size - 1) return 0.0f;
+        return (curve.cd[i + 1] - curve.cd[i]) * (1.0f / BCE_DRAG_MACH_STEP);
+    }
+
     /**
      * Compute the retardation (deceleration) of the projectile.
      *
@@ -42,6 +106,76 @@ public:
                                   float bc_corrected, DragModel model,
                                   float air_density);
 
-private:
-    static float interpolate(const struct DragPoint* table, int size, float mach);
+    /**
+     * Build the per-solve drag context.
+     * @param drag_scale  Multiplier on the retardation (already validated by caller)
+     */
+    static DragContext makeContext(DragModel model, float speed_of_sound,
+                                   float bc_corrected, float air_density,
+                                   float drag_scale = 1.0f);
+
+    /**
+     * Deceleration from a prepared context. Caller guarantees velocity_ms ≥ 1.
+     */
+    static float getDeceleration(const DragContext& ctx, float velocity_ms) {
+        float cd = lookupCd(ctx.curve, velocity_ms * ctx.inv_speed_of_sound);
+        return ctx.coefficient * cd * velocity_ms * velocity_ms;
+    }
+
+    /**
+     * d(deceleration)/d(velocity) of getDeceleration() within the active
+     * band. Caller guarantees velocity_ms ≥ 1.
+     */
+    static float getDecelerationSlope(const DragContext& ctx, float velocity_ms) {
+        float mach = velocity_ms * ctx.inv_speed_of_sound;
+        float cd = lookupCd(ctx.curve, mach);
+        float cd_slope = lookupCdSlope(ctx.curve, mach) * ctx.inv_speed_of_sound;
+        return ctx.coefficient * velocity_ms * (2.0f * cd + cd_slope * velocity_ms);
+    }
+
+    /**
+     * Add velocity bands to a context: below velocity_ms[i] (strictly
+     * descending) the BC is scaled by ratio[i]. Each band's coefficient is
+     * folded here, once per solve.
+     */
+    static void setBands(DragContext& ctx, const float* velocity_ms, const float* ratio,
+                         int count);
+
+    /**
+     * getDeceleration() for a banded context. The active band only moves
+     * when velocity_ms leaves it, one band at a time, so the common case is
+     * two compares; an unbanded context never leaves band 0.
+     */
+    static float getBandedDeceleration(DragContext& ctx, float velocity_ms) {
+        if (velocity_ms < ctx.band_floor_ms || velocity_ms >= ctx.band_ceiling_ms) {
+            selectBand(ctx, velocity_ms);
+        }
+        return getDeceleration(ctx, velocity_ms);
+    }
+
+    /** Move ctx to the band containing velocity_ms. */
+    static void selectBand(DragContext& ctx, float velocity_ms);
+
+    /** Piecewise linear interpolation on a source (Mach, Cd) table. */
+    static float interpolate(const DragPoint* table, int size, float mach);
+
+    /**
+     * Load the DragModel::CUSTOM curve: 2..BCE_CUSTOM_DRAG_MAX_POINTS
+     * breakpoints with finite, non-negative Mach strictly increasing and
+     * finite, non-negative Cd. The points are copied.
+     * @return false (the previous curve is kept) if the points are invalid
+     */
+    static bool setCustomCurve(const DragPoint* points, int n);
+
+    /** Drop the custom curve; CUSTOM falls back to G1. */
+    static void clearCustomCurve();
+
+    /**
+     * Content hash of the loaded custom curve (0 when none is loaded), for
+     * cache keys: equal curves hash equal across loads and power cycles.
+     */
+    static uint32_t getCustomCurveId();
+
+    /** Static RAM of the process-wide custom curve storage. */
+    static size_t getCustomCurveBytes();
 };
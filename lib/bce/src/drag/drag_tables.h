@@ -10,13 +10,9 @@
 
 #pragma once
 
+#include "bce/bce_types.h"
 #include <cstdint>
 
-struct DragPoint {
-    float mach;
-    float cd;
-};
-
 // ---------------------------------------------------------------------------
 // G1 — Flat-base, blunt nose (Ingalls standard)
 // ---------------------------------------------------------------------------
@@ -0,0 +1,74 @@
+/**
+ * @file drag_tables_uniform.h
+ * @brief G1–G8 drag tables resampled onto a uniform Mach grid.
+ *
+ * The tables are generated at compile time from drag_tables.h by the same
+ * piecewise linear interpolation used by the reference lookup, at
+ * BCE_DRAG_MACH_STEP spacing. A lookup is then one multiply, one truncate
+ * and one lerp instead of a binary search.
+ *
+ * All tables are constexpr static — stored in flash / .rodata, zero RAM cost.
+ */
+
+#pragma once
+
+#include "drag_tables.h"
+#include "bce/bce_config.h"
+
+namespace DragUniform {
+
+/** Number of uniform samples needed to span a source table. */
+constexpr int sampleCount(const DragPoint* table, int size) {
+    return static_cast<int>(table[size - 1].mach / BCE_DRAG_MACH_STEP + 0.5f) + 1;
+}
+
+/** Constexpr twin of DragModelLookup::interpolate (reference path). */
+constexpr float referenceCd(const DragPoint* table, int size, float mach) {
+    if (mach <= table[0].mach) return table[0].cd;
+    if (mach >= table[size - 1].mach) return table[size - 1].cd;
+
+    int lo = 0, hi = size - 1;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (table[mid].mach <= mach) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    float frac = (mach - table[lo].mach) / (table[hi].mach - table[lo].mach);
+    return table[lo].cd + frac * (table[hi].cd - table[lo].cd);
+}
+
+template <int N>
+struct Table {
+    float cd[N] = {};
+};
+
+template <int N>
+constexpr Table<N> resample(const DragPoint* table, int size) {
+    Table<N> out;
+    for (int i = 0; i < N; ++i) {
+        out.cd[i] = referenceCd(table, size, static_cast<float>(i) * BCE_DRAG_MACH_STEP);
+    }
+    return out;
+}
+
+} // namespace DragUniform
+
+#define BCE_DRAG_UNIFORM_TABLE(NAME, SRC)                                                   \
+    static constexpr int NAME##_SIZE = DragUniform::sampleCount(SRC, SRC##_SIZE);           \
+    static constexpr DragUniform::Table<NAME##_SIZE> NAME =                                 \
+        DragUniform::resample<NAME##_SIZE>(SRC, SRC##_SIZE)
+
+BCE_DRAG_UNIFORM_TABLE(G1_UNIFORM, G1_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G2_UNIFORM, G2_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G3_UNIFORM, G3_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G4_UNIFORM, G4_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G5_UNIFORM, G5_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G6_UNIFORM, G6_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G7_UNIFORM, G7_TABLE);
+BCE_DRAG_UNIFORM_TABLE(G8_UNIFORM, G8_TABLE);
+
+#undef BCE_DRAG_UNIFORM_TABLE
@@ -0,0 +1,26 @@
+/**
+ * @file bce_clock.h
+ * @brief Microsecond clock for deadline-bounded work (BCE_StepSolve).
+ *
+ * Wraps at 2^32 µs (~71 minutes); compare intervals with unsigned
+ * subtraction only.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef BCE_PLATFORM_ESP32
+#include "esp_timer.h"
+
+inline uint32_t bceMicros() {
+    return static_cast<uint32_t>(esp_timer_get_time());
+}
+#else
+#include <chrono>
+
+inline uint32_t bceMicros() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
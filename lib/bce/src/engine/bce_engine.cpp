@@ -6,23 +6,53 @@
  *   1. Feed IMU/mag → AHRS
  *   2. Feed baro → Atmosphere
  *   3. Store LRF range + quaternion snapshot
- *   4. Evaluate state machine
- *   5. If data sufficient → run solver → apply corrections → populate FiringSolution
+ *   4. Capture an IngestSnapshot of everything the solver reads
+ *   5. Evaluate state machine
+ *   6. If data sufficient → run solver → apply corrections → populate FiringSolution
+ *   7. Publish the FiringSolution for BCE_GetSolution
+ *
+ * BCE_UpdateIMUBurst runs step 1 for a whole IMU FIFO burst, then steps
+ * 4–7 once.
+ *
+ * In split-pipeline mode BCE_Update stops after step 4 and stores the
+ * snapshot in a seqlock slot; BCE_ServiceSolver runs steps 5–7 on the
+ * latest snapshot, typically from a task on the other core. BCE_StepSolve
+ * runs the same steps spread over several deadline-bounded calls.
  */
 
 #include "bce_engine.h"
+#include "bce_clock.h"
+#include "../solver/batch_solver.h"
+#include "../drag/drag_model.h"
+#include "../math/crc32.h"
 #include <cmath>
 #include <cstring>
 
+std::atomic<int> BCE_Engine::split_engines_{0};
+
 namespace {
 constexpr float BCE_LRF_FILTER_ALPHA = 0.2f;
+
+bool integratorTuningMatches(const IntegratorTuning& a, const IntegratorTuning& b) {
+    return a.method == b.method &&
+           a.tolerance_m == b.tolerance_m &&
+           a.step_scale_m == b.step_scale_m &&
+           a.max_step_m == b.max_step_m &&
+           a.transonic_dt_s == b.transonic_dt_s &&
+           a.range_step_m == b.range_step_m;
+}
 }
 
 void BCE_Engine::init() {
     ahrs_.init();
     mag_.init();
+    mag_fit_active_.store(false, std::memory_order_relaxed);
+    mag_fit_.reset();
+    mag_fit_published_.reset();
     atmo_.init();
     solver_.init();
+    recorder_.reset();
+    profile_db_.close();
 
     mode_ = BCE_Mode::IDLE;
     fault_flags_ = 0;
@@ -41,11 +71,19 @@ void BCE_Engine::init() {
 
     zero_angle_rad_ = 0.0f;
     zero_dirty_ = true;
+    zero_solved_ = false;
+    std::memset(&zero_fingerprint_, 0, sizeof(zero_fingerprint_));
+    std::memset(&restored_zero_fingerprint_, 0, sizeof(restored_zero_fingerprint_));
+    restored_zero_angle_rad_ = 0.0f;
+    has_restored_zero_ = false;
 
     lrf_range_m_ = 0.0f;
     lrf_timestamp_us_ = 0;
+    lrf_confidence_ = 0.0f;
     lrf_quaternion_ = {1, 0, 0, 0};
 
+    target_speed_ms_ = 0.0f;
+    target_heading_deg_ = 0.0f;
     latitude_deg_ = 0.0f;
     boresight_ = {0, 0};
     reticle_ = {0, 0};
@@ -55,12 +93,79 @@ void BCE_Engine::init() {
     first_update_ = true;
     had_invalid_sensor_input_ = false;
     external_reference_mode_ = false;
+    integrator_ = IntegratorTuning{};
+
+    std::memset(&cache_key_, 0, sizeof(cache_key_));
+    std::memset(&cached_result_, 0, sizeof(cached_result_));
+    std::memset(&solver_diag_, 0, sizeof(solver_diag_));
+    cache_valid_ = false;
+
+    std::memset(&trajectory_key_, 0, sizeof(trajectory_key_));
+    trajectory_valid_ = false;
+    trajectory_extent_m_ = 0.0f;
+    trajectory_horizon_m_ = 0.0f;
+    horizon_margin_m_ = BCE_TRAJ_HORIZON_MARGIN_M;
+    max_range_m_ = BCE_MAX_RANGE_M;
+
+    angle_cache_.reset();
+    std::memset(&angle_cache_key_, 0, sizeof(angle_cache_key_));
+    angle_cache_enabled_ = false;
+    angle_cache_valid_ = false;
+
+    std::memset(&uncertainty_, 0, sizeof(uncertainty_));
+    dispersion_sampler_.seed(0);
+    dispersion_.reset();
+    std::memset(&dispersion_key_, 0, sizeof(dispersion_key_));
+    dispersion_valid_ = false;
+    dispersion_nominal_elev_moa_ = 0.0f;
+    dispersion_nominal_wind_moa_ = 0.0f;
+    dispersion_target_radius_moa_ = 0.0f;
+
+    if (split_pipeline_) split_engines_.fetch_sub(1, std::memory_order_acq_rel);
+    split_pipeline_ = false;
+    zero_hint_count_ = 0;
+    zero_hint_seen_ = 0;
+    solved_snapshot_version_ = 0;
+    snapshot_slot_.reset();
+    slicing_ = false;
+    step_pending_ = false;
+    slice_job_ = SliceJob::NONE;
+    std::memset(&slice_zero_fingerprint_, 0, sizeof(slice_zero_fingerprint_));
+    slice_zero_angle_rad_ = 0.0f;
+    slice_zero_ready_ = false;
+    slice_fresh_trajectory_ = false;
+    std::memset(&event_ref_, 0, sizeof(event_ref_));
+    event_solve_requested_ = true;
+    captureSnapshot(0, snap_);
+
+#if BCE_ENABLE_PROFILING
+    std::memset(&perf_, 0, sizeof(perf_));
+    perf_.enabled = 1;
+    perf_.tick_hz = BCE_PERF_TICK_HZ;
+#endif
 
     solution_.solution_mode = static_cast<uint32_t>(BCE_Mode::IDLE);
+    // Never reset the generation, so readers notice a re-init
+    last_published_ = solution_;
+    published_.store(solution_);
+
+    solution_callback_ = nullptr;
+    solution_callback_user_ = nullptr;
+    solution_callback_epsilon_moa_ = 0.0f;
+    notified_ = solution_;
 }
 
 void BCE_Engine::update(const SensorFrame* frame) {
     if (!frame) return;
+    if (recorder_.isRecording()) recorder_.recordFrame(*frame);
+
+#if BCE_ENABLE_PROFILING
+    // In split mode a profiling frame is one solver service; the ingestion
+    // stage ticks measured here are not reported
+    uint32_t ingest_ticks[BCE_PerfStage::COUNT] = {};
+    uint32_t* stage_ticks = split_pipeline_ ? ingest_ticks : perf_.stage_ticks;
+    if (!split_pipeline_) beginPerfFrame();
+#endif
 
     had_invalid_sensor_input_ = false;
 
@@ -68,95 +173,426 @@ void BCE_Engine::update(const SensorFrame* frame) {
 
     // --- 1. AHRS Update ---
     if (frame->imu_valid) {
-        bool imu_finite = std::isfinite(frame->accel_x) && std::isfinite(frame->accel_y) && std::isfinite(frame->accel_z) &&
-                          std::isfinite(frame->gyro_x) && std::isfinite(frame->gyro_y) && std::isfinite(frame->gyro_z);
-        if (!imu_finite) {
-            had_invalid_sensor_input_ = true;
-        }
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::AHRS]);
+        ImuSample sample = {now_us,
+                            frame->accel_x, frame->accel_y, frame->accel_z,
+                            frame->gyro_x, frame->gyro_y, frame->gyro_z};
+        const float mag[3] = {frame->mag_x, frame->mag_y, frame->mag_z};
+        ingestIMU(sample, frame->mag_valid ? mag : nullptr);
+    }
+
+    // --- 2. Barometer → Atmosphere ---
+    if (frame->baro_valid) {
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::ATMOSPHERE]);
+        ingestBaro(frame->baro_pressure_pa, frame->baro_temperature_c,
+                   frame->baro_humidity_valid ? frame->baro_humidity : -1.0f);
+    }
+
+    // --- 3. LRF Range ---
+    if (frame->lrf_valid) {
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::LRF]);
+        ingestLRF(frame->lrf_timestamp_us, frame->lrf_range_m, frame->lrf_confidence);
+    }
+
+    finishUpdate(now_us);
+}
 
-        float dt = 0.01f; // default 100 Hz
-        if (!first_update_ && now_us > last_imu_timestamp_us_) {
-            dt = static_cast<float>(now_us - last_imu_timestamp_us_) * 1e-6f;
-            if (dt > 0.1f) dt = 0.1f; // cap at 100ms for safety
-            if (dt < 0.0001f) dt = 0.0001f;
+void BCE_Engine::updateIMU(const ImuSample* sample, const float mag[3]) {
+    if (!sample) return;
+    if (recorder_.isRecording()) {
+        SensorFrame frame = {};
+        frame.timestamp_us = sample->timestamp_us;
+        frame.accel_x = sample->accel_x;
+        frame.accel_y = sample->accel_y;
+        frame.accel_z = sample->accel_z;
+        frame.gyro_x = sample->gyro_x;
+        frame.gyro_y = sample->gyro_y;
+        frame.gyro_z = sample->gyro_z;
+        frame.imu_valid = true;
+        if (mag) {
+            frame.mag_x = mag[0];
+            frame.mag_y = mag[1];
+            frame.mag_z = mag[2];
+            frame.mag_valid = true;
         }
-        first_update_ = false;
-        last_imu_timestamp_us_ = now_us;
-
-        // Store last gyro for calibration
-        if (imu_finite) {
-            last_gyro_[0] = frame->gyro_x;
-            last_gyro_[1] = frame->gyro_y;
-            last_gyro_[2] = frame->gyro_z;
+        recorder_.recordFrame(frame);
+    }
+
+#if BCE_ENABLE_PROFILING
+    uint32_t ingest_ticks[BCE_PerfStage::COUNT] = {};
+    uint32_t* stage_ticks = split_pipeline_ ? ingest_ticks : perf_.stage_ticks;
+    if (!split_pipeline_) beginPerfFrame();
+#endif
+
+    had_invalid_sensor_input_ = false;
+    {
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::AHRS]);
+        ingestIMU(*sample, mag);
+    }
+    finishUpdate(sample->timestamp_us, true);
+}
+
+void BCE_Engine::updateBaro(uint64_t timestamp_us, float pressure_pa, float temperature_c,
+                            float humidity) {
+    if (recorder_.isRecording()) {
+        SensorFrame frame = {};
+        frame.timestamp_us = timestamp_us;
+        frame.baro_pressure_pa = pressure_pa;
+        frame.baro_temperature_c = temperature_c;
+        frame.baro_valid = true;
+        if (humidity >= 0.0f) {
+            frame.baro_humidity = humidity;
+            frame.baro_humidity_valid = true;
         }
+        recorder_.recordFrame(frame);
+    }
 
-        // Magnetometer: apply calibration and check disturbance
-        float mx = frame->mag_x, my = frame->mag_y, mz = frame->mag_z;
-        bool use_mag = false;
-        if (frame->mag_valid) {
-            bool mag_finite = std::isfinite(mx) && std::isfinite(my) && std::isfinite(mz);
-            if (!mag_finite) {
-                had_invalid_sensor_input_ = true;
-            } else {
-                bool mag_ok = mag_.apply(mx, my, mz);
-                use_mag = mag_ok; // suppress if disturbed
+#if BCE_ENABLE_PROFILING
+    uint32_t ingest_ticks[BCE_PerfStage::COUNT] = {};
+    uint32_t* stage_ticks = split_pipeline_ ? ingest_ticks : perf_.stage_ticks;
+    if (!split_pipeline_) beginPerfFrame();
+#endif
+
+    had_invalid_sensor_input_ = false;
+    {
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::ATMOSPHERE]);
+        ingestBaro(pressure_pa, temperature_c, humidity >= 0.0f ? humidity : -1.0f);
+    }
+    finishUpdate(timestamp_us, true);
+}
+
+void BCE_Engine::updateLRF(uint64_t timestamp_us, float range_m, float confidence) {
+    if (recorder_.isRecording()) {
+        SensorFrame frame = {};
+        frame.timestamp_us = timestamp_us;
+        frame.lrf_range_m = range_m;
+        frame.lrf_timestamp_us = timestamp_us;
+        frame.lrf_confidence = confidence;
+        frame.lrf_valid = true;
+        recorder_.recordFrame(frame);
+    }
+
+#if BCE_ENABLE_PROFILING
+    uint32_t ingest_ticks[BCE_PerfStage::COUNT] = {};
+    uint32_t* stage_ticks = split_pipeline_ ? ingest_ticks : perf_.stage_ticks;
+    if (!split_pipeline_) beginPerfFrame();
+#endif
+
+    had_invalid_sensor_input_ = false;
+    {
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::LRF]);
+        ingestLRF(timestamp_us, range_m, confidence);
+    }
+    // Every reading solves, accepted or not
+    event_solve_requested_ = true;
+    finishUpdate(timestamp_us, true);
+}
+
+void BCE_Engine::ingestIMU(const ImuSample& sample, const float* mag) {
+    bool imu_finite = std::isfinite(sample.accel_x) && std::isfinite(sample.accel_y) && std::isfinite(sample.accel_z) &&
+                      std::isfinite(sample.gyro_x) && std::isfinite(sample.gyro_y) && std::isfinite(sample.gyro_z);
+    if (!imu_finite) {
+        had_invalid_sensor_input_ = true;
+    }
+
+    float dt = imuStepDt(sample.timestamp_us);
+
+    // Store last gyro for calibration
+    if (imu_finite) {
+        last_gyro_[0] = sample.gyro_x;
+        last_gyro_[1] = sample.gyro_y;
+        last_gyro_[2] = sample.gyro_z;
+    }
+
+    // Magnetometer: apply calibration and check disturbance
+    float mx = 0.0f, my = 0.0f, mz = 0.0f;
+    bool use_mag = false;
+    if (mag) {
+        mx = mag[0];
+        my = mag[1];
+        mz = mag[2];
+        bool mag_finite = std::isfinite(mx) && std::isfinite(my) && std::isfinite(mz);
+        if (!mag_finite) {
+            had_invalid_sensor_input_ = true;
+        } else {
+            if (mag_fit_active_.load(std::memory_order_acquire) && mag_fit_.addSample(mx, my, mz)) {
+                mag_fit_published_.store(mag_fit_.getState());
             }
+            bool mag_ok = mag_.apply(mx, my, mz);
+            use_mag = mag_ok; // suppress if disturbed
         }
+    }
 
-        if (imu_finite) {
-            ahrs_.update(frame->accel_x, frame->accel_y, frame->accel_z,
-                          frame->gyro_x, frame->gyro_y, frame->gyro_z,
-                          mx, my, mz, use_mag, dt);
-        }
+    if (imu_finite) {
+        ahrs_.update(sample.accel_x, sample.accel_y, sample.accel_z,
+                     sample.gyro_x, sample.gyro_y, sample.gyro_z,
+                     mx, my, mz, use_mag, dt);
     }
+}
 
-    // --- 2. Barometer → Atmosphere ---
-    if (frame->baro_valid) {
-        float humidity = frame->baro_humidity_valid ? frame->baro_humidity : -1.0f;
-        atmo_.updateFromBaro(frame->baro_pressure_pa, frame->baro_temperature_c, humidity);
-        if (atmo_.consumeZeroRecomputeHint()) {
-            zero_dirty_ = true;
-        }
+void BCE_Engine::ingestBaro(float pressure_pa, float temperature_c, float humidity) {
+    const uint32_t atmo_generation = atmo_.getGeneration();
+    atmo_.updateFromBaro(pressure_pa, temperature_c, humidity);
+    // A reading inside the deadbands leaves nothing to derive or compare
+    if (atmo_.getGeneration() != atmo_generation && atmo_.consumeZeroRecomputeHint()) {
+        zero_hint_count_++;
     }
+}
 
-    // --- 3. LRF Range ---
-    if (frame->lrf_valid) {
-        if (!std::isfinite(frame->lrf_range_m)) {
-            had_invalid_sensor_input_ = true;
+void BCE_Engine::ingestLRF(uint64_t timestamp_us, float range_m, float confidence) {
+    if (!std::isfinite(range_m)) {
+        had_invalid_sensor_input_ = true;
+    }
+
+    bool range_valid = std::isfinite(range_m) &&
+                       range_m > 0.0f &&
+                       range_m <= max_range_m_;
+
+    bool confidence_provided = confidence > 0.0f;
+    bool confidence_in_range = std::isfinite(confidence) && confidence >= 0.0f && confidence <= 1.0f;
+    bool confidence_valid = !confidence_provided ||
+                            (confidence_in_range && confidence >= BCE_LRF_MIN_CONFIDENCE);
+
+    if (confidence_provided && !confidence_in_range) {
+        had_invalid_sensor_input_ = true;
+    }
+
+    if (range_valid && confidence_valid) {
+        if (!has_range_) {
+            // First valid range, initialize filter
+            lrf_range_filtered_m_ = range_m;
+        } else {
+            // Apply IIR filter
+            lrf_range_filtered_m_ = BCE_LRF_FILTER_ALPHA * range_m +
+                                    (1.0f - BCE_LRF_FILTER_ALPHA) * lrf_range_filtered_m_;
         }
+        lrf_range_m_ = range_m;
+        lrf_timestamp_us_ = timestamp_us;
+        lrf_confidence_ = confidence_provided ? confidence : 0.0f;
+        lrf_quaternion_ = ahrs_.getQuaternion();
+        has_range_ = true;
+    }
+}
 
-        bool range_valid = std::isfinite(frame->lrf_range_m) &&
-                           frame->lrf_range_m > 0.0f &&
-                           frame->lrf_range_m <= static_cast<float>(BCE_MAX_RANGE_M);
+void BCE_Engine::updateIMUBurst(const ImuSample* samples, int count) {
+    if (!samples || count <= 0) return;
 
-        float confidence = frame->lrf_confidence;
-        bool confidence_provided = confidence > 0.0f;
-        bool confidence_in_range = std::isfinite(confidence) && confidence >= 0.0f && confidence <= 1.0f;
-        bool confidence_valid = !confidence_provided ||
-                                (confidence_in_range && confidence >= BCE_LRF_MIN_CONFIDENCE);
+#if BCE_ENABLE_PROFILING
+    uint32_t ingest_ticks[BCE_PerfStage::COUNT] = {};
+    uint32_t* stage_ticks = split_pipeline_ ? ingest_ticks : perf_.stage_ticks;
+    if (!split_pipeline_) beginPerfFrame();
+#endif
 
-        if (confidence_provided && !confidence_in_range) {
-            had_invalid_sensor_input_ = true;
+    had_invalid_sensor_input_ = false;
+
+    // --- 1. AHRS Update, in chunks of finite samples ---
+    {
+        BCE_PERF_SCOPE(stage_ticks[BCE_PerfStage::AHRS]);
+
+        ImuSample chunk[BCE_AHRS_BURST_MAX];
+        float dt[BCE_AHRS_BURST_MAX];
+        int n = 0;
+        for (int i = 0; i < count; ++i) {
+            const ImuSample& s = samples[i];
+            float step = imuStepDt(s.timestamp_us);
+
+            bool finite = std::isfinite(s.accel_x) && std::isfinite(s.accel_y) && std::isfinite(s.accel_z) &&
+                          std::isfinite(s.gyro_x) && std::isfinite(s.gyro_y) && std::isfinite(s.gyro_z);
+            if (!finite) {
+                had_invalid_sensor_input_ = true;
+                continue;
+            }
+            last_gyro_[0] = s.gyro_x;
+            last_gyro_[1] = s.gyro_y;
+            last_gyro_[2] = s.gyro_z;
+
+            chunk[n] = s;
+            dt[n] = step;
+            if (++n == BCE_AHRS_BURST_MAX) {
+                ahrs_.updateBurst(chunk, dt, n);
+                n = 0;
+            }
         }
+        if (n > 0) {
+            ahrs_.updateBurst(chunk, dt, n);
+        }
+    }
+
+    finishUpdate(samples[count - 1].timestamp_us);
+}
+
+float BCE_Engine::imuStepDt(uint64_t now_us) {
+    float dt = 0.01f; // default 100 Hz
+    if (!first_update_ && now_us > last_imu_timestamp_us_) {
+        dt = static_cast<float>(now_us - last_imu_timestamp_us_) * 1e-6f;
+        if (dt > 0.1f) dt = 0.1f; // cap at 100ms for safety
+        if (dt < 0.0001f) dt = 0.0001f;
+    }
+    first_update_ = false;
+    last_imu_timestamp_us_ = now_us;
+    return dt;
+}
+
+void BCE_Engine::finishUpdate(uint64_t now_us, bool event) {
+    // --- 4. Snapshot, then solve here or hand off to the solver core ---
+    IngestSnapshot snap;
+    captureSnapshot(now_us, snap);
+    if (event && !event_solve_requested_ && !eventDue(snap)) {
+#if BCE_ENABLE_PROFILING
+        if (!split_pipeline_) endPerfFrame();
+#endif
+        return;
+    }
+    event_solve_requested_ = false;
+    event_ref_.pitch_rad = snap.pitch_rad;
+    event_ref_.roll_rad = snap.roll_rad;
+    event_ref_.heading_true_deg = snap.heading_true_deg;
+    event_ref_.atmo_generation = snap.atmo.getGeneration();
+    event_ref_.zero_hint_count = snap.zero_hint_count;
+    event_ref_.drag_curve_id = DragModelLookup::getCustomCurveId();
+    event_ref_.has_range = snap.has_range;
+    event_ref_.ahrs_stable = snap.ahrs_stable;
+    event_ref_.mag_disturbed = snap.mag_disturbed;
+    event_ref_.sensor_invalid = snap.sensor_invalid;
+    event_ref_.atmo_invalid = snap.atmo.hadInvalidInput();
+
+    if (split_pipeline_) {
+        snapshot_slot_.store(snap);
+        return;
+    }
+
+    snap_ = snap;
+    {
+        BCE_PERF_SCOPE(perf_.stage_ticks[BCE_PerfStage::SOLVE]);
+        evaluateState();
+    }
+    publishSolution();
+
+#if BCE_ENABLE_PROFILING
+    endPerfFrame();
+#endif
+}
+
+bool BCE_Engine::eventDue(const IngestSnapshot& snap) const {
+    const EventReference& ref = event_ref_;
+    if (snap.has_range != ref.has_range || snap.ahrs_stable != ref.ahrs_stable ||
+        snap.mag_disturbed != ref.mag_disturbed || snap.sensor_invalid != ref.sensor_invalid ||
+        snap.zero_hint_count != ref.zero_hint_count ||
+        DragModelLookup::getCustomCurveId() != ref.drag_curve_id ||
+        snap.atmo.getGeneration() != ref.atmo_generation ||
+        snap.atmo.hadInvalidInput() != ref.atmo_invalid) {
+        return true;
+    }
+    if (std::fabs(snap.pitch_rad - ref.pitch_rad) >= BCE_EVENT_PITCH_DELTA_RAD ||
+        std::fabs(snap.roll_rad - ref.roll_rad) >= BCE_EVENT_ROLL_DELTA_RAD) {
+        return true;
+    }
+    float heading_delta = std::fabs(snap.heading_true_deg - ref.heading_true_deg);
+    if (heading_delta > 180.0f) heading_delta = 360.0f - heading_delta;
+    return heading_delta >= BCE_EVENT_HEADING_DELTA_DEG;
+}
+
+bool BCE_Engine::serviceSolver() {
+    if (!split_pipeline_) return false;
+
+    IngestSnapshot snap;
+    uint32_t version = snapshot_slot_.load(snap);
+    if (version == solved_snapshot_version_) return false;
+    solved_snapshot_version_ = version;
+
+#if BCE_ENABLE_PROFILING
+    beginPerfFrame();
+#endif
 
-        if (range_valid && confidence_valid) {
-            if (!has_range_) {
-                // First valid range, initialize filter
-                lrf_range_filtered_m_ = frame->lrf_range_m;
-            } else {
-                // Apply IIR filter
-                lrf_range_filtered_m_ = BCE_LRF_FILTER_ALPHA * frame->lrf_range_m +
-                                        (1.0f - BCE_LRF_FILTER_ALPHA) * lrf_range_filtered_m_;
+    snap_ = snap;
+    {
+        BCE_PERF_SCOPE(perf_.stage_ticks[BCE_PerfStage::SOLVE]);
+        evaluateState();
+    }
+    publishSolution();
+
+#if BCE_ENABLE_PROFILING
+    endPerfFrame();
+#endif
+    return true;
+}
+
+bool BCE_Engine::stepSolve(uint32_t budget_us) {
+    if (!split_pipeline_) return false;
+    const uint32_t start_us = bceMicros();
+
+    if (!step_pending_) {
+        IngestSnapshot snap;
+        uint32_t version = snapshot_slot_.load(snap);
+        if (version == solved_snapshot_version_) return false;
+        solved_snapshot_version_ = version;
+        snap_ = snap;
+        step_pending_ = true;
+    }
+
+#if BCE_ENABLE_PROFILING
+    // A profiling frame is one call, so frame_ticks_max tracks the budget
+    beginPerfFrame();
+#endif
+
+    bool finished = false;
+    {
+        BCE_PERF_SCOPE(perf_.stage_ticks[BCE_PerfStage::SOLVE]);
+        bool stepped = false;
+        for (;;) {
+            if (slice_job_ == SliceJob::NONE) {
+                // Cheap unless it starts a job; adopts the one just finished
+                slicing_ = true;
+                evaluateState();
+                slicing_ = false;
+                slice_fresh_trajectory_ = false;
+                if (slice_job_ == SliceJob::NONE) {
+                    finished = true;
+                    break;
+                }
             }
-            lrf_range_m_ = frame->lrf_range_m;
-            lrf_timestamp_us_ = frame->lrf_timestamp_us;
-            lrf_quaternion_ = ahrs_.getQuaternion();
-            has_range_ = true;
+            if (!solver_.hasJob()) {
+                // Cancelled by a blocking solver integration since the last
+                // call (hold table, state restore); start over
+                slice_job_ = SliceJob::NONE;
+                continue;
+            }
+            if (stepped && bceMicros() - start_us >= budget_us) break;
+            stepped = true;
+
+            // Zero-search slices also count towards the ZERO stage
+            bool done;
+            {
+                BCE_PERF_SCOPE(slice_job_ == SliceJob::ZERO ? perf_.stage_ticks[BCE_PerfStage::ZERO]
+                                                            : perf_unstaged_ticks_);
+                done = solver_.stepJob(BCE_STEP_SOLVE_SLICE_STEPS);
+            }
+            if (done) finishSliceJob();
         }
     }
 
-    // --- 4. Evaluate state and compute solution ---
-    evaluateState(now_us);
+    if (finished) {
+        step_pending_ = false;
+    } else {
+        diag_flags_ |= BCE_Diag::SOLUTION_PENDING;
+    }
+    publishSolution(!finished);
+
+#if BCE_ENABLE_PROFILING
+    endPerfFrame();
+#endif
+    return finished;
+}
+
+void BCE_Engine::finishSliceJob() {
+    if (slice_job_ == SliceJob::ZERO) {
+        slice_zero_angle_rad_ = solver_.getJobZeroAngle();
+        slice_zero_ready_ = true;
+    } else if (slice_job_ == SliceJob::TRAJECTORY) {
+        trajectory_valid_ = solver_.getMaxValidRange() > 0;
+        slice_fresh_trajectory_ = true;
+    }
+    slice_job_ = SliceJob::NONE;
 }
 
 void BCE_Engine::setBulletProfile(const BulletProfile* profile) {
@@ -164,6 +600,8 @@ void BCE_Engine::setBulletProfile(const BulletProfile* profile) {
     bullet_ = *profile;
     has_bullet_ = true;
     zero_dirty_ = true;
+    event_solve_requested_ = true;
+    recorder_.recordBullet(bullet_);
 }
 
 void BCE_Engine::setZeroConfig(const ZeroConfig* config) {
@@ -171,10 +609,23 @@ void BCE_Engine::setZeroConfig(const ZeroConfig* config) {
     zero_ = *config;
     has_zero_ = true;
     zero_dirty_ = true;
+    event_solve_requested_ = true;
+    recorder_.recordZero(zero_);
 }
 
 void BCE_Engine::setWindManual(float speed_ms, float heading_deg) {
     wind_.setWind(speed_ms, heading_deg);
+    event_solve_requested_ = true;
+}
+
+void BCE_Engine::setTargetMotion(float speed_ms, float heading_deg) {
+    if (!(speed_ms > 0.0f) || !std::isfinite(speed_ms) || !std::isfinite(heading_deg)) {
+        speed_ms = 0.0f;
+        heading_deg = 0.0f;
+    }
+    target_speed_ms_ = speed_ms;
+    target_heading_deg_ = heading_deg;
+    event_solve_requested_ = true;
 }
 
 void BCE_Engine::setLatitude(float latitude_deg) {
@@ -184,6 +635,7 @@ void BCE_Engine::setLatitude(float latitude_deg) {
         latitude_deg_ = latitude_deg;
         has_latitude_ = true;
     }
+    event_solve_requested_ = true;
 }
 
 void BCE_Engine::setDefaultOverrides(const BCE_DefaultOverrides* defaults) {
@@ -200,7 +652,8 @@ void BCE_Engine::setDefaultOverrides(const BCE_DefaultOverrides* defaults) {
         wind_.setWind(defaults->wind_speed_ms, defaults->wind_heading_deg);
     }
 
-    zero_dirty_ = true; // atmosphere changed → zero must recompute
+    zero_hint_count_++; // atmosphere changed → zero must recompute
+    event_solve_requested_ = true;
 }
 
 void BCE_Engine::setIMUBias(const float accel_bias[3], const float gyro_bias[3]) {
@@ -218,19 +671,65 @@ void BCE_Engine::setMagCalibration(const float hard_iron[3], const float soft_ir
                         soft_iron ? soft_iron : identity_si);
 }
 
+void BCE_Engine::startMagCalibration() {
+    mag_fit_active_.store(false, std::memory_order_relaxed);
+    mag_fit_.reset();
+    mag_fit_published_.store(mag_fit_.getState());
+    mag_fit_active_.store(true, std::memory_order_release);
+}
+
+void BCE_Engine::cancelMagCalibration() {
+    mag_fit_active_.store(false, std::memory_order_release);
+}
+
+void BCE_Engine::getMagCalibrationStatus(BCE_MagCalStatus* out) const {
+    if (!out) return;
+    std::memset(out, 0, sizeof(*out));
+    MagEllipsoidFit::State state;
+    if (mag_fit_published_.load(state) == 0) {
+        mag_.getCalibration(out->hard_iron, out->soft_iron);
+        return;
+    }
+    MagEllipsoidFit::Result fit;
+    out->ready = MagEllipsoidFit::solve(state, fit);
+    out->samples = state.samples;
+    out->rejected = state.rejected;
+    out->coverage = fit.coverage;
+    out->field_ut = fit.field_ut;
+    out->residual_ut = fit.residual_ut;
+    std::memcpy(out->hard_iron, fit.hard_iron, sizeof(out->hard_iron));
+    std::memcpy(out->soft_iron, fit.soft_iron, sizeof(out->soft_iron));
+    out->collecting = mag_fit_active_.load(std::memory_order_acquire);
+}
+
+bool BCE_Engine::commitMagCalibration() {
+    // The fit is solved from the published state and swapped in through
+    // the calibration's double buffer: ingestIMU() keeps running and picks
+    // the new calibration up on its next reading
+    MagEllipsoidFit::State state;
+    if (mag_fit_published_.load(state) == 0) return false;
+    MagEllipsoidFit::Result fit;
+    if (!MagEllipsoidFit::solve(state, fit)) return false;
+    mag_.setCalibration(fit.hard_iron, fit.soft_iron);
+    mag_fit_active_.store(false, std::memory_order_release);
+    return true;
+}
+
 void BCE_Engine::setBoresightOffset(float vertical_moa, float horizontal_moa) {
     boresight_.vertical_moa = vertical_moa;
     boresight_.horizontal_moa = horizontal_moa;
+    event_solve_requested_ = true;
 }
 
 void BCE_Engine::setReticleOffset(float vertical_moa, float horizontal_moa) {
     reticle_.vertical_moa = vertical_moa;
     reticle_.horizontal_moa = horizontal_moa;
+    event_solve_requested_ = true;
 }
 
 void BCE_Engine::calibrateBaro() {
     atmo_.calibrateBaro();
-    zero_dirty_ = true;
+    zero_hint_count_++;
 }
 
 void BCE_Engine::calibrateGyro() {
@@ -247,30 +746,256 @@ void BCE_Engine::setMagDeclination(float declination_deg) {
 
 void BCE_Engine::setExternalReferenceMode(bool enabled) {
     external_reference_mode_ = enabled;
+    event_solve_requested_ = true;
+}
+
+void BCE_Engine::setIntegrator(IntegratorMethod method, float tolerance_m) {
+    IntegratorTuning tuning = integrator_;
+    tuning.method = method;
+    tuning.tolerance_m = tolerance_m;
+    setIntegratorTuning(&tuning);
+}
+
+void BCE_Engine::setIntegratorTuning(const IntegratorTuning* tuning) {
+    const IntegratorTuning t = tuning ? *tuning : IntegratorTuning{};
+    if (!integratorTuningMatches(t, integrator_)) {
+        integrator_ = t;
+        zero_dirty_ = true;
+        event_solve_requested_ = true;
+        recorder_.recordIntegrator(t);
+    }
+}
+
+void BCE_Engine::setRecorder(bool enabled) {
+    if (enabled) {
+        recorder_.start();
+    } else {
+        recorder_.stop();
+    }
+}
+
+void BCE_Engine::setTrajectoryHorizon(float horizon_m) {
+    if (!(horizon_m >= 1.0f)) {
+        horizon_m = 0.0f; // automatic
+    } else if (horizon_m > BCE_MAX_RANGE_M) {
+        horizon_m = BCE_MAX_RANGE_M;
+    }
+    trajectory_horizon_m_ = horizon_m;
+    horizon_margin_m_ = BCE_TRAJ_HORIZON_MARGIN_M;
+}
+
+void BCE_Engine::setMaxRange(float max_range_m) {
+    if (!(max_range_m >= 1.0f) || max_range_m > BCE_MAX_RANGE_M) {
+        max_range_m = BCE_MAX_RANGE_M;
+    }
+    if (max_range_m == max_range_m_) return;
+    max_range_m_ = max_range_m;
+
+    // Tables and the zero were built against the old limit
+    zero_dirty_ = true;
+    cache_valid_ = false;
+    trajectory_valid_ = false;
+    angle_cache_valid_ = false;
+    event_solve_requested_ = true;
 }
 
-void BCE_Engine::getSolution(FiringSolution* out) const {
+void BCE_Engine::setAngleCache(bool enabled) {
+    angle_cache_enabled_ = enabled;
+    angle_cache_valid_ = false;
+}
+
+void BCE_Engine::setSplitPipeline(bool enabled) {
+    if (enabled != split_pipeline_) {
+        split_engines_.fetch_add(enabled ? 1 : -1, std::memory_order_acq_rel);
+    }
+    split_pipeline_ = enabled;
+    solved_snapshot_version_ = snapshot_slot_.version();
+    step_pending_ = false;
+    slice_job_ = SliceJob::NONE;
+    event_solve_requested_ = true;
+}
+
+void BCE_Engine::setSolutionCallback(BCE_SolutionCallback fn, void* user, float epsilon_moa) {
+    solution_callback_ = fn;
+    solution_callback_user_ = user;
+    solution_callback_epsilon_moa_ = epsilon_moa;
+    if (!fn) return;
+    // Start the listener from the current solution
+    notified_ = last_published_;
+    fn(&notified_, user);
+}
+
+uint32_t BCE_Engine::getSolution(FiringSolution* out) const {
+    if (!out) return published_.generation();
+    return published_.load(*out);
+}
+
+BCE_Mode BCE_Engine::getMode() const {
+    if (!split_pipeline_) return mode_;
+    FiringSolution sol;
+    published_.load(sol);
+    return static_cast<BCE_Mode>(sol.solution_mode);
+}
+
+uint32_t BCE_Engine::getFaultFlags() const {
+    if (!split_pipeline_) return fault_flags_;
+    FiringSolution sol;
+    published_.load(sol);
+    return sol.fault_flags;
+}
+
+uint32_t BCE_Engine::getDiagFlags() const {
+    if (!split_pipeline_) return diag_flags_;
+    FiringSolution sol;
+    published_.load(sol);
+    return sol.defaults_active;
+}
+
+void BCE_Engine::getSolverDiagnostics(BCE_SolverDiagnostics* out) const {
     if (out) {
-        *out = solution_;
+        *out = solver_diag_;
     }
 }
 
+bool BCE_Engine::getTrajectoryView(const TrajectoryPoint** points, int* count,
+                                   uint32_t* generation) const {
+    const TrajectoryPoint* table = nullptr;
+    int n = 0;
+#if !BCE_TRAJ_TABLE_COMPACT
+    // A table an angle-cache fill or a pending slice job left behind does
+    // not belong to the current solution
+    if (trajectory_valid_ && solver_.getMaxValidRange() > 0) {
+        table = solver_.getTable();
+        n = solver_.getMaxValidRange() / BCE_TRAJ_TABLE_STRIDE_M + 1;
+    }
+#endif
+    if (points) *points = table;
+    if (count) *count = n;
+    if (generation) *generation = solver_.getTableGeneration();
+    return n > 0;
+}
+
+void BCE_Engine::getPerfStats(BCE_PerfStats* out) const {
+    if (!out) return;
+#if BCE_ENABLE_PROFILING
+    *out = perf_;
+#else
+    std::memset(out, 0, sizeof(*out));
+#endif
+}
+
+#if BCE_ENABLE_PROFILING
+// ---------------------------------------------------------------------------
+// Internal: per-frame instrumentation
+// ---------------------------------------------------------------------------
+
+void BCE_Engine::beginPerfFrame() {
+    std::memset(perf_.stage_ticks, 0, sizeof(perf_.stage_ticks));
+    perf_.zero_iterations = 0;
+    perf_steps_base_ = solver_.getPerfStepCount();
+    perf_lookups_base_ = solver_.getPerfDragLookups();
+    perf_frame_start_ = bcePerfNow();
+}
+
+void BCE_Engine::endPerfFrame() {
+    perf_.frame_ticks = bcePerfNow() - perf_frame_start_;
+
+    // The zero recompute runs inside the solve stage; report it separately
+    uint32_t& solve = perf_.stage_ticks[BCE_PerfStage::SOLVE];
+    uint32_t zero = perf_.stage_ticks[BCE_PerfStage::ZERO];
+    solve = (solve > zero) ? solve - zero : 0;
+
+    perf_.integration_steps = solver_.getPerfStepCount() - perf_steps_base_;
+    perf_.drag_lookups = solver_.getPerfDragLookups() - perf_lookups_base_;
+    perf_.frame_count++;
+
+    if (perf_.frame_ticks > perf_.frame_ticks_max) {
+        perf_.frame_ticks_max = perf_.frame_ticks;
+    }
+    for (uint32_t i = 0; i < BCE_PerfStage::COUNT; ++i) {
+        if (perf_.stage_ticks[i] > perf_.stage_ticks_max[i]) {
+            perf_.stage_ticks_max[i] = perf_.stage_ticks[i];
+        }
+    }
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Internal: ingestion → solver handoff
+// ---------------------------------------------------------------------------
+
+void BCE_Engine::captureSnapshot(uint64_t now_us, IngestSnapshot& snap) {
+    snap.lrf_stale = false;
+    if (has_range_ && now_us > lrf_timestamp_us_ + BCE_LRF_STALE_US) {
+        // The next accepted sample restarts the range filter
+        has_range_ = false;
+        snap.lrf_stale = true;
+    }
+
+    snap.atmo = atmo_;
+    snap.timestamp_us = now_us;
+    snap.pitch_rad = ahrs_.getPitch();
+    snap.roll_rad = ahrs_.getRoll();
+    snap.heading_true_deg = mag_.computeHeading(ahrs_.getYaw());
+    snap.lrf_range_m = lrf_range_m_;
+    snap.lrf_range_filtered_m = lrf_range_filtered_m_;
+    snap.lrf_confidence = lrf_confidence_;
+    snap.zero_hint_count = zero_hint_count_;
+    snap.has_range = has_range_;
+    snap.ahrs_stable = ahrs_.isStable();
+    snap.mag_disturbed = mag_.isDisturbed();
+    snap.sensor_invalid = had_invalid_sensor_input_;
+}
+
+void BCE_Engine::publishSolution(bool pending) {
+    FiringSolution out = solution_;
+    if (pending) {
+        out.defaults_active |= BCE_Diag::SOLUTION_PENDING;
+    }
+    if (std::memcmp(&out, &last_published_, sizeof(out)) == 0) return;
+    last_published_ = out;
+    published_.store(out);
+
+    if (solution_callback_ && solutionChangeNotable(out)) {
+        notified_ = out;
+        solution_callback_(&out, solution_callback_user_);
+    }
+}
+
+bool BCE_Engine::solutionChangeNotable(const FiringSolution& sol) const {
+    // Mode and flag transitions always count, holds only past the epsilon
+    if (sol.solution_mode != notified_.solution_mode ||
+        sol.fault_flags != notified_.fault_flags ||
+        sol.defaults_active != notified_.defaults_active) {
+        return true;
+    }
+    const float eps = solution_callback_epsilon_moa_;
+    if (!(eps > 0.0f)) return true;
+    return std::fabs(sol.hold_elevation_moa - notified_.hold_elevation_moa) > eps ||
+           std::fabs(sol.hold_windage_moa - notified_.hold_windage_moa) > eps;
+}
+
 // ---------------------------------------------------------------------------
 // Internal: state machine evaluation
 // ---------------------------------------------------------------------------
 
-void BCE_Engine::evaluateState(uint64_t now_us) {
+void BCE_Engine::evaluateState() {
     fault_flags_ = 0;
-    diag_flags_ = atmo_.getDiagFlags();
+    diag_flags_ = snap_.atmo.getDiagFlags();
+
+    if (snap_.zero_hint_count != zero_hint_seen_) {
+        zero_hint_seen_ = snap_.zero_hint_count;
+        zero_dirty_ = true;
+    }
+    checkCustomDragCurve();
 
     // Check hard faults — SRS §13
-    if (!has_range_) {
-        fault_flags_ |= BCE_Fault::NO_RANGE;
-    } else if (now_us > lrf_timestamp_us_ + BCE_LRF_STALE_US) {
-        // LRF stale — not a hard fault, but range is invalid
-        has_range_ = false;
+    if (!snap_.has_range) {
         fault_flags_ |= BCE_Fault::NO_RANGE;
-        diag_flags_ |= BCE_Diag::LRF_STALE;
+        if (snap_.lrf_stale) {
+            // LRF stale — not a hard fault, but range is invalid
+            diag_flags_ |= BCE_Diag::LRF_STALE;
+        }
     }
 
     if (!has_bullet_) {
@@ -282,14 +1007,16 @@ void BCE_Engine::evaluateState(uint64_t now_us) {
         if (bullet_.bc < 0.001f) {
             fault_flags_ |= BCE_Fault::NO_BC;
         }
+        if (!customCurveLoaded()) {
+            fault_flags_ |= BCE_Fault::NO_DRAG_CURVE;
+        }
 
-        if (has_zero_ && (zero_.zero_range_m < 1.0f ||
-                          zero_.zero_range_m > static_cast<float>(BCE_MAX_RANGE_M))) {
+        if (has_zero_ && (zero_.zero_range_m < 1.0f || zero_.zero_range_m > max_range_m_)) {
             fault_flags_ |= BCE_Fault::ZERO_UNSOLVABLE;
         }
     }
 
-    if (!ahrs_.isStable()) {
+    if (!snap_.ahrs_stable) {
         fault_flags_ |= BCE_Fault::AHRS_UNSTABLE;
     }
 
@@ -297,7 +1024,7 @@ void BCE_Engine::evaluateState(uint64_t now_us) {
         diag_flags_ |= BCE_Diag::CORIOLIS_DISABLED;
     }
 
-    if (mag_.isDisturbed()) {
+    if (snap_.mag_disturbed) {
         diag_flags_ |= BCE_Diag::MAG_SUPPRESSED;
     }
 
@@ -305,7 +1032,7 @@ void BCE_Engine::evaluateState(uint64_t now_us) {
         diag_flags_ |= BCE_Diag::DEFAULT_WIND;
     }
 
-    if (atmo_.hadInvalidInput() || had_invalid_sensor_input_) {
+    if (snap_.atmo.hadInvalidInput() || snap_.sensor_invalid) {
         fault_flags_ |= BCE_Fault::SENSOR_INVALID;
     }
 
@@ -316,6 +1043,7 @@ void BCE_Engine::evaluateState(uint64_t now_us) {
                                                  BCE_Fault::NO_BULLET |
                                                  BCE_Fault::NO_MV |
                                                  BCE_Fault::NO_BC |
+                                                 BCE_Fault::NO_DRAG_CURVE |
                                                  BCE_Fault::AHRS_UNSTABLE |
                                                  BCE_Fault::ZERO_UNSOLVABLE);
         if (hard_faults != 0) {
@@ -328,9 +1056,10 @@ void BCE_Engine::evaluateState(uint64_t now_us) {
     }
 
     // Have enough data — check if we can compute
-    if (has_range_ && has_bullet_ &&
+    if (snap_.has_range && has_bullet_ &&
         bullet_.muzzle_velocity_ms > 1.0f && bullet_.bc > 0.001f) {
         computeSolution();
+        if (slice_job_ != SliceJob::NONE) return; // finishes in a later stepSolve()
         mode_ = BCE_Mode::SOLUTION_READY;
     } else {
         mode_ = BCE_Mode::IDLE;
@@ -347,7 +1076,9 @@ void BCE_Engine::evaluateState(uint64_t now_us) {
 void BCE_Engine::computeSolution() {
     // Recompute zero if dirty
     if (zero_dirty_) {
+        BCE_PERF_SCOPE(perf_.stage_ticks[BCE_PerfStage::ZERO]);
         recomputeZero();
+        if (slice_job_ != SliceJob::NONE) return;
     }
 
     if (fault_flags_ & BCE_Fault::ZERO_UNSOLVABLE) {
@@ -358,18 +1089,53 @@ void BCE_Engine::computeSolution() {
         return;
     }
 
-    // Get current pitch (bore elevation) and heading from AHRS
-    float pitch = ahrs_.getPitch();
-    float roll  = ahrs_.getRoll();
-    float yaw   = ahrs_.getYaw();
-    float heading_true = mag_.computeHeading(yaw);
+    // Bore elevation, cant and heading as of the snapshot
+    float pitch = snap_.pitch_rad;
+    float roll  = snap_.roll_rad;
+    float heading_true = snap_.heading_true_deg;
 
     // Build solver params
-    SolverParams params = buildSolverParams(lrf_range_filtered_m_);
+    SolverParams params = buildSolverParams(snap_.lrf_range_filtered_m);
     params.launch_angle_rad = zero_angle_rad_ + pitch;
 
-    // Run solver
-    SolverResult result = solver_.integrate(params);
+    // Run solver, unless the quantized inputs match the cached result. When
+    // only the range moved, sample the already-integrated trajectory table.
+    SolutionCacheKey key = makeCacheKey(params);
+    SolverResult result;
+    if (cache_valid_ && cacheKeyMatches(key, cache_key_)) {
+        result = cached_result_;
+        solver_diag_.solution_cache_hits++;
+    } else if (angle_cache_enabled_ && !slicing_ && solveFromAngleCache(params, key, result)) {
+        cache_key_ = key;
+        cached_result_ = result;
+        cache_valid_ = true;
+    } else {
+        const bool same_trajectory = trajectory_valid_ && trajectoryKeyMatches(key, trajectory_key_);
+        if (same_trajectory && params.target_range_m <= trajectory_extent_m_) {
+            // A table a slice job just integrated was counted as a miss
+            if (!slice_fresh_trajectory_) solver_diag_.trajectory_table_hits++;
+        } else {
+            if (same_trajectory) widenHorizon();
+            float horizon = tabulationHorizon(params.target_range_m);
+            trajectory_key_ = key;
+            trajectory_extent_m_ = horizon;
+            solver_diag_.trajectory_extent_m = static_cast<uint32_t>(horizon);
+            solver_diag_.solution_cache_misses++;
+            if (slicing_) {
+                trajectory_valid_ = false;
+                solver_.beginTrajectory(params, horizon);
+                slice_job_ = SliceJob::TRAJECTORY;
+                return;
+            }
+            trajectory_valid_ = solver_.integrateTrajectory(params, horizon);
+        }
+        result = solver_.sampleTrajectory(params, params.target_range_m);
+        cache_valid_ = result.valid;
+        if (result.valid) {
+            cache_key_ = key;
+            cached_result_ = result;
+        }
+    }
 
     if (!result.valid) {
         // Zero may be unsolvable
@@ -381,28 +1147,547 @@ void BCE_Engine::computeSolution() {
         return;
     }
 
+    // Lead for a moving target, from the table the result was sampled from
+    LeadSolution lead;
+    solver_diag_.lead_iterations = 0;
+    const bool leading = target_speed_ms_ > 0.0f && solveLead(params, key, result, heading_true, lead);
+
+    // Populate firing solution
+    solution_.solution_mode = static_cast<uint32_t>(BCE_Mode::SOLUTION_READY);
+    solution_.fault_flags = fault_flags_;
+    solution_.defaults_active = diag_flags_;
+    populateSolution(result, snap_.lrf_range_m, roll, heading_true, solution_,
+                     leading ? &lead : nullptr);
+}
+
+int BCE_Engine::computeHoldTable(const float* ranges, int count, FiringSolution* out) {
+    if (!ranges || !out || count <= 0) return 0;
+
+    // Same preconditions as the live solve, except that ranges come from the
+    // caller rather than the LRF
+    uint32_t faults = 0;
+    if (!has_bullet_) {
+        faults |= BCE_Fault::NO_BULLET;
+    } else {
+        if (bullet_.muzzle_velocity_ms < 1.0f) faults |= BCE_Fault::NO_MV;
+        if (bullet_.bc < 0.001f) faults |= BCE_Fault::NO_BC;
+        if (!customCurveLoaded()) faults |= BCE_Fault::NO_DRAG_CURVE;
+    }
+    if (!snap_.ahrs_stable) {
+        faults |= BCE_Fault::AHRS_UNSTABLE;
+    }
+    checkCustomDragCurve();
+    if (faults == 0 && zero_dirty_) {
+        recomputeZero();
+    }
+    if (has_zero_ && (!zero_solved_ || zero_.zero_range_m < 1.0f ||
+                      zero_.zero_range_m > max_range_m_)) {
+        faults |= BCE_Fault::ZERO_UNSOLVABLE;
+    }
+
+    float max_range = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        std::memset(&out[i], 0, sizeof(out[i]));
+        out[i].solution_mode = static_cast<uint32_t>(BCE_Mode::FAULT);
+        out[i].fault_flags = faults;
+        out[i].defaults_active = diag_flags_;
+        out[i].range_m = ranges[i];
+        if (std::isfinite(ranges[i]) && ranges[i] > max_range) {
+            max_range = ranges[i];
+        }
+    }
+    if (faults != 0) return 0;
+    if (max_range > max_range_m_) {
+        max_range = max_range_m_;
+    }
+
+    float pitch = snap_.pitch_rad;
+    float roll  = snap_.roll_rad;
+    float heading_true = snap_.heading_true_deg;
+
+    SolverParams params = buildSolverParams(max_range);
+    params.launch_angle_rad = zero_angle_rad_ + pitch;
+
+    // One integration out to the farthest range (or the live horizon, so the
+    // trajectory stays reusable by BCE_Update), then sample every range
+    SolutionCacheKey key = makeCacheKey(params);
+    if (!(trajectory_valid_ && trajectoryKeyMatches(key, trajectory_key_) &&
+          max_range <= trajectory_extent_m_)) {
+        float horizon = (trajectory_horizon_m_ > 0.0f) ? trajectory_horizon_m_
+                                                       : max_range + horizon_margin_m_;
+        if (horizon < max_range) horizon = max_range;
+        if (horizon > max_range_m_) horizon = max_range_m_;
+        trajectory_valid_ = solver_.integrateTrajectory(params, horizon);
+        trajectory_key_ = key;
+        trajectory_extent_m_ = horizon;
+        solver_diag_.trajectory_extent_m = static_cast<uint32_t>(horizon);
+        solver_diag_.solution_cache_misses++;
+    }
+
+    int solved = 0;
+    for (int i = 0; i < count; ++i) {
+        float range = ranges[i];
+        bool range_valid = std::isfinite(range) && range >= 1.0f && range <= max_range_m_;
+        SolverResult result = {};
+        if (range_valid && trajectory_valid_) {
+            result = solver_.sampleTrajectory(params, range);
+        }
+        if (!result.valid) {
+            out[i].fault_flags |= BCE_Fault::NO_RANGE;
+            continue;
+        }
+
+        solver_diag_.trajectory_table_hits++;
+        out[i].solution_mode = static_cast<uint32_t>(BCE_Mode::SOLUTION_READY);
+        populateSolution(result, range, roll, heading_true, out[i]);
+        solved++;
+    }
+    return solved;
+}
+
+// ---------------------------------------------------------------------------
+// Dispersion (Monte Carlo)
+// ---------------------------------------------------------------------------
+
+void BCE_Engine::setUncertainty(const BCE_UncertaintyConfig* config) {
+    if (!config) return;
+    uncertainty_ = *config;
+    dispersion_sampler_.seed(config->seed);
+    dispersion_.reset();
+    dispersion_valid_ = false;
+}
+
+uint32_t BCE_Engine::runDispersion(int samples) {
+    if (mode_ != BCE_Mode::SOLUTION_READY || samples <= 0) {
+        return dispersion_valid_ ? dispersion_.getCount() : 0;
+    }
+
+    float roll = snap_.roll_rad;
+    float heading_true = snap_.heading_true_deg;
+    float range = snap_.lrf_range_filtered_m;
+
+    SolverParams nominal = buildSolverParams(range);
+    nominal.launch_angle_rad = zero_angle_rad_ + snap_.pitch_rad;
+
+    SolverParams params[BCE_BATCH_LANES];
+    SolverResult results[BCE_BATCH_LANES];
+    FiringSolution hold;
+
+    // Restart the statistics when the nominal solution moved; the nominal
+    // holds come from the batch path too so zero sigmas give zero spread
+    SolutionCacheKey key = makeCacheKey(nominal);
+    if (!dispersion_valid_ || !dispersionKeyMatches(key, dispersion_key_)) {
+        BatchSolver::solve(&nominal, 1, results);
+        if (!results[0].valid) return 0;
+        populateSolution(results[0], range, roll, heading_true, hold);
+        dispersion_.reset();
+        dispersion_key_ = key;
+        dispersion_valid_ = true;
+        dispersion_nominal_elev_moa_ = hold.hold_elevation_moa;
+        dispersion_nominal_wind_moa_ = hold.hold_windage_moa;
+        dispersion_target_radius_moa_ = (uncertainty_.target_radius_m / range) * BCE_RAD_TO_MOA;
+    }
+
+    // Range 1σ: configured term combined with the LRF confidence term
+    float conf_sigma = 0.0f;
+    if (snap_.lrf_confidence > 0.0f) {
+        conf_sigma = (1.0f - snap_.lrf_confidence) * BCE_DISPERSION_LRF_SIGMA_FRACTION * range;
+    }
+    const float range_sigma = std::sqrt(uncertainty_.range_sigma_m * uncertainty_.range_sigma_m +
+                                        conf_sigma * conf_sigma);
+    const float radius2 = dispersion_target_radius_moa_ * dispersion_target_radius_moa_;
+
+    float ranges[BCE_BATCH_LANES];
+    while (samples > 0) {
+        int lanes = (samples < BCE_BATCH_LANES) ? samples : BCE_BATCH_LANES;
+        for (int l = 0; l < lanes; ++l) {
+            SolverParams& p = params[l];
+            p = nominal;
+            p.muzzle_velocity_ms += uncertainty_.mv_sigma_ms * dispersion_sampler_.gaussian();
+            p.bc *= 1.0f + uncertainty_.bc_sigma_fraction * dispersion_sampler_.gaussian();
+            p.air_density *= 1.0f + uncertainty_.density_sigma_fraction *
+                                        dispersion_sampler_.gaussian();
+
+            WindCorrection wind;
+            float speed = wind_.getSpeed() +
+                          uncertainty_.wind_speed_sigma_ms * dispersion_sampler_.gaussian();
+            float heading = wind_.getHeading() +
+                            uncertainty_.wind_heading_sigma_deg * dispersion_sampler_.gaussian();
+            wind.setWind(speed > 0.0f ? speed : 0.0f, heading);
+            wind.decompose(heading_true, p.headwind_ms, p.crosswind_ms);
+
+            float r = range + range_sigma * dispersion_sampler_.gaussian();
+            if (r < 1.0f) r = 1.0f;
+            if (r > max_range_m_) r = max_range_m_;
+            p.target_range_m = r;
+            ranges[l] = r;
+        }
+
+        BatchSolver::solve(params, lanes, results);
+
+        // The shooter holds the nominal solution; each sample lands off the
+        // point of aim by the difference to the hold it actually needed
+        for (int l = 0; l < lanes; ++l) {
+            if (!results[l].valid) continue;
+            populateSolution(results[l], ranges[l], roll, heading_true, hold);
+            float elev = dispersion_nominal_elev_moa_ - hold.hold_elevation_moa;
+            float windage = dispersion_nominal_wind_moa_ - hold.hold_windage_moa;
+            dispersion_.add(elev, windage, elev * elev + windage * windage <= radius2);
+        }
+        samples -= lanes;
+    }
+
+    return dispersion_.getCount();
+}
+
+void BCE_Engine::getDispersion(BCE_DispersionStats* out) const {
+    if (!out) return;
+    if (!dispersion_valid_) {
+        std::memset(out, 0, sizeof(*out));
+        return;
+    }
+    dispersion_.getStats(out);
+    out->target_radius_moa = dispersion_target_radius_moa_;
+}
+
+// ---------------------------------------------------------------------------
+// Sensitivities
+// ---------------------------------------------------------------------------
+
+bool BCE_Engine::getSensitivity(BCE_Sensitivity* out) {
+    if (!out) return false;
+    std::memset(out, 0, sizeof(*out));
+    if (mode_ != BCE_Mode::SOLUTION_READY) return false;
+
+    float roll = snap_.roll_rad;
+    float range = snap_.lrf_range_filtered_m;
+
+    // Same nominal as runDispersion(): the bore stays where it points now
+    SolverParams params = buildSolverParams(range);
+    params.launch_angle_rad = zero_angle_rad_ + snap_.pitch_rad;
+
+    SolverSensitivity sens;
+    SolverResult result = solver_.integrateWithSensitivity(params, sens);
+    if (!result.valid) return false;
+
+    populatePartials(result, sens.range, range, roll, true, out->range);
+    populatePartials(result, sens.muzzle_velocity, range, roll, false, out->muzzle_velocity);
+    populatePartials(result, sens.bc, range, roll, false, out->bc);
+    populatePartials(result, sens.crosswind, range, roll, false, out->crosswind);
+    populatePartials(result, sens.headwind, range, roll, false, out->headwind);
+    return true;
+}
+
+void BCE_Engine::populatePartials(const SolverResult& result, const SolverPartials& d,
+                                  float range, float roll, bool along_range,
+                                  BCE_HoldPartials& out) const {
+    // Differentiates populateSolution() term by term; the offsets are
+    // constant and cant is a rotation, so only the solver terms contribute
+    std::memset(&out, 0, sizeof(out));
+    if (!(range > 0.0f)) return;
+
+    float sight_h = has_zero_ ? zero_.sight_height_mm * BCE_MM_TO_M : 0.0f;
+    float zero_range_m = (has_zero_ && zero_.zero_range_m > 0.0f) ? zero_.zero_range_m : range;
+
+    float d_relative_drop = d.drop_m;
+    float d_elev = 0.0f;
+    float d_wind = 0.0f;
+    if (along_range) {
+        float sight_line_drop = sight_h - (sight_h / zero_range_m) * range;
+        float relative_drop = result.drop_at_target_m - sight_line_drop;
+        d_relative_drop += sight_h / zero_range_m;
+        d_elev = (relative_drop / (range * range)) * BCE_RAD_TO_MOA;
+        d_wind = (result.windage_at_target_m / (range * range)) * BCE_RAD_TO_MOA;
+    }
+    d_elev -= (d_relative_drop / range) * BCE_RAD_TO_MOA;
+    d_wind -= (d.windage_m / range) * BCE_RAD_TO_MOA;
+
+    // Coriolis scales with TOF, spin drift with TOF^1.83 / range
+    if (result.tof_s > 0.0f) {
+        float d_log_tof = d.tof_s / result.tof_s;
+        d_elev += result.coriolis_elev_moa * d_log_tof;
+        d_wind += result.coriolis_wind_moa * d_log_tof +
+                  result.spin_drift_moa * (1.83f * d_log_tof - (along_range ? 1.0f / range : 0.0f));
+    }
+
+    float cant_elev, cant_wind;
+    CantCorrection::apply(roll, d_elev, cant_elev, cant_wind);
+    out.elevation_moa = cant_elev;
+    out.windage_moa = d_wind + cant_wind;
+    out.tof_ms = d.tof_s * 1000.0f;
+    out.velocity_ms = d.velocity_ms;
+}
+
+// ---------------------------------------------------------------------------
+// Internal: launch-angle cache
+// ---------------------------------------------------------------------------
+
+bool BCE_Engine::solveFromAngleCache(const SolverParams& params, const SolutionCacheKey& key,
+                                     SolverResult& result) {
+    if (!angle_cache_valid_ || !trajectoryShapeMatches(key, angle_cache_key_)) {
+        angle_cache_.reset();
+        angle_cache_key_ = key;
+        angle_cache_valid_ = true;
+    } else if (params.target_range_m > angle_cache_.getExtent()) {
+        widenHorizon();
+    }
+
+    float horizon = tabulationHorizon(params.target_range_m);
+    bool ok = angle_cache_.sample(solver_, params, horizon, result);
+
+    // Grid-angle integrations reuse the solver table
+    uint32_t fills = angle_cache_.getLastFills();
+    if (fills > 0) {
+        trajectory_valid_ = false;
+        solver_diag_.trajectory_extent_m = static_cast<uint32_t>(angle_cache_.getExtent());
+        solver_diag_.angle_cache_fills += fills;
+        solver_diag_.solution_cache_misses++;
+    } else if (ok) {
+        solver_diag_.angle_cache_hits++;
+    }
+    return ok && result.valid;
+}
+
+// ---------------------------------------------------------------------------
+// Profile database
+// ---------------------------------------------------------------------------
+
+bool BCE_Engine::setProfileDb(const void* data, size_t size) {
+    if (!data) {
+        profile_db_.close();
+        return true;
+    }
+    return profile_db_.open(data, size);
+}
+
+bool BCE_Engine::selectProfile(const char* cartridge, const char* gun) {
+    if (!cartridge && !gun) return false;
+    const ProfileCartridge* c = nullptr;
+    const ProfileGun* g = nullptr;
+    if (cartridge && !(c = profile_db_.findCartridge(cartridge))) return false;
+    if (gun && !(g = profile_db_.findGun(gun))) return false;
+
+    // Start from the current profile so a cartridge swap keeps the rifle
+    BulletProfile bullet = bullet_;
+    IntegratorTuning tuning = integrator_;
+    if (c) {
+        ProfileDb::applyCartridge(*c, bullet);
+        if (ProfileDb::applyIntegrator(*c, tuning)) setIntegratorTuning(&tuning);
+    }
+    if (g) {
+        ZeroConfig zero = zero_;
+        ProfileDb::applyGun(*g, bullet, zero);
+        setZeroConfig(&zero);
+    }
+    setBulletProfile(&bullet);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Memory profile
+// ---------------------------------------------------------------------------
+
+#if BCE_ENGINE_RAM_BUDGET_BYTES > 0
+static_assert(sizeof(BCE_Engine) <= BCE_ENGINE_RAM_BUDGET_BYTES,
+              "BCE_Engine exceeds BCE_ENGINE_RAM_BUDGET_BYTES; lower BCE_MAX_RANGE_M, "
+              "enable BCE_TRAJ_TABLE_COMPACT or shrink the angle cache / recorder");
+#endif
+
+void BCE_Engine::getMemoryReport(BCE_MemoryReport* out) {
+    if (!out) return;
+    const size_t table = BallisticSolver::getTableBytes();
+    const size_t sensors = sizeof(mag_) + sizeof(mag_fit_) + sizeof(atmo_) + sizeof(wind_);
+    const size_t dispersion = sizeof(dispersion_sampler_) + sizeof(dispersion_);
+    const size_t subsystems = sizeof(solver_) + sizeof(angle_cache_) + sizeof(ahrs_) + sensors +
+                              dispersion + sizeof(recorder_);
+
+    out->instance_bytes = static_cast<uint32_t>(sizeof(BCE_Engine));
+    out->trajectory_table_bytes = static_cast<uint32_t>(table);
+    out->solver_bytes = static_cast<uint32_t>(sizeof(solver_) - table);
+    out->angle_cache_bytes = static_cast<uint32_t>(sizeof(angle_cache_));
+    out->ahrs_bytes = static_cast<uint32_t>(sizeof(ahrs_));
+    out->sensor_bytes = static_cast<uint32_t>(sensors);
+    out->dispersion_bytes = static_cast<uint32_t>(dispersion);
+    out->recorder_bytes = static_cast<uint32_t>(sizeof(recorder_));
+    out->engine_bytes = static_cast<uint32_t>(sizeof(BCE_Engine) - subsystems);
+    out->shared_bytes = static_cast<uint32_t>(DragModelLookup::getCustomCurveBytes());
+    out->max_range_m = BCE_MAX_RANGE_M;
+}
+
+// ---------------------------------------------------------------------------
+// Persistent state
+// ---------------------------------------------------------------------------
+
+size_t BCE_Engine::getStateSize(bool include_trajectory) {
+    size_t size = sizeof(StateHeader) + sizeof(StateZero);
+    if (include_trajectory) {
+        size += sizeof(StateTrajectory) +
+                (BCE_MAX_RANGE_M / BCE_STATE_TRAJ_STEP_M + 1) * sizeof(TrajectoryPoint);
+    }
+    return size;
+}
+
+size_t BCE_Engine::saveState(void* buf, size_t size, bool include_trajectory) const {
+    if (!buf || !zero_solved_ || zero_dirty_) return 0;
+
+    // Only the trajectory of the current solve is worth restoring
+    const int last = solver_.getMaxValidRange() / BCE_STATE_TRAJ_STEP_M;
+    include_trajectory = include_trajectory && trajectory_valid_ && last >= 1;
+
+    size_t total = sizeof(StateHeader) + sizeof(StateZero);
+    if (include_trajectory) {
+        total += sizeof(StateTrajectory) + static_cast<size_t>(last + 1) * sizeof(TrajectoryPoint);
+    }
+    if (size < total) return 0;
+
+    uint8_t* out = static_cast<uint8_t*>(buf);
+    size_t offset = sizeof(StateHeader);
+
+    StateZero zero;
+    std::memset(&zero, 0, sizeof(zero));
+    zero.fingerprint = zero_fingerprint_;
+    zero.zero_angle_rad = zero_angle_rad_;
+    std::memcpy(out + offset, &zero, sizeof(zero));
+    offset += sizeof(zero);
+
+    if (include_trajectory) {
+        StateTrajectory traj;
+        std::memset(&traj, 0, sizeof(traj));
+        traj.key = trajectory_key_;
+        traj.extent_m = trajectory_extent_m_;
+        traj.node_step_m = BCE_STATE_TRAJ_STEP_M;
+        traj.last = last;
+        std::memcpy(out + offset, &traj, sizeof(traj));
+        offset += sizeof(traj);
+
+        for (int i = 0; i <= last; ++i) {
+            TrajectoryPoint tp;
+            solver_.getPointAtRange(static_cast<float>(i * BCE_STATE_TRAJ_STEP_M), tp);
+            std::memcpy(out + offset, &tp, sizeof(tp));
+            offset += sizeof(tp);
+        }
+    }
+
+    StateHeader header;
+    header.magic = BCE_STATE_MAGIC;
+    header.version = BCE_STATE_VERSION;
+    header.layout = static_cast<uint32_t>(sizeof(StateZero) | (sizeof(StateTrajectory) << 16));
+    header.flags = include_trajectory ? STATE_HAS_TRAJECTORY : 0u;
+    header.payload_bytes = static_cast<uint32_t>(total - sizeof(StateHeader));
+    header.crc32 = bceCrc32(out + sizeof(StateHeader), header.payload_bytes);
+    std::memcpy(out, &header, sizeof(header));
+    return total;
+}
+
+bool BCE_Engine::restoreState(const void* buf, size_t size) {
+    if (!buf || size < sizeof(StateHeader) + sizeof(StateZero)) return false;
+
+    const uint8_t* in = static_cast<const uint8_t*>(buf);
+    StateHeader header;
+    std::memcpy(&header, in, sizeof(header));
+    if (header.magic != BCE_STATE_MAGIC || header.version != BCE_STATE_VERSION ||
+        header.layout != static_cast<uint32_t>(sizeof(StateZero) | (sizeof(StateTrajectory) << 16)) ||
+        header.payload_bytes > size - sizeof(StateHeader) ||
+        header.payload_bytes < sizeof(StateZero) ||
+        bceCrc32(in + sizeof(StateHeader), header.payload_bytes) != header.crc32) {
+        return false;
+    }
+
+    size_t offset = sizeof(StateHeader);
+    StateZero zero;
+    std::memcpy(&zero, in + offset, sizeof(zero));
+    offset += sizeof(zero);
+    if (!std::isfinite(zero.zero_angle_rad)) return false;
+
+    StateTrajectory traj;
+    std::memset(&traj, 0, sizeof(traj));
+    const uint8_t* nodes = nullptr;
+    if (header.flags & STATE_HAS_TRAJECTORY) {
+        if (header.payload_bytes < sizeof(StateZero) + sizeof(StateTrajectory)) return false;
+        std::memcpy(&traj, in + offset, sizeof(traj));
+        offset += sizeof(traj);
+        size_t node_bytes = header.payload_bytes - sizeof(StateZero) - sizeof(StateTrajectory);
+        if (traj.node_step_m < 1 || traj.last < 1 ||
+            static_cast<int64_t>(traj.last) * traj.node_step_m > BCE_MAX_RANGE_M ||
+            node_bytes != static_cast<size_t>(traj.last + 1) * sizeof(TrajectoryPoint)) {
+            return false;
+        }
+        nodes = in + offset;
+    }
+
+    // The blob is sound: seed the zero and, if present, the trajectory table.
+    // Both are adopted only once a solve finds matching inputs.
+    restored_zero_fingerprint_ = zero.fingerprint;
+    restored_zero_angle_rad_ = zero.zero_angle_rad;
+    has_restored_zero_ = true;
+    zero_angle_rad_ = zero.zero_angle_rad;
+    zero_dirty_ = true;
+    event_solve_requested_ = true;
+
+    if (nodes) {
+        trajectory_valid_ = solver_.loadTrajectory(nodes, traj.last, traj.node_step_m);
+        trajectory_key_ = traj.key;
+        trajectory_extent_m_ = traj.extent_m;
+        cache_valid_ = false;
+    }
+    return true;
+}
+
+bool BCE_Engine::zeroFingerprintMatches(const ZeroFingerprint& a, const ZeroFingerprint& b) {
+    // Only what shapes the zero: wind and azimuth follow the heading and never
+    // trigger a live recompute, and atmosphere counts once it moves as far as
+    // the AtmosphereModel recompute thresholds
+    const SolutionCacheKey& ka = a.key;
+    const SolutionCacheKey& kb = b.key;
+    return ka.range_q == kb.range_q &&
+           a.sight_height_m == b.sight_height_m &&
+           std::fabs(ka.bc - kb.bc) < BCE_ZERO_RECOMPUTE_BC_FACTOR_DELTA * kb.bc &&
+           std::fabs(ka.air_density - kb.air_density) < BCE_ZERO_RECOMPUTE_DENSITY_DELTA &&
+           std::fabs(ka.speed_of_sound - kb.speed_of_sound) < BCE_ZERO_RECOMPUTE_SOS_DELTA &&
+           ka.muzzle_velocity_ms == kb.muzzle_velocity_ms &&
+           ka.bullet_mass_kg == kb.bullet_mass_kg &&
+           ka.drag_reference_scale == kb.drag_reference_scale &&
+           ka.coriolis_lat_rad == kb.coriolis_lat_rad &&
+           ka.twist_rate_inches == kb.twist_rate_inches &&
+           ka.caliber_m == kb.caliber_m &&
+           ka.drag_model == kb.drag_model &&
+           ka.drag_curve_id == kb.drag_curve_id &&
+           ka.bc_band_id == kb.bc_band_id &&
+           integratorTuningMatches(ka.integrator, kb.integrator) &&
+           ka.coriolis_enabled == kb.coriolis_enabled &&
+           ka.spin_drift_enabled == kb.spin_drift_enabled;
+}
+
+// ---------------------------------------------------------------------------
+// Internal: convert a trajectory result into MOA holds
+// ---------------------------------------------------------------------------
+
+float BCE_Engine::sightLineHoldMoa(float drop_m, float range) const {
+    // The drop relative to the zero'd sight line:
+    // At zero range, the bullet hits the POA. At other ranges,
+    // the drop from the sight line must be corrected.
+    // Sight line at range R: -sight_height * (R / zero_range) + sight_height
+    // Simplification: the zero angle already accounts for this.
+    // The solver gives drop from bore line. We need drop from sight line.
+
+    float sight_h = has_zero_ ? zero_.sight_height_mm * BCE_MM_TO_M : 0.0f;
+    float zero_range_m = (has_zero_ && zero_.zero_range_m > 0.0f) ? zero_.zero_range_m : range;
+    float sight_line_drop = sight_h - (sight_h / zero_range_m) * range;
+
+    // Drop relative to sight line, as an angular adjustment in MOA
+    float relative_drop = drop_m - sight_line_drop;
+    return -(relative_drop / range) * BCE_RAD_TO_MOA;
+}
+
+void BCE_Engine::populateSolution(const SolverResult& result, float range, float roll,
+                                  float heading_true, FiringSolution& out,
+                                  const LeadSolution* lead) const {
     // Convert drop/windage to MOA holds
-    float range = lrf_range_m_;
     float drop_moa = 0.0f;
     float wind_from_wind_moa = 0.0f;
 
     if (range > 0.0f) {
-        // The drop relative to the zero'd sight line:
-        // At zero range, the bullet hits the POA. At other ranges,
-        // the drop from the sight line must be corrected.
-        // Sight line at range R: -sight_height * (R / zero_range) + sight_height
-        // Simplification: the zero angle already accounts for this.
-        // The solver gives drop from bore line. We need drop from sight line.
-
-        float sight_h = has_zero_ ? zero_.sight_height_mm * BCE_MM_TO_M : 0.0f;
-        float zero_range_m = (has_zero_ && zero_.zero_range_m > 0.0f) ? zero_.zero_range_m : range;
-        float sight_line_drop = sight_h - (sight_h / zero_range_m) * range;
-
-        // Drop relative to sight line
-        float relative_drop = result.drop_at_target_m - sight_line_drop;
-
-        // Convert to angular adjustment in MOA
-        drop_moa = -(relative_drop / range) * BCE_RAD_TO_MOA;
+        drop_moa = sightLineHoldMoa(result.drop_at_target_m, range);
         wind_from_wind_moa = -(result.windage_at_target_m / range) * BCE_RAD_TO_MOA;
     }
 
@@ -414,6 +1699,12 @@ void BCE_Engine::computeSolution() {
     drop_moa += result.coriolis_elev_moa;
     float windage_moa = wind_from_wind_moa + windage_earth_spin_moa;
 
+    // Moving-target lead, ahead of cant so it is corrected with the rest
+    const float lead_elevation_moa = lead ? lead->elevation_moa : 0.0f;
+    const float lead_windage_moa = lead ? lead->windage_moa : 0.0f;
+    drop_moa += lead_elevation_moa;
+    windage_moa += lead_windage_moa;
+
     // Add boresight and reticle offsets
     drop_moa += boresight_.vertical_moa + reticle_.vertical_moa;
     windage_moa += windage_offsets_moa;
@@ -426,59 +1717,191 @@ void BCE_Engine::computeSolution() {
     windage_moa += cant_wind;
     const float windage_cant_moa = windage_moa - windage_before_cant_moa;
 
-    // Populate firing solution
-    solution_.solution_mode = static_cast<uint32_t>(BCE_Mode::SOLUTION_READY);
-    solution_.fault_flags = fault_flags_;
-    solution_.defaults_active = diag_flags_;
+    out.hold_elevation_moa = drop_moa;
+    out.hold_windage_moa = windage_moa;
+
+    out.range_m = range;
+    out.horizontal_range_m = result.horizontal_range_m;
+    out.tof_ms = result.tof_s * 1000.0f;
+    out.velocity_at_target_ms = result.velocity_at_target_ms;
+    out.energy_at_target_j = result.energy_at_target_j;
+
+    out.coriolis_windage_moa = result.coriolis_wind_moa;
+    out.coriolis_elevation_moa = result.coriolis_elev_moa;
+    out.spin_drift_moa = result.spin_drift_moa;
+    out.wind_only_windage_moa = wind_from_wind_moa;
+    out.earth_spin_windage_moa = windage_earth_spin_moa;
+    out.offsets_windage_moa = windage_offsets_moa;
+    out.cant_windage_moa = windage_cant_moa;
+
+    out.cant_angle_deg = roll * BCE_RAD_TO_DEG;
+    out.heading_deg_true = heading_true;
+    out.air_density_kgm3 = snap_.atmo.getAirDensity();
+
+    out.lead_elevation_moa = lead_elevation_moa;
+    out.lead_windage_moa = lead_windage_moa;
+    out.lead_range_m = range + (lead ? lead->range_change_m : 0.0f);
+}
 
-    solution_.hold_elevation_moa = drop_moa;
-    solution_.hold_windage_moa = windage_moa;
+// ---------------------------------------------------------------------------
+// Internal: moving-target lead
+// ---------------------------------------------------------------------------
 
-    solution_.range_m = range;
-    solution_.horizontal_range_m = result.horizontal_range_m;
-    solution_.tof_ms = result.tof_s * 1000.0f;
-    solution_.velocity_at_target_ms = result.velocity_at_target_ms;
-    solution_.energy_at_target_j = result.energy_at_target_j;
+bool BCE_Engine::solveLead(const SolverParams& params, const SolutionCacheKey& key,
+                           const SolverResult& result, float heading_true, LeadSolution& out) {
+    // Sample whichever source holds this trajectory: the solver table out
+    // to its extent, else the launch-angle cache out to the horizon it was
+    // built for (same grid angles, so nothing is integrated)
+    const bool from_table = trajectory_valid_ && trajectoryKeyMatches(key, trajectory_key_);
+    float limit = 0.0f;
+    if (from_table) {
+        limit = trajectory_extent_m_;
+        const float tabulated = static_cast<float>(solver_.getMaxValidRange());
+        if (limit > tabulated) limit = tabulated;
+    } else if (angle_cache_enabled_ && angle_cache_valid_ &&
+               trajectoryShapeMatches(key, angle_cache_key_)) {
+        limit = angle_cache_.getExtent();
+    } else {
+        return false;
+    }
 
-    solution_.coriolis_windage_moa = result.coriolis_wind_moa;
-    solution_.coriolis_elevation_moa = result.coriolis_elev_moa;
-    solution_.spin_drift_moa = result.spin_drift_moa;
-    solution_.wind_only_windage_moa = wind_from_wind_moa;
-    solution_.earth_spin_windage_moa = windage_earth_spin_moa;
-    solution_.offsets_windage_moa = windage_offsets_moa;
-    solution_.cant_windage_moa = windage_cant_moa;
+    // Target velocity along the line of sight (+ receding) and across it
+    // (+ moving right)
+    const float bearing = (target_heading_deg_ - heading_true) * BCE_DEG_TO_RAD;
+    const float v_range = target_speed_ms_ * std::cos(bearing);
+    const float v_cross = target_speed_ms_ * std::sin(bearing);
+
+    // Fixed point: the impact range depends on the TOF, the TOF on the
+    // impact range. The map contracts by about v_range / bullet speed.
+    const float base = params.target_range_m;
+    SolverParams p = params;
+    SolverResult impact = result;
+    float impact_range = base;
+    uint32_t iterations = 0;
+    bool clamped = false;
+    bool converged = false;
+    for (uint32_t i = 0; i < BCE_LEAD_MAX_ITERATIONS; ++i) {
+        float next = base + v_range * impact.tof_s;
+        if (next < 1.0f) next = 1.0f;
+        if (next > limit) {
+            next = limit;
+            clamped = true;
+        }
+        p.target_range_m = next;
+        SolverResult sample = {};
+        if (from_table) {
+            sample = solver_.sampleTrajectory(p, next);
+        } else {
+            if (!angle_cache_.sample(solver_, p, limit, sample)) sample.valid = false;
+            // Same slots as the solve, so normally nothing; a fill reuses the table
+            if (angle_cache_.getLastFills() > 0) {
+                trajectory_valid_ = false;
+                solver_diag_.angle_cache_fills += angle_cache_.getLastFills();
+            }
+        }
+        iterations++;
+        if (!sample.valid) break;
 
-    solution_.cant_angle_deg = roll * BCE_RAD_TO_DEG;
-    solution_.heading_deg_true = heading_true;
-    solution_.air_density_kgm3 = atmo_.getAirDensity();
+        converged = std::fabs(sample.tof_s - impact.tof_s) < BCE_LEAD_TOF_TOLERANCE_S;
+        impact = sample;
+        impact_range = next;
+        if (converged) break;
+    }
+    solver_diag_.lead_iterations = iterations;
+
+    // The holds still aim at the last estimate, but the impact point past
+    // the table or an unsettled fixed point is not a trustworthy lead
+    if (clamped || !converged) diag_flags_ |= BCE_Diag::LEAD_UNRESOLVED;
+
+    // Hold for the impact point minus hold for the target now, plus the
+    // angle the target crosses during flight
+    const float lateral_m = v_cross * impact.tof_s;
+    out.elevation_moa = sightLineHoldMoa(impact.drop_at_target_m, impact_range) -
+                        sightLineHoldMoa(result.drop_at_target_m, base);
+    out.windage_moa = (result.windage_at_target_m / base -
+                       impact.windage_at_target_m / impact_range) * BCE_RAD_TO_MOA +
+                      std::atan2(lateral_m, impact_range) * BCE_RAD_TO_MOA;
+    out.range_change_m = impact_range - base;
+    return true;
 }
 
 // ---------------------------------------------------------------------------
 // Internal: recompute zero angle
 // ---------------------------------------------------------------------------
 
+bool BCE_Engine::customCurveLoaded() const {
+    // DragModelLookup falls back to G1 without a curve; solving that silently
+    // would hand back holds for the wrong bullet
+    return bullet_.drag_model != DragModel::CUSTOM || DragModelLookup::getCustomCurveId() != 0;
+}
+
+void BCE_Engine::checkCustomDragCurve() {
+    // The curve is process-wide, so a change made through any handle shows
+    // up here as a fingerprint mismatch rather than through a setter
+    if (has_bullet_ && has_zero_ && bullet_.drag_model == DragModel::CUSTOM &&
+        zero_fingerprint_.key.drag_curve_id != DragModelLookup::getCustomCurveId()) {
+        zero_dirty_ = true;
+    }
+}
+
 void BCE_Engine::recomputeZero() {
     zero_dirty_ = false;
+    zero_solved_ = false;
 
     if (!has_bullet_ || !has_zero_) {
         zero_angle_rad_ = 0.0f;
         return;
     }
 
-    if (zero_.zero_range_m < 1.0f || zero_.zero_range_m > BCE_MAX_RANGE_M) {
+    if (zero_.zero_range_m < 1.0f || zero_.zero_range_m > max_range_m_) {
         fault_flags_ |= BCE_Fault::ZERO_UNSOLVABLE;
         zero_angle_rad_ = 0.0f;
         return;
     }
 
     SolverParams params = buildSolverParams(zero_.zero_range_m);
-    float angle = solver_.solveZeroAngle(params, zero_.zero_range_m);
+    zero_fingerprint_.key = makeCacheKey(params);
+    zero_fingerprint_.sight_height_m = params.sight_height_m;
+
+    // A zero saved by a previous boot for the same inputs needs no solve
+    if (has_restored_zero_ &&
+        zeroFingerprintMatches(zero_fingerprint_, restored_zero_fingerprint_)) {
+        zero_angle_rad_ = restored_zero_angle_rad_;
+        zero_solved_ = true;
+        solver_diag_.zero_iterations = 0;
+        solver_diag_.zero_coarse_iterations = 0;
+        return;
+    }
+
+    // Warm-start from the previous (or restored) zero; atmosphere-driven
+    // recomputes move it by a fraction of a milliradian
+    float angle;
+    if (slice_zero_ready_ && zeroFingerprintMatches(zero_fingerprint_, slice_zero_fingerprint_)) {
+        // Solved by stepSolve() slices
+        slice_zero_ready_ = false;
+        angle = slice_zero_angle_rad_;
+    } else if (slicing_) {
+        solver_.beginZeroSolve(params, zero_.zero_range_m, zero_angle_rad_);
+        slice_zero_fingerprint_ = zero_fingerprint_;
+        slice_zero_ready_ = false;
+        slice_job_ = SliceJob::ZERO;
+        zero_dirty_ = true;
+        return;
+    } else {
+        angle = solver_.solveZeroAngle(params, zero_.zero_range_m, zero_angle_rad_);
+    }
+    solver_diag_.zero_iterations = solver_.getLastZeroIterations();
+    solver_diag_.zero_coarse_iterations = solver_.getLastZeroCoarseIterations();
+#if BCE_ENABLE_PROFILING
+    perf_.zero_iterations = solver_.getLastZeroIterations();
+#endif
 
     if (std::isnan(angle)) {
         fault_flags_ |= BCE_Fault::ZERO_UNSOLVABLE;
         zero_angle_rad_ = 0.0f;
     } else {
         zero_angle_rad_ = angle;
+        zero_solved_ = true;
     }
 }
 
@@ -486,13 +1909,40 @@ void BCE_Engine::recomputeZero() {
 // Internal: build solver parameters
 // ---------------------------------------------------------------------------
 
+float BCE_Engine::tabulationHorizon(float target_range_m) const {
+    if (!(trajectory_horizon_m_ > 0.0f)) {
+        const float horizon = target_range_m + horizon_margin_m_;
+        return (horizon < max_range_m_) ? horizon : max_range_m_;
+    }
+    // Targets past the configured horizon tabulate out to the range limit so
+    // a rising LRF reading does not re-integrate every frame
+    float horizon = (trajectory_horizon_m_ < max_range_m_) ? trajectory_horizon_m_ : max_range_m_;
+    return (target_range_m > horizon) ? max_range_m_ : horizon;
+}
+
+void BCE_Engine::widenHorizon() {
+    if (trajectory_horizon_m_ > 0.0f) return;
+    horizon_margin_m_ *= 2.0f;
+    if (horizon_margin_m_ > max_range_m_) horizon_margin_m_ = max_range_m_;
+}
+
 SolverParams BCE_Engine::buildSolverParams(float range_m) const {
     SolverParams p;
     std::memset(&p, 0, sizeof(p));
 
-    // BC with atmospheric correction
-    p.bc = atmo_.correctBC(bullet_.bc);
+    // BC with atmospheric correction, once per band; bands are carried as
+    // ratios to the primary BC so BC perturbations scale them all
+    p.bc = snap_.atmo.correctBC(bullet_.bc);
     p.drag_model = bullet_.drag_model;
+    if (p.bc > 0.0f) {
+        int bands = (bullet_.bc_band_count < BCE_MAX_BC_BANDS) ? bullet_.bc_band_count
+                                                               : BCE_MAX_BC_BANDS;
+        for (int i = 0; i < bands; ++i) {
+            p.bc_band_velocity_ms[i] = bullet_.bc_bands[i].below_velocity_ms;
+            p.bc_band_ratio[i] = snap_.atmo.correctBC(bullet_.bc_bands[i].bc) / p.bc;
+        }
+        p.bc_band_count = bands;
+    }
 
     // Muzzle velocity adjusted for barrel length
     float base_mv_fps = bullet_.muzzle_velocity_ms * 3.28084f;
@@ -504,16 +1954,22 @@ SolverParams BCE_Engine::buildSolverParams(float range_m) const {
     p.bullet_mass_kg = bullet_.mass_grains * BCE_GRAINS_TO_KG;
     p.sight_height_m = has_zero_ ? zero_.sight_height_mm * BCE_MM_TO_M : 0.0f;
 
-    p.air_density = atmo_.getAirDensity();
-    p.speed_of_sound = atmo_.getSpeedOfSound();
+    p.air_density = snap_.atmo.getAirDensity();
+    p.speed_of_sound = snap_.atmo.getSpeedOfSound();
     p.drag_reference_scale = external_reference_mode_
         ? BCE_EXTERNAL_REFERENCE_DRAG_SCALE
         : BCE_DEFAULT_DRAG_REFERENCE_SCALE;
+    p.integrator = integrator_.method;
+    p.integrator_tolerance_m = integrator_.tolerance_m;
+    p.integrator_step_scale_m = integrator_.step_scale_m;
+    p.integrator_max_step_m = integrator_.max_step_m;
+    p.integrator_transonic_dt_s = integrator_.transonic_dt_s;
+    p.integrator_range_step_m = integrator_.range_step_m;
     p.target_range_m = range_m;
     p.launch_angle_rad = 0.0f; // set by caller
 
     // Wind decomposition
-    float heading = mag_.computeHeading(ahrs_.getYaw());
+    float heading = snap_.heading_true_deg;
     wind_.decompose(heading, p.headwind_ms, p.crosswind_ms);
 
     // Coriolis
@@ -536,3 +1992,108 @@ SolverParams BCE_Engine::buildSolverParams(float range_m) const {
 
     return p;
 }
+
+// ---------------------------------------------------------------------------
+// Internal: solution cache fingerprint
+// ---------------------------------------------------------------------------
+
+namespace {
+int32_t quantize(float value, float step) {
+    return static_cast<int32_t>(std::lround(value / step));
+}
+
+// FNV-1a over the band thresholds and ratios (to 1e-5, so atmosphere-level
+// rounding in the ratios does not churn the key); 0 without bands
+uint32_t bcBandId(const SolverParams& params) {
+    if (params.bc_band_count <= 0) return 0;
+    uint32_t id = 2166136261u;
+    auto mix = [&](int32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            id = (id ^ static_cast<uint8_t>(v >> (8 * i))) * 16777619u;
+        }
+    };
+    mix(params.bc_band_count);
+    for (int i = 0; i < params.bc_band_count && i < BCE_MAX_BC_BANDS; ++i) {
+        mix(quantize(params.bc_band_velocity_ms[i], 1e-3f));
+        mix(quantize(params.bc_band_ratio[i], 1e-5f));
+    }
+    return (id != 0) ? id : 1u;
+}
+} // namespace
+
+BCE_Engine::SolutionCacheKey BCE_Engine::makeCacheKey(const SolverParams& params) {
+    SolutionCacheKey k;
+    std::memset(&k, 0, sizeof(k));
+
+    k.range_q = quantize(params.target_range_m, BCE_SOLUTION_CACHE_RANGE_QUANT_M);
+    k.launch_angle_q = quantize(params.launch_angle_rad, BCE_SOLUTION_CACHE_ANGLE_QUANT_RAD);
+    k.headwind_q = quantize(params.headwind_ms, BCE_SOLUTION_CACHE_WIND_QUANT_MS);
+    k.crosswind_q = quantize(params.crosswind_ms, BCE_SOLUTION_CACHE_WIND_QUANT_MS);
+    k.azimuth_q = params.coriolis_enabled
+        ? quantize(params.azimuth_rad, BCE_SOLUTION_CACHE_AZIMUTH_QUANT_RAD)
+        : 0;
+
+    k.bc = params.bc;
+    k.air_density = params.air_density;
+    k.speed_of_sound = params.speed_of_sound;
+
+    k.muzzle_velocity_ms = params.muzzle_velocity_ms;
+    k.bullet_mass_kg = params.bullet_mass_kg;
+    k.drag_reference_scale = params.drag_reference_scale;
+    k.coriolis_lat_rad = params.coriolis_enabled ? params.coriolis_lat_rad : 0.0f;
+    k.twist_rate_inches = params.spin_drift_enabled ? params.twist_rate_inches : 0.0f;
+    k.caliber_m = params.spin_drift_enabled ? params.caliber_m : 0.0f;
+    k.drag_model = params.drag_model;
+    k.drag_curve_id = (params.drag_model == DragModel::CUSTOM)
+        ? DragModelLookup::getCustomCurveId()
+        : 0;
+    k.bc_band_id = bcBandId(params);
+    k.integrator.method = params.integrator;
+    k.integrator.tolerance_m = params.integrator_tolerance_m;
+    k.integrator.step_scale_m = params.integrator_step_scale_m;
+    k.integrator.max_step_m = params.integrator_max_step_m;
+    k.integrator.transonic_dt_s = params.integrator_transonic_dt_s;
+    k.integrator.range_step_m = params.integrator_range_step_m;
+    k.coriolis_enabled = params.coriolis_enabled;
+    k.spin_drift_enabled = params.spin_drift_enabled;
+    return k;
+}
+
+bool BCE_Engine::cacheKeyMatches(const SolutionCacheKey& a, const SolutionCacheKey& b) {
+    return a.range_q == b.range_q && trajectoryKeyMatches(a, b);
+}
+
+bool BCE_Engine::trajectoryKeyMatches(const SolutionCacheKey& a, const SolutionCacheKey& b) {
+    return a.launch_angle_q == b.launch_angle_q && trajectoryShapeMatches(a, b);
+}
+
+bool BCE_Engine::dispersionKeyMatches(const SolutionCacheKey& a, const SolutionCacheKey& b) {
+    const float angle = static_cast<float>(a.launch_angle_q - b.launch_angle_q) *
+                        BCE_SOLUTION_CACHE_ANGLE_QUANT_RAD;
+    const float range = static_cast<float>(a.range_q - b.range_q) * BCE_SOLUTION_CACHE_RANGE_QUANT_M;
+    const float range_tol = static_cast<float>(b.range_q) * BCE_SOLUTION_CACHE_RANGE_QUANT_M *
+                            BCE_DISPERSION_RESTART_RANGE_FRACTION;
+    return std::fabs(angle) <= BCE_DISPERSION_RESTART_ANGLE_RAD && std::fabs(range) <= range_tol &&
+           trajectoryShapeMatches(a, b);
+}
+
+bool BCE_Engine::trajectoryShapeMatches(const SolutionCacheKey& a, const SolutionCacheKey& b) {
+    return a.headwind_q == b.headwind_q &&
+           a.crosswind_q == b.crosswind_q &&
+           a.azimuth_q == b.azimuth_q &&
+           std::fabs(a.bc - b.bc) < BCE_SOLUTION_CACHE_BC_DELTA &&
+           std::fabs(a.air_density - b.air_density) < BCE_SOLUTION_CACHE_DENSITY_DELTA &&
+           std::fabs(a.speed_of_sound - b.speed_of_sound) < BCE_SOLUTION_CACHE_SOS_DELTA &&
+           a.muzzle_velocity_ms == b.muzzle_velocity_ms &&
+           a.bullet_mass_kg == b.bullet_mass_kg &&
+           a.drag_reference_scale == b.drag_reference_scale &&
+           a.coriolis_lat_rad == b.coriolis_lat_rad &&
+           a.twist_rate_inches == b.twist_rate_inches &&
+           a.caliber_m == b.caliber_m &&
+           a.drag_model == b.drag_model &&
+           a.drag_curve_id == b.drag_curve_id &&
+           a.bc_band_id == b.bc_band_id &&
+           integratorTuningMatches(a.integrator, b.integrator) &&
+           a.coriolis_enabled == b.coriolis_enabled &&
+           a.spin_drift_enabled == b.spin_drift_enabled;
+}
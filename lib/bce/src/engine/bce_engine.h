@@ -7,6 +7,23 @@
  * Owns all module instances (AHRS, atmosphere, solver, corrections) as
  * static objects. Implements the state machine (IDLE / SOLUTION_READY / FAULT)
  * and populates the FiringSolution structure.
+ *
+ * Split-pipeline mode divides the engine between two threads. update() owns
+ * the AHRS, magnetometer, atmosphere and LRF state. serviceSolver(),
+ * computeHoldTable(), runDispersion() and getSensitivity() own everything
+ * else. Only the IngestSnapshot slot and the published FiringSolution cross
+ * between them. Configuration setters are not synchronized and must be
+ * called while neither side is running.
+ *
+ * stepSolve() is the time-sliced serviceSolver(): it evaluates the snapshot
+ * until the zero search or trajectory integration would block, hands that
+ * to the solver as a resumable job, and evaluates again once the job is done.
+ *
+ * updateIMU(), updateBaro() and updateLRF() ingest one sensor each and only
+ * evaluate (or, split, publish a snapshot) when the event can change the
+ * solution: an LRF reading, an atmosphere change, a configuration change,
+ * an orientation move past the BCE_EVENT_* thresholds, or a flip of a
+ * fault-relevant flag. update() always evaluates.
  */
 
 #pragma once
@@ -15,28 +32,58 @@
 #include "bce/bce_config.h"
 #include "../ahrs/ahrs_manager.h"
 #include "../mag/mag_calibration.h"
+#include "../mag/mag_ellipsoid_fit.h"
 #include "../atmo/atmosphere.h"
 #include "../solver/solver.h"
+#include "../solver/angle_cache.h"
 #include "../corrections/wind.h"
 #include "../corrections/cant.h"
+#include "../dispersion/dispersion.h"
+#include "../recorder/frame_recorder.h"
+#include "../profile/profile_db.h"
+#include "bce_perf.h"
+#include "bce_seqlock.h"
 
 class BCE_Engine {
 public:
+    ~BCE_Engine() {
+        if (split_pipeline_) split_engines_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
     void init();
 
     // --- Primary update ---
     void update(const SensorFrame* frame);
+    void updateIMUBurst(const ImuSample* samples, int count);
+
+    // --- Event-driven ingestion ---
+    void updateIMU(const ImuSample* sample, const float mag[3]);
+    void updateBaro(uint64_t timestamp_us, float pressure_pa, float temperature_c, float humidity);
+    void updateLRF(uint64_t timestamp_us, float range_m, float confidence);
+
+    // --- Split pipeline ---
+    void setSplitPipeline(bool enabled);
+    bool isSplitPipeline() const { return split_pipeline_; }
+    /** True while any engine in the process runs split (the custom drag curve is shared). */
+    static bool anySplitPipeline() { return split_engines_.load(std::memory_order_acquire) > 0; }
+    bool serviceSolver();
+    bool stepSolve(uint32_t budget_us);
 
     // --- Manual inputs ---
     void setBulletProfile(const BulletProfile* profile);
     void setZeroConfig(const ZeroConfig* config);
     void setWindManual(float speed_ms, float heading_deg);
+    void setTargetMotion(float speed_ms, float heading_deg);
     void setLatitude(float latitude_deg);
     void setDefaultOverrides(const BCE_DefaultOverrides* defaults);
 
     // --- Calibration ---
     void setIMUBias(const float accel_bias[3], const float gyro_bias[3]);
     void setMagCalibration(const float hard_iron[3], const float soft_iron[9]);
+    void startMagCalibration();
+    void cancelMagCalibration();
+    void getMagCalibrationStatus(BCE_MagCalStatus* out) const;
+    bool commitMagCalibration();
     void setBoresightOffset(float vertical_moa, float horizontal_moa);
     void setReticleOffset(float vertical_moa, float horizontal_moa);
     void calibrateBaro();
@@ -44,17 +91,167 @@ public:
     void setAHRSAlgorithm(AHRS_Algorithm algo);
     void setMagDeclination(float declination_deg);
     void setExternalReferenceMode(bool enabled);
+    void setTrajectoryHorizon(float horizon_m);
+    void setMaxRange(float max_range_m);
+    float getMaxRange() const { return max_range_m_; }
+    void setAngleCache(bool enabled);
+    void setIntegrator(IntegratorMethod method, float tolerance_m);
+    void setIntegratorTuning(const IntegratorTuning* tuning);
+    const IntegratorTuning& getIntegratorTuning() const { return integrator_; }
 
     // --- Output ---
-    void getSolution(FiringSolution* out) const;
-    BCE_Mode getMode() const { return mode_; }
-    uint32_t getFaultFlags() const { return fault_flags_; }
-    uint32_t getDiagFlags() const { return diag_flags_; }
+    uint32_t getSolution(FiringSolution* out) const;
+    uint32_t getSolutionGeneration() const { return published_.generation(); }
+    void setSolutionCallback(BCE_SolutionCallback fn, void* user, float epsilon_moa);
+    // Split, read from the published solution: the solver thread owns the fields
+    BCE_Mode getMode() const;
+    uint32_t getFaultFlags() const;
+    uint32_t getDiagFlags() const;
+    void getSolverDiagnostics(BCE_SolverDiagnostics* out) const;
+    void getPerfStats(BCE_PerfStats* out) const;
+    int computeHoldTable(const float* ranges, int count, FiringSolution* out);
+    bool getTrajectoryView(const TrajectoryPoint** points, int* count, uint32_t* generation) const;
+
+    // --- Input recorder ---
+    void setRecorder(bool enabled);
+    size_t readRecorder(uint8_t* out, size_t size) { return recorder_.read(out, size); }
+    uint32_t getRecorderDropped() const { return recorder_.getDropped(); }
+
+    // --- Profile database ---
+    bool setProfileDb(const void* data, size_t size);
+    bool selectProfile(const char* cartridge, const char* gun);
+
+    // --- Memory profile ---
+    static void getMemoryReport(BCE_MemoryReport* out);
+
+    // --- Persistent state ---
+    static size_t getStateSize(bool include_trajectory);
+    size_t saveState(void* buf, size_t size, bool include_trajectory) const;
+    bool restoreState(const void* buf, size_t size);
+
+    // --- Dispersion (Monte Carlo) ---
+    void setUncertainty(const BCE_UncertaintyConfig* config);
+    uint32_t runDispersion(int samples);
+    void getDispersion(BCE_DispersionStats* out) const;
+
+    // --- Sensitivities ---
+    bool getSensitivity(BCE_Sensitivity* out);
 
 private:
+    /**
+     * Quantized fingerprint of the SolverParams behind the cached result.
+     * Geometry/wind inputs are bucketed; atmosphere-derived inputs are kept
+     * as floats and compared with hysteresis thresholds. Every field except
+     * range_q shapes the trajectory itself; every field except range_q and
+     * launch_angle_q is shared by all entries of the launch-angle cache.
+     */
+    struct SolutionCacheKey {
+        int32_t range_q;
+        int32_t launch_angle_q;
+        int32_t headwind_q;
+        int32_t crosswind_q;
+        int32_t azimuth_q;
+
+        float bc;
+        float air_density;
+        float speed_of_sound;
+
+        float muzzle_velocity_ms;
+        float bullet_mass_kg;
+        float drag_reference_scale;
+        float coriolis_lat_rad;
+        float twist_rate_inches;
+        float caliber_m;
+        DragModel drag_model;
+        uint32_t drag_curve_id;  // custom curve content hash, 0 for G1–G8
+        uint32_t bc_band_id;     // velocity-band hash, 0 for a single BC
+        IntegratorTuning integrator;
+        bool coriolis_enabled;
+        bool spin_drift_enabled;
+    };
+
+    /**
+     * The inputs a zero angle was solved for. Compared by
+     * zeroFingerprintMatches(), which ignores the heading-driven fields.
+     */
+    struct ZeroFingerprint {
+        SolutionCacheKey key;  // zero-range solve parameters
+        float sight_height_m;
+    };
+
+    /**
+     * Saved-state blob layout: StateHeader, then StateZero, then optionally
+     * StateTrajectory followed by its last + 1 records. The CRC covers
+     * everything after the header.
+     */
+    struct StateHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t layout;        // sizeof fingerprint of the payload structs
+        uint32_t flags;         // STATE_HAS_TRAJECTORY
+        uint32_t payload_bytes;
+        uint32_t crc32;
+    };
+    struct StateZero {
+        ZeroFingerprint fingerprint;
+        float zero_angle_rad;
+    };
+    struct StateTrajectory {
+        SolutionCacheKey key;
+        float extent_m;
+        int32_t node_step_m;
+        int32_t last;
+    };
+    static constexpr uint32_t STATE_HAS_TRAJECTORY = 1u << 0;
+
+    /**
+     * Everything the solver side reads from the ingestion side, captured at
+     * the end of update(). The atmosphere is copied whole so the BC
+     * correction is evaluated exactly as on the live object.
+     */
+    struct IngestSnapshot {
+        Atmosphere atmo;
+        uint64_t timestamp_us;
+        float pitch_rad;
+        float roll_rad;
+        float heading_true_deg;
+        float lrf_range_m;
+        float lrf_range_filtered_m;
+        float lrf_confidence;
+        uint32_t zero_hint_count; // bumps when the atmosphere moves the zero
+        bool has_range;
+        bool lrf_stale;           // range went stale on this frame
+        bool ahrs_stable;
+        bool mag_disturbed;
+        bool sensor_invalid;
+    };
+
+    /** Moving-target lead added to the live holds by populateSolution(). */
+    struct LeadSolution {
+        float elevation_moa;
+        float windage_moa;
+        float range_change_m; // impact range minus the solved range
+    };
+
+    /** Snapshot fields an event is compared against to decide whether it solves. */
+    struct EventReference {
+        float pitch_rad;
+        float roll_rad;
+        float heading_true_deg;
+        uint32_t atmo_generation;
+        uint32_t zero_hint_count;
+        uint32_t drag_curve_id;  // process-wide custom curve, changed outside any setter
+        bool has_range;
+        bool ahrs_stable;
+        bool mag_disturbed;
+        bool sensor_invalid;
+        bool atmo_invalid;
+    };
+
     // Subsystem instances (all static, no heap)
     AHRSManager ahrs_;
     MagCalibration mag_;
+    MagEllipsoidFit mag_fit_;
     Atmosphere atmo_;
     BallisticSolver solver_;
     WindCorrection wind_;
@@ -64,8 +261,47 @@ private:
     uint32_t fault_flags_ = 0;
     uint32_t diag_flags_ = 0;
 
-    // Latest firing solution
+    // Latest firing solution (solver side) and its published copy; the
+    // generation only advances when the published contents change
     FiringSolution solution_;
+    FiringSolution last_published_;
+    DoubleBufferedSeqLock<FiringSolution> published_;
+
+    // Solution callback — publishSolution() fires it when the published
+    // solution moved by more than the epsilon since the last notification
+    BCE_SolutionCallback solution_callback_ = nullptr;
+    void* solution_callback_user_ = nullptr;
+    float solution_callback_epsilon_moa_ = 0.0f;
+    FiringSolution notified_;
+
+    // Split pipeline — update() stores snapshots into snapshot_slot_, the
+    // solver side copies the newest one into snap_ before evaluating. In
+    // combined mode update() writes snap_ directly.
+    bool split_pipeline_ = false;
+    static std::atomic<int> split_engines_; // engines with split_pipeline_ set
+    IngestSnapshot snap_;
+    SeqLock<IngestSnapshot> snapshot_slot_;
+    uint32_t solved_snapshot_version_ = 0;
+    uint32_t zero_hint_count_ = 0; // ingestion side
+    uint32_t zero_hint_seen_ = 0;  // solver side
+
+    // Event-driven ingestion — the last snapshot handed to the solver, and
+    // whether a configuration change forces the next event to solve
+    EventReference event_ref_;
+    bool event_solve_requested_ = true;
+
+    // Time-sliced solve — while slicing_, recomputeZero() and
+    // computeSolution() start a solver job instead of integrating and
+    // return; stepSolve() advances the job and re-evaluates snap_ once it
+    // finishes, when the prepared zero or trajectory is picked up
+    enum class SliceJob : uint8_t { NONE, ZERO, TRAJECTORY };
+    bool slicing_ = false;
+    bool step_pending_ = false;          // snap_ not yet solved by stepSolve()
+    SliceJob slice_job_ = SliceJob::NONE;
+    ZeroFingerprint slice_zero_fingerprint_; // inputs of the zero job
+    float slice_zero_angle_rad_ = 0.0f;
+    bool slice_zero_ready_ = false;      // finished zero job awaiting adoption
+    bool slice_fresh_trajectory_ = false; // table just integrated by a job
 
     // Bullet profile
     BulletProfile bullet_;
@@ -76,14 +312,27 @@ private:
     bool has_zero_ = false;
     float zero_angle_rad_ = 0.0f;
     bool zero_dirty_ = true; // needs recomputation
+    bool zero_solved_ = false; // last recompute produced a valid angle
+    ZeroFingerprint zero_fingerprint_; // inputs behind zero_angle_rad_
+
+    // Zero restored by restoreState() — adopted by recomputeZero() while the
+    // fingerprint still matches, otherwise only used as the warm start
+    ZeroFingerprint restored_zero_fingerprint_;
+    float restored_zero_angle_rad_ = 0.0f;
+    bool has_restored_zero_ = false;
 
     // LRF state
     float lrf_range_m_ = 0.0f;
     float lrf_range_filtered_m_ = 0.0f; // IIR filtered range
     uint64_t lrf_timestamp_us_ = 0;
+    float lrf_confidence_ = 0.0f; // 0 = not provided
     bool has_range_ = false;
     Quaternion lrf_quaternion_; // quaternion snapshot at LRF receipt
 
+    // Target motion (BCE_SetTargetMotion); speed 0 = stationary
+    float target_speed_ms_ = 0.0f;
+    float target_heading_deg_ = 0.0f;
+
     // Latitude
     float latitude_deg_ = 0.0f;
     bool has_latitude_ = false;
@@ -99,6 +348,12 @@ private:
     // Last gyro reading for calibration capture
     float last_gyro_[3] = {0, 0, 0};
 
+    // Streaming magnetometer fit. ingestIMU() is its only writer and
+    // publishes the fit state after each reading it uses; status and commit
+    // read the published copy, so they may run on another core.
+    std::atomic<bool> mag_fit_active_{false};
+    SeqLock<MagEllipsoidFit::State> mag_fit_published_;
+
     // Internal timestamps for dt computation
     uint64_t last_imu_timestamp_us_ = 0;
     bool first_update_ = true;
@@ -109,9 +364,110 @@ private:
     // Optional solver calibration mode for external-reference alignment
     bool external_reference_mode_ = false;
 
+    // Trajectory integrator selection
+    IntegratorTuning integrator_ = {}; // zero fields = bce_config.h defaults
+
+    // Solution cache — last valid SolverResult and the inputs it came from
+    SolutionCacheKey cache_key_;
+    SolverResult cached_result_;
+    bool cache_valid_ = false;
+    BCE_SolverDiagnostics solver_diag_;
+
+    // Trajectory-valid mode — solver_ table holds the trajectory for
+    // trajectory_key_ out to trajectory_extent_m_, so range-only changes are
+    // answered by sampling the table instead of re-integrating
+    SolutionCacheKey trajectory_key_;
+    bool trajectory_valid_ = false;
+    float trajectory_extent_m_ = 0.0f;
+    float trajectory_horizon_m_ = 0.0f;                      // ≤ 0 = automatic
+    float horizon_margin_m_ = BCE_TRAJ_HORIZON_MARGIN_M;     // automatic: past the target
+    float max_range_m_ = BCE_MAX_RANGE_M; // hard limit on ranges, zero and tabulation
+
+    // Launch-angle cache — coarse trajectories on a launch-angle grid for
+    // angle_cache_key_, so bore tilt is interpolated instead of integrated
+    LaunchAngleCache angle_cache_;
+    SolutionCacheKey angle_cache_key_;
+    bool angle_cache_enabled_ = false;
+    bool angle_cache_valid_ = false;
+
+    // Dispersion — statistics accumulate for the solution behind
+    // dispersion_key_ and restart once the nominal inputs move past the
+    // BCE_DISPERSION_RESTART_* tolerances
+    BCE_UncertaintyConfig uncertainty_;
+    DispersionSampler dispersion_sampler_;
+    DispersionAccumulator dispersion_;
+    SolutionCacheKey dispersion_key_;
+    bool dispersion_valid_ = false;
+    float dispersion_nominal_elev_moa_ = 0.0f;
+    float dispersion_nominal_wind_moa_ = 0.0f;
+    float dispersion_target_radius_moa_ = 0.0f;
+
+    // Input recorder — update() appends every frame while enabled; drained
+    // through readRecorder() from any one context
+    FrameRecorder recorder_;
+    ProfileDb profile_db_;
+
+#if BCE_ENABLE_PROFILING
+    // Per-frame instrumentation (compiled out unless BCE_ENABLE_PROFILING)
+    BCE_PerfStats perf_;
+    uint32_t perf_frame_start_ = 0;
+    uint32_t perf_steps_base_ = 0;
+    uint32_t perf_lookups_base_ = 0;
+    uint32_t perf_unstaged_ticks_ = 0; // sink for scopes outside any stage
+
+    void beginPerfFrame();
+    void endPerfFrame();
+#endif
+
     // --- Internal methods ---
-    void evaluateState(uint64_t now_us);
+    float imuStepDt(uint64_t now_us); // AHRS step since the last IMU sample
+    // Steps 1–3 of update(), one sensor each
+    void ingestIMU(const ImuSample& sample, const float* mag);
+    void ingestBaro(float pressure_pa, float temperature_c, float humidity);
+    void ingestLRF(uint64_t timestamp_us, float range_m, float confidence);
+    /** Steps 4–7 of update(); an event skips them unless eventDue(). */
+    void finishUpdate(uint64_t now_us, bool event = false);
+    bool eventDue(const IngestSnapshot& snap) const;
+    void captureSnapshot(uint64_t now_us, IngestSnapshot& snap);
+    void publishSolution(bool pending = false);
+    bool solutionChangeNotable(const FiringSolution& sol) const;
+    void finishSliceJob();
+    void evaluateState();
     void computeSolution();
+    void populateSolution(const SolverResult& result, float range, float roll,
+                          float heading_true, FiringSolution& out,
+                          const LeadSolution* lead = nullptr) const;
+    /** Elevation hold (MOA) for a bore-line drop at range, against the zeroed sight line. */
+    float sightLineHoldMoa(float drop_m, float range) const;
+    /**
+     * Lead for the moving target by fixed-point iteration over the table (or
+     * angle cache) result was sampled from; never integrates.
+     * @return false if neither still holds the trajectory of key
+     */
+    bool solveLead(const SolverParams& params, const SolutionCacheKey& key,
+                   const SolverResult& result, float heading_true, LeadSolution& out);
+    /** Hold partials from solver partials; along_range adds populateSolution()'s 1/R terms. */
+    void populatePartials(const SolverResult& result, const SolverPartials& d, float range,
+                          float roll, bool along_range, BCE_HoldPartials& out) const;
     void recomputeZero();
+    /** Mark the zero dirty if the custom drag curve it was solved with changed. */
+    void checkCustomDragCurve();
+    /** False while the bullet flies DragModel::CUSTOM with no curve loaded. */
+    bool customCurveLoaded() const;
     SolverParams buildSolverParams(float range_m) const;
+    /**
+     * How far to tabulate for a target: the set horizon (max_range_m_ past
+     * it), or automatically the target plus horizon_margin_m_.
+     */
+    float tabulationHorizon(float target_range_m) const;
+    /** A range-only change ran past the table: widen the automatic margin. */
+    void widenHorizon();
+    bool solveFromAngleCache(const SolverParams& params, const SolutionCacheKey& key,
+                             SolverResult& result);
+    static SolutionCacheKey makeCacheKey(const SolverParams& params);
+    static bool cacheKeyMatches(const SolutionCacheKey& a, const SolutionCacheKey& b);
+    static bool trajectoryKeyMatches(const SolutionCacheKey& a, const SolutionCacheKey& b);
+    static bool trajectoryShapeMatches(const SolutionCacheKey& a, const SolutionCacheKey& b);
+    static bool zeroFingerprintMatches(const ZeroFingerprint& a, const ZeroFingerprint& b);
+    static bool dispersionKeyMatches(const SolutionCacheKey& a, const SolutionCacheKey& b);
 };
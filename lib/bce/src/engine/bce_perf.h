@@ -0,0 +1,58 @@
+/**
+ * @file bce_perf.h
+ * @brief Compile-time-gated timing helpers for BCE_ENABLE_PROFILING builds.
+ *
+ * Ticks are CPU cycles on ESP32-P4 and nanoseconds on native. With
+ * profiling disabled, BCE_PERF_SCOPE expands to nothing.
+ */
+
+#pragma once
+
+#include "bce/bce_config.h"
+#include <cstdint>
+
+#if BCE_ENABLE_PROFILING
+
+#ifdef BCE_PLATFORM_ESP32
+#include "esp_cpu.h"
+#include "sdkconfig.h"
+
+constexpr uint32_t BCE_PERF_TICK_HZ = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000u;
+
+inline uint32_t bcePerfNow() {
+    return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+}
+#else
+#include <chrono>
+
+constexpr uint32_t BCE_PERF_TICK_HZ = 1000000000u;
+
+inline uint32_t bcePerfNow() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+/** Accumulates elapsed ticks into a slot when it goes out of scope. */
+class BCE_PerfScope {
+public:
+    explicit BCE_PerfScope(uint32_t& slot) : slot_(slot), start_(bcePerfNow()) {}
+    ~BCE_PerfScope() { slot_ += bcePerfNow() - start_; }
+
+    BCE_PerfScope(const BCE_PerfScope&) = delete;
+    BCE_PerfScope& operator=(const BCE_PerfScope&) = delete;
+
+private:
+    uint32_t& slot_;
+    uint32_t start_;
+};
+
+#define BCE_PERF_CONCAT_(a, b) a##b
+#define BCE_PERF_CONCAT(a, b) BCE_PERF_CONCAT_(a, b)
+#define BCE_PERF_SCOPE(slot) BCE_PerfScope BCE_PERF_CONCAT(bce_perf_scope_, __LINE__)(slot)
+
+#else
+
+#define BCE_PERF_SCOPE(slot) ((void)0)
+
+#endif
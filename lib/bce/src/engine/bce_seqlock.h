@@ -0,0 +1,157 @@
+/**
+ * @file bce_seqlock.h
+ * @brief Single-writer sequence locks for handing a value between cores.
+ *
+ * The writer bumps the sequence to odd, stores the payload and bumps it back
+ * to even; a reader retries until it copies the payload with the same even
+ * sequence before and after. Neither side blocks or allocates. The payload is
+ * kept as 32-bit atomic words so the concurrent copy is well defined; on
+ * ESP32-P4 these compile to plain loads and stores plus fences.
+ *
+ * SeqLock readers spin while a write is in flight, so the writer must not be
+ * preemptible by a reader on the same core (pin them to different cores or
+ * give the writer the higher priority). DoubleBufferedSeqLock writes into the
+ * slot readers are not using, so a reader only retries if the writer laps it
+ * twice mid-copy.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqLock payload must be trivially copyable");
+
+public:
+    /** Clear the payload and sequence. Not safe against concurrent access. */
+    void reset() {
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(0, std::memory_order_relaxed);
+        }
+        seq_.store(0, std::memory_order_release);
+    }
+
+    /** Publish value. Single writer only. */
+    void store(const T& value) {
+        uint32_t buf[WORDS] = {};
+        std::memcpy(buf, &value, sizeof(T));
+
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Copy the latest published value into out.
+     * @return Number of stores published so far (0 = never written)
+     */
+    uint32_t load(T& out) const {
+        uint32_t buf[WORDS];
+        uint32_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; ++i) {
+                buf[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1u) != 0 || before != after);
+
+        std::memcpy(&out, buf, sizeof(T));
+        return before / 2;
+    }
+
+    /** Number of stores published so far, without copying the payload. */
+    uint32_t version() const {
+        return seq_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> words_[WORDS] = {};
+};
+
+template <typename T>
+class DoubleBufferedSeqLock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "DoubleBufferedSeqLock payload must be trivially copyable");
+
+public:
+    /** Clear both slots and the generation. Not safe against concurrent access. */
+    void reset() {
+        for (Slot& slot : slots_) {
+            for (size_t i = 0; i < WORDS; ++i) {
+                slot.words[i].store(0, std::memory_order_relaxed);
+            }
+            slot.seq.store(0, std::memory_order_relaxed);
+        }
+        generation_.store(0, std::memory_order_release);
+    }
+
+    /** Publish value as the next generation. Single writer only. */
+    void store(const T& value) {
+        uint32_t buf[WORDS] = {};
+        std::memcpy(buf, &value, sizeof(T));
+
+        // Slot seq is 2 × generation when complete, odd while being written
+        uint32_t gen = generation_.load(std::memory_order_relaxed) + 1;
+        Slot& slot = slots_[gen & 1u];
+        slot.seq.store(2 * gen - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            slot.words[i].store(buf[i], std::memory_order_relaxed);
+        }
+        slot.seq.store(2 * gen, std::memory_order_release);
+        generation_.store(gen, std::memory_order_release);
+    }
+
+    /**
+     * Copy the latest published value into out.
+     * @return Generation of the copied value (0 = never written)
+     */
+    uint32_t load(T& out) const {
+        uint32_t buf[WORDS];
+        uint32_t before, after;
+        do {
+            uint32_t gen = generation_.load(std::memory_order_acquire);
+            const Slot& slot = slots_[gen & 1u];
+            before = slot.seq.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; ++i) {
+                buf[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = slot.seq.load(std::memory_order_relaxed);
+        } while ((before & 1u) != 0 || before != after);
+
+        std::memcpy(&out, buf, sizeof(T));
+        return before / 2;
+    }
+
+    /** Generation of the latest published value, without copying it. */
+    uint32_t generation() const {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    struct Slot {
+        std::atomic<uint32_t> seq{0};
+        std::atomic<uint32_t> words[WORDS] = {};
+    };
+
+    std::atomic<uint32_t> generation_{0};
+    Slot slots_[2];
+};
@@ -8,17 +8,26 @@
 #include <cstring>
 
 void MagCalibration::init() {
-    std::memset(hard_iron_, 0, sizeof(hard_iron_));
     // Identity matrix for soft iron
-    float identity[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
-    std::memcpy(soft_iron_, identity, sizeof(soft_iron_));
+    Params p = {{0, 0, 0}, {1, 0, 0, 0, 1, 0, 0, 0, 1}};
+    params_.reset();
+    params_.store(p);
     declination_deg_ = 0.0f;
     is_disturbed_ = false;
 }
 
 void MagCalibration::setCalibration(const float hard_iron[3], const float soft_iron[9]) {
-    std::memcpy(hard_iron_, hard_iron, 3 * sizeof(float));
-    std::memcpy(soft_iron_, soft_iron, 9 * sizeof(float));
+    Params p;
+    std::memcpy(p.hard_iron, hard_iron, 3 * sizeof(float));
+    std::memcpy(p.soft_iron, soft_iron, 9 * sizeof(float));
+    params_.store(p);
+}
+
+void MagCalibration::getCalibration(float hard_iron[3], float soft_iron[9]) const {
+    Params p;
+    params_.load(p);
+    std::memcpy(hard_iron, p.hard_iron, 3 * sizeof(float));
+    std::memcpy(soft_iron, p.soft_iron, 9 * sizeof(float));
 }
 
 void MagCalibration::setDeclination(float declination_deg) {
@@ -26,15 +35,20 @@ void MagCalibration::setDeclination(float declination_deg) {
 }
 
 bool MagCalibration::apply(float& mx, float& my, float& mz) const {
+    Params p;
+    params_.load(p);
+    const float* hard_iron = p.hard_iron;
+    const float* soft_iron = p.soft_iron;
+
     // Subtract hard iron
-    float cx = mx - hard_iron_[0];
-    float cy = my - hard_iron_[1];
-    float cz = mz - hard_iron_[2];
+    float cx = mx - hard_iron[0];
+    float cy = my - hard_iron[1];
+    float cz = mz - hard_iron[2];
 
     // Apply soft iron correction (3×3 matrix multiply)
-    mx = soft_iron_[0] * cx + soft_iron_[1] * cy + soft_iron_[2] * cz;
-    my = soft_iron_[3] * cx + soft_iron_[4] * cy + soft_iron_[5] * cz;
-    mz = soft_iron_[6] * cx + soft_iron_[7] * cy + soft_iron_[8] * cz;
+    mx = soft_iron[0] * cx + soft_iron[1] * cy + soft_iron[2] * cz;
+    my = soft_iron[3] * cx + soft_iron[4] * cy + soft_iron[5] * cz;
+    mz = soft_iron[6] * cx + soft_iron[7] * cy + soft_iron[8] * cz;
 
     // Check field magnitude for disturbance detection
     float field_mag = std::sqrt(mx * mx + my * my + mz * mz);
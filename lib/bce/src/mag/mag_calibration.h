@@ -3,23 +3,34 @@
  * @brief Magnetometer calibration, disturbance detection, and heading computation.
  *
  * BCE SRS v1.3 — Sections 7.2, 10
+ *
+ * The calibration is double-buffered: setCalibration() may run on another
+ * core than apply() (e.g. committing a streaming fit), and apply() always
+ * sees a complete offset/matrix pair without either side blocking.
  */
 
 #pragma once
 
 #include "bce/bce_config.h"
+#include "../engine/bce_seqlock.h"
 
 class MagCalibration {
 public:
+    MagCalibration() { init(); }
+
     void init();
 
     /**
-     * Set hard-iron offset and soft-iron correction matrix.
+     * Set hard-iron offset and soft-iron correction matrix. Single writer;
+     * safe against a concurrent apply().
      * @param hard_iron  3-element offset vector to subtract.
      * @param soft_iron  9-element 3×3 matrix (row-major) for soft-iron correction.
      */
     void setCalibration(const float hard_iron[3], const float soft_iron[9]);
 
+    /** Copy out the calibration apply() currently uses. */
+    void getCalibration(float hard_iron[3], float soft_iron[9]) const;
+
     /**
      * Set magnetic declination (east positive).
      */
@@ -46,8 +57,12 @@ public:
     float getDeclination() const { return declination_deg_; }
 
 private:
-    float hard_iron_[3]  = {0, 0, 0};
-    float soft_iron_[9]  = {1, 0, 0,  0, 1, 0,  0, 0, 1}; // identity
+    struct Params {
+        float hard_iron[3];
+        float soft_iron[9];
+    };
+
+    DoubleBufferedSeqLock<Params> params_;
     float declination_deg_ = 0.0f;
     mutable bool is_disturbed_ = false;
 };
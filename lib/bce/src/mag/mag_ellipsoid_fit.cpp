@@ -0,0 +1,271 @@
+/**
+ * @file mag_ellipsoid_fit.cpp
+ * @brief Streaming hard/soft-iron fit implementation.
+ */
+
+#include "mag_ellipsoid_fit.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr float kErrorAlpha = 1.0f / 32.0f;
+
+// Eigen-decomposition of a symmetric 3×3 matrix by cyclic Jacobi rotations.
+// a is destroyed; eigenvectors are the columns of v (row-major).
+void jacobiEigen3(float a[9], float eig[3], float v[9]) {
+    const float identity[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    std::memcpy(v, identity, sizeof(identity));
+    for (int sweep = 0; sweep < 16; ++sweep) {
+        const float off = a[1] * a[1] + a[2] * a[2] + a[5] * a[5];
+        if (off < 1e-18f) break;
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                const float apq = a[p * 3 + q];
+                if (std::fabs(apq) < 1e-20f) continue;
+                const float theta = (a[q * 3 + q] - a[p * 3 + p]) / (2.0f * apq);
+                const float t = (theta >= 0.0f ? 1.0f : -1.0f) /
+                                (std::fabs(theta) + std::sqrt(theta * theta + 1.0f));
+                const float c = 1.0f / std::sqrt(t * t + 1.0f);
+                const float s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const float akp = a[k * 3 + p];
+                    const float akq = a[k * 3 + q];
+                    a[k * 3 + p] = c * akp - s * akq;
+                    a[k * 3 + q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const float apk = a[p * 3 + k];
+                    const float aqk = a[q * 3 + k];
+                    a[p * 3 + k] = c * apk - s * aqk;
+                    a[q * 3 + k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const float vkp = v[k * 3 + p];
+                    const float vkq = v[k * 3 + q];
+                    v[k * 3 + p] = c * vkp - s * vkq;
+                    v[k * 3 + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    eig[0] = a[0];
+    eig[1] = a[4];
+    eig[2] = a[8];
+}
+
+} // namespace
+
+void MagEllipsoidFit::reset() {
+    std::memset(&state_, 0, sizeof(state_));
+    // Prior: the unit sphere about the origin, i.e. an uncalibrated sensor
+    // reading a BCE_MAG_CAL_SCALE_UT field
+    state_.theta[0] = state_.theta[1] = state_.theta[2] = 1.0f;
+    std::memset(p_, 0, sizeof(p_));
+    for (int i = 0; i < PARAMS; ++i) p_[i * PARAMS + i] = BCE_MAG_CAL_RLS_INIT;
+    std::memset(last_, 0, sizeof(last_));
+    std::memset(min_, 0, sizeof(min_));
+    std::memset(max_, 0, sizeof(max_));
+    std::memset(cell_reading_, 0, sizeof(cell_reading_));
+    cell_stored_ = 0;
+}
+
+bool MagEllipsoidFit::addSample(float mx, float my, float mz) {
+    const float m[3] = {mx, my, mz};
+    const float norm = std::sqrt(mx * mx + my * my + mz * mz);
+    if (!(norm > 0.0f) || norm > 4.0f * BCE_MAG_MAX_FIELD_UT) {
+        state_.rejected++;
+        return false;
+    }
+    if (state_.samples > 0) {
+        const float dx = mx - last_[0], dy = my - last_[1], dz = mz - last_[2];
+        if (dx * dx + dy * dy + dz * dz < BCE_MAG_CAL_MIN_STEP_UT * BCE_MAG_CAL_MIN_STEP_UT) {
+            return false;
+        }
+    }
+
+    const float u = mx / BCE_MAG_CAL_SCALE_UT;
+    const float v = my / BCE_MAG_CAL_SCALE_UT;
+    const float w = mz / BCE_MAG_CAL_SCALE_UT;
+    const float phi[PARAMS] = {u * u, v * v, w * w,
+                               2.0f * u * v, 2.0f * u * w, 2.0f * v * w,
+                               2.0f * u, 2.0f * v, 2.0f * w};
+
+    // A priori error against the current quadric
+    float predicted = 0.0f;
+    for (int i = 0; i < PARAMS; ++i) predicted += phi[i] * state_.theta[i];
+    const float e = 1.0f - predicted;
+
+    // Until the readings surround the sensor the fit is loose across the
+    // missing directions, so only then is a large error a disturbance
+    if (state_.samples >= BCE_MAG_CAL_MIN_SAMPLES &&
+        coverage(state_.cells) >= BCE_MAG_CAL_MIN_COVERAGE && std::fabs(e) > BCE_MAG_CAL_MAX_ERROR) {
+        state_.rejected++;
+        return false;
+    }
+
+    // RLS: k = P phi / (lambda + phi' P phi), theta += k e,
+    // P = (P - k phi' P) / lambda, updated as a symmetric matrix
+    float pphi[PARAMS];
+    float denom = BCE_MAG_CAL_FORGETTING;
+    for (int i = 0; i < PARAMS; ++i) {
+        float acc = 0.0f;
+        for (int j = 0; j < PARAMS; ++j) acc += p_[i * PARAMS + j] * phi[j];
+        pphi[i] = acc;
+        denom += phi[i] * acc;
+    }
+    const float inv_denom = 1.0f / denom;
+    const float inv_lambda = 1.0f / BCE_MAG_CAL_FORGETTING;
+    for (int i = 0; i < PARAMS; ++i) {
+        state_.theta[i] += pphi[i] * inv_denom * e;
+        for (int j = i; j < PARAMS; ++j) {
+            const float pij = (p_[i * PARAMS + j] - pphi[i] * pphi[j] * inv_denom) * inv_lambda;
+            p_[i * PARAMS + j] = pij;
+            p_[j * PARAMS + i] = pij;
+        }
+    }
+
+    state_.error_ms = (state_.samples == 0) ? e * e
+                                            : state_.error_ms + kErrorAlpha * (e * e - state_.error_ms);
+
+    for (int i = 0; i < 3; ++i) {
+        if (state_.samples == 0 || m[i] < min_[i]) min_[i] = m[i];
+        if (state_.samples == 0 || m[i] > max_[i]) max_[i] = m[i];
+    }
+    updateCoverage(m);
+
+    std::memcpy(last_, m, sizeof(last_));
+    state_.samples++;
+    return true;
+}
+
+int MagEllipsoidFit::cellOf(const float m[3], const float centre[3]) {
+    const float d[3] = {m[0] - centre[0], m[1] - centre[1], m[2] - centre[2]};
+    if (d[0] * d[0] + d[1] * d[1] + d[2] * d[2] < BCE_MAG_CAL_MIN_STEP_UT * BCE_MAG_CAL_MIN_STEP_UT) {
+        return -1;
+    }
+    int axis = 0;
+    if (std::fabs(d[1]) > std::fabs(d[axis])) axis = 1;
+    if (std::fabs(d[2]) > std::fabs(d[axis])) axis = 2;
+    const int b = (axis + 1) % 3;
+    const int c = (axis + 2) % 3;
+    const int face = 2 * axis + (d[axis] < 0.0f ? 1 : 0);
+    const int quadrant = (d[b] < 0.0f ? 1 : 0) + (d[c] < 0.0f ? 2 : 0);
+    return face * 4 + quadrant;
+}
+
+void MagEllipsoidFit::updateCoverage(const float m[3]) {
+    // Cells are taken about the bounding-box centre, which moves while the
+    // readings still cover part of the sphere: store the reading as its
+    // cell's latest, then re-bin every stored reading about the new centre
+    // (a fixed CELLS checks per reading)
+    const float centre[3] = {0.5f * (min_[0] + max_[0]), 0.5f * (min_[1] + max_[1]),
+                             0.5f * (min_[2] + max_[2])};
+    const int cell = cellOf(m, centre);
+    if (cell >= 0) {
+        std::memcpy(cell_reading_[cell], m, sizeof(cell_reading_[cell]));
+        cell_stored_ |= 1u << cell;
+    }
+
+    uint32_t stayed = 0;
+    uint32_t moved_mask = 0;
+    float moved[CELLS][3];
+    for (int i = 0; i < CELLS; ++i) {
+        if ((cell_stored_ & (1u << i)) == 0) continue;
+        const int now = cellOf(cell_reading_[i], centre);
+        if (now == i) {
+            stayed |= 1u << i;
+        } else if (now >= 0) {
+            std::memcpy(moved[now], cell_reading_[i], sizeof(moved[now]));
+            moved_mask |= 1u << now;
+        }
+    }
+    // A reading that changed cell fills its new cell unless that cell's own
+    // reading is still there
+    for (int i = 0; i < CELLS; ++i) {
+        if ((moved_mask & ~stayed & (1u << i)) != 0) {
+            std::memcpy(cell_reading_[i], moved[i], sizeof(cell_reading_[i]));
+        }
+    }
+    cell_stored_ = stayed | moved_mask;
+    state_.cells = cell_stored_;
+}
+
+float MagEllipsoidFit::coverage(uint32_t cells) {
+    int n = 0;
+    for (uint32_t c = cells; c != 0; c &= c - 1u) n++;
+    return static_cast<float>(n) / static_cast<float>(CELLS);
+}
+
+bool MagEllipsoidFit::solve(const State& state, Result& out) {
+    const float identity[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    std::memset(&out, 0, sizeof(out));
+    std::memcpy(out.soft_iron, identity, sizeof(identity));
+    out.coverage = coverage(state.cells);
+
+    const float* t = state.theta;
+    const float m[9] = {t[0], t[3], t[4],
+                        t[3], t[1], t[5],
+                        t[4], t[5], t[2]};
+
+    // Centre c = -M^-1 g (adjugate inverse)
+    const float c00 = m[4] * m[8] - m[5] * m[7];
+    const float c01 = m[2] * m[7] - m[1] * m[8];
+    const float c02 = m[1] * m[5] - m[2] * m[4];
+    const float c11 = m[0] * m[8] - m[2] * m[6];
+    const float c12 = m[2] * m[3] - m[0] * m[5];
+    const float c22 = m[0] * m[4] - m[1] * m[3];
+    const float det = m[0] * c00 + m[1] * (m[5] * m[6] - m[3] * m[8]) + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    if (!(std::fabs(det) > 1e-12f)) return false;
+    const float inv_det = 1.0f / det;
+    const float inv[9] = {c00 * inv_det, c01 * inv_det, c02 * inv_det,
+                          c01 * inv_det, c11 * inv_det, c12 * inv_det,
+                          c02 * inv_det, c12 * inv_det, c22 * inv_det};
+    float centre[3];
+    for (int i = 0; i < 3; ++i) {
+        centre[i] = -(inv[i * 3 + 0] * t[6] + inv[i * 3 + 1] * t[7] + inv[i * 3 + 2] * t[8]);
+    }
+
+    // About the centre the quadric is y' M y = 1 + c' M c
+    float k = 1.0f;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) k += centre[i] * m[i * 3 + j] * centre[j];
+    }
+    if (!(k > 0.0f)) return false;
+
+    float a[9];
+    for (int i = 0; i < 9; ++i) a[i] = m[i] / k;
+    float eig[3];
+    float vec[9];
+    jacobiEigen3(a, eig, vec);
+    if (!(eig[0] > 0.0f && eig[1] > 0.0f && eig[2] > 0.0f)) return false;
+
+    // Semi-axes 1/sqrt(eig); the sphere keeps their geometric mean, so the
+    // calibrated magnitude stays an absolute field strength
+    const float r0 = 1.0f / std::sqrt(eig[0]);
+    const float r1 = 1.0f / std::sqrt(eig[1]);
+    const float r2 = 1.0f / std::sqrt(eig[2]);
+    const float radius = std::cbrt(r0 * r1 * r2);
+    const float r_max = std::fmax(r0, std::fmax(r1, r2));
+    const float r_min = std::fmin(r0, std::fmin(r1, r2));
+
+    // Soft iron = radius * V diag(sqrt(eig)) V'
+    const float scale[3] = {radius * std::sqrt(eig[0]), radius * std::sqrt(eig[1]),
+                            radius * std::sqrt(eig[2])};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            float acc = 0.0f;
+            for (int n = 0; n < 3; ++n) acc += vec[i * 3 + n] * scale[n] * vec[j * 3 + n];
+            out.soft_iron[i * 3 + j] = acc;
+        }
+        out.hard_iron[i] = centre[i] * BCE_MAG_CAL_SCALE_UT;
+    }
+    out.field_ut = radius * BCE_MAG_CAL_SCALE_UT;
+    // The normalized error is about twice the relative radius error
+    out.residual_ut = 0.5f * std::sqrt(state.error_ms) * out.field_ut;
+
+    return state.samples >= BCE_MAG_CAL_MIN_SAMPLES &&
+           out.coverage >= BCE_MAG_CAL_MIN_COVERAGE &&
+           out.field_ut >= BCE_MAG_MIN_FIELD_UT && out.field_ut <= BCE_MAG_MAX_FIELD_UT &&
+           r_max <= BCE_MAG_CAL_MAX_AXIS_RATIO * r_min;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file mag_ellipsoid_fit.h
+ * @brief Streaming hard/soft-iron fit — recursive least squares, constant memory.
+ *
+ * Raw readings of a rotated magnetometer lie on an ellipsoid: the Earth field
+ * sphere, shifted by hard iron and stretched by soft iron. Each reading u
+ * (scaled by BCE_MAG_CAL_SCALE_UT) adds one row of the general quadric
+ *
+ *   A u² + B v² + C w² + 2D uv + 2E uw + 2F vw + 2G u + 2H v + 2I w = 1
+ *
+ * to a 9-parameter recursive least-squares estimate, so the fit costs one
+ * 9×9 covariance update per reading and never stores readings. solve() turns
+ * the quadric into a hard-iron offset (its centre) and a symmetric soft-iron
+ * matrix that maps the ellipsoid onto a sphere of the fitted field strength.
+ *
+ * Coverage counts which of 24 direction cells (cube faces split in four)
+ * around the centre of the readings' bounding box have been visited; a fit
+ * from readings in one plane is unconstrained across it. The latest reading
+ * in each cell is kept and re-binned as the centre moves, so cells seen
+ * while the centre was still off are corrected rather than miscounted. With
+ * one slot per cell the metric can only undercount: a single slow pass from
+ * pole to pole may need a second pass before it reports full coverage.
+ */
+
+#pragma once
+
+#include "bce/bce_config.h"
+#include <cstdint>
+
+class MagEllipsoidFit {
+public:
+    static constexpr int PARAMS = 9;
+    static constexpr int CELLS = 24;
+
+    /** Everything solve() needs; small enough to hand between cores. */
+    struct State {
+        float theta[PARAMS];  // quadric A..I in scaled units
+        float error_ms;       // running mean square of the normalized fit error
+        uint32_t samples;     // readings used
+        uint32_t rejected;    // implausible or disturbed readings
+        uint32_t cells;       // visited direction cells, one bit each
+    };
+
+    struct Result {
+        float hard_iron[3];   // µT, to subtract
+        float soft_iron[9];   // row-major, applied after the offset
+        float field_ut;       // fitted field strength
+        float residual_ut;    // approximate RMS radius error
+        float coverage;       // visited fraction of the direction cells
+    };
+
+    /** Restart from the unit-sphere prior. */
+    void reset();
+
+    /**
+     * Fold in one raw reading (µT).
+     * @return false if it was skipped: too close to the last reading used,
+     *         implausibly large, or (once the fit is constrained) too far off
+     *         the ellipsoid to be undisturbed
+     */
+    bool addSample(float mx, float my, float mz);
+
+    const State& getState() const { return state_; }
+
+    static float coverage(uint32_t cells);
+
+    /**
+     * Fit a calibration from state. out is filled as far as the quadric
+     * allows even when the fit is rejected.
+     * @return true if the fit can be committed: enough samples and coverage,
+     *         a real ellipsoid, field within BCE_MAG_MIN/MAX_FIELD_UT and axes
+     *         within BCE_MAG_CAL_MAX_AXIS_RATIO
+     */
+    static bool solve(const State& state, Result& out);
+
+private:
+    State state_ = {};
+    float p_[PARAMS * PARAMS] = {};  // RLS covariance, kept symmetric
+    float last_[3] = {0, 0, 0};
+    float min_[3] = {0, 0, 0};
+    float max_[3] = {0, 0, 0};
+    float cell_reading_[CELLS][3] = {};
+    uint32_t cell_stored_ = 0;         // cell_reading_ entries in use
+
+    /** Direction cell of m about centre, or -1 if m is too close to it. */
+    static int cellOf(const float m[3], const float centre[3]);
+    void updateCoverage(const float m[3]);
+};
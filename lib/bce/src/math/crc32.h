@@ -0,0 +1,21 @@
+/**
+ * @file crc32.h
+ * @brief CRC-32 for the blobs the engine reads back (saved state, profile DB).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3, reflected), bitwise to keep flash use minimal
+inline uint32_t bceCrc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file fast_math.h
+ * @brief Reduced-cost float approximations for the solver, atmosphere and AHRS.
+ *
+ * FastMath holds the approximations themselves and is always compiled, so
+ * tests can check them in any build. The bce* dispatch functions below pick
+ * FastMath when BCE_FAST_MATH is set and the std:: implementation otherwise;
+ * with BCE_FAST_MATH = 0 they are exactly the std:: calls they replace.
+ *
+ * Error bounds, measured against double precision over the input ranges
+ * checked by test_solver.cpp:
+ *
+ *   rsqrt, sqrt   bit-level seed + 2 Newton steps      ≤ 5e-6 relative
+ *   exp2          Cephes exp2f polynomial, |f| ≤ 0.5   ≤ 2e-7 relative (|x| ≤ 20)
+ *   exp           exp2(x · log2 e)                     ≤ 2e-6 relative (|x| ≤ 20)
+ *   log           Cephes logf polynomial               ≤ 1e-6 absolute
+ *   pow           exp2(y · log2 x)                     ≤ 2e-6 relative (|y · log2 x| ≤ 20)
+ *   atan2         A&S 4.4.49, octant-reduced           ≤ 5e-7 rad absolute
+ *   asin          A&S 4.4.46                           ≤ 5e-7 rad absolute
+ *
+ * Inputs outside the finite positive domain of sqrt / log / pow return 0
+ * rather than NaN; callers in this library never pass them.
+ */
+
+#pragma once
+
+#include "bce/bce_config.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+class FastMath {
+public:
+    /** 1/√x for x > 0; 0 otherwise. */
+    static float rsqrt(float x) {
+        if (!(x > 0.0f)) return 0.0f;
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        bits = 0x5F375A86u - (bits >> 1);
+        float y;
+        std::memcpy(&y, &bits, sizeof(y));
+        float half_x = 0.5f * x;
+        y = y * (1.5f - half_x * y * y);
+        y = y * (1.5f - half_x * y * y);
+        return y;
+    }
+
+    /** √x for x > 0; 0 otherwise. */
+    static float sqrt(float x) {
+        return x * rsqrt(x);
+    }
+
+    /** 2^x, saturating to 0 / 2^127 outside [-126, 127]; NaN passes through. */
+    static float exp2(float x) {
+        if (std::isnan(x)) return x;
+        if (x < -126.0f) return 0.0f;
+        if (x > 127.0f) x = 127.0f;
+
+        float n = std::floor(x + 0.5f);
+        float f = x - n; // |f| ≤ 0.5
+        float p = 1.535336188319500e-4f;
+        p = p * f + 1.339887440266574e-3f;
+        p = p * f + 9.618437357674640e-3f;
+        p = p * f + 5.550332471162809e-2f;
+        p = p * f + 2.402264791363012e-1f;
+        p = p * f + 6.931472028550421e-1f;
+        p = p * f + 1.0f;
+
+        uint32_t bits = static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+    }
+
+    /** e^x. */
+    static float exp(float x) {
+        return exp2(x * LOG2E);
+    }
+
+    /** Natural log for finite x > 0; 0 otherwise. */
+    static float log(float x) {
+        if (!(x > 0.0f) || !std::isfinite(x)) return 0.0f;
+
+        // x = m · 2^e with m in [√½, √2)
+        int e;
+        float m = std::frexp(x, &e);
+        if (m < SQRT_HALF) {
+            m += m;
+            e -= 1;
+        }
+        float z = m - 1.0f;
+        float z2 = z * z;
+
+        float p = 7.0376836292e-2f;
+        p = p * z - 1.1514610310e-1f;
+        p = p * z + 1.1676998740e-1f;
+        p = p * z - 1.2420140846e-1f;
+        p = p * z + 1.4249322787e-1f;
+        p = p * z - 1.6668057665e-1f;
+        p = p * z + 2.0000714765e-1f;
+        p = p * z - 2.4999993993e-1f;
+        p = p * z + 3.3333331174e-1f;
+
+        float fe = static_cast<float>(e);
+        float y = z * z2 * p;
+        y += -2.12194440e-4f * fe;
+        y += -0.5f * z2;
+        return z + y + 0.693359375f * fe;
+    }
+
+    /** x^y for finite x > 0; 0 otherwise. */
+    static float pow(float x, float y) {
+        if (!(x > 0.0f) || !std::isfinite(x)) return 0.0f;
+        return exp2(y * log(x) * LOG2E);
+    }
+
+    /** Four-quadrant arctangent in radians, matching std::atan2 signs. */
+    static float atan2(float y, float x) {
+        float ax = std::fabs(x);
+        float ay = std::fabs(y);
+        if (ax == 0.0f && ay == 0.0f) {
+            return std::signbit(x) ? std::copysign(PI, y) : std::copysign(0.0f, y);
+        }
+
+        // atan on [0, 1], then unfold the octant and quadrant
+        bool swap = ay > ax;
+        float t = swap ? ax / ay : ay / ax;
+        float t2 = t * t;
+        float p = 0.0028662257f;
+        p = p * t2 - 0.0161657367f;
+        p = p * t2 + 0.0429096138f;
+        p = p * t2 - 0.0752896400f;
+        p = p * t2 + 0.1065626393f;
+        p = p * t2 - 0.1420889944f;
+        p = p * t2 + 0.1999355085f;
+        p = p * t2 - 0.3333314528f;
+        float a = t + t * t2 * p;
+
+        if (swap) a = 0.5f * PI - a;
+        if (std::signbit(x)) a = PI - a;
+        return std::copysign(a, y);
+    }
+
+    /** Arcsine in radians; x is clamped to [-1, 1]. */
+    static float asin(float x) {
+        float ax = std::fabs(x);
+        if (ax > 1.0f) ax = 1.0f;
+        float p = -0.0012624911f;
+        p = p * ax + 0.0066700901f;
+        p = p * ax - 0.0170881256f;
+        p = p * ax + 0.0308918810f;
+        p = p * ax - 0.0501743046f;
+        p = p * ax + 0.0889789874f;
+        p = p * ax - 0.2145988016f;
+        p = p * ax + 1.5707963050f;
+        float a = 0.5f * PI - std::sqrt(1.0f - ax) * p;
+        return std::copysign(a, x);
+    }
+
+private:
+    static constexpr float PI = 3.14159265358979f;
+    static constexpr float LOG2E = 1.44269504088896f;
+    static constexpr float SQRT_HALF = 0.70710678118655f;
+};
+
+// ---------------------------------------------------------------------------
+// Dispatch — selected by BCE_FAST_MATH
+// ---------------------------------------------------------------------------
+
+inline float bceSqrt(float x) {
+#if BCE_FAST_MATH
+    return FastMath::sqrt(x);
+#else
+    return std::sqrt(x);
+#endif
+}
+
+inline float bceRsqrt(float x) {
+#if BCE_FAST_MATH
+    return FastMath::rsqrt(x);
+#else
+    return 1.0f / std::sqrt(x);
+#endif
+}
+
+inline float bceExp(float x) {
+#if BCE_FAST_MATH
+    return FastMath::exp(x);
+#else
+    return std::exp(x);
+#endif
+}
+
+inline float bcePow(float x, float y) {
+#if BCE_FAST_MATH
+    return FastMath::pow(x, y);
+#else
+    return std::pow(x, y);
+#endif
+}
+
+inline float bceAtan2(float y, float x) {
+#if BCE_FAST_MATH
+    return FastMath::atan2(y, x);
+#else
+    return std::atan2(y, x);
+#endif
+}
+
+inline float bceAsin(float x) {
+#if BCE_FAST_MATH
+    return FastMath::asin(x);
+#else
+    return std::asin(x);
+#endif
+}
@@ -0,0 +1,162 @@
+/**
+ * @file sweep_executor.cpp
+ * @brief Work-stealing sweep executor implementation (native builds only).
+ */
+
+#include "sweep_executor.h"
+
+#ifdef BCE_PLATFORM_NATIVE
+
+namespace {
+constexpr int BCE_SWEEP_CHUNKS_PER_WORKER = 4;
+}
+
+SweepExecutor::SweepExecutor(int threads) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) threads = 1;
+    }
+
+    workers_.reserve(static_cast<size_t>(threads));
+    for (int i = 0; i < threads; ++i) {
+        std::unique_ptr<Worker> w(new Worker());
+        w->solver.reset(new BallisticSolver());
+        w->solver->init();
+        workers_.push_back(std::move(w));
+    }
+    for (int i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread(&SweepExecutor::run, this, i);
+    }
+}
+
+SweepExecutor::~SweepExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(job_mutex_);
+        stop_ = true;
+    }
+    job_cv_.notify_all();
+    for (auto& w : workers_) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+}
+
+void SweepExecutor::parallelFor(int count, int chunk, const Task& task) {
+    if (count <= 0) return;
+
+    const int n = getThreadCount();
+    if (chunk <= 0) {
+        chunk = count / (n * BCE_SWEEP_CHUNKS_PER_WORKER);
+        if (chunk < 1) chunk = 1;
+    }
+
+    // Deal chunks round-robin; boundaries depend only on count and chunk
+    int k = 0;
+    for (int begin = 0; begin < count; begin += chunk, ++k) {
+        int end = (count - begin < chunk) ? count : begin + chunk;
+        Worker& w = *workers_[k % n];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        w.queue.push_back({begin, end});
+    }
+
+    std::unique_lock<std::mutex> lock(job_mutex_);
+    task_ = &task;
+    busy_ = n;
+    generation_++;
+    job_cv_.notify_all();
+    done_cv_.wait(lock, [this] { return busy_ == 0; });
+    task_ = nullptr;
+}
+
+int SweepExecutor::solve(const SolverParams* params, int count, SolverResult* out) {
+    if (!params || !out || count <= 0) return 0;
+
+    parallelFor(count, 0, [&](int worker, int begin, int end) {
+        BallisticSolver& solver = getSolver(worker);
+        for (int i = begin; i < end; ++i) {
+            out[i] = solver.integrate(params[i]);
+        }
+    });
+
+    int valid = 0;
+    for (int i = 0; i < count; ++i) {
+        if (out[i].valid) valid++;
+    }
+    return valid;
+}
+
+int SweepExecutor::solveGrid(const SolverParams* params, int param_count, const float* ranges,
+                             int range_count, SolverResult* out) {
+    if (!params || !ranges || !out || param_count <= 0 || range_count <= 0) return 0;
+
+    float horizon = 0.0f;
+    for (int r = 0; r < range_count; ++r) {
+        if (ranges[r] > horizon) horizon = ranges[r];
+    }
+
+    parallelFor(param_count, 0, [&](int worker, int begin, int end) {
+        BallisticSolver& solver = getSolver(worker);
+        for (int p = begin; p < end; ++p) {
+            SolverResult* row = out + static_cast<size_t>(p) * range_count;
+            bool ok = solver.integrateTrajectory(params[p], horizon);
+            for (int r = 0; r < range_count; ++r) {
+                if (ok) {
+                    row[r] = solver.sampleTrajectory(params[p], ranges[r]);
+                } else {
+                    row[r] = SolverResult{};
+                }
+            }
+        }
+    });
+
+    int valid = 0;
+    for (int i = 0; i < param_count * range_count; ++i) {
+        if (out[i].valid) valid++;
+    }
+    return valid;
+}
+
+void SweepExecutor::run(int index) {
+    uint64_t seen = 0;
+    for (;;) {
+        const Task* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(job_mutex_);
+            job_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            task = task_;
+        }
+
+        Chunk c;
+        while (popLocal(index, c) || steal(index, c)) {
+            (*task)(index, c.begin, c.end);
+        }
+
+        std::lock_guard<std::mutex> lock(job_mutex_);
+        if (--busy_ == 0) done_cv_.notify_one();
+    }
+}
+
+bool SweepExecutor::popLocal(int index, Chunk& out) {
+    Worker& w = *workers_[index];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.queue.empty()) return false;
+    out = w.queue.back();
+    w.queue.pop_back();
+    return true;
+}
+
+bool SweepExecutor::steal(int thief, Chunk& out) {
+    const int n = getThreadCount();
+    for (int k = 1; k < n; ++k) {
+        Worker& victim = *workers_[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.queue.empty()) continue;
+        out = victim.queue.front();
+        victim.queue.pop_front();
+        return true;
+    }
+    return false;
+}
+
+#endif // BCE_PLATFORM_NATIVE
@@ -0,0 +1,103 @@
+/**
+ * @file sweep_executor.h
+ * @brief Work-stealing thread pool for parameter sweeps (native builds only).
+ *
+ * Splits an index range into fixed chunks, deals them round-robin onto
+ * per-worker deques and lets idle workers steal from the front of other
+ * deques. Each worker owns a BallisticSolver, so no trajectory table is
+ * shared. Chunk boundaries follow the thread count when the chunk size is
+ * left to parallelFor(), but every item is integrated from its own params
+ * with no carry-over from whatever the worker's solver ran before, and writes
+ * only its own output slot, so results are bit-identical for any thread
+ * count and chunking.
+ *
+ * Desktop tooling only: uses std::thread and heap allocation, and is compiled
+ * out unless BCE_PLATFORM_NATIVE is defined.
+ */
+
+#pragma once
+
+#ifdef BCE_PLATFORM_NATIVE
+
+#include "../solver/solver.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SweepExecutor {
+public:
+    /** Work callback: process items [begin, end) on the given worker. */
+    using Task = std::function<void(int worker, int begin, int end)>;
+
+    /** @param threads  Worker count; ≤ 0 selects std::thread::hardware_concurrency(). */
+    explicit SweepExecutor(int threads = 0);
+    ~SweepExecutor();
+
+    SweepExecutor(const SweepExecutor&) = delete;
+    SweepExecutor& operator=(const SweepExecutor&) = delete;
+
+    int getThreadCount() const { return static_cast<int>(workers_.size()); }
+
+    /** Per-worker solver, valid only inside a Task running on that worker. */
+    BallisticSolver& getSolver(int worker) { return *workers_[worker]->solver; }
+
+    /**
+     * Run task over [0, count) in chunks of chunk items and block until all
+     * chunks are done. chunk ≤ 0 picks a size giving each worker several
+     * chunks to balance uneven work. Not reentrant: a task must not call
+     * back into the same executor.
+     */
+    void parallelFor(int count, int chunk, const Task& task);
+
+    /**
+     * Integrate params[i] into out[i] with BallisticSolver::integrate().
+     * @return Number of valid results
+     */
+    int solve(const SolverParams* params, int count, SolverResult* out);
+
+    /**
+     * Ranges × parameter grid: out[p * range_count + r] is params[p] sampled
+     * at ranges[r]. Each parameter set is integrated once out to its farthest
+     * range and every range is sampled from the table.
+     * @return Number of valid results
+     */
+    int solveGrid(const SolverParams* params, int param_count, const float* ranges,
+                  int range_count, SolverResult* out);
+
+private:
+    struct Chunk {
+        int begin;
+        int end;
+    };
+
+    struct Worker {
+        std::unique_ptr<BallisticSolver> solver;
+        std::deque<Chunk> queue;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Job publication: workers wake on a new generation and decrement busy_
+    // once their own queue and every steal attempt come up empty
+    std::mutex job_mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable done_cv_;
+    const Task* task_ = nullptr;
+    uint64_t generation_ = 0;
+    int busy_ = 0;
+    bool stop_ = false;
+
+    void run(int index);
+    bool popLocal(int index, Chunk& out);
+    bool steal(int thief, Chunk& out);
+};
+
+#endif // BCE_PLATFORM_NATIVE
@@ -0,0 +1,252 @@
+/**
+ * @file profile_db.cpp
+ * @brief Packed profile database implementation.
+ */
+
+#include "profile_db.h"
+#include "../math/crc32.h"
+#include <cstring>
+
+namespace {
+
+size_t alignUp(size_t n) {
+    return (n + 3u) & ~static_cast<size_t>(3u);
+}
+
+// Slots for count names: a power of two, at least twice the names, so
+// probes stay short and always reach an empty slot
+int indexSlots(int count) {
+    int slots = 4;
+    while (slots < 2 * count) slots <<= 1;
+    return slots;
+}
+
+bool validName(const char* name) {
+    const void* nul = std::memchr(name, '\0', PROFILE_NAME_BYTES);
+    return name[0] != '\0' && nul != nullptr;
+}
+
+// Bounds of a section of count records of size bytes, inside total
+bool sectionFits(uint32_t offset, size_t count, size_t size, uint32_t total) {
+    return offset % 4 == 0 && offset <= total && count * size <= total - offset;
+}
+
+} // namespace
+
+uint32_t ProfileDb::hashName(const char* name) {
+    uint32_t h = 2166136261u;
+    for (const char* p = name; *p != '\0'; ++p) {
+        h = (h ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    return h;
+}
+
+bool ProfileDb::open(const void* data, size_t size) {
+    if (!data || reinterpret_cast<uintptr_t>(data) % 4 != 0 ||
+        size < sizeof(ProfileDbHeader)) {
+        return false;
+    }
+    const uint8_t* base = static_cast<const uint8_t*>(data);
+    const ProfileDbHeader* h = static_cast<const ProfileDbHeader*>(data);
+    if (h->magic != BCE_PROFILE_DB_MAGIC || h->version != BCE_PROFILE_DB_VERSION ||
+        h->header_bytes != sizeof(ProfileDbHeader) || h->total_bytes > size ||
+        h->total_bytes < sizeof(ProfileDbHeader)) {
+        return false;
+    }
+    const int slots = h->index_slots;
+    if (slots < 4 || (slots & (slots - 1)) != 0 ||
+        slots <= h->cartridge_count + h->gun_count) {
+        return false;
+    }
+    if (!sectionFits(h->cartridge_offset, h->cartridge_count, sizeof(ProfileCartridge), h->total_bytes) ||
+        !sectionFits(h->gun_offset, h->gun_count, sizeof(ProfileGun), h->total_bytes) ||
+        !sectionFits(h->index_offset, static_cast<size_t>(slots), sizeof(ProfileIndexSlot), h->total_bytes)) {
+        return false;
+    }
+    if (bceCrc32(base + sizeof(ProfileDbHeader), h->total_bytes - sizeof(ProfileDbHeader)) != h->crc32) {
+        return false;
+    }
+
+    header_ = h;
+    cartridges_ = reinterpret_cast<const ProfileCartridge*>(base + h->cartridge_offset);
+    guns_ = reinterpret_cast<const ProfileGun*>(base + h->gun_offset);
+    index_ = reinterpret_cast<const ProfileIndexSlot*>(base + h->index_offset);
+    return true;
+}
+
+const ProfileCartridge* ProfileDb::getCartridge(int i) const {
+    if (i < 0 || i >= getCartridgeCount()) return nullptr;
+    return &cartridges_[i];
+}
+
+const ProfileGun* ProfileDb::getGun(int i) const {
+    if (i < 0 || i >= getGunCount()) return nullptr;
+    return &guns_[i];
+}
+
+const ProfileCartridge* ProfileDb::findCartridge(const char* name) const {
+    int i = find(CARTRIDGE, name);
+    return (i >= 0) ? &cartridges_[i] : nullptr;
+}
+
+const ProfileGun* ProfileDb::findGun(const char* name) const {
+    int i = find(GUN, name);
+    return (i >= 0) ? &guns_[i] : nullptr;
+}
+
+int ProfileDb::find(Kind kind, const char* name) const {
+    if (!header_ || !name) return -1;
+    const uint32_t hash = hashName(name);
+    const uint32_t mask = header_->index_slots - 1u;
+    const int count = (kind == CARTRIDGE) ? header_->cartridge_count : header_->gun_count;
+    for (uint32_t probe = 0, i = hash & mask; probe <= mask; ++probe, i = (i + 1) & mask) {
+        const ProfileIndexSlot& slot = index_[i];
+        if (slot.kind == 0) return -1;
+        if (slot.hash != hash || slot.kind != kind || slot.record >= count) continue;
+        const char* stored = (kind == CARTRIDGE) ? cartridges_[slot.record].name
+                                                 : guns_[slot.record].name;
+        if (std::strncmp(stored, name, PROFILE_NAME_BYTES) == 0) return slot.record;
+    }
+    return -1;
+}
+
+void ProfileDb::applyCartridge(const ProfileCartridge& cartridge, BulletProfile& bullet) {
+    bullet.bc = cartridge.bc;
+    bullet.drag_model = static_cast<DragModel>(cartridge.drag_model);
+    bullet.muzzle_velocity_ms = cartridge.muzzle_velocity_ms;
+    bullet.mass_grains = cartridge.mass_grains;
+    bullet.caliber_inches = cartridge.caliber_inches;
+    bullet.length_mm = cartridge.length_mm;
+
+    int bands = cartridge.bc_band_count;
+    if (bands > PROFILE_BC_BANDS) bands = PROFILE_BC_BANDS;
+    if (bands > BCE_MAX_BC_BANDS) bands = BCE_MAX_BC_BANDS;
+    for (int i = 0; i < bands; ++i) {
+        bullet.bc_bands[i] = cartridge.bc_bands[i];
+    }
+    bullet.bc_band_count = static_cast<uint8_t>(bands);
+}
+
+void ProfileDb::applyGun(const ProfileGun& gun, BulletProfile& bullet, ZeroConfig& zero) {
+    bullet.barrel_length_in = gun.barrel_length_in;
+    bullet.mv_adjustment_factor = gun.mv_adjustment_factor;
+    bullet.twist_rate_inches = gun.twist_rate_inches;
+    zero.zero_range_m = gun.zero_range_m;
+    zero.sight_height_mm = gun.sight_height_mm;
+}
+
+bool ProfileDb::applyIntegrator(const ProfileCartridge& cartridge, IntegratorTuning& tuning) {
+    if (cartridge.integrator_tuned == 0) return false;
+    tuning.method = static_cast<IntegratorMethod>(cartridge.integrator_method);
+    tuning.tolerance_m = cartridge.integrator_tolerance_m;
+    tuning.step_scale_m = cartridge.integrator_step_scale_m;
+    tuning.max_step_m = cartridge.integrator_max_step_m;
+    tuning.transonic_dt_s = cartridge.integrator_transonic_dt_s;
+    tuning.range_step_m = cartridge.integrator_range_step_m;
+    return true;
+}
+
+size_t ProfileDb::buildSize(int cartridge_count, int gun_count) {
+    if (cartridge_count < 0 || gun_count < 0 ||
+        cartridge_count + gun_count >= MAX_INDEX_SLOTS / 2) {
+        return 0;
+    }
+    size_t n = sizeof(ProfileDbHeader);
+    n += static_cast<size_t>(cartridge_count) * sizeof(ProfileCartridge);
+    n += static_cast<size_t>(gun_count) * sizeof(ProfileGun);
+    n += static_cast<size_t>(indexSlots(cartridge_count + gun_count)) * sizeof(ProfileIndexSlot);
+    return alignUp(n);
+}
+
+size_t ProfileDb::build(const ProfileCartridge* cartridges, int cartridge_count,
+                        const ProfileGun* guns, int gun_count, void* out, size_t size) {
+    const size_t total = buildSize(cartridge_count, gun_count);
+    if (total == 0 || !out || size < total || reinterpret_cast<uintptr_t>(out) % 4 != 0 ||
+        (cartridge_count > 0 && !cartridges) || (gun_count > 0 && !guns)) {
+        return 0;
+    }
+    for (int i = 0; i < cartridge_count; ++i) {
+        const uint8_t model = cartridges[i].drag_model;
+        if (!validName(cartridges[i].name) || cartridges[i].bc_band_count > PROFILE_BC_BANDS ||
+            model < static_cast<uint8_t>(DragModel::G1) || model > static_cast<uint8_t>(DragModel::G8) ||
+            (cartridges[i].integrator_tuned != 0 &&
+             cartridges[i].integrator_method > static_cast<uint8_t>(IntegratorMethod::RK4_RANGE))) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < gun_count; ++i) {
+        if (!validName(guns[i].name)) return 0;
+    }
+
+    uint8_t* base = static_cast<uint8_t*>(out);
+    std::memset(base, 0, total);
+    ProfileDbHeader h = {};
+    h.magic = BCE_PROFILE_DB_MAGIC;
+    h.version = BCE_PROFILE_DB_VERSION;
+    h.header_bytes = sizeof(ProfileDbHeader);
+    h.total_bytes = static_cast<uint32_t>(total);
+    h.cartridge_count = static_cast<uint16_t>(cartridge_count);
+    h.gun_count = static_cast<uint16_t>(gun_count);
+    h.index_slots = static_cast<uint16_t>(indexSlots(cartridge_count + gun_count));
+    h.cartridge_offset = sizeof(ProfileDbHeader);
+    h.gun_offset = h.cartridge_offset + static_cast<uint32_t>(cartridge_count * sizeof(ProfileCartridge));
+    h.index_offset = h.gun_offset + static_cast<uint32_t>(gun_count * sizeof(ProfileGun));
+
+    // Records go in with names NUL-padded and unused integrator fields
+    // cleared, so the same inputs always build the same bytes
+    ProfileCartridge* cartridge_out = reinterpret_cast<ProfileCartridge*>(base + h.cartridge_offset);
+    for (int i = 0; i < cartridge_count; ++i) {
+        ProfileCartridge& c = cartridge_out[i];
+        c = cartridges[i];
+        const size_t len = std::strlen(c.name);
+        std::memset(c.name + len, 0, PROFILE_NAME_BYTES - len);
+        if (c.integrator_tuned != 0) {
+            c.integrator_tuned = 1;
+        } else {
+            c.integrator_method = 0;
+            c.integrator_tolerance_m = 0.0f;
+            c.integrator_step_scale_m = 0.0f;
+            c.integrator_max_step_m = 0.0f;
+            c.integrator_transonic_dt_s = 0.0f;
+            c.integrator_range_step_m = 0.0f;
+        }
+    }
+    ProfileGun* gun_out = reinterpret_cast<ProfileGun*>(base + h.gun_offset);
+    for (int i = 0; i < gun_count; ++i) {
+        ProfileGun& g = gun_out[i];
+        g = guns[i];
+        const size_t len = std::strlen(g.name);
+        std::memset(g.name + len, 0, PROFILE_NAME_BYTES - len);
+    }
+
+    // Insert every name; a duplicate within one kind makes the set invalid
+    ProfileIndexSlot* index = reinterpret_cast<ProfileIndexSlot*>(base + h.index_offset);
+    const uint32_t mask = h.index_slots - 1u;
+    auto insert = [&](Kind kind, int record, const char* name) {
+        const uint32_t hash = hashName(name);
+        for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+            ProfileIndexSlot& slot = index[i];
+            if (slot.kind == 0) {
+                slot.hash = hash;
+                slot.kind = kind;
+                slot.record = static_cast<uint16_t>(record);
+                return true;
+            }
+            if (slot.kind == kind && slot.hash == hash) {
+                const char* other = (kind == CARTRIDGE) ? cartridges[slot.record].name
+                                                        : guns[slot.record].name;
+                if (std::strncmp(other, name, PROFILE_NAME_BYTES) == 0) return false;
+            }
+        }
+    };
+    for (int i = 0; i < cartridge_count; ++i) {
+        if (!insert(CARTRIDGE, i, cartridges[i].name)) return 0;
+    }
+    for (int i = 0; i < gun_count; ++i) {
+        if (!insert(GUN, i, guns[i].name)) return 0;
+    }
+
+    h.crc32 = bceCrc32(base + sizeof(ProfileDbHeader), total - sizeof(ProfileDbHeader));
+    std::memcpy(base, &h, sizeof(h));
+    return total;
+}
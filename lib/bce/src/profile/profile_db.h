@@ -0,0 +1,141 @@
+/**
+ * @file profile_db.h
+ * @brief Packed cartridge/gun profile database, read in place.
+ *
+ * A database is one little-endian blob: a ProfileDbHeader, the cartridge
+ * records, the gun records and an open-addressing hash index over all names
+ * (FNV-1a, linear probing, at most half full). Every part sits 4-byte
+ * aligned at the offset the header gives, so a blob linked into flash or
+ * memory-mapped is used as is: open() checks it once (magic, version,
+ * bounds, CRC-32 of everything after the header) and a lookup hashes the
+ * name, probes a slot or two and compares one record. Nothing is copied or
+ * allocated.
+ *
+ * build() writes a database into a caller buffer; the profile_pack tool uses
+ * it to convert the GUI's JSON profile library. A cartridge may carry the
+ * integrator settings integrator_tune found for it. Big-endian hosts read the
+ * magic byte-swapped and reject every blob.
+ */
+
+#pragma once
+
+#include "bce/bce_types.h"
+#include "bce/bce_config.h"
+#include <cstddef>
+#include <cstdint>
+
+constexpr int PROFILE_NAME_BYTES = 32; // including the terminating NUL
+constexpr int PROFILE_BC_BANDS = 4;    // fixed by the format, not BCE_MAX_BC_BANDS
+
+/** Cartridge (load) record: the bullet half of a BulletProfile. */
+struct ProfileCartridge {
+    char name[PROFILE_NAME_BYTES];
+    float bc;
+    float muzzle_velocity_ms;
+    float mass_grains;
+    float caliber_inches;
+    float length_mm;
+    BCBand bc_bands[PROFILE_BC_BANDS];
+    uint8_t drag_model;    // DragModel G1–G8 (custom curves are not stored)
+    uint8_t bc_band_count;
+    uint8_t integrator_tuned;  // 1 = the integrator fields below apply
+    uint8_t integrator_method; // IntegratorMethod
+    float integrator_tolerance_m;
+    float integrator_step_scale_m;
+    float integrator_max_step_m;
+    float integrator_transonic_dt_s;
+    float integrator_range_step_m;
+};
+
+/** Gun record: the rifle half of a BulletProfile, plus its zero. */
+struct ProfileGun {
+    char name[PROFILE_NAME_BYTES];
+    float caliber_inches;  // informational; selection does not check it
+    float barrel_length_in;
+    float mv_adjustment_factor;
+    float twist_rate_inches;
+    float zero_range_m;
+    float sight_height_mm;
+};
+
+struct ProfileIndexSlot {
+    uint32_t hash;         // FNV-1a of the name
+    uint16_t kind;         // 0 = empty, else ProfileDb::Kind
+    uint16_t record;       // index into the records of that kind
+};
+
+struct ProfileDbHeader {
+    uint32_t magic;        // BCE_PROFILE_DB_MAGIC
+    uint16_t version;      // BCE_PROFILE_DB_VERSION
+    uint16_t header_bytes; // sizeof(ProfileDbHeader)
+    uint32_t total_bytes;
+    uint32_t crc32;        // of bytes [header_bytes, total_bytes)
+    uint16_t cartridge_count;
+    uint16_t gun_count;
+    uint16_t index_slots;  // power of two
+    uint16_t reserved;
+    uint32_t cartridge_offset;
+    uint32_t gun_offset;
+    uint32_t index_offset;
+};
+
+static_assert(sizeof(ProfileCartridge) == 108, "ProfileCartridge layout is part of the format");
+static_assert(sizeof(ProfileGun) == 56, "ProfileGun layout is part of the format");
+static_assert(sizeof(ProfileIndexSlot) == 8, "ProfileIndexSlot layout is part of the format");
+static_assert(sizeof(ProfileDbHeader) == 36, "ProfileDbHeader layout is part of the format");
+
+class ProfileDb {
+public:
+    enum Kind : uint16_t { CARTRIDGE = 1, GUN = 2 };
+
+    /** Largest index the uint16 slot count can describe. */
+    static constexpr int MAX_INDEX_SLOTS = 32768;
+
+    /**
+     * Validate a database and read it in place from now on. data must stay
+     * valid and unchanged while the database is open and be 4-byte aligned.
+     * @return false if data is not a valid database (the previous one stays open)
+     */
+    bool open(const void* data, size_t size);
+    void close() { header_ = nullptr; }
+    bool isOpen() const { return header_ != nullptr; }
+
+    int getCartridgeCount() const { return header_ ? header_->cartridge_count : 0; }
+    int getGunCount() const { return header_ ? header_->gun_count : 0; }
+    const ProfileCartridge* getCartridge(int i) const;
+    const ProfileGun* getGun(int i) const;
+
+    /** Hashed lookup by exact name. @return nullptr if absent */
+    const ProfileCartridge* findCartridge(const char* name) const;
+    const ProfileGun* findGun(const char* name) const;
+
+    /** Copy a cartridge's fields into a bullet profile, leaving the gun's. */
+    static void applyCartridge(const ProfileCartridge& cartridge, BulletProfile& bullet);
+    /** Copy a gun's fields into a bullet profile and zero config. */
+    static void applyGun(const ProfileGun& gun, BulletProfile& bullet, ZeroConfig& zero);
+    /** Copy a cartridge's integrator settings. @return false if it has none */
+    static bool applyIntegrator(const ProfileCartridge& cartridge, IntegratorTuning& tuning);
+
+    /** Bytes build() needs for these record counts (0 if too many). */
+    static size_t buildSize(int cartridge_count, int gun_count);
+
+    /**
+     * Write a database of the given records to out (4-byte aligned). Names
+     * must be non-empty, NUL-terminated within PROFILE_NAME_BYTES and unique
+     * per kind; drag models must be G1–G8 and tuned integrators known methods.
+     * @return Bytes written, or 0 if the records are invalid or out is too small
+     */
+    static size_t build(const ProfileCartridge* cartridges, int cartridge_count,
+                        const ProfileGun* guns, int gun_count, void* out, size_t size);
+
+    static uint32_t hashName(const char* name);
+
+private:
+    const ProfileDbHeader* header_ = nullptr;
+    const ProfileCartridge* cartridges_ = nullptr;
+    const ProfileGun* guns_ = nullptr;
+    const ProfileIndexSlot* index_ = nullptr;
+
+    /** Record number of name in the index, or -1. */
+    int find(Kind kind, const char* name) const;
+};
@@ -0,0 +1,372 @@
+/**
+ * @file frame_codec.cpp
+ * @brief Packed SensorFrame stream encoding implementation.
+ */
+
+#include "frame_codec.h"
+#include <cstring>
+
+namespace {
+
+enum Tag : uint8_t {
+    TAG_KEY_FRAME  = 0x01,
+    TAG_FRAME      = 0x02,
+    TAG_BULLET     = 0x10,
+    TAG_ZERO       = 0x11,
+    TAG_INTEGRATOR = 0x12,
+};
+
+// Frame validity flags
+constexpr uint8_t F_IMU      = 1u << 0;
+constexpr uint8_t F_MAG      = 1u << 1;
+constexpr uint8_t F_BARO     = 1u << 2;
+constexpr uint8_t F_HUMIDITY = 1u << 3;
+constexpr uint8_t F_LRF      = 1u << 4;
+constexpr uint8_t F_ENCODER  = 1u << 5;
+
+// bc, drag model, 7 floats, band count, then 2 floats per band
+constexpr size_t BULLET_PAYLOAD_BYTES = 4 + 1 + 7 * 4 + 1 + 8 * BCE_MAX_BC_BANDS;
+static_assert(BULLET_PAYLOAD_BYTES <= 255, "BCE_MAX_BC_BANDS too large for one record");
+
+uint32_t floatBits(float v) {
+    uint32_t b;
+    std::memcpy(&b, &v, sizeof(b));
+    return b;
+}
+
+float bitsFloat(uint32_t b) {
+    float v;
+    std::memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+uint64_t zigzag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+struct Writer {
+    uint8_t* p;
+
+    void u8(uint8_t v) { *p++ = v; }
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; ++i) *p++ = static_cast<uint8_t>(v >> (8 * i));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) *p++ = static_cast<uint8_t>(v >> (8 * i));
+    }
+    void f32(float v) { u32(floatBits(v)); }
+    void varint(uint64_t v) {
+        while (v >= 0x80) {
+            *p++ = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        *p++ = static_cast<uint8_t>(v);
+    }
+    // XOR against the reference, which then follows the value
+    void delta(float v, uint32_t& ref) {
+        uint32_t b = floatBits(v);
+        varint(b ^ ref);
+        ref = b;
+    }
+};
+
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint8_t u8() {
+        if (p >= end) { ok = false; return 0; }
+        return *p++;
+    }
+    uint32_t u32() {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(u8()) << (8 * i);
+        return v;
+    }
+    uint64_t u64() {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(u8()) << (8 * i);
+        return v;
+    }
+    float f32() { return bitsFloat(u32()); }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = u8();
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    float delta(uint32_t& ref) {
+        uint64_t x = varint();
+        if (x > 0xFFFFFFFFull) ok = false;
+        ref ^= static_cast<uint32_t>(x);
+        return bitsFloat(ref);
+    }
+};
+
+// Record framing: tag, length byte, payload written by body
+template <typename Body>
+size_t writeRecord(uint8_t* out, uint8_t tag, Body body) {
+    Writer w{out + 2};
+    body(w);
+    const size_t n = static_cast<size_t>(w.p - (out + 2));
+    out[0] = tag;
+    out[1] = static_cast<uint8_t>(n);
+    return n + 2;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Encoder
+// ---------------------------------------------------------------------------
+
+size_t FrameEncoder::writeHeader(uint8_t* out) {
+    Writer w{out};
+    w.u32(BCE_FRAME_LOG_MAGIC);
+    w.u32(BCE_FRAME_LOG_VERSION);
+    return FRAME_LOG_HEADER_BYTES;
+}
+
+size_t FrameEncoder::encodeFrame(const SensorFrame& f, uint8_t* out) {
+    const bool key = key_pending_;
+    key_pending_ = false;
+    if (key) std::memset(&refs_, 0, sizeof(refs_));
+
+    uint8_t flags = 0;
+    if (f.imu_valid) flags |= F_IMU;
+    if (f.mag_valid) flags |= F_MAG;
+    if (f.baro_valid) flags |= F_BARO;
+    if (f.baro_humidity_valid) flags |= F_HUMIDITY;
+    if (f.lrf_valid) flags |= F_LRF;
+    if (f.encoder_valid) flags |= F_ENCODER;
+
+    return writeRecord(out, key ? TAG_KEY_FRAME : TAG_FRAME, [&](Writer& w) {
+        w.u8(flags);
+        if (key) {
+            w.u64(f.timestamp_us);
+        } else {
+            w.varint(zigzag(static_cast<int64_t>(f.timestamp_us - refs_.timestamp_us)));
+        }
+        refs_.timestamp_us = f.timestamp_us;
+
+        if (f.imu_valid) {
+            w.f32(f.accel_x);
+            w.f32(f.accel_y);
+            w.f32(f.accel_z);
+            w.f32(f.gyro_x);
+            w.f32(f.gyro_y);
+            w.f32(f.gyro_z);
+        }
+        if (f.mag_valid) {
+            w.f32(f.mag_x);
+            w.f32(f.mag_y);
+            w.f32(f.mag_z);
+        }
+        if (f.baro_valid) {
+            w.delta(f.baro_pressure_pa, refs_.baro_pressure);
+            w.delta(f.baro_temperature_c, refs_.baro_temperature);
+            if (f.baro_humidity_valid) w.delta(f.baro_humidity, refs_.baro_humidity);
+        }
+        if (f.lrf_valid) {
+            w.delta(f.lrf_range_m, refs_.lrf_range);
+            w.varint(zigzag(static_cast<int64_t>(f.lrf_timestamp_us - f.timestamp_us)));
+            w.delta(f.lrf_confidence, refs_.lrf_confidence);
+        }
+        if (f.encoder_valid) {
+            w.delta(f.encoder_focal_length_mm, refs_.focal_length);
+        }
+    });
+}
+
+size_t FrameEncoder::encodeBullet(const BulletProfile& b, uint8_t* out) {
+    return writeRecord(out, TAG_BULLET, [&](Writer& w) {
+        w.f32(b.bc);
+        w.u8(static_cast<uint8_t>(b.drag_model));
+        w.f32(b.muzzle_velocity_ms);
+        w.f32(b.barrel_length_in);
+        w.f32(b.mv_adjustment_factor);
+        w.f32(b.mass_grains);
+        w.f32(b.length_mm);
+        w.f32(b.caliber_inches);
+        w.f32(b.twist_rate_inches);
+        const uint8_t bands = (b.bc_band_count < BCE_MAX_BC_BANDS) ? b.bc_band_count
+                                                                    : BCE_MAX_BC_BANDS;
+        w.u8(bands);
+        for (int i = 0; i < bands; ++i) {
+            w.f32(b.bc_bands[i].bc);
+            w.f32(b.bc_bands[i].below_velocity_ms);
+        }
+    });
+}
+
+size_t FrameEncoder::encodeZero(const ZeroConfig& z, uint8_t* out) {
+    return writeRecord(out, TAG_ZERO, [&](Writer& w) {
+        w.f32(z.zero_range_m);
+        w.f32(z.sight_height_mm);
+    });
+}
+
+size_t FrameEncoder::encodeIntegrator(const IntegratorTuning& t, uint8_t* out) {
+    return writeRecord(out, TAG_INTEGRATOR, [&](Writer& w) {
+        w.u8(static_cast<uint8_t>(t.method));
+        w.f32(t.tolerance_m);
+        w.f32(t.step_scale_m);
+        w.f32(t.max_step_m);
+        w.f32(t.transonic_dt_s);
+        w.f32(t.range_step_m);
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Decoder
+// ---------------------------------------------------------------------------
+
+bool FrameDecoder::begin(const uint8_t* data, size_t size) {
+    data_ = data;
+    size_ = size;
+    pos_ = 0;
+    has_key_ = false;
+    std::memset(&refs_, 0, sizeof(refs_));
+    if (data == nullptr || size < FRAME_LOG_HEADER_BYTES) return false;
+
+    Reader r{data, data + FRAME_LOG_HEADER_BYTES};
+    if (r.u32() != BCE_FRAME_LOG_MAGIC || r.u32() != BCE_FRAME_LOG_VERSION) return false;
+    pos_ = FRAME_LOG_HEADER_BYTES;
+    return true;
+}
+
+FrameDecoder::Record FrameDecoder::next() {
+    for (;;) {
+        if (data_ == nullptr || pos_ + 2 > size_) return Record::END;
+        const uint8_t tag = data_[pos_];
+        const size_t n = data_[pos_ + 1];
+        if (pos_ + 2 + n > size_) return Record::END; // cut mid-record
+        const uint8_t* p = data_ + pos_ + 2;
+        pos_ += 2 + n;
+
+        switch (tag) {
+        case TAG_KEY_FRAME:
+        case TAG_FRAME:
+            return decodeFrame(p, n, tag == TAG_KEY_FRAME) ? Record::FRAME : Record::INVALID;
+
+        case TAG_BULLET:
+            return decodeBullet(p, n) ? Record::BULLET : Record::INVALID;
+
+        case TAG_ZERO: {
+            Reader r{p, p + n};
+            zero_.zero_range_m = r.f32();
+            zero_.sight_height_mm = r.f32();
+            return r.ok ? Record::ZERO : Record::INVALID;
+        }
+
+        case TAG_INTEGRATOR: {
+            // Older streams stop after the tolerance: the rest stays default
+            Reader r{p, p + n};
+            IntegratorTuning t = {};
+            t.method = static_cast<IntegratorMethod>(r.u8());
+            t.tolerance_m = r.f32();
+            if (r.p < r.end) {
+                t.step_scale_m = r.f32();
+                t.max_step_m = r.f32();
+                t.transonic_dt_s = r.f32();
+                t.range_step_m = r.f32();
+            }
+            if (!r.ok) return Record::INVALID;
+            integrator_ = t;
+            return Record::INTEGRATOR;
+        }
+
+        default:
+            break; // newer record type: skip
+        }
+    }
+}
+
+bool FrameDecoder::decodeFrame(const uint8_t* p, size_t n, bool key) {
+    if (key) {
+        std::memset(&refs_, 0, sizeof(refs_));
+        has_key_ = true;
+    } else if (!has_key_) {
+        return false;
+    }
+
+    Reader r{p, p + n};
+    SensorFrame& f = frame_;
+    std::memset(&f, 0, sizeof(f));
+
+    const uint8_t flags = r.u8();
+    f.imu_valid = (flags & F_IMU) != 0;
+    f.mag_valid = (flags & F_MAG) != 0;
+    f.baro_valid = (flags & F_BARO) != 0;
+    f.baro_humidity_valid = (flags & F_HUMIDITY) != 0;
+    f.lrf_valid = (flags & F_LRF) != 0;
+    f.encoder_valid = (flags & F_ENCODER) != 0;
+
+    f.timestamp_us = key ? r.u64()
+                         : refs_.timestamp_us + static_cast<uint64_t>(unzigzag(r.varint()));
+    refs_.timestamp_us = f.timestamp_us;
+
+    if (f.imu_valid) {
+        f.accel_x = r.f32();
+        f.accel_y = r.f32();
+        f.accel_z = r.f32();
+        f.gyro_x = r.f32();
+        f.gyro_y = r.f32();
+        f.gyro_z = r.f32();
+    }
+    if (f.mag_valid) {
+        f.mag_x = r.f32();
+        f.mag_y = r.f32();
+        f.mag_z = r.f32();
+    }
+    if (f.baro_valid) {
+        f.baro_pressure_pa = r.delta(refs_.baro_pressure);
+        f.baro_temperature_c = r.delta(refs_.baro_temperature);
+        if (f.baro_humidity_valid) f.baro_humidity = r.delta(refs_.baro_humidity);
+    }
+    if (f.lrf_valid) {
+        f.lrf_range_m = r.delta(refs_.lrf_range);
+        f.lrf_timestamp_us = f.timestamp_us + static_cast<uint64_t>(unzigzag(r.varint()));
+        f.lrf_confidence = r.delta(refs_.lrf_confidence);
+    }
+    if (f.encoder_valid) {
+        f.encoder_focal_length_mm = r.delta(refs_.focal_length);
+    }
+
+    if (!r.ok) has_key_ = false; // references are lost until the next key frame
+    return r.ok;
+}
+
+bool FrameDecoder::decodeBullet(const uint8_t* p, size_t n) {
+    Reader r{p, p + n};
+    BulletProfile b;
+    std::memset(&b, 0, sizeof(b));
+    b.bc = r.f32();
+    b.drag_model = static_cast<DragModel>(r.u8());
+    b.muzzle_velocity_ms = r.f32();
+    b.barrel_length_in = r.f32();
+    b.mv_adjustment_factor = r.f32();
+    b.mass_grains = r.f32();
+    b.length_mm = r.f32();
+    b.caliber_inches = r.f32();
+    b.twist_rate_inches = r.f32();
+    const uint8_t bands = r.u8();
+    for (int i = 0; i < bands; ++i) {
+        const float bc = r.f32();
+        const float below = r.f32();
+        if (i < BCE_MAX_BC_BANDS) b.bc_bands[i] = {bc, below};
+    }
+    b.bc_band_count = (bands < BCE_MAX_BC_BANDS) ? bands : BCE_MAX_BC_BANDS;
+    if (!r.ok) return false;
+    bullet_ = b;
+    return true;
+}
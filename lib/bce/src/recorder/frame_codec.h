@@ -0,0 +1,112 @@
+/**
+ * @file frame_codec.h
+ * @brief Packed, versioned SensorFrame stream encoding.
+ *
+ * A stream is an 8-byte header (BCE_FRAME_LOG_MAGIC, BCE_FRAME_LOG_VERSION)
+ * followed by records of [tag, payload length, payload]; readers skip tags
+ * they do not know. All values are little-endian and floats keep their exact
+ * bits, so a decoded frame drives the engine exactly like the original.
+ *
+ * A frame record stores one byte of validity flags and only the fields of
+ * valid sensors (fields of invalid sensors decode as 0). The timestamp is a
+ * zigzag varint delta from the previous frame, the LRF timestamp a delta from
+ * the frame's own. The slowly changing fields (baro, LRF range and
+ * confidence, focal length) are XORed with their previous value and written
+ * as a varint, so a repeated reading costs one byte. IMU and mag samples are
+ * noise-dominated and stored raw. Key frames carry an absolute timestamp and
+ * restart the XOR references at zero, so they decode on their own; the
+ * encoder writes one first and after every resync().
+ *
+ * Configuration records capture what a replay needs besides the frames: the
+ * bullet profile, zero config and integrator.
+ */
+
+#pragma once
+
+#include "bce/bce_types.h"
+#include "bce/bce_config.h"
+#include <cstddef>
+#include <cstdint>
+
+constexpr size_t FRAME_LOG_HEADER_BYTES = 8;
+constexpr size_t FRAME_LOG_MAX_RECORD_BYTES = 2 + 255;
+
+/** Reference values the delta fields are coded against. */
+struct FrameLogRefs {
+    uint64_t timestamp_us;
+    uint32_t baro_pressure;     // float bits
+    uint32_t baro_temperature;
+    uint32_t baro_humidity;
+    uint32_t lrf_range;
+    uint32_t lrf_confidence;
+    uint32_t focal_length;
+};
+
+class FrameEncoder {
+public:
+    /** Write the stream header (FRAME_LOG_HEADER_BYTES) to out. */
+    static size_t writeHeader(uint8_t* out);
+
+    /** Make the next frame a key frame. */
+    void resync() { key_pending_ = true; }
+
+    /**
+     * Encode one frame record into out (at least FRAME_LOG_MAX_RECORD_BYTES).
+     * @return Bytes written
+     */
+    size_t encodeFrame(const SensorFrame& frame, uint8_t* out);
+
+    static size_t encodeBullet(const BulletProfile& profile, uint8_t* out);
+    static size_t encodeZero(const ZeroConfig& config, uint8_t* out);
+    static size_t encodeIntegrator(const IntegratorTuning& tuning, uint8_t* out);
+
+private:
+    FrameLogRefs refs_ = {};
+    bool key_pending_ = true;
+};
+
+class FrameDecoder {
+public:
+    enum class Record : uint8_t {
+        FRAME,       // frame() holds the decoded frame
+        BULLET,      // bullet()
+        ZERO,        // zero()
+        INTEGRATOR,  // integratorTuning()
+        END,         // no complete record left
+        INVALID      // malformed record, or a delta frame before any key frame
+    };
+
+    /**
+     * Start decoding data[0, size).
+     * @return false if the header is missing or from another format version
+     */
+    bool begin(const uint8_t* data, size_t size);
+
+    /** Decode the next record. */
+    Record next();
+
+    const SensorFrame& frame() const { return frame_; }
+    const BulletProfile& bullet() const { return bullet_; }
+    const ZeroConfig& zero() const { return zero_; }
+    const IntegratorTuning& integratorTuning() const { return integrator_; }
+    IntegratorMethod integratorMethod() const { return integrator_.method; }
+    float integratorTolerance() const { return integrator_.tolerance_m; }
+
+    /** Bytes consumed so far, header included. */
+    size_t offset() const { return pos_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    FrameLogRefs refs_ = {};
+    bool has_key_ = false;
+
+    SensorFrame frame_ = {};
+    BulletProfile bullet_ = {};
+    ZeroConfig zero_ = {};
+    IntegratorTuning integrator_ = {};
+
+    bool decodeFrame(const uint8_t* p, size_t n, bool key);
+    bool decodeBullet(const uint8_t* p, size_t n);
+};
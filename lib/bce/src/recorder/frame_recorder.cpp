@@ -0,0 +1,117 @@
+/**
+ * @file frame_recorder.cpp
+ * @brief Lock-free input recorder implementation.
+ */
+
+#include "frame_recorder.h"
+#include <cstring>
+
+void FrameRecorder::reset() {
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    encoder_.resync();
+    recording_ = false;
+    header_pending_ = false;
+    config_pending_ = false;
+    std::memset(&bullet_, 0, sizeof(bullet_));
+    std::memset(&zero_, 0, sizeof(zero_));
+    integrator_ = IntegratorTuning{};
+    has_bullet_ = false;
+    has_zero_ = false;
+}
+
+void FrameRecorder::start() {
+    if (recording_) return;
+    recording_ = true;
+    header_pending_ = true;
+    config_pending_ = true;
+    encoder_.resync();
+}
+
+void FrameRecorder::recordFrame(const SensorFrame& frame) {
+    if (!recording_) return;
+    if (!flushPending()) {
+        drop();
+        return;
+    }
+    uint8_t rec[FRAME_LOG_MAX_RECORD_BYTES];
+    size_t n = encoder_.encodeFrame(frame, rec);
+    if (!push(rec, n)) drop();
+}
+
+void FrameRecorder::recordBullet(const BulletProfile& profile) {
+    bullet_ = profile;
+    has_bullet_ = true;
+    if (!recording_ || config_pending_) return;
+    uint8_t rec[FRAME_LOG_MAX_RECORD_BYTES];
+    if (!push(rec, FrameEncoder::encodeBullet(profile, rec))) drop();
+}
+
+void FrameRecorder::recordZero(const ZeroConfig& config) {
+    zero_ = config;
+    has_zero_ = true;
+    if (!recording_ || config_pending_) return;
+    uint8_t rec[FRAME_LOG_MAX_RECORD_BYTES];
+    if (!push(rec, FrameEncoder::encodeZero(config, rec))) drop();
+}
+
+void FrameRecorder::recordIntegrator(const IntegratorTuning& tuning) {
+    integrator_ = tuning;
+    if (!recording_ || config_pending_) return;
+    uint8_t rec[FRAME_LOG_MAX_RECORD_BYTES];
+    if (!push(rec, FrameEncoder::encodeIntegrator(tuning, rec))) drop();
+}
+
+size_t FrameRecorder::read(uint8_t* out, size_t size) {
+    if (out == nullptr) return 0;
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    uint32_t n = head - tail;
+    if (n > size) n = static_cast<uint32_t>(size);
+
+    const uint32_t at = tail & MASK;
+    const uint32_t first = (n < CAPACITY - at) ? n : CAPACITY - at;
+    std::memcpy(out, ring_ + at, first);
+    std::memcpy(out + first, ring_, n - first);
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+bool FrameRecorder::flushPending() {
+    if (!header_pending_ && !config_pending_) return true;
+
+    // Header and configuration go in as one unit, so a reader never sees
+    // frames whose configuration was dropped
+    uint8_t buf[FRAME_LOG_HEADER_BYTES + 3 * FRAME_LOG_MAX_RECORD_BYTES];
+    size_t n = 0;
+    if (header_pending_) n += FrameEncoder::writeHeader(buf);
+    if (has_bullet_) n += FrameEncoder::encodeBullet(bullet_, buf + n);
+    if (has_zero_) n += FrameEncoder::encodeZero(zero_, buf + n);
+    n += FrameEncoder::encodeIntegrator(integrator_, buf + n);
+    if (!push(buf, n)) return false;
+
+    header_pending_ = false;
+    config_pending_ = false;
+    return true;
+}
+
+bool FrameRecorder::push(const uint8_t* data, size_t n) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (n > CAPACITY - (head - tail)) return false;
+
+    const uint32_t at = head & MASK;
+    const uint32_t len = static_cast<uint32_t>(n);
+    const uint32_t first = (len < CAPACITY - at) ? len : CAPACITY - at;
+    std::memcpy(ring_ + at, data, first);
+    std::memcpy(ring_, data + first, len - first);
+    head_.store(head + len, std::memory_order_release);
+    return true;
+}
+
+void FrameRecorder::drop() {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    config_pending_ = true;
+    encoder_.resync();
+}
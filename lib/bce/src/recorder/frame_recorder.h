@@ -0,0 +1,76 @@
+/**
+ * @file frame_recorder.h
+ * @brief Lock-free ring buffer of packed engine inputs.
+ *
+ * The engine's update() side appends packed records (frame_codec.h) and a
+ * drain task on any core pulls bytes out with read() to dump them to flash or
+ * UART. One producer, one consumer: each side owns one free-running byte
+ * counter and only reads the other's, so neither blocks and a record is
+ * visible to the reader only once it is complete. A record that does not fit
+ * is dropped whole and counted; the next record then re-sends the
+ * configuration and a key frame, so the stream stays decodable across gaps.
+ */
+
+#pragma once
+
+#include "bce/bce_types.h"
+#include "bce/bce_config.h"
+#include "frame_codec.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class FrameRecorder {
+public:
+    /** Empty the ring and forget the configuration. Not safe against a concurrent read(). */
+    void reset();
+
+    /**
+     * Start recording: queue a stream header, the current configuration and
+     * a key frame ahead of the next frame. No-op while recording.
+     */
+    void start();
+    void stop() { recording_ = false; }
+    bool isRecording() const { return recording_; }
+
+    // --- Producer side (the engine's update() context) ---
+    void recordFrame(const SensorFrame& frame);
+
+    /** Remember the configuration, and record it if recording. */
+    void recordBullet(const BulletProfile& profile);
+    void recordZero(const ZeroConfig& config);
+    void recordIntegrator(const IntegratorTuning& tuning);
+
+    // --- Consumer side (one drain task) ---
+    /** Move up to size recorded bytes into out. @return Bytes copied */
+    size_t read(uint8_t* out, size_t size);
+
+    /** Records dropped because the ring was full. */
+    uint32_t getDropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t CAPACITY = BCE_RECORDER_BUFFER_BYTES;
+    static constexpr uint32_t MASK = CAPACITY - 1;
+
+    uint8_t ring_[CAPACITY];
+    std::atomic<uint32_t> head_{0}; // bytes ever written (producer)
+    std::atomic<uint32_t> tail_{0}; // bytes ever read (consumer)
+    std::atomic<uint32_t> dropped_{0};
+
+    FrameEncoder encoder_;
+    bool recording_ = false;
+    bool header_pending_ = false;
+    bool config_pending_ = false; // re-send configuration before the next frame
+
+    BulletProfile bullet_;
+    ZeroConfig zero_;
+    IntegratorTuning integrator_ = {};
+    bool has_bullet_ = false;
+    bool has_zero_ = false;
+
+    /** Flush the header and configuration if due. @return false if they did not fit */
+    bool flushPending();
+    /** Append n bytes whole, or drop them. */
+    bool push(const uint8_t* data, size_t n);
+    void drop();
+};
@@ -0,0 +1,105 @@
+/**
+ * @file angle_cache.cpp
+ * @brief Launch-angle trajectory cache implementation.
+ */
+
+#include "angle_cache.h"
+#include <cmath>
+#include <cstdlib>
+
+void LaunchAngleCache::reset() {
+    for (Slot& slot : slots_) {
+        slot.valid = false;
+    }
+    extent_m_ = 0.0f;
+    last_fills_ = 0;
+}
+
+bool LaunchAngleCache::sample(BallisticSolver& solver, const SolverParams& params,
+                              float horizon_m, SolverResult& out) {
+    last_fills_ = 0;
+    const float range = params.target_range_m;
+    if (!(range >= 1.0f) || range > static_cast<float>(BCE_MAX_RANGE_M)) {
+        return false;
+    }
+    if (!(range <= extent_m_)) {
+        // Round the new extent up to a whole record so it is fully tabulated
+        const float step = static_cast<float>(BCE_ANGLE_CACHE_RANGE_STEP_M);
+        float extent = (horizon_m > range) ? horizon_m : range;
+        extent = std::ceil(extent / step) * step;
+        if (extent > static_cast<float>(BCE_MAX_RANGE_M)) extent = static_cast<float>(BCE_MAX_RANGE_M);
+        reset();
+        extent_m_ = extent;
+    }
+
+    // Stencil of grid angles base-1 .. base+2 around the launch angle
+    float u = params.launch_angle_rad / BCE_ANGLE_CACHE_STEP_RAD;
+    float base_f = std::floor(u);
+    int32_t base = static_cast<int32_t>(base_f);
+    float t = u - base_f;
+
+    const float w[4] = {
+        -t * (t - 1.0f) * (t - 2.0f) / 6.0f,
+        (t + 1.0f) * (t - 1.0f) * (t - 2.0f) / 2.0f,
+        -(t + 1.0f) * t * (t - 2.0f) / 2.0f,
+        (t + 1.0f) * t * (t - 1.0f) / 6.0f,
+    };
+
+    TrajectoryPoint tp = {};
+    const float step = static_cast<float>(BCE_ANGLE_CACHE_RANGE_STEP_M);
+    for (int k = 0; k < 4; ++k) {
+        const Slot& slot = acquire(solver, params, base - 1 + k, base);
+        TrajectoryPoint p;
+        if (!BallisticSolver::interpolateTable(slot.table, slot.last, step, range, p)) {
+            return false;
+        }
+        tp.drop_m += w[k] * p.drop_m;
+        tp.windage_m += w[k] * p.windage_m;
+        tp.velocity_ms += w[k] * p.velocity_ms;
+        tp.tof_s += w[k] * p.tof_s;
+    }
+    tp.energy_j = 0.5f * params.bullet_mass_kg * tp.velocity_ms * tp.velocity_ms;
+
+    out = BallisticSolver::buildResult(params, tp, range);
+    return true;
+}
+
+const LaunchAngleCache::Slot& LaunchAngleCache::acquire(BallisticSolver& solver,
+                                                        const SolverParams& params,
+                                                        int32_t grid_index,
+                                                        int32_t stencil_base) {
+    // Distance from the stencil centre (base + ½), doubled to stay integral;
+    // stencil members score ≤ 3, so they are never chosen as the victim
+    auto distance = [&](int32_t index) {
+        return std::abs(2 * (index - stencil_base) - 1);
+    };
+
+    Slot* victim = &slots_[0];
+    for (Slot& slot : slots_) {
+        if (slot.valid && slot.grid_index == grid_index) {
+            return slot;
+        }
+        if (!victim->valid) continue;
+        if (!slot.valid || distance(slot.grid_index) > distance(victim->grid_index)) {
+            victim = &slot;
+        }
+    }
+
+    SolverParams p = params;
+    p.launch_angle_rad = static_cast<float>(grid_index) * BCE_ANGLE_CACHE_STEP_RAD;
+    solver.integrateTrajectory(p, extent_m_);
+    last_fills_++;
+
+    // Records past the solver's tabulated range are left out; a slot that
+    // never reached 1 m keeps last = 0 and fails every sample
+    const int reach = solver.getMaxValidRange() / BCE_ANGLE_CACHE_RANGE_STEP_M;
+    victim->last = 0;
+    for (int i = 0; i <= reach; ++i) {
+        const float r = static_cast<float>(i * BCE_ANGLE_CACHE_RANGE_STEP_M);
+        if (!solver.getPointAtRange(r, victim->table[i])) break;
+        victim->last = i;
+    }
+    victim->grid_index = grid_index;
+    victim->valid = true;
+    return *victim;
+}
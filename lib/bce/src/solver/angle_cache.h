@@ -0,0 +1,57 @@
+/**
+ * @file angle_cache.h
+ * @brief Launch-angle trajectory cache — drop and TOF over angle and range.
+ *
+ * For a fixed bullet, atmosphere and wind, the trajectory changes from frame
+ * to frame only through the launch angle (zero angle + bore pitch). The cache
+ * keeps coarse trajectory tables for launch angles on a uniform grid of
+ * BCE_ANGLE_CACHE_STEP_RAD. A solve interpolates each of the four grid angles
+ * around the requested one in range (cubic Hermite) and then across angle
+ * (four-point Lagrange), so tilting the rifle costs one integration per new
+ * grid angle instead of one per frame. The caller owns the fingerprint and
+ * calls reset() when anything other than the angle or range changes.
+ */
+
+#pragma once
+
+#include "bce/bce_config.h"
+#include "solver.h"
+#include <cstdint>
+
+class LaunchAngleCache {
+public:
+    /** Drop every slot and the tabulated extent. */
+    void reset();
+
+    /**
+     * Solve params by interpolation, integrating any missing grid angles with
+     * solver (its own table is overwritten when that happens). If the target
+     * lies past the tabulated extent, the slots are rebuilt out to horizon_m.
+     * @return false if a grid angle does not reach the target range; the
+     *         caller should fall back to integrating params directly
+     */
+    bool sample(BallisticSolver& solver, const SolverParams& params, float horizon_m,
+                SolverResult& out);
+
+    /** Grid angles integrated by the most recent sample() call. */
+    uint32_t getLastFills() const { return last_fills_; }
+
+    /** Range the slots are tabulated to (0 when empty). */
+    float getExtent() const { return extent_m_; }
+
+private:
+    struct Slot {
+        TrajectoryPoint table[BCE_ANGLE_CACHE_TABLE_SIZE];
+        int32_t grid_index = 0; // launch angle = grid_index × BCE_ANGLE_CACHE_STEP_RAD
+        int last = 0;           // highest valid record
+        bool valid = false;
+    };
+
+    Slot slots_[BCE_ANGLE_CACHE_SLOTS];
+    float extent_m_ = 0.0f;
+    uint32_t last_fills_ = 0;
+
+    /** Slot holding grid_index, integrating it over the farthest-off slot if needed. */
+    const Slot& acquire(BallisticSolver& solver, const SolverParams& params,
+                        int32_t grid_index, int32_t stencil_base);
+};
@@ -0,0 +1,229 @@
+/**
+ * @file batch_solver.cpp
+ * @brief Lockstep RK4 batch solver implementation.
+ *
+ * Follows the step-size rules and RK4 arithmetic of
+ * BallisticSolver::integrateToRange() lane by lane, so each lane reproduces
+ * the scalar RK4 trajectory. Per-lane loops carry no cross-lane dependencies;
+ * the drag curve lookup is the only gather.
+ */
+
+#include "batch_solver.h"
+#include "../drag/drag_model.h"
+#include "../math/fast_math.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr int L = BCE_BATCH_LANES;
+}
+
+int BatchSolver::solve(const SolverParams* params, int count, SolverResult* out) {
+    if (!params || !out || count <= 0) return 0;
+
+    int valid = 0;
+    for (int base = 0; base < count; base += L) {
+        int lanes = (count - base < L) ? count - base : L;
+        valid += solveChunk(params + base, lanes, out + base);
+    }
+    return valid;
+}
+
+int BatchSolver::solveChunk(const SolverParams* params, int lanes, SolverResult* out) {
+    // Per-lane constants
+    DragContext drag[L];
+    float headwind[L], crosswind[L], sos[L], target[L];
+    float step_scale[L], max_step[L], transonic_dt[L];
+
+    // Per-lane state (current, start of step) and step size
+    float x[L], y[L], z[L], vx[L], vy[L], vz[L], t[L];
+    float x0[L], y0[L], z0[L], vx0[L], vy0[L], vz0[L], t0[L];
+    float dt[L];
+    bool active[L];
+
+    for (int l = 0; l < L; ++l) {
+        // Pad a short chunk by repeating lane 0; padded lanes start inactive
+        const SolverParams& p = params[(l < lanes) ? l : 0];
+
+        float drag_scale = p.drag_reference_scale;
+        if (!std::isfinite(drag_scale) || drag_scale <= 0.0f) drag_scale = 1.0f;
+        if (drag_scale < 0.2f) drag_scale = 0.2f;
+        if (drag_scale > 2.0f) drag_scale = 2.0f;
+        drag[l] = DragModelLookup::makeContext(p.drag_model, p.speed_of_sound, p.bc,
+                                               p.air_density, drag_scale);
+        DragModelLookup::setBands(drag[l], p.bc_band_velocity_ms, p.bc_band_ratio,
+                                  p.bc_band_count);
+        headwind[l] = p.headwind_ms;
+        crosswind[l] = p.crosswind_ms;
+        sos[l] = p.speed_of_sound;
+        target[l] = p.target_range_m;
+        step_scale[l] = (p.integrator_step_scale_m > 0.0f) ? p.integrator_step_scale_m
+                                                           : BCE_RK4_STEP_SCALE_M;
+        max_step[l] = (p.integrator_max_step_m > 0.0f) ? p.integrator_max_step_m
+                                                       : BCE_MAX_STEP_DISTANCE_M;
+        transonic_dt[l] = (p.integrator_transonic_dt_s > 0.0f) ? p.integrator_transonic_dt_s
+                                                               : BCE_DT_MIN;
+
+        x[l] = 0.0f;
+        y[l] = 0.0f;
+        z[l] = 0.0f;
+        vx[l] = p.muzzle_velocity_ms * std::cos(p.launch_angle_rad);
+        vy[l] = p.muzzle_velocity_ms * std::sin(p.launch_angle_rad);
+        vz[l] = 0.0f;
+        t[l] = 0.0f;
+        dt[l] = 0.0f;
+
+        active[l] = (l < lanes) && target[l] >= 1.0f &&
+                    target[l] <= static_cast<float>(BCE_MAX_RANGE_M);
+        if (l < lanes) std::memset(&out[l], 0, sizeof(out[l]));
+    }
+
+    // Stage accelerations for every lane at the given velocities
+    auto acceleration = [&](const float* svx, const float* svy, const float* svz,
+                            float* ax, float* ay, float* az) {
+        for (int l = 0; l < L; ++l) {
+            float vx_rel = svx[l] + headwind[l];
+            float vz_rel = svz[l] - crosswind[l];
+#if BCE_FAST_MATH
+            float v2 = vx_rel * vx_rel + svy[l] * svy[l] + vz_rel * vz_rel;
+            float inv_v = (v2 >= 1.0f) ? bceRsqrt(v2) : 0.0f;
+            float v_rel = v2 * inv_v;
+
+            // Below 1 m/s only gravity acts
+            float decel = 0.0f;
+            if (v_rel >= 1.0f) {
+                decel = DragModelLookup::getBandedDeceleration(drag[l], v_rel);
+            }
+            ax[l] = -decel * (vx_rel * inv_v);
+            ay[l] = -decel * (svy[l] * inv_v) - BCE_GRAVITY;
+            az[l] = -decel * (vz_rel * inv_v);
+#else
+            float v_rel = std::sqrt(vx_rel * vx_rel + svy[l] * svy[l] + vz_rel * vz_rel);
+
+            // Below 1 m/s only gravity acts; the divisor stays finite
+            float decel = 0.0f;
+            float div = 1.0f;
+            if (v_rel >= 1.0f) {
+                decel = DragModelLookup::getBandedDeceleration(drag[l], v_rel);
+                div = v_rel;
+            }
+            ax[l] = -decel * (vx_rel / div);
+            ay[l] = -decel * (svy[l] / div) - BCE_GRAVITY;
+            az[l] = -decel * (vz_rel / div);
+#endif
+        }
+    };
+
+    float k1x[L], k1y[L], k1z[L], k2x[L], k2y[L], k2z[L];
+    float k3x[L], k3y[L], k3z[L], k4x[L], k4y[L], k4z[L];
+    float svx[L], svy[L], svz[L];
+    float sv2x[L], sv2y[L], sv2z[L], sv3x[L], sv3y[L], sv3z[L];
+
+    int solved = 0;
+    for (uint32_t iteration = 0; iteration < BCE_MAX_SOLVER_ITERATIONS; ++iteration) {
+        // Mask out lanes that terminated; inactive lanes step with dt = 0
+        int running = 0;
+        for (int l = 0; l < L; ++l) {
+            float v = bceSqrt(vx[l] * vx[l] + vy[l] * vy[l] + vz[l] * vz[l]);
+            if (v < BCE_MIN_VELOCITY) active[l] = false;
+            running += active[l] ? 1 : 0;
+
+            x0[l] = x[l]; y0[l] = y[l]; z0[l] = z[l];
+            vx0[l] = vx[l]; vy0[l] = vy[l]; vz0[l] = vz[l];
+            t0[l] = t[l];
+
+            // Same step rule as the scalar RK4 path
+            float mach = v / sos[l];
+            float h = (mach > 0.9f && mach < 1.2f) ? transonic_dt[l] : step_scale[l] / v;
+            float h_from_step = max_step[l] / v;
+            if (h > h_from_step) h = h_from_step;
+            if (h < BCE_DT_MIN) h = BCE_DT_MIN;
+            if (h > BCE_DT_MAX) h = BCE_DT_MAX;
+            dt[l] = active[l] ? h : 0.0f;
+        }
+        if (running == 0) break;
+
+        acceleration(vx, vy, vz, k1x, k1y, k1z);
+        for (int l = 0; l < L; ++l) {
+            svx[l] = vx[l] + 0.5f * dt[l] * k1x[l];
+            svy[l] = vy[l] + 0.5f * dt[l] * k1y[l];
+            svz[l] = vz[l] + 0.5f * dt[l] * k1z[l];
+        }
+        acceleration(svx, svy, svz, k2x, k2y, k2z);
+        for (int l = 0; l < L; ++l) {
+            sv2x[l] = svx[l];
+            sv2y[l] = svy[l];
+            sv2z[l] = svz[l];
+            svx[l] = vx[l] + 0.5f * dt[l] * k2x[l];
+            svy[l] = vy[l] + 0.5f * dt[l] * k2y[l];
+            svz[l] = vz[l] + 0.5f * dt[l] * k2z[l];
+        }
+        acceleration(svx, svy, svz, k3x, k3y, k3z);
+        for (int l = 0; l < L; ++l) {
+            sv3x[l] = svx[l];
+            sv3y[l] = svy[l];
+            sv3z[l] = svz[l];
+            svx[l] = vx[l] + dt[l] * k3x[l];
+            svy[l] = vy[l] + dt[l] * k3y[l];
+            svz[l] = vz[l] + dt[l] * k3z[l];
+        }
+        acceleration(svx, svy, svz, k4x, k4y, k4z);
+
+        for (int l = 0; l < L; ++l) {
+            float w = dt[l] / 6.0f;
+            x[l] += w * (vx[l] + 2.0f * sv2x[l] + 2.0f * sv3x[l] + svx[l]);
+            vx[l] += w * (k1x[l] + 2.0f * k2x[l] + 2.0f * k3x[l] + k4x[l]);
+            y[l] += w * (vy[l] + 2.0f * sv2y[l] + 2.0f * sv3y[l] + svy[l]);
+            vy[l] += w * (k1y[l] + 2.0f * k2y[l] + 2.0f * k3y[l] + k4y[l]);
+            z[l] += w * (vz[l] + 2.0f * sv2z[l] + 2.0f * sv3z[l] + svz[l]);
+            vz[l] += w * (k1z[l] + 2.0f * k2z[l] + 2.0f * k3z[l] + k4z[l]);
+            t[l] += dt[l];
+        }
+
+        // Lanes that crossed their target this step: reconstruct the state
+        // at the crossing exactly as the scalar table fill does, then retire
+        for (int l = 0; l < lanes; ++l) {
+            if (!active[l] || x[l] < target[l]) continue;
+            active[l] = false;
+
+            float h = dt[l];
+            float xc = target[l];
+            float s = (x[l] > x0[l]) ? (xc - x0[l]) / (x[l] - x0[l]) : 1.0f;
+            for (int k = 0; k < 2 && x[l] > x0[l]; ++k) {
+                float s2 = s * s;
+                float s3 = s2 * s;
+                float xs = (2.0f * s3 - 3.0f * s2 + 1.0f) * x0[l] +
+                           (s3 - 2.0f * s2 + s) * h * vx0[l] +
+                           (-2.0f * s3 + 3.0f * s2) * x[l] + (s3 - s2) * h * vx[l];
+                float dxs = (6.0f * s2 - 6.0f * s) * x0[l] +
+                            (3.0f * s2 - 4.0f * s + 1.0f) * h * vx0[l] +
+                            (-6.0f * s2 + 6.0f * s) * x[l] + (3.0f * s2 - 2.0f * s) * h * vx[l];
+                if (!(dxs > 0.0f)) break;
+                s -= (xs - xc) / dxs;
+                if (s < 0.0f) s = 0.0f;
+                if (s > 1.0f) s = 1.0f;
+            }
+            float s2 = s * s;
+            float s3 = s2 * s;
+            float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+            float h10 = s3 - 2.0f * s2 + s;
+            float h01 = -2.0f * s3 + 3.0f * s2;
+            float h11 = s3 - s2;
+
+            TrajectoryPoint tp;
+            tp.drop_m = h00 * y0[l] + h10 * h * vy0[l] + h01 * y[l] + h11 * h * vy[l];
+            tp.windage_m = h00 * z0[l] + h10 * h * vz0[l] + h01 * z[l] + h11 * h * vz[l];
+            float vxc = vx0[l] + s * (vx[l] - vx0[l]);
+            float vyc = vy0[l] + s * (vy[l] - vy0[l]);
+            float vzc = vz0[l] + s * (vz[l] - vz0[l]);
+            tp.velocity_ms = bceSqrt(vxc * vxc + vyc * vyc + vzc * vzc);
+            tp.tof_s = t0[l] + s * h;
+            tp.energy_j = 0.5f * params[l].bullet_mass_kg * tp.velocity_ms * tp.velocity_ms;
+
+            out[l] = BallisticSolver::buildResult(params[l], tp, target[l]);
+            solved++;
+        }
+    }
+
+    return solved;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file batch_solver.h
+ * @brief Lockstep RK4 solver for many independent trajectories.
+ *
+ * Integrates BCE_BATCH_LANES trajectories at a time with their state held in
+ * structure-of-arrays layout, so each RK4 stage is a loop over lanes the
+ * compiler can vectorize. Lanes that reach their target range or fall below
+ * BCE_MIN_VELOCITY are masked out (their timestep is forced to zero) while
+ * the rest of the batch keeps stepping. No trajectory table is kept.
+ */
+
+#pragma once
+
+#include "solver.h"
+
+class BatchSolver {
+public:
+    /**
+     * Solve one trajectory per params entry, in chunks of BCE_BATCH_LANES.
+     * Each result matches BallisticSolver::integrate() with the RK4
+     * integrator and the entry's RK4 step controls; params.integrator is
+     * ignored.
+     *
+     * @param params  count solver parameter sets (target_range_m per entry)
+     * @param count   Number of trajectories
+     * @param out     Caller-owned array of count results
+     * @return Number of results with valid = true
+     */
+    static int solve(const SolverParams* params, int count, SolverResult* out);
+
+private:
+    static int solveChunk(const SolverParams* params, int lanes, SolverResult* out);
+};
@@ -0,0 +1,128 @@
+/**
+ * @file compact_table.cpp
+ * @brief Fixed-point trajectory table implementation.
+ */
+
+#include "compact_table.h"
+#include "solver.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr float CODE_MAX = 65535.0f;
+
+// Starting quantizer steps, a little below the final resolution of a typical
+// table so most tables widen once or twice
+constexpr float INITIAL_STEP[4] = {
+    1.0e-6f,  // drop below reference line, m per m
+    1.0e-7f,  // windage, m per m
+    5.0e-3f,  // velocity, m/s
+    2.0e-8f,  // TOF, s per m
+};
+} // namespace
+
+void CompactTrajectoryTable::clear() {
+    std::memset(codes_, 0, sizeof(codes_));
+    std::memset(quant_, 0, sizeof(quant_));
+    slope_ = 0.0f;
+    mass_kg_ = 0.0f;
+    records_ = 0;
+}
+
+void CompactTrajectoryTable::store(int i, const TrajectoryPoint& tp) {
+    if (i < 0 || i >= BCE_TRAJ_TABLE_SIZE) return;
+
+    if (i == 0) {
+        std::memset(quant_, 0, sizeof(quant_));
+        slope_ = 0.0f;
+        records_ = 0;
+        float v2 = tp.velocity_ms * tp.velocity_ms;
+        mass_kg_ = (v2 > 0.0f) ? 2.0f * tp.energy_j / v2 : 0.0f;
+        codes_[0][DROP] = codes_[0][WINDAGE] = codes_[0][TOF] = 0;
+        codes_[0][VELOCITY] = encode(VELOCITY, tp.velocity_ms);
+        records_ = 1;
+        return;
+    }
+
+    const float r = static_cast<float>(i * BCE_TRAJ_TABLE_STRIDE_M);
+    if (i == 1) {
+        slope_ = tp.drop_m / r;
+    }
+    // Count the record first: a widen() re-encodes only the field being
+    // encoded, whose code for this record is overwritten right after
+    if (i + 1 > records_) records_ = i + 1;
+    codes_[i][DROP] = encode(DROP, tp.drop_m / r - slope_);
+    codes_[i][WINDAGE] = encode(WINDAGE, tp.windage_m / r);
+    codes_[i][VELOCITY] = encode(VELOCITY, tp.velocity_ms);
+    codes_[i][TOF] = encode(TOF, tp.tof_s / r);
+}
+
+TrajectoryPoint CompactTrajectoryTable::load(int i) const {
+    if (i < 0) i = 0;
+    if (i >= BCE_TRAJ_TABLE_SIZE) i = BCE_TRAJ_TABLE_SIZE - 1;
+
+    auto decode = [&](Field f) {
+        return quant_[f].offset + quant_[f].step * static_cast<float>(codes_[i][f]);
+    };
+
+    TrajectoryPoint tp;
+    tp.velocity_ms = decode(VELOCITY);
+    tp.energy_j = 0.5f * mass_kg_ * tp.velocity_ms * tp.velocity_ms;
+    if (i == 0) {
+        tp.drop_m = 0.0f;
+        tp.windage_m = 0.0f;
+        tp.tof_s = 0.0f;
+        return tp;
+    }
+    const float r = static_cast<float>(i * BCE_TRAJ_TABLE_STRIDE_M);
+    tp.drop_m = r * (slope_ + decode(DROP));
+    tp.windage_m = r * decode(WINDAGE);
+    tp.tof_s = r * decode(TOF);
+    return tp;
+}
+
+uint16_t CompactTrajectoryTable::encode(Field field, float value) {
+    if (!std::isfinite(value)) value = 0.0f;
+    Quantizer& q = quant_[field];
+    if (q.step == 0.0f) {
+        // First value sits mid-span so it can move either way
+        q.step = INITIAL_STEP[field];
+        q.offset = value - 0.5f * CODE_MAX * q.step;
+        q.lo = q.hi = value;
+    }
+    float code = std::round((value - q.offset) / q.step);
+    if (code < 0.0f || code > CODE_MAX) {
+        widen(field, value);
+        code = std::round((value - q.offset) / q.step);
+        if (code < 0.0f) code = 0.0f;
+        if (code > CODE_MAX) code = CODE_MAX;
+    }
+    if (value < q.lo) q.lo = value;
+    if (value > q.hi) q.hi = value;
+    return static_cast<uint16_t>(code);
+}
+
+void CompactTrajectoryTable::widen(Field field, float value) {
+    Quantizer& q = quant_[field];
+    const Quantizer old = q;
+
+    float lo = (value < old.lo) ? value : old.lo;
+    float hi = (value > old.hi) ? value : old.hi;
+
+    // At least double, anchored at the far extreme so all headroom (a
+    // quarter of the span or more) lies on the side that overflowed
+    float step = (hi - lo) * 1.25f / CODE_MAX;
+    if (step < 2.0f * old.step) step = 2.0f * old.step;
+    float span = CODE_MAX * step;
+    q.step = step;
+    q.offset = (value < old.offset) ? hi - span : lo;
+
+    const int first = (field == VELOCITY) ? 0 : 1;
+    for (int i = first; i < records_; ++i) {
+        float v = old.offset + old.step * static_cast<float>(codes_[i][field]);
+        float code = std::round((v - q.offset) / q.step);
+        if (code < 0.0f) code = 0.0f;
+        if (code > CODE_MAX) code = CODE_MAX;
+        codes_[i][field] = static_cast<uint16_t>(code);
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file compact_table.h
+ * @brief Fixed-point trajectory table — 8 bytes per record instead of 20.
+ *
+ * Each record keeps drop, windage, velocity and TOF as uint16 codes with a
+ * per-table offset and step per field; energy is dropped and recomputed
+ * from velocity and the bullet mass. Drop, windage and TOF are stored
+ * range-normalized (per meter of downrange travel), with drop taken
+ * relative to the line through the muzzle and the first record, so the
+ * codes resolve angles rather than absolute meters and short ranges keep
+ * their precision. Record 0 (the muzzle) only stores velocity.
+ *
+ * The quantizer steps are not known until the table is complete, so each
+ * field starts fine and widens (at least doubling, then re-encoding the
+ * records already stored) when a value falls outside its span. Worst-case
+ * error is about one final step per field: ~0.005 MOA in drop for a flat
+ * 2500 m .308 table, ~0.01 MOA for one shot 20° uphill.
+ *
+ * Always compiled so tests can compare it to the float table; it only
+ * backs BallisticSolver when BCE_TRAJ_TABLE_COMPACT is set.
+ */
+
+#pragma once
+
+#include "bce/bce_config.h"
+#include <cstdint>
+
+struct TrajectoryPoint;
+
+class CompactTrajectoryTable {
+public:
+    /** Drop all records. */
+    void clear();
+
+    /**
+     * Store record i (downrange i × BCE_TRAJ_TABLE_STRIDE_M). Storing record
+     * 0 starts a new table, record 1 fixes the drop reference line; later
+     * records may follow in any order.
+     */
+    void store(int i, const TrajectoryPoint& tp);
+
+    /**
+     * Decode record i. Only stored records are meaningful: any other record
+     * i > 0 decodes code 0, i.e. each field's quantizer offset, so callers
+     * read only the range the solver has tabulated.
+     */
+    TrajectoryPoint load(int i) const;
+
+private:
+    enum Field { DROP = 0, WINDAGE, VELOCITY, TOF, FIELD_COUNT };
+
+    /** value = offset + step × code; step = 0 until the first value */
+    struct Quantizer {
+        float offset;
+        float step;
+        float lo, hi; // extremes encoded so far
+    };
+
+    uint16_t codes_[BCE_TRAJ_TABLE_SIZE][FIELD_COUNT];
+    Quantizer quant_[FIELD_COUNT];
+    float slope_ = 0.0f;    // drop reference line (m per m)
+    float mass_kg_ = 0.0f;  // recovered from record 0's energy
+    int records_ = 0;       // highest stored index + 1
+
+    uint16_t encode(Field field, float value);
+    void widen(Field field, float value);
+};
@@ -2,7 +2,8 @@
  * @file solver.cpp
  * @brief Point-mass ballistic trajectory solver implementation.
  *
- * Uses an adaptive fourth-order Runge-Kutta (RK4) integrator.
+ * Uses an adaptive fourth-order Runge-Kutta (RK4) integrator, or
+ * Dormand–Prince 5(4), or RK4 in downrange distance.
  * All state stored in static trajectory table — zero heap allocation.
  *
  * Coordinate system:
@@ -12,30 +13,62 @@
  */
 
 #include "solver.h"
+#include "zero_search.h"
 #include "../drag/drag_model.h"
+#include "../math/fast_math.h"
 #include <cmath>
 #include <cstring>
 
+namespace {
+
+// Drag context for a solve, with drag_reference_scale validated and the BC
+// bands folded in
+DragContext makeDragContext(const SolverParams& params) {
+    float drag_scale = params.drag_reference_scale;
+    if (!std::isfinite(drag_scale) || drag_scale <= 0.0f) drag_scale = 1.0f;
+    if (drag_scale < 0.2f) drag_scale = 0.2f;
+    if (drag_scale > 2.0f) drag_scale = 2.0f;
+    DragContext drag = DragModelLookup::makeContext(params.drag_model, params.speed_of_sound,
+                                                    params.bc, params.air_density, drag_scale);
+    DragModelLookup::setBands(drag, params.bc_band_velocity_ms, params.bc_band_ratio,
+                              params.bc_band_count);
+    return drag;
+}
+
+} // namespace
+
 void BallisticSolver::init() {
+#if BCE_TRAJ_TABLE_COMPACT
+    table_.clear();
+#else
     std::memset(table_, 0, sizeof(table_));
-    max_valid_range_ = 0;
+#endif
+    resetTable();
+    last_zero_iterations_ = 0;
+    last_zero_coarse_iterations_ = 0;
+    last_step_count_ = 0;
+    job_ = Job::NONE;
+#if BCE_ENABLE_PROFILING
+    perf_steps_ = 0;
+    perf_drag_lookups_ = 0;
+#endif
 }
 
-float BallisticSolver::solveZeroAngle(SolverParams params, float zero_range_m) {
+float BallisticSolver::solveZeroAngle(SolverParams params, float zero_range_m,
+                                      float initial_guess_rad) {
+    last_zero_iterations_ = 0;
+    last_zero_coarse_iterations_ = 0;
     if (zero_range_m < 1.0f || zero_range_m > BCE_MAX_RANGE_M) {
         return NAN;
     }
 
-    // Binary search for the launch angle that makes the bullet's trajectory
-    // intersect the line of sight at the specified zero range.
+    // Find the launch angle that makes the bullet's trajectory intersect the
+    // line of sight at the specified zero range.
     //
     // The sight is mounted above the bore, so the line of sight is a straight
     // line from the sight to the target. The barrel must be angled slightly
     // upward for the bullet to follow an arc that intersects this line.
 
-    float lo = -5.0f * BCE_DEG_TO_RAD;        // -5 degrees (bore pointing down)
-    float hi = 5.0f * BCE_DEG_TO_RAD;         // +5 degrees (bore pointing up)
-
     float sight_h = params.sight_height_m;
 
     // The line of sight (LOS) is a straight line. At range x, its height
@@ -56,47 +89,74 @@ float BallisticSolver::solveZeroAngle(SolverParams params, float zero_range_m) {
 
     float target_drop = -sight_h;
 
-    float best_angle = 0.0f;
-    bool solved = false;
+    // Residual: positive means the bullet lands too high. NAN if the
+    // trajectory terminated before the zero range.
+    ZeroSearch search;
+    float slope = NAN;
+    if (useCoarseZeroPass(params)) {
+        // Converge on the cheap integrator, then hand its angle and slope
+        // to the full-fidelity search
+        SolverParams coarse = coarseZeroParams(params);
+        search.start(ZERO_LO_BOUND_RAD, ZERO_HI_BOUND_RAD, initial_guess_rad);
+        while (!search.done()) {
+            coarse.launch_angle_rad = search.angle();
+            search.feed(integrateToRange(coarse, zero_range_m, false) - target_drop);
+        }
+        last_zero_coarse_iterations_ = search.getEvaluations();
+        if (std::isfinite(search.result())) {
+            initial_guess_rad = search.result();
+            slope = search.getSlope();
+        }
+    }
 
-    for (uint32_t i = 0; i < BCE_ZERO_MAX_ITERATIONS; ++i) {
-        float mid = (lo + hi) * 0.5f;
-        params.launch_angle_rad = mid;
+    search.start(ZERO_LO_BOUND_RAD, ZERO_HI_BOUND_RAD, initial_guess_rad, slope);
+    while (!search.done()) {
+        params.launch_angle_rad = search.angle();
+        search.feed(integrateToRange(params, zero_range_m, false) - target_drop);
+    }
+    last_zero_iterations_ = search.getEvaluations();
+    return search.result();
+}
 
-        float drop = integrateToRange(params, zero_range_m, false);
-        if (std::isnan(drop)) {
-            // Bullet didn't reach. This can happen if the angle is too low,
-            // causing the trajectory to terminate early. We need more angle.
-            lo = mid;
-            continue;
-        }
+bool BallisticSolver::useCoarseZeroPass(const SolverParams& params) {
+    // Only the fixed-step time-domain RK4 pays for the extra pass;
+    // Dormand–Prince and the range-domain RK4 are already cheap per zero
+    return BCE_ZERO_COARSE_PASS && params.integrator == IntegratorMethod::RK4;
+}
 
-        // If the drop is greater than the target drop, it means the bullet
-        // hit too low. We need to increase the launch angle.
-        if (drop > target_drop) {
-            hi = mid;
-        } else {
-            lo = mid;
-        }
+SolverParams BallisticSolver::coarseZeroParams(const SolverParams& params) {
+    SolverParams coarse = params;
+    coarse.integrator = IntegratorMethod::RK4_RANGE;
+    coarse.integrator_tolerance_m = 0.0f;
+    coarse.integrator_range_step_m = 0.0f;
+    return coarse;
+}
 
-        best_angle = mid;
+SolverResult BallisticSolver::integrate(const SolverParams& params) {
+    SolverResult result;
+    std::memset(&result, 0, sizeof(result));
+    result.valid = false;
 
-        if (std::fabs(drop - target_drop) < BCE_ZERO_TOLERANCE_M) {
-            solved = true;
-            break;
-        }
+    if (params.target_range_m < 1.0f || params.target_range_m > BCE_MAX_RANGE_M) {
+        return result;
     }
 
-    // Final check: if the loop finished without converging, we might still
-    // be close.
-    if (!solved && std::fabs(integrateToRange(params, zero_range_m, false) - target_drop) < BCE_ZERO_TOLERANCE_M) {
-        solved = true;
+    // Run full integration, filling the trajectory table out to the first
+    // stored record at or beyond the target so it can be interpolated
+    if (job_ == Job::TRAJECTORY) job_ = Job::NONE;
+    resetTable();
+    integrateToRange(params, nodeRangeAtOrAbove(params.target_range_m), true);
+
+    TrajectoryPoint tp;
+    if (!getPointAtRange(params.target_range_m, tp)) {
+        return result;
     }
 
-    return solved ? best_angle : NAN;
+    return buildResult(params, tp, params.target_range_m);
 }
 
-SolverResult BallisticSolver::integrate(const SolverParams& params) {
+SolverResult BallisticSolver::integrateWithSensitivity(const SolverParams& params,
+                                                       SolverSensitivity& sens) {
     SolverResult result;
     std::memset(&result, 0, sizeof(result));
     result.valid = false;
@@ -105,18 +165,175 @@ SolverResult BallisticSolver::integrate(const SolverParams& params) {
         return result;
     }
 
-    // Run full integration, filling the trajectory table
-    float drop = integrateToRange(params, params.target_range_m, true);
+    // Always the wind kernel: the crosswind tangent moves the bullet sideways
+    // even when the nominal trajectory has no lateral component
+    IntegrationState state;
+    startIntegration(params, false, state);
+    uint32_t budget = UINT32_MAX;
+    SensitivityPass pass;
+    float drop;
+    if (params.integrator == IntegratorMethod::DORMAND_PRINCE) {
+        drop = integrateKernel<IntegratorMethod::DORMAND_PRINCE, true, false, true>(
+            params, params.target_range_m, state, budget, &pass);
+    } else {
+        drop = integrateKernel<IntegratorMethod::RK4, true, false, true>(
+            params, params.target_range_m, state, budget, &pass);
+    }
     if (std::isnan(drop)) {
         return result;
     }
 
-    int target_idx = static_cast<int>(params.target_range_m);
-    if (target_idx < 0 || target_idx >= BCE_TRAJ_TABLE_SIZE) {
+    sens = pass.sens;
+    return buildResult(params, pass.at_range, params.target_range_m);
+}
+
+bool BallisticSolver::integrateTrajectory(const SolverParams& params, float horizon_m) {
+    if (job_ == Job::TRAJECTORY) job_ = Job::NONE;
+    resetTable();
+    if (!(horizon_m >= 1.0f)) {
+        return false;
+    }
+    // A trajectory that terminates early (velocity floor) still leaves a valid
+    // table up to max_valid_range_, so the NAN return is not an error here.
+    integrateToRange(params, nodeRangeAtOrAbove(horizon_m), true);
+    return max_valid_range_ > 0;
+}
+
+void BallisticSolver::beginZeroSolve(const SolverParams& params, float zero_range_m,
+                                     float initial_guess_rad) {
+    last_zero_iterations_ = 0;
+    last_zero_coarse_iterations_ = 0;
+    job_zero_angle_rad_ = NAN;
+    job_ = Job::NONE;
+    if (zero_range_m < 1.0f || zero_range_m > BCE_MAX_RANGE_M) {
+        return;
+    }
+    job_params_ = params;
+    job_range_m_ = zero_range_m;
+    job_guess_rad_ = initial_guess_rad;
+    job_coarse_ = useCoarseZeroPass(params);
+    job_search_.start(ZERO_LO_BOUND_RAD, ZERO_HI_BOUND_RAD, initial_guess_rad);
+    if (job_coarse_) {
+        job_coarse_params_ = coarseZeroParams(params);
+        job_coarse_params_.launch_angle_rad = job_search_.angle();
+        startIntegration(job_coarse_params_, false, job_state_);
+    } else {
+        job_params_.launch_angle_rad = job_search_.angle();
+        startIntegration(job_params_, false, job_state_);
+    }
+    job_ = Job::ZERO;
+}
+
+void BallisticSolver::beginTrajectory(const SolverParams& params, float horizon_m) {
+    job_ = Job::NONE;
+    resetTable();
+    if (!(horizon_m >= 1.0f)) {
+        return;
+    }
+    job_params_ = params;
+    job_range_m_ = nodeRangeAtOrAbove(horizon_m);
+    job_coarse_ = false;
+    startIntegration(job_params_, true, job_state_);
+    job_ = Job::TRAJECTORY;
+}
+
+bool BallisticSolver::stepJob(uint32_t max_steps) {
+    uint32_t budget = max_steps;
+    while (job_ != Job::NONE) {
+        const bool fill = (job_ == Job::TRAJECTORY);
+        SolverParams& params = job_coarse_ ? job_coarse_params_ : job_params_;
+        float drop = continueIntegration(params, job_range_m_, fill, job_state_, budget);
+        if (!job_state_.finished) return false;
+
+        if (fill) {
+            job_ = Job::NONE;
+            return true;
+        }
+
+        job_search_.feed(drop + job_params_.sight_height_m);
+        if (job_coarse_) {
+            last_zero_coarse_iterations_ = job_search_.getEvaluations();
+            if (job_search_.done()) {
+                // Refine with the full-fidelity integrator, as solveZeroAngle()
+                float guess = job_guess_rad_;
+                float slope = NAN;
+                if (std::isfinite(job_search_.result())) {
+                    guess = job_search_.result();
+                    slope = job_search_.getSlope();
+                }
+                job_coarse_ = false;
+                job_search_.start(ZERO_LO_BOUND_RAD, ZERO_HI_BOUND_RAD, guess, slope);
+            }
+        } else {
+            last_zero_iterations_ = job_search_.getEvaluations();
+            if (job_search_.done()) {
+                job_zero_angle_rad_ = job_search_.result();
+                job_ = Job::NONE;
+                return true;
+            }
+        }
+        SolverParams& next = job_coarse_ ? job_coarse_params_ : job_params_;
+        next.launch_angle_rad = job_search_.angle();
+        startIntegration(next, false, job_state_);
+        if (budget == 0) return false;
+    }
+    return false;
+}
+
+bool BallisticSolver::loadTrajectory(const uint8_t* nodes, int last, int node_step_m) {
+    if (job_ == Job::TRAJECTORY) job_ = Job::NONE;
+    resetTable();
+    if (!nodes || last < 1 || node_step_m < 1) {
+        return false;
+    }
+
+    // Copy out only the nodes each Hermite segment and its tangents read,
+    // as getPointAtRange() does for the compact table
+    int extent = last * node_step_m;
+    if (extent > BCE_MAX_RANGE_M) extent = BCE_MAX_RANGE_M;
+    const int records = extent / BCE_TRAJ_TABLE_STRIDE_M;
+    const float step = static_cast<float>(node_step_m);
+    for (int i = 0; i <= records; ++i) {
+        const float r = static_cast<float>(i * BCE_TRAJ_TABLE_STRIDE_M);
+        int n = static_cast<int>(r / step);
+        if (n > last) n = last;
+        const int lo = (n > 0) ? n - 1 : 0;
+        const int hi = (n + 2 < last) ? n + 2 : last;
+        TrajectoryPoint window[4];
+        std::memcpy(window, nodes + static_cast<size_t>(lo) * sizeof(TrajectoryPoint),
+                    static_cast<size_t>(hi - lo + 1) * sizeof(TrajectoryPoint));
+        float local = r - static_cast<float>(lo) * step;
+        const float span = static_cast<float>(hi - lo) * step;
+        if (local > span) local = span;
+        TrajectoryPoint tp;
+        interpolateTable(window, hi - lo, step, local, tp);
+        storeRecord(i, tp);
+    }
+    max_valid_range_ = records * BCE_TRAJ_TABLE_STRIDE_M;
+    return max_valid_range_ > 0;
+}
+
+SolverResult BallisticSolver::sampleTrajectory(const SolverParams& params, float range_m) const {
+    SolverResult result;
+    std::memset(&result, 0, sizeof(result));
+    result.valid = false;
+
+    if (!(range_m >= 1.0f) || range_m > static_cast<float>(max_valid_range_)) {
+        return result;
+    }
+
+    TrajectoryPoint tp;
+    if (!getPointAtRange(range_m, tp)) {
         return result;
     }
 
-    const TrajectoryPoint& tp = table_[target_idx];
+    return buildResult(params, tp, range_m);
+}
+
+SolverResult BallisticSolver::buildResult(const SolverParams& params, const TrajectoryPoint& tp,
+                                          float range_m) {
+    SolverResult result;
+    std::memset(&result, 0, sizeof(result));
 
     result.valid = true;
     result.drop_at_target_m = tp.drop_m;
@@ -124,7 +341,7 @@ SolverResult BallisticSolver::integrate(const SolverParams& params) {
     result.tof_s = tp.tof_s;
     result.velocity_at_target_ms = tp.velocity_ms;
     result.energy_at_target_j = tp.energy_j;
-    result.horizontal_range_m = params.target_range_m * std::cos(params.launch_angle_rad);
+    result.horizontal_range_m = range_m * std::cos(params.launch_angle_rad);
 
     // Compute spin drift. This is a simplified model based on the Litz
     // approximation (drift ∝ TOF^1.83). The gyroscopic stability factor (SG)
@@ -138,13 +355,13 @@ SolverResult BallisticSolver::integrate(const SolverParams& params) {
         // drift_inches = 1.25 * (SG + 1.2) * TOF^1.83
         // Simplified: we use a caliber-and-twist dependent scaling
         float sg = 1.5f; // simplified stability factor estimate
-        float drift_m = 0.0254f * 1.25f * (sg + 1.2f) * std::pow(tp.tof_s, 1.83f);
+        float drift_m = 0.0254f * 1.25f * (sg + 1.2f) * bcePow(tp.tof_s, 1.83f);
 
         // Sign by twist direction: RH twist (positive) drifts right
         if (params.twist_rate_inches < 0.0f) drift_m = -drift_m;
 
         // Convert to MOA
-        float range = params.target_range_m;
+        float range = range_m;
         if (range > 0.0f) {
             result.spin_drift_moa = (drift_m / range) * BCE_RAD_TO_MOA;
         }
@@ -160,7 +377,7 @@ SolverResult BallisticSolver::integrate(const SolverParams& params) {
         float lat = params.coriolis_lat_rad;
         float azi = params.azimuth_rad;
         float tof = tp.tof_s;
-        float range = params.target_range_m;
+        float range = range_m;
 
         // Horizontal (windage) Coriolis deflection:
         // deflection = ω × v × tof × sin(lat)  (simplified)
@@ -182,41 +399,239 @@ SolverResult BallisticSolver::integrate(const SolverParams& params) {
 }
 
 const TrajectoryPoint* BallisticSolver::getPointAt(int range_m) const {
-    if (range_m < 0 || range_m > max_valid_range_ || range_m >= BCE_TRAJ_TABLE_SIZE) {
+    if (range_m < 0 || range_m > max_valid_range_ || range_m % BCE_TRAJ_TABLE_STRIDE_M != 0) {
         return nullptr;
     }
-    return &table_[range_m];
+#if BCE_TRAJ_TABLE_COMPACT
+    TrajectoryPoint& slot = decoded_[decoded_next_++ % 4];
+    slot = table_.load(range_m / BCE_TRAJ_TABLE_STRIDE_M);
+    return &slot;
+#else
+    return &table_[range_m / BCE_TRAJ_TABLE_STRIDE_M];
+#endif
 }
 
-float BallisticSolver::integrateToRange(const SolverParams& params, float range_m, bool fill_table) {
-    // Initial conditions
-    float vx = params.muzzle_velocity_ms * std::cos(params.launch_angle_rad);
-    float vy = params.muzzle_velocity_ms * std::sin(params.launch_angle_rad);
-    float vz = 0.0f; // no initial lateral velocity
+bool BallisticSolver::getPointAtRange(float range_m, TrajectoryPoint& out) const {
+    const int last = max_valid_range_ / BCE_TRAJ_TABLE_STRIDE_M;
+    const float stride = static_cast<float>(BCE_TRAJ_TABLE_STRIDE_M);
+#if BCE_TRAJ_TABLE_COMPACT
+    if (!(range_m >= 0.0f) || range_m > static_cast<float>(last) * stride) {
+        return false;
+    }
+    const int i = static_cast<int>(range_m / stride);
+    if (i >= last) {
+        out = table_.load(last);
+        return true;
+    }
+    // Decode only the records the Hermite segment and its tangents read;
+    // keeping a neighbour on each side leaves the tangents central
+    const int lo = (i > 0) ? i - 1 : 0;
+    const int hi = (i + 2 < last) ? i + 2 : last;
+    TrajectoryPoint window[4];
+    for (int k = lo; k <= hi; ++k) {
+        window[k - lo] = table_.load(k);
+    }
+    const float span = static_cast<float>(hi - lo) * stride;
+    float local = range_m - static_cast<float>(lo) * stride;
+    if (local > span) local = span;
+    if (local < 0.0f) local = 0.0f;
+    return interpolateTable(window, hi - lo, stride, local, out);
+#else
+    return interpolateTable(table_, last, stride, range_m, out);
+#endif
+}
+
+void BallisticSolver::resetTable() {
+    max_valid_range_ = 0;
+    table_generation_++;
+}
+
+void BallisticSolver::storeRecord(int index, const TrajectoryPoint& tp) {
+#if BCE_TRAJ_TABLE_COMPACT
+    table_.store(index, tp);
+#else
+    table_[index] = tp;
+#endif
+}
+
+bool BallisticSolver::interpolateTable(const TrajectoryPoint* table, int last, float stride,
+                                       float range_m, TrajectoryPoint& out) {
+    if (!(range_m >= 0.0f) || range_m > static_cast<float>(last) * stride) {
+        return false;
+    }
+
+    float u = range_m / stride;
+    int i = static_cast<int>(u);
+    if (i >= last) {
+        out = table[last];
+        return true;
+    }
+    float s = u - static_cast<float>(i);
+
+    // Finite-difference tangent (per meter) of a record field at node k
+    auto tangent = [&](float TrajectoryPoint::*field, int k) {
+        if (k <= 0) {
+            return (table[1].*field - table[0].*field) / stride;
+        }
+        if (k >= last) {
+            return (table[last].*field - table[last - 1].*field) / stride;
+        }
+        return (table[k + 1].*field - table[k - 1].*field) / (2.0f * stride);
+    };
+
+    // dt/dx from the local path slope and speed
+    auto tofTangent = [&](int k) {
+        float dy = tangent(&TrajectoryPoint::drop_m, k);
+        float dz = tangent(&TrajectoryPoint::windage_m, k);
+        float v = table[k].velocity_ms;
+        return (v > 0.0f) ? bceSqrt(1.0f + dy * dy + dz * dz) / v : 0.0f;
+    };
+
+    // Cubic Hermite basis on the unit interval
+    float s2 = s * s;
+    float s3 = s2 * s;
+    float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+    float h10 = s3 - 2.0f * s2 + s;
+    float h01 = -2.0f * s3 + 3.0f * s2;
+    float h11 = s3 - s2;
+
+    const TrajectoryPoint& a = table[i];
+    const TrajectoryPoint& b = table[i + 1];
+
+    auto hermite = [&](float p0, float m0, float p1, float m1) {
+        return h00 * p0 + h10 * stride * m0 + h01 * p1 + h11 * stride * m1;
+    };
 
-    float x = 0.0f;  // downrange
-    float y = 0.0f;  // vertical (bore axis is at y=0 at muzzle)
-    float z = 0.0f;  // lateral
+    out.drop_m = hermite(a.drop_m, tangent(&TrajectoryPoint::drop_m, i),
+                         b.drop_m, tangent(&TrajectoryPoint::drop_m, i + 1));
+    out.windage_m = hermite(a.windage_m, tangent(&TrajectoryPoint::windage_m, i),
+                            b.windage_m, tangent(&TrajectoryPoint::windage_m, i + 1));
+    out.velocity_ms = hermite(a.velocity_ms, tangent(&TrajectoryPoint::velocity_ms, i),
+                              b.velocity_ms, tangent(&TrajectoryPoint::velocity_ms, i + 1));
+    out.tof_s = hermite(a.tof_s, tofTangent(i), b.tof_s, tofTangent(i + 1));
 
-    float t = 0.0f;  // time of flight
+    // Energy follows from velocity; scale the stored record rather than
+    // interpolating it independently
+    float ratio = (a.velocity_ms > 0.0f) ? out.velocity_ms / a.velocity_ms : 0.0f;
+    out.energy_j = a.energy_j * ratio * ratio;
+    return true;
+}
+
+float BallisticSolver::nodeRangeAtOrAbove(float range_m) {
+    const float stride = static_cast<float>(BCE_TRAJ_TABLE_STRIDE_M);
+    float node = std::ceil(range_m / stride) * stride;
+    if (node > static_cast<float>(BCE_MAX_RANGE_M)) {
+        node = static_cast<float>(BCE_MAX_RANGE_M);
+    }
+    return node;
+}
+
+float BallisticSolver::integrateToRange(const SolverParams& params, float range_m, bool fill_table) {
+    IntegrationState state;
+    startIntegration(params, fill_table, state);
+    uint32_t budget = UINT32_MAX;
+    return continueIntegration(params, range_m, fill_table, state, budget);
+}
+
+void BallisticSolver::startIntegration(const SolverParams& params, bool fill_table,
+                                       IntegrationState& s) {
+    std::memset(&s, 0, sizeof(s));
+    s.vx = params.muzzle_velocity_ms * std::cos(params.launch_angle_rad);
+    s.vy = params.muzzle_velocity_ms * std::sin(params.launch_angle_rad);
 
-    int last_range_index = 0;
     if (fill_table) {
-        table_[0].drop_m = 0.0f;
-        table_[0].windage_m = 0.0f;
-        table_[0].velocity_ms = params.muzzle_velocity_ms;
-        table_[0].tof_s = 0.0f;
-        table_[0].energy_j = 0.5f * params.bullet_mass_kg *
-                              params.muzzle_velocity_ms * params.muzzle_velocity_ms;
+        TrajectoryPoint muzzle;
+        muzzle.drop_m = 0.0f;
+        muzzle.windage_m = 0.0f;
+        muzzle.velocity_ms = params.muzzle_velocity_ms;
+        muzzle.tof_s = 0.0f;
+        muzzle.energy_j = 0.5f * params.bullet_mass_kg *
+                          params.muzzle_velocity_ms * params.muzzle_velocity_ms;
+        storeRecord(0, muzzle);
     }
+}
+
+float BallisticSolver::continueIntegration(const SolverParams& params, float range_m,
+                                           bool fill_table, IntegrationState& state,
+                                           uint32_t& budget) {
+    // Pick the specialization once per solve; nothing in the step loop
+    // branches on the integrator, the wind or table filling
+    using Kernel = float (BallisticSolver::*)(const SolverParams&, float, IntegrationState&,
+                                              uint32_t&, SensitivityPass*);
+    static constexpr Kernel KERNELS[3][2][2] = {
+        {{&BallisticSolver::integrateKernel<IntegratorMethod::RK4, false, false>,
+          &BallisticSolver::integrateKernel<IntegratorMethod::RK4, false, true>},
+         {&BallisticSolver::integrateKernel<IntegratorMethod::RK4, true, false>,
+          &BallisticSolver::integrateKernel<IntegratorMethod::RK4, true, true>}},
+        {{&BallisticSolver::integrateKernel<IntegratorMethod::DORMAND_PRINCE, false, false>,
+          &BallisticSolver::integrateKernel<IntegratorMethod::DORMAND_PRINCE, false, true>},
+         {&BallisticSolver::integrateKernel<IntegratorMethod::DORMAND_PRINCE, true, false>,
+          &BallisticSolver::integrateKernel<IntegratorMethod::DORMAND_PRINCE, true, true>}},
+        {{&BallisticSolver::integrateRangeKernel<false, false>,
+          &BallisticSolver::integrateRangeKernel<false, true>},
+         {&BallisticSolver::integrateRangeKernel<true, false>,
+          &BallisticSolver::integrateRangeKernel<true, true>}},
+    };
+    int method = 0;
+    if (params.integrator == IntegratorMethod::DORMAND_PRINCE) method = 1;
+    if (params.integrator == IntegratorMethod::RK4_RANGE) method = 2;
+    const int wind = (params.headwind_ms != 0.0f || params.crosswind_ms != 0.0f) ? 1 : 0;
+    return (this->*KERNELS[method][wind][fill_table ? 1 : 0])(params, range_m, state, budget,
+                                                              nullptr);
+}
+
+template <IntegratorMethod Method, bool Wind, bool FillTable, bool Sensitivity>
+float BallisticSolver::integrateKernel(const SolverParams& params, float range_m,
+                                       IntegrationState& s, uint32_t& budget,
+                                       SensitivityPass* pass) {
+    // Resume from the saved state (the muzzle, from startIntegration())
+    float vx = s.vx;
+    float vy = s.vy;
+    float vz = s.vz;
 
-    uint32_t iteration = 0;
+    float x = s.x;  // downrange
+    float y = s.y;  // vertical (bore axis is at y=0 at muzzle)
+    float z = s.z;  // lateral
+
+    float t = s.t;  // time of flight
+
+    int last_range_index = s.last_range_index;
+    uint32_t iteration = s.iteration;
+
+    // Resolve everything constant over the trajectory once
+    DragContext drag = makeDragContext(params);
+
+    // Speed over the axes this specialization carries. Without wind nothing
+    // pushes the bullet sideways, so z and vz stay zero and are skipped.
+    auto speed = [](float a, float b, float c) {
+        if constexpr (Wind) {
+            return bceSqrt(a * a + b * b + c * c);
+        } else {
+            (void)c;
+            return bceSqrt(a * a + b * b);
+        }
+    };
 
     auto computeAcceleration = [&](float vxn, float vyn, float vzn,
                                    float& ax, float& ay, float& az) {
-        float vx_rel = vxn + params.headwind_ms;
-        float vz_rel = vzn - params.crosswind_ms;
-        float v_rel = std::sqrt(vx_rel * vx_rel + vyn * vyn + vz_rel * vz_rel);
+        float vx_rel = vxn;
+        float vz_rel = 0.0f;
+        float v2 = 0.0f;
+        if constexpr (Wind) {
+            vx_rel += params.headwind_ms;
+            vz_rel = vzn - params.crosswind_ms;
+            v2 = vx_rel * vx_rel + vyn * vyn + vz_rel * vz_rel;
+        } else {
+            (void)vzn;
+            v2 = vx_rel * vx_rel + vyn * vyn;
+        }
+#if BCE_FAST_MATH
+        // One reciprocal square root replaces the sqrt and three divides
+        float inv_v = (v2 >= 1.0f) ? bceRsqrt(v2) : 0.0f;
+        float v_rel = v2 * inv_v;
+#else
+        float v_rel = std::sqrt(v2);
+#endif
 
         if (v_rel < 1.0f) {
             ax = 0.0f;
@@ -225,40 +640,339 @@ float BallisticSolver::integrateToRange(const SolverParams& params, float range_
             return;
         }
 
-        float decel = DragModelLookup::getDeceleration(v_rel, params.speed_of_sound,
-                                                        params.bc, params.drag_model,
-                                                        params.air_density);
-        float drag_scale = params.drag_reference_scale;
-        if (!std::isfinite(drag_scale) || drag_scale <= 0.0f) drag_scale = 1.0f;
-        if (drag_scale < 0.2f) drag_scale = 0.2f;
-        if (drag_scale > 2.0f) drag_scale = 2.0f;
-        decel *= drag_scale;
+#if BCE_ENABLE_PROFILING
+        perf_drag_lookups_++;
+#endif
+        float decel = DragModelLookup::getBandedDeceleration(drag, v_rel);
+#if BCE_FAST_MATH
+        ax = -decel * (vx_rel * inv_v);
+        ay = -decel * (vyn * inv_v) - BCE_GRAVITY;
+        az = Wind ? -decel * (vz_rel * inv_v) : 0.0f;
+#else
         ax = -decel * (vx_rel / v_rel);
         ay = -decel * (vyn / v_rel) - BCE_GRAVITY;
-        az = -decel * (vz_rel / v_rel);
+        az = Wind ? -decel * (vz_rel / v_rel) : 0.0f;
+#endif
     };
 
+    // --- Forward sensitivities ---
+    // Tangent state d(position, velocity)/dp for the inputs p below. With
+    // w = v + (headwind, 0, -crosswind) the air-relative velocity and D(|w|)
+    // the drag deceleration, a = -D ŵ - g ŷ has the Jacobian
+    //   ∂a/∂w = -(D/|w|) I - (D' - D/|w|) ŵŵᵀ
+    // and drag ∝ 1/BC, so the tangent accelerations are ∂a/∂w · S_v plus
+    // D ŵ (BC), -∂a/∂w · ẑ (crosswind) and ∂a/∂w · x̂ (headwind).
+    enum { SENS_MV, SENS_BC, SENS_CROSSWIND, SENS_HEADWIND, SENS_INPUTS };
+    float sens_pos[SENS_INPUTS][3] = {};
+    float sens_vel[SENS_INPUTS][3] = {};
+    float sens_pos0[SENS_INPUTS][3] = {};  // at the start of the current step
+    float sens_vel0[SENS_INPUTS][3] = {};
+    if constexpr (Sensitivity) {
+        static_assert(Wind && !FillTable, "sensitivity kernels carry wind, no table");
+        sens_vel[SENS_MV][0] = std::cos(params.launch_angle_rad);
+        sens_vel[SENS_MV][1] = std::sin(params.launch_angle_rad);
+    }
+
+    auto tangentAcceleration = [&](float vxn, float vyn, float vzn,
+                                   const float (&tv)[SENS_INPUTS][3],
+                                   float (&ta)[SENS_INPUTS][3]) {
+        const float w[3] = {vxn + params.headwind_ms, vyn, vzn - params.crosswind_ms};
+        const float v_rel = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        if (v_rel < 1.0f) {
+            std::memset(ta, 0, sizeof(ta));
+            return;
+        }
+#if BCE_ENABLE_PROFILING
+        perf_drag_lookups_++;
+#endif
+        const float decel = DragModelLookup::getBandedDeceleration(drag, v_rel);
+        const float alpha = decel / v_rel;
+        const float beta = DragModelLookup::getDecelerationSlope(drag, v_rel) - alpha;
+        const float u[3] = {w[0] / v_rel, w[1] / v_rel, w[2] / v_rel};
+        for (int p = 0; p < SENS_INPUTS; ++p) {
+            const float proj = u[0] * tv[p][0] + u[1] * tv[p][1] + u[2] * tv[p][2];
+            for (int c = 0; c < 3; ++c) ta[p][c] = -alpha * tv[p][c] - beta * proj * u[c];
+        }
+        for (int c = 0; c < 3; ++c) {
+            ta[SENS_BC][c] += decel * u[c];
+            ta[SENS_CROSSWIND][c] += beta * u[2] * u[c];
+            ta[SENS_HEADWIND][c] -= beta * u[0] * u[c];
+        }
+        ta[SENS_CROSSWIND][2] += alpha;
+        ta[SENS_HEADWIND][0] -= alpha;
+    };
+
+    // State at the start of the current step, for locating exact crossings
+    float x0 = 0.0f, y0 = 0.0f, z0 = 0.0f;
+    float vx0 = vx, vy0 = vy, vz0 = vz;
+    float t0 = 0.0f;
+    float dt = 0.0f;
+
+    // Cubic Hermite (in time) reconstruction of the state where the bullet
+    // crossed downrange distance xc during the last step. The step fraction
+    // is refined with Newton iterations on the Hermite x(s), which matters
+    // for the long steps taken by the adaptive integrator.
+    auto crossing = [&](float xc, TrajectoryPoint& tp) {
+        float s = (x > x0) ? (xc - x0) / (x - x0) : 1.0f;
+        for (int k = 0; k < 2 && x > x0; ++k) {
+            float s2 = s * s;
+            float s3 = s2 * s;
+            float xs = (2.0f * s3 - 3.0f * s2 + 1.0f) * x0 + (s3 - 2.0f * s2 + s) * dt * vx0 +
+                       (-2.0f * s3 + 3.0f * s2) * x + (s3 - s2) * dt * vx;
+            float dxs = (6.0f * s2 - 6.0f * s) * x0 + (3.0f * s2 - 4.0f * s + 1.0f) * dt * vx0 +
+                        (-6.0f * s2 + 6.0f * s) * x + (3.0f * s2 - 2.0f * s) * dt * vx;
+            if (!(dxs > 0.0f)) break;
+            s -= (xs - xc) / dxs;
+            if (s < 0.0f) s = 0.0f;
+            if (s > 1.0f) s = 1.0f;
+        }
+        float s2 = s * s;
+        float s3 = s2 * s;
+        float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+        float h10 = s3 - 2.0f * s2 + s;
+        float h01 = -2.0f * s3 + 3.0f * s2;
+        float h11 = s3 - s2;
+        tp.drop_m = h00 * y0 + h10 * dt * vy0 + h01 * y + h11 * dt * vy;
+        float vxc = vx0 + s * (vx - vx0);
+        float vyc = vy0 + s * (vy - vy0);
+        float vzc = 0.0f;
+        tp.windage_m = 0.0f;
+        if constexpr (Wind) {
+            tp.windage_m = h00 * z0 + h10 * dt * vz0 + h01 * z + h11 * dt * vz;
+            vzc = vz0 + s * (vz - vz0);
+        }
+        tp.velocity_ms = speed(vxc, vyc, vzc);
+        tp.tof_s = t0 + s * dt;
+        tp.energy_j = 0.5f * params.bullet_mass_kg * tp.velocity_ms * tp.velocity_ms;
+        return s;
+    };
+
+    // Tangent state at the crossing found at step fraction cs (Hermite in
+    // time like crossing()), projected onto the fixed target range: a
+    // change that moves the bullet downrange by δx reaches the target
+    // δx / vx earlier.
+    auto fillSensitivity = [&](float cs, SolverSensitivity& out) {
+        float s2 = cs * cs;
+        float s3 = s2 * cs;
+        float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+        float h10 = s3 - 2.0f * s2 + cs;
+        float h01 = -2.0f * s3 + 3.0f * s2;
+        float h11 = s3 - s2;
+        const float vc[3] = {vx0 + cs * (vx - vx0), vy0 + cs * (vy - vy0), vz0 + cs * (vz - vz0)};
+        float ac[3];
+        computeAcceleration(vc[0], vc[1], vc[2], ac[0], ac[1], ac[2]);
+        const float vmag = speed(vc[0], vc[1], vc[2]);
+        const float v_dot_a = vc[0] * ac[0] + vc[1] * ac[1] + vc[2] * ac[2];
+
+        out.range.drop_m = vc[1] / vc[0];
+        out.range.windage_m = vc[2] / vc[0];
+        out.range.tof_s = 1.0f / vc[0];
+        out.range.velocity_ms = v_dot_a / (vmag * vc[0]);
+
+        SolverPartials* inputs[SENS_INPUTS] = {&out.muzzle_velocity, &out.bc, &out.crosswind,
+                                               &out.headwind};
+        for (int p = 0; p < SENS_INPUTS; ++p) {
+            float sp[3], sv[3];
+            for (int c = 0; c < 3; ++c) {
+                sp[c] = h00 * sens_pos0[p][c] + h10 * dt * sens_vel0[p][c] +
+                        h01 * sens_pos[p][c] + h11 * dt * sens_vel[p][c];
+                sv[c] = sens_vel0[p][c] + cs * (sens_vel[p][c] - sens_vel0[p][c]);
+            }
+            const float dtof = -sp[0] / vc[0];
+            inputs[p]->drop_m = sp[1] + vc[1] * dtof;
+            inputs[p]->windage_m = sp[2] + vc[2] * dtof;
+            inputs[p]->tof_s = dtof;
+            inputs[p]->velocity_ms =
+                (vc[0] * sv[0] + vc[1] * sv[1] + vc[2] * sv[2] + v_dot_a * dtof) / vmag;
+        }
+    };
+
+    // Fill trajectory table at each stride boundary crossed by the last step
+    auto recordCrossings = [&]() {
+        if constexpr (!FillTable) return;
+        int current_index = static_cast<int>(x) / BCE_TRAJ_TABLE_STRIDE_M;
+        while (last_range_index < current_index &&
+               last_range_index < BCE_TRAJ_TABLE_SIZE - 1) {
+            last_range_index++;
+            TrajectoryPoint tp;
+            crossing(static_cast<float>(last_range_index * BCE_TRAJ_TABLE_STRIDE_M), tp);
+            storeRecord(last_range_index, tp);
+        }
+        max_valid_range_ = last_range_index * BCE_TRAJ_TABLE_STRIDE_M;
+    };
+
+    // --- Dormand–Prince 5(4) ---
+    // Error-controlled step on position with an absolute tolerance; the
+    // 5th-order solution is propagated (local extrapolation). Acceleration
+    // depends only on velocity, so position stages are the stage velocities.
+    constexpr int AXES = Wind ? 3 : 2;
+    float tol = params.integrator_tolerance_m;
+    if (!(tol > 0.0f)) tol = BCE_RK45_DEFAULT_TOLERANCE_M;
+
+    // RK4 step controls, ≤ 0 = config default
+    const float step_scale = (params.integrator_step_scale_m > 0.0f)
+        ? params.integrator_step_scale_m : BCE_RK4_STEP_SCALE_M;
+    const float max_step = (params.integrator_max_step_m > 0.0f)
+        ? params.integrator_max_step_m : BCE_MAX_STEP_DISTANCE_M;
+    const float transonic_dt = (params.integrator_transonic_dt_s > 0.0f)
+        ? params.integrator_transonic_dt_s : BCE_DT_MIN;
+    float dp_dt = s.dp_dt;     // proposed next step (0 = pick initial step)
+    float dp_a[7][3];          // stage accelerations
+    bool dp_fsal = s.dp_fsal;  // dp_a[0] holds f(current state) from last step
+    dp_a[0][0] = s.dp_a0[0];
+    dp_a[0][1] = s.dp_a0[1];
+    dp_a[0][2] = s.dp_a0[2];
+
+    auto dormandPrinceStep = [&]() {
+        static constexpr float A[7][6] = {
+            {0, 0, 0, 0, 0, 0},
+            {1.0f / 5.0f, 0, 0, 0, 0, 0},
+            {3.0f / 40.0f, 9.0f / 40.0f, 0, 0, 0, 0},
+            {44.0f / 45.0f, -56.0f / 15.0f, 32.0f / 9.0f, 0, 0, 0},
+            {19372.0f / 6561.0f, -25360.0f / 2187.0f, 64448.0f / 6561.0f, -212.0f / 729.0f, 0, 0},
+            {9017.0f / 3168.0f, -355.0f / 33.0f, 46732.0f / 5247.0f, 49.0f / 176.0f,
+             -5103.0f / 18656.0f, 0},
+            {35.0f / 384.0f, 0, 500.0f / 1113.0f, 125.0f / 192.0f, -2187.0f / 6784.0f,
+             11.0f / 84.0f},
+        };
+        // 5th-order weights (== last row of A) minus 4th-order weights
+        static constexpr float E[7] = {71.0f / 57600.0f, 0, -71.0f / 16695.0f, 71.0f / 1920.0f,
+                                       -17253.0f / 339200.0f, 22.0f / 525.0f, -1.0f / 40.0f};
+
+        float v = speed(vx, vy, vz);
+        float dt_max = BCE_RK45_MAX_STEP_DISTANCE_M / v;
+        if (!(dp_dt > 0.0f)) dp_dt = max_step / v;
+        if (dp_dt > dt_max) dp_dt = dt_max;
+
+        if (!dp_fsal) {
+            computeAcceleration(vx, vy, vz, dp_a[0][0], dp_a[0][1], dp_a[0][2]);
+        }
+
+        const float v0[3] = {vx, vy, vz};
+        float sv[7][3] = {};   // stage velocities
+        sv[0][0] = vx; sv[0][1] = vy; sv[0][2] = vz;
+
+        for (;;) {
+            float h = dp_dt;
+            for (int st = 1; st < 7; ++st) {
+                for (int c = 0; c < AXES; ++c) {
+                    float acc = 0.0f;
+                    for (int j = 0; j < st; ++j) acc += A[st][j] * dp_a[j][c];
+                    sv[st][c] = v0[c] + h * acc;
+                }
+                computeAcceleration(sv[st][0], sv[st][1], sv[st][2],
+                                    dp_a[st][0], dp_a[st][1], dp_a[st][2]);
+            }
+
+            // Position increments and their embedded error estimate
+            float dpos[3] = {};
+            float err = 0.0f;
+            for (int c = 0; c < AXES; ++c) {
+                float inc = 0.0f;
+                float e = 0.0f;
+                for (int j = 0; j < 6; ++j) inc += A[6][j] * sv[j][c];
+                for (int j = 0; j < 7; ++j) e += E[j] * sv[j][c];
+                dpos[c] = h * inc;
+                float ec = std::fabs(h * e);
+                if (ec > err) err = ec;
+            }
+            float ratio = err / tol;
+
+            if (ratio <= 1.0f || h <= BCE_DT_MIN) {
+                if constexpr (Sensitivity) {
+                    // Same tableau on the tangent state, at the accepted stages
+                    float ta[6][SENS_INPUTS][3];
+                    float dpos_t[SENS_INPUTS][3] = {};
+                    for (int st = 0; st < 6; ++st) {
+                        float tv[SENS_INPUTS][3];
+                        for (int p = 0; p < SENS_INPUTS; ++p) {
+                            for (int c = 0; c < 3; ++c) {
+                                float acc = 0.0f;
+                                for (int j = 0; j < st; ++j) acc += A[st][j] * ta[j][p][c];
+                                tv[p][c] = sens_vel[p][c] + h * acc;
+                                dpos_t[p][c] += A[6][st] * tv[p][c];
+                            }
+                        }
+                        tangentAcceleration(sv[st][0], sv[st][1], sv[st][2], tv, ta[st]);
+                    }
+                    for (int p = 0; p < SENS_INPUTS; ++p) {
+                        for (int c = 0; c < 3; ++c) {
+                            float acc = 0.0f;
+                            for (int j = 0; j < 6; ++j) acc += A[6][j] * ta[j][p][c];
+                            sens_pos[p][c] += h * dpos_t[p][c];
+                            sens_vel[p][c] += h * acc;
+                        }
+                    }
+                }
+                x += dpos[0];
+                y += dpos[1];
+                vx = sv[6][0];
+                vy = sv[6][1];
+                if constexpr (Wind) {
+                    z += dpos[2];
+                    vz = sv[6][2];
+                }
+                t += h;
+                dt = h;
+
+                // FSAL: the last stage is f(new state)
+                dp_a[0][0] = dp_a[6][0];
+                dp_a[0][1] = dp_a[6][1];
+                dp_a[0][2] = dp_a[6][2];
+                dp_fsal = true;
+
+                float grow = (ratio > 0.0f) ? 0.9f * bcePow(ratio, -0.2f) : 5.0f;
+                if (grow > 5.0f) grow = 5.0f;
+                dp_dt = h * grow;
+                return;
+            }
+
+            float shrink = 0.9f * bcePow(ratio, -0.25f);
+            if (shrink < 0.2f) shrink = 0.2f;
+            dp_dt = h * shrink;
+            if (dp_dt < BCE_DT_MIN) dp_dt = BCE_DT_MIN;
+        }
+    };
+
+    bool paused = false;
     while (x < range_m && iteration < BCE_MAX_SOLVER_ITERATIONS) {
+        if (budget == 0) {
+            paused = true;
+            break;
+        }
+        budget--;
         iteration++;
 
-        float v = std::sqrt(vx * vx + vy * vy + vz * vz);
+        x0 = x; y0 = y; z0 = z;
+        vx0 = vx; vy0 = vy; vz0 = vz;
+        t0 = t;
+        if constexpr (Sensitivity) {
+            std::memcpy(sens_pos0, sens_pos, sizeof(sens_pos));
+            std::memcpy(sens_vel0, sens_vel, sizeof(sens_vel));
+        }
+
+        float v = speed(vx, vy, vz);
         if (v < BCE_MIN_VELOCITY) break;
 
+        if constexpr (Method == IntegratorMethod::DORMAND_PRINCE) {
+            dormandPrinceStep();
+            recordCrossings();
+            continue;
+        }
+
         // Adaptive timestep: smaller near transonic, larger at supersonic.
-        // The constant 0.5 is a tuning parameter that balances performance
-        // and stability. A smaller value would increase accuracy but slow
-        // down the simulation.
+        // step_scale (default 0.5) balances performance and stability; a
+        // smaller value increases accuracy but slows down the simulation.
         float mach = v / params.speed_of_sound;
-        float dt;
         if (mach > 0.9f && mach < 1.2f) {
-            dt = BCE_DT_MIN; // transonic region — use smallest step
+            dt = transonic_dt; // transonic region — smallest step by default
         } else {
             // Scale dt with velocity — faster bullet covers more ground per step
-            dt = 0.5f / v;
+            dt = step_scale / v;
         }
 
         // Bound per-step downrange travel for stability and table fidelity
-        float dt_from_step = BCE_MAX_STEP_DISTANCE_M / v;
+        float dt_from_step = max_step / v;
         if (dt > dt_from_step) dt = dt_from_step;
         if (dt < BCE_DT_MIN) dt = BCE_DT_MIN;
         if (dt > BCE_DT_MAX) dt = BCE_DT_MAX;
@@ -276,7 +990,7 @@ float BallisticSolver::integrateToRange(const SolverParams& params, float range_
 
         float vx_k2 = vx + 0.5f * dt * k1_vx;
         float vy_k2 = vy + 0.5f * dt * k1_vy;
-        float vz_k2 = vz + 0.5f * dt * k1_vz;
+        float vz_k2 = Wind ? vz + 0.5f * dt * k1_vz : 0.0f;
         float ax2, ay2, az2;
         computeAcceleration(vx_k2, vy_k2, vz_k2, ax2, ay2, az2);
 
@@ -289,7 +1003,7 @@ float BallisticSolver::integrateToRange(const SolverParams& params, float range_
 
         float vx_k3 = vx + 0.5f * dt * k2_vx;
         float vy_k3 = vy + 0.5f * dt * k2_vy;
-        float vz_k3 = vz + 0.5f * dt * k2_vz;
+        float vz_k3 = Wind ? vz + 0.5f * dt * k2_vz : 0.0f;
         float ax3, ay3, az3;
         computeAcceleration(vx_k3, vy_k3, vz_k3, ax3, ay3, az3);
 
@@ -302,7 +1016,7 @@ float BallisticSolver::integrateToRange(const SolverParams& params, float range_
 
         float vx_k4 = vx + dt * k3_vx;
         float vy_k4 = vy + dt * k3_vy;
-        float vz_k4 = vz + dt * k3_vz;
+        float vz_k4 = Wind ? vz + dt * k3_vz : 0.0f;
         float ax4, ay4, az4;
         computeAcceleration(vx_k4, vy_k4, vz_k4, ax4, ay4, az4);
 
@@ -321,30 +1035,228 @@ float BallisticSolver::integrateToRange(const SolverParams& params, float range_
 
         rk4_step(x, vx, k1_x, k1_vx, k2_x, k2_vx, k3_x, k3_vx, k4_x, k4_vx);
         rk4_step(y, vy, k1_y, k1_vy, k2_y, k2_vy, k3_y, k3_vy, k4_y, k4_vy);
-        rk4_step(z, vz, k1_z, k1_vz, k2_z, k2_vz, k3_z, k3_vz, k4_z, k4_vz);
+        if constexpr (Wind) {
+            rk4_step(z, vz, k1_z, k1_vz, k2_z, k2_vz, k3_z, k3_vz, k4_z, k4_vz);
+        }
         t += dt;
 
-        // Fill trajectory table at each meter mark
-        if (fill_table) {
-            int current_range = static_cast<int>(x);
-            while (last_range_index < current_range &&
-                   last_range_index < BCE_TRAJ_TABLE_SIZE - 1) {
-                last_range_index++;
-                float v_current = std::sqrt(vx * vx + vy * vy + vz * vz);
-                table_[last_range_index].drop_m = y;
-                table_[last_range_index].windage_m = z;
-                table_[last_range_index].velocity_ms = v_current;
-                table_[last_range_index].tof_s = t;
-                table_[last_range_index].energy_j = 0.5f * params.bullet_mass_kg *
-                                                     v_current * v_current;
+        if constexpr (Sensitivity) {
+            // Same stages on the tangent state, at the stage velocities above
+            float tv2[SENS_INPUTS][3], tv3[SENS_INPUTS][3], tv4[SENS_INPUTS][3];
+            float ta1[SENS_INPUTS][3], ta2[SENS_INPUTS][3], ta3[SENS_INPUTS][3],
+                ta4[SENS_INPUTS][3];
+            tangentAcceleration(vx0, vy0, vz0, sens_vel0, ta1);
+            for (int p = 0; p < SENS_INPUTS; ++p) {
+                for (int c = 0; c < 3; ++c) tv2[p][c] = sens_vel0[p][c] + 0.5f * dt * ta1[p][c];
+            }
+            tangentAcceleration(vx_k2, vy_k2, vz_k2, tv2, ta2);
+            for (int p = 0; p < SENS_INPUTS; ++p) {
+                for (int c = 0; c < 3; ++c) tv3[p][c] = sens_vel0[p][c] + 0.5f * dt * ta2[p][c];
+            }
+            tangentAcceleration(vx_k3, vy_k3, vz_k3, tv3, ta3);
+            for (int p = 0; p < SENS_INPUTS; ++p) {
+                for (int c = 0; c < 3; ++c) tv4[p][c] = sens_vel0[p][c] + dt * ta3[p][c];
+            }
+            tangentAcceleration(vx_k4, vy_k4, vz_k4, tv4, ta4);
+            for (int p = 0; p < SENS_INPUTS; ++p) {
+                for (int c = 0; c < 3; ++c) {
+                    sens_pos[p][c] += (dt / 6.0f) * (sens_vel0[p][c] + 2.0f * tv2[p][c] +
+                                                     2.0f * tv3[p][c] + tv4[p][c]);
+                    sens_vel[p][c] += (dt / 6.0f) * (ta1[p][c] + 2.0f * ta2[p][c] +
+                                                     2.0f * ta3[p][c] + ta4[p][c]);
+                }
             }
-            max_valid_range_ = last_range_index;
         }
+
+        recordCrossings();
+    }
+
+#if BCE_ENABLE_PROFILING
+    perf_steps_ += iteration - s.iteration;
+#endif
+    s.finished = !paused;
+    if (paused) {
+        s.x = x; s.y = y; s.z = z;
+        s.vx = vx; s.vy = vy; s.vz = vz;
+        s.t = t;
+        s.dp_dt = dp_dt;
+        s.dp_a0[0] = dp_a[0][0];
+        s.dp_a0[1] = dp_a[0][1];
+        s.dp_a0[2] = dp_a[0][2];
+        s.dp_fsal = dp_fsal;
+        s.iteration = iteration;
+        s.last_range_index = last_range_index;
+        return NAN;
     }
+    last_step_count_ = iteration;
 
     if (x < range_m) {
         return NAN; // bullet didn't reach target range
     }
 
-    return y; // vertical drop at target range
+    TrajectoryPoint at_range;
+    if constexpr (Sensitivity) {
+        fillSensitivity(crossing(range_m, at_range), pass->sens);
+        pass->at_range = at_range;
+    } else {
+        (void)pass;
+        crossing(range_m, at_range);
+    }
+    return at_range.drop_m; // vertical drop at target range
+}
+
+template <bool Wind, bool FillTable>
+float BallisticSolver::integrateRangeKernel(const SolverParams& params, float range_m,
+                                            IntegrationState& s, uint32_t& budget,
+                                            SensitivityPass* pass) {
+    (void)pass;
+    float x = s.x;
+    float y = s.y;
+    float z = s.z;
+    float vx = s.vx;
+    float vy = s.vy;
+    float vz = s.vz;
+    float t = s.t;
+    int last_range_index = s.last_range_index;
+    uint32_t iteration = s.iteration;
+
+    DragContext drag = makeDragContext(params);
+
+    // Filling: whole steps per stride, none longer than the range step
+    // (BCE_RANGE_STEP_M by default). Otherwise only the target matters and
+    // steps run at full length.
+    const float stride = static_cast<float>(BCE_TRAJ_TABLE_STRIDE_M);
+    const float range_step = (params.integrator_range_step_m > 0.0f)
+        ? params.integrator_range_step_m : BCE_RANGE_STEP_M;
+    const float step_m = FillTable ? stride / std::ceil(stride / range_step) : range_step;
+
+    // State derivatives with respect to x: dt/dx = 1/vx, and every other
+    // rate divides by vx the same way
+    struct Slope {
+        float y, z, vx, vy, vz, t;
+    };
+    auto derivative = [&](float vxn, float vyn, float vzn, Slope& d) {
+        float vx_rel = vxn;
+        float vz_rel = 0.0f;
+        float v2 = 0.0f;
+        if constexpr (Wind) {
+            vx_rel += params.headwind_ms;
+            vz_rel = vzn - params.crosswind_ms;
+            v2 = vx_rel * vx_rel + vyn * vyn + vz_rel * vz_rel;
+        } else {
+            v2 = vx_rel * vx_rel + vyn * vyn;
+        }
+#if BCE_FAST_MATH
+        float inv_v = (v2 >= 1.0f) ? bceRsqrt(v2) : 0.0f;
+        float v_rel = v2 * inv_v;
+#else
+        float v_rel = std::sqrt(v2);
+        float inv_v = (v_rel >= 1.0f) ? 1.0f / v_rel : 0.0f;
+#endif
+        float ax = 0.0f;
+        float ay = -BCE_GRAVITY;
+        float az = 0.0f;
+        if (v_rel >= 1.0f) {
+#if BCE_ENABLE_PROFILING
+            perf_drag_lookups_++;
+#endif
+            float k = DragModelLookup::getBandedDeceleration(drag, v_rel) * inv_v;
+            ax = -k * vx_rel;
+            ay -= k * vyn;
+            az = -k * vz_rel;
+        }
+        const float inv_vx = 1.0f / vxn;
+        d.y = vyn * inv_vx;
+        d.vx = ax * inv_vx;
+        d.vy = ay * inv_vx;
+        d.t = inv_vx;
+        d.z = 0.0f;
+        d.vz = 0.0f;
+        if constexpr (Wind) {
+            d.z = vzn * inv_vx;
+            d.vz = az * inv_vx;
+        }
+    };
+
+    auto velocity = [&]() {
+        if constexpr (Wind) {
+            return bceSqrt(vx * vx + vy * vy + vz * vz);
+        } else {
+            return bceSqrt(vx * vx + vy * vy);
+        }
+    };
+
+    bool paused = false;
+    while (x < range_m && iteration < BCE_MAX_SOLVER_ITERATIONS) {
+        if (budget == 0) {
+            paused = true;
+            break;
+        }
+        budget--;
+        iteration++;
+
+        // A bullet that no longer makes downrange progress ends the
+        // trajectory like one that drops below the velocity floor
+        if (velocity() < BCE_MIN_VELOCITY || vx < BCE_MIN_VELOCITY) break;
+
+        // End the step on the next record (when filling), or on the target, exactly
+        const float node = static_cast<float>((last_range_index + 1) * BCE_TRAJ_TABLE_STRIDE_M);
+        float x_next = x + step_m;
+        if (FillTable && x_next > node - 1e-3f * step_m) x_next = node;
+        if (x_next > range_m) x_next = range_m;
+        const float h = x_next - x;
+
+        // --- RK4 in x ---
+        Slope k1, k2, k3, k4;
+        derivative(vx, vy, vz, k1);
+        derivative(vx + 0.5f * h * k1.vx, vy + 0.5f * h * k1.vy, vz + 0.5f * h * k1.vz, k2);
+        derivative(vx + 0.5f * h * k2.vx, vy + 0.5f * h * k2.vy, vz + 0.5f * h * k2.vz, k3);
+        derivative(vx + h * k3.vx, vy + h * k3.vy, vz + h * k3.vz, k4);
+
+        const float w = h / 6.0f;
+        y += w * (k1.y + 2.0f * k2.y + 2.0f * k3.y + k4.y);
+        vx += w * (k1.vx + 2.0f * k2.vx + 2.0f * k3.vx + k4.vx);
+        vy += w * (k1.vy + 2.0f * k2.vy + 2.0f * k3.vy + k4.vy);
+        t += w * (k1.t + 2.0f * k2.t + 2.0f * k3.t + k4.t);
+        if constexpr (Wind) {
+            z += w * (k1.z + 2.0f * k2.z + 2.0f * k3.z + k4.z);
+            vz += w * (k1.vz + 2.0f * k2.vz + 2.0f * k3.vz + k4.vz);
+        }
+        x = x_next;
+
+        if constexpr (FillTable) {
+            if (x == node) {
+                last_range_index++;
+                if (last_range_index < BCE_TRAJ_TABLE_SIZE) {
+                    TrajectoryPoint tp;
+                    tp.drop_m = y;
+                    tp.windage_m = z;
+                    tp.velocity_ms = velocity();
+                    tp.tof_s = t;
+                    tp.energy_j = 0.5f * params.bullet_mass_kg * tp.velocity_ms * tp.velocity_ms;
+                    storeRecord(last_range_index, tp);
+                    max_valid_range_ = last_range_index * BCE_TRAJ_TABLE_STRIDE_M;
+                }
+            }
+        }
+    }
+
+#if BCE_ENABLE_PROFILING
+    perf_steps_ += iteration - s.iteration;
+#endif
+    s.finished = !paused;
+    if (paused) {
+        s.x = x; s.y = y; s.z = z;
+        s.vx = vx; s.vy = vy; s.vz = vz;
+        s.t = t;
+        s.iteration = iteration;
+        s.last_range_index = last_range_index;
+        return NAN;
+    }
+    last_step_count_ = iteration;
+
+    if (x < range_m) {
+        return NAN; // bullet didn't reach target range
+    }
+    return y; // the last step ended on range_m
 }
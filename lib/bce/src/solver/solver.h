@@ -5,32 +5,26 @@
  * BCE SRS v1.3 — Section 11.1
  *
  * Integrates the point-mass equations of motion with adaptive timestep
- * fourth-order Runge-Kutta (RK4). Produces a 1-meter resolution trajectory table
- * stored in static memory. Also solves for the zero angle via binary search.
+ * fourth-order Runge-Kutta (RK4). Error-controlled Dormand–Prince 5(4) and
+ * RK4 stepped in downrange distance are optional alternatives. Produces a
+ * trajectory table (one record per BCE_TRAJ_TABLE_STRIDE_M) in static
+ * memory, and solves for the zero angle by warm-started secant iteration.
  */
 
 #pragma once
 
 #include "bce/bce_config.h"
 #include "bce/bce_types.h"
-
-/**
- * Per-meter trajectory record stored in the static table.
- */
-struct TrajectoryPoint {
-    float drop_m;           // Vertical drop from bore line (m, negative = below)
-    float windage_m;        // Lateral deflection (m, positive = right)
-    float velocity_ms;      // Velocity at this range
-    float tof_s;            // Time of flight to this range (seconds)
-    float energy_j;         // Kinetic energy at this range (joules)
-};
+#include "compact_table.h"
+#include "zero_search.h"
+#include <cmath>
 
 /**
  * Solver input parameters — everything needed for one trajectory solution.
  */
 struct SolverParams {
     float bc;                    // Ballistic coefficient (already atmosphere-corrected)
-    DragModel drag_model;        // G1–G8
+    DragModel drag_model;        // G1–G8 or CUSTOM
     float muzzle_velocity_ms;    // m/s
     float bullet_mass_kg;        // kg (converted from grains by caller)
     float sight_height_m;        // meters above bore axis
@@ -58,6 +52,22 @@ struct SolverParams {
     float twist_rate_inches;     // signed: positive = RH
     float caliber_m;             // bullet caliber in meters
     bool  spin_drift_enabled;
+
+    // Velocity-banded BC: below bc_band_velocity_ms[i] (airspeed, strictly
+    // descending) drag uses bc × bc_band_ratio[i]. 0 bands = bc throughout.
+    int   bc_band_count;
+    float bc_band_velocity_ms[BCE_MAX_BC_BANDS];
+    float bc_band_ratio[BCE_MAX_BC_BANDS];
+
+    // Integrator (zero-initialized params select the legacy RK4 path)
+    IntegratorMethod integrator;
+    float integrator_tolerance_m; // Dormand–Prince position tolerance; ≤ 0 = default
+
+    // Step controls (IntegratorTuning); ≤ 0 = the bce_config.h default
+    float integrator_step_scale_m;   // RK4: dt = scale / speed outside Mach 0.9–1.2
+    float integrator_max_step_m;     // RK4: longest downrange step; Dormand–Prince: first step
+    float integrator_transonic_dt_s; // RK4: step inside Mach 0.9–1.2
+    float integrator_range_step_m;   // RK4_RANGE: longest downrange step
 };
 
 /**
@@ -78,6 +88,29 @@ struct SolverResult {
     float  spin_drift_moa;
 };
 
+/**
+ * Partial derivatives of the target-range outputs with respect to one input.
+ */
+struct SolverPartials {
+    float drop_m;
+    float windage_m;
+    float tof_s;
+    float velocity_ms;
+};
+
+/**
+ * Forward sensitivities at params.target_range_m, launch angle held fixed
+ * (the rifle keeps its zero). Each member holds the partials per unit of
+ * its input.
+ */
+struct SolverSensitivity {
+    SolverPartials range;            // per meter, along the trajectory
+    SolverPartials muzzle_velocity;  // per m/s
+    SolverPartials bc;               // per unit fractional change (ΔBC / BC)
+    SolverPartials crosswind;        // per m/s, positive = right-to-left
+    SolverPartials headwind;         // per m/s, positive = into shooter
+};
+
 class BallisticSolver {
 public:
     void init();
@@ -87,11 +120,35 @@ public:
      * This finds the launch angle that results in zero drop at zero_range_m
      * accounting for sight_height_m.
      *
+     * Secant iterations start from initial_guess_rad (typically the previous
+     * zero), falling back to an Illinois solve on [-5°, +5°] if the secant
+     * phase leaves the bracket or fails to converge. With
+     * BCE_ZERO_COARSE_PASS and the time-domain RK4 integrator, a coarse
+     * pass searches with the range-domain RK4 kernel first and the
+     * time-domain RK4 then refines that angle. Both passes stop on
+     * BCE_ZERO_TOLERANCE_M.
+     *
      * @param params  Solver parameters (launch_angle_rad will be ignored/overwritten)
      * @param zero_range_m  Range to zero at (meters)
+     * @param initial_guess_rad  Warm-start angle; NAN or out-of-bracket starts at 0
      * @return Zero angle in radians, or NAN if unsolvable
      */
-    float solveZeroAngle(SolverParams params, float zero_range_m);
+    float solveZeroAngle(SolverParams params, float zero_range_m, float initial_guess_rad = NAN);
+
+    /** Integration steps taken by the most recent trajectory integration. */
+    uint32_t getLastStepCount() const { return last_step_count_; }
+
+    /** Full-fidelity integrations used by the most recent solveZeroAngle() call. */
+    uint32_t getLastZeroIterations() const { return last_zero_iterations_; }
+
+    /** Coarse-pass integrations used by the most recent solveZeroAngle() call. */
+    uint32_t getLastZeroCoarseIterations() const { return last_zero_coarse_iterations_; }
+
+#if BCE_ENABLE_PROFILING
+    /** Cumulative integrator steps and drag evaluations since init(). */
+    uint32_t getPerfStepCount() const { return perf_steps_; }
+    uint32_t getPerfDragLookups() const { return perf_drag_lookups_; }
+#endif
 
     /**
      * Integrate a full trajectory with the given parameters.
@@ -103,20 +160,246 @@ public:
     SolverResult integrate(const SolverParams& params);
 
     /**
-     * Get a trajectory point at a specific range (meters).
-     * Only valid after integrate() has been called.
+     * Integrate to params.target_range_m and, in the same pass, the
+     * variational equations of the launch state and of the BC and wind
+     * terms in the drag, giving the first-order sensitivities without
+     * perturbed re-integrations. The Jacobian of the drag is analytic (Cd
+     * slope from the drag table); the step sizes and BC band edges are
+     * treated as fixed. RK4_RANGE runs this pass with the time-domain RK4.
+     * Leaves the trajectory table untouched.
+     *
+     * @param params  Complete solver parameters including launch_angle_rad
+     * @param sens    Filled when the result is valid
+     * @return SolverResult at the target range, from the integration itself
+     */
+    SolverResult integrateWithSensitivity(const SolverParams& params, SolverSensitivity& sens);
+
+    /**
+     * Integrate the trajectory once out to horizon_m, filling the table so that
+     * any range up to getMaxValidRange() can later be answered by
+     * sampleTrajectory() without re-integrating. params.target_range_m is ignored.
+     *
+     * @param params     Complete solver parameters including launch_angle_rad
+     * @param horizon_m  Farthest range to tabulate (clamped to BCE_MAX_RANGE_M)
+     * @return true if at least one meter of trajectory was tabulated
+     */
+    bool integrateTrajectory(const SolverParams& params, float horizon_m);
+
+    /**
+     * Rebuild the trajectory table from records spaced node_step_m apart
+     * (indices 0..last), e.g. a table saved by a previous boot. Intermediate
+     * records are filled by interpolateTable(). The restored table is only
+     * meaningful for the SolverParams it was integrated with.
+     * @param nodes  (last + 1) packed TrajectoryPoint records; any alignment,
+     *               since blobs read from flash often have none
+     * @return true if at least one meter of trajectory was restored
+     */
+    bool loadTrajectory(const uint8_t* nodes, int last, int node_step_m);
+
+    /**
+     * Build a SolverResult at range_m by interpolating the trajectory table.
+     * params must be the same parameters the table was integrated with
+     * (only target_range_m may differ). Returns result.valid = false if
+     * range_m lies beyond the tabulated trajectory.
+     */
+    SolverResult sampleTrajectory(const SolverParams& params, float range_m) const;
+
+    /**
+     * Populate a SolverResult from a trajectory record at range_m, including
+     * spin drift and Coriolis components.
+     */
+    static SolverResult buildResult(const SolverParams& params, const TrajectoryPoint& tp,
+                                    float range_m);
+
+    /** Farthest range (meters) currently tabulated. */
+    int getMaxValidRange() const { return max_valid_range_; }
+
+    /**
+     * Advances each time the table is emptied for a new fill (integrate(),
+     * integrateTrajectory(), beginTrajectory(), loadTrajectory(), init()),
+     * so a caller holding table records can tell they were overwritten.
+     */
+    uint32_t getTableGeneration() const { return table_generation_; }
+
+    /** Static RAM of the trajectory table (float or compact records). */
+    static constexpr size_t getTableBytes() { return sizeof(table_); }
+
+#if !BCE_TRAJ_TABLE_COMPACT
+    /**
+     * The trajectory table itself, records 0..getMaxValidRange() /
+     * BCE_TRAJ_TABLE_STRIDE_M. Not available with BCE_TRAJ_TABLE_COMPACT,
+     * which stores encoded records.
+     */
+    const TrajectoryPoint* getTable() const { return table_; }
+#endif
+
+    /**
+     * Get the stored trajectory record at a specific range (meters).
+     * Only valid after integrate() has been called. With a table stride
+     * above 1 m only multiples of BCE_TRAJ_TABLE_STRIDE_M are stored;
+     * use getPointAtRange() for arbitrary ranges. With BCE_TRAJ_TABLE_COMPACT
+     * the record is decoded into a small ring of scratch copies, so a pointer
+     * stays valid for the next three calls only.
      * @param range_m  Range in meters (0 to BCE_MAX_RANGE_M)
      * @return Pointer to trajectory point, or nullptr if out of range
      */
     const TrajectoryPoint* getPointAt(int range_m) const;
 
+    /**
+     * Interpolate the trajectory at a sub-meter range using cubic Hermite
+     * segments between stored records. Drop, windage and velocity tangents
+     * come from neighbouring records; the TOF tangent is the physical
+     * dt/dx = path length per meter / velocity.
+     * @param range_m  Range in meters (0 to getMaxValidRange())
+     * @param out      Filled with the interpolated point on success
+     * @return false if range_m lies outside the tabulated trajectory
+     */
+    bool getPointAtRange(float range_m, TrajectoryPoint& out) const;
+
+    /**
+     * Cubic Hermite interpolation of range_m over any table of records spaced
+     * stride meters apart, indices 0..last. getPointAtRange() applies it to the
+     * solver's own table.
+     */
+    static bool interpolateTable(const TrajectoryPoint* table, int last, float stride,
+                                 float range_m, TrajectoryPoint& out);
+
+    // --- Time-sliced jobs ---
+    // solveZeroAngle() and integrateTrajectory() split into bounded slices.
+    // A job runs the same integration steps and produces bit-identical
+    // results; one job is in flight at a time and begin*() replaces it.
+
+    /** Start a resumable solveZeroAngle(); the result is getJobZeroAngle(). */
+    void beginZeroSolve(const SolverParams& params, float zero_range_m, float initial_guess_rad);
+
+    /**
+     * Start a resumable integrateTrajectory(). The table is only complete
+     * once the job finishes; integrate(), integrateTrajectory() or
+     * loadTrajectory() in between cancel the job.
+     */
+    void beginTrajectory(const SolverParams& params, float horizon_m);
+
+    /**
+     * Advance the job by up to max_steps integration steps.
+     * @return true if the job finished during this call
+     */
+    bool stepJob(uint32_t max_steps);
+
+    /** True while a job is waiting for more steps. */
+    bool hasJob() const { return job_ != Job::NONE; }
+
+    /** Zero angle from the last finished zero job, or NAN if unsolvable. */
+    float getJobZeroAngle() const { return job_zero_angle_rad_; }
+
 private:
+    /** Integrator state carried between slices of one integration. */
+    struct IntegrationState {
+        float x, y, z;
+        float vx, vy, vz;
+        float t;
+        float dp_dt;       // Dormand–Prince proposed next step
+        float dp_a0[3];    // Dormand–Prince FSAL stage
+        bool dp_fsal;
+        uint32_t iteration;
+        int last_range_index;
+        bool finished;     // range reached or trajectory terminated
+    };
+
+    enum class Job : uint8_t { NONE, ZERO, TRAJECTORY };
+
+    /** What a sensitivity kernel reports at the target range. */
+    struct SensitivityPass {
+        TrajectoryPoint at_range;
+        SolverSensitivity sens;
+    };
+
+    // Zero search bracket
+    static constexpr float ZERO_LO_BOUND_RAD = -5.0f * BCE_DEG_TO_RAD; // bore pointing down
+    static constexpr float ZERO_HI_BOUND_RAD = 5.0f * BCE_DEG_TO_RAD;  // bore pointing up
+
+#if BCE_TRAJ_TABLE_COMPACT
+    CompactTrajectoryTable table_;
+    mutable TrajectoryPoint decoded_[4] = {}; // ring backing getPointAt()
+    mutable uint32_t decoded_next_ = 0;
+#else
     TrajectoryPoint table_[BCE_TRAJ_TABLE_SIZE];
-    int max_valid_range_ = 0;
+#endif
+    int max_valid_range_ = 0; // meters, always a multiple of the table stride
+    uint32_t table_generation_ = 0;
+    uint32_t last_zero_iterations_ = 0;
+    uint32_t last_zero_coarse_iterations_ = 0;
+    uint32_t last_step_count_ = 0;
+#if BCE_ENABLE_PROFILING
+    uint32_t perf_steps_ = 0;
+    uint32_t perf_drag_lookups_ = 0;
+#endif
+
+    // Time-sliced job in flight
+    Job job_ = Job::NONE;
+    SolverParams job_params_ = {};
+    float job_range_m_ = 0.0f;  // zero range, or table extent
+    IntegrationState job_state_ = {};
+    ZeroSearch job_search_;
+    float job_zero_angle_rad_ = NAN;
+    float job_guess_rad_ = NAN;      // caller's guess, if the coarse pass fails
+    bool job_coarse_ = false;        // zero job still in its coarse pass
+    SolverParams job_coarse_params_ = {};
 
     /**
-     * Run the RK4 integration.
+     * Integrate the trajectory with params.integrator.
      * Returns drop at specified range_m, or NAN if bullet didn't reach.
+     * When fill_table is set, records one table entry per stride up to the
+     * last stride boundary crossed.
      */
     float integrateToRange(const SolverParams& params, float range_m, bool fill_table);
+
+    /** True if a zero solve for params starts with the coarse pass. */
+    static bool useCoarseZeroPass(const SolverParams& params);
+
+    /** params on the coarse-pass integrator. */
+    static SolverParams coarseZeroParams(const SolverParams& params);
+
+    /** Muzzle state for an integration; stores the muzzle record when filling. */
+    void startIntegration(const SolverParams& params, bool fill_table, IntegrationState& state);
+
+    /**
+     * Run state forward by at most budget steps (decremented as they are
+     * taken). Returns integrateToRange()'s result once state.finished is
+     * set, NAN while paused.
+     */
+    float continueIntegration(const SolverParams& params, float range_m, bool fill_table,
+                              IntegrationState& state, uint32_t& budget);
+
+    /**
+     * integrateToRange() specialized at compile time for the time-domain
+     * integrators; integrateToRange picks one instantiation per solve.
+     * Wind = false drops the relative-wind terms and the lateral axis
+     * (exact, as windage is then identically zero). Sensitivity = true
+     * also propagates the tangent state and fills *pass at range_m (run
+     * unsliced, without the table).
+     */
+    template <IntegratorMethod Method, bool Wind, bool FillTable, bool Sensitivity = false>
+    float integrateKernel(const SolverParams& params, float range_m, IntegrationState& state,
+                          uint32_t& budget, SensitivityPass* pass);
+
+    /**
+     * IntegratorMethod::RK4_RANGE: RK4 with downrange distance x as the
+     * independent variable (d/dx = (1/vx) d/dt). Steps of at most
+     * BCE_RANGE_STEP_M divide the table stride evenly (full-length steps
+     * when not filling) and the last one is cut to range_m, so records and
+     * the target are step ends and need no crossing reconstruction.
+     * Signature and state as integrateKernel().
+     */
+    template <bool Wind, bool FillTable>
+    float integrateRangeKernel(const SolverParams& params, float range_m, IntegrationState& state,
+                               uint32_t& budget, SensitivityPass* pass);
+
+    /** Empty the table ahead of a fill and advance its generation. */
+    void resetTable();
+    /** Write a table record, encoding it when BCE_TRAJ_TABLE_COMPACT is set. */
+    void storeRecord(int index, const TrajectoryPoint& tp);
+
+
+    /** Smallest stored-record range >= range_m, clamped to BCE_MAX_RANGE_M. */
+    static float nodeRangeAtOrAbove(float range_m);
 };
@@ -0,0 +1,161 @@
+/**
+ * @file zero_search.cpp
+ * @brief Zero-angle root search implementation.
+ */
+
+#include "zero_search.h"
+
+void ZeroSearch::start(float lo_bound, float hi_bound, float initial_guess_rad,
+                       float slope_hint) {
+    lo_bound_ = lo_bound;
+    hi_bound_ = hi_bound;
+    evaluations_ = 0;
+    iteration_ = 0;
+    result_ = NAN;
+    slope_hint_ = slope_hint;
+    slope_ = NAN;
+
+    a0_ = initial_guess_rad;
+    if (!std::isfinite(a0_) || a0_ <= lo_bound_ || a0_ >= hi_bound_) {
+        a0_ = 0.0f;
+    }
+    phase_ = FIRST;
+    pending_ = a0_;
+}
+
+void ZeroSearch::feed(float f) {
+    if (phase_ == DONE) return;
+    evaluations_++;
+
+    switch (phase_) {
+    // --- Secant phase ---
+    // Drop is nearly linear in launch angle over the small angles involved,
+    // so from a warm start this typically converges in 2–4 integrations.
+    case FIRST:
+        if (!std::isfinite(f)) {
+            startBracket();
+            return;
+        }
+        if (std::fabs(f) < BCE_ZERO_TOLERANCE_M) {
+            finish(a0_);
+            return;
+        }
+        f0_ = f;
+        a1_ = (f > 0.0f) ? a0_ - BCE_ZERO_SECANT_STEP_RAD : a0_ + BCE_ZERO_SECANT_STEP_RAD;
+        if (std::isfinite(slope_hint_) && slope_hint_ != 0.0f) {
+            // Newton step on the hinted slope; the secant takes over from there
+            float newton = a0_ - f / slope_hint_;
+            if (newton > lo_bound_ && newton < hi_bound_ && newton != a0_) a1_ = newton;
+        }
+        if (BCE_ZERO_SECANT_MAX_ITERATIONS == 0) {
+            startBracket();
+            return;
+        }
+        phase_ = SECANT;
+        pending_ = a1_;
+        return;
+
+    case SECANT: {
+        if (!std::isfinite(f)) break;
+        if (std::fabs(f) < BCE_ZERO_TOLERANCE_M) {
+            finish(a1_);
+            return;
+        }
+        if (f == f0_) break;
+
+        slope_ = (f - f0_) / (a1_ - a0_);
+        float a2 = a1_ - f * (a1_ - a0_) / (f - f0_);
+        if (!(a2 > lo_bound_ && a2 < hi_bound_)) break;
+
+        a0_ = a1_;
+        f0_ = f;
+        a1_ = a2;
+        if (++iteration_ >= BCE_ZERO_SECANT_MAX_ITERATIONS) break;
+        pending_ = a1_;
+        return;
+    }
+
+    // --- Bracketed fallback (Illinois) ---
+    // If the bullet cannot reach or rise to the line of sight even at the
+    // upper bound, no angle in the bracket can zero it.
+    case UPPER:
+        if (!std::isfinite(f) || f < 0.0f) {
+            finish(NAN);
+            return;
+        }
+        if (std::fabs(f) < BCE_ZERO_TOLERANCE_M) {
+            finish(hi_);
+            return;
+        }
+        f_hi_ = f;
+        phase_ = LOWER;
+        pending_ = lo_;
+        return;
+
+    // f_lo stays NAN while the low end does not reach the zero range; the
+    // step then bisects, since the bullet needs more angle.
+    case LOWER:
+        if (std::isfinite(f) && f > 0.0f) {
+            finish(NAN);
+            return;
+        }
+        f_lo_ = f;
+        retained_ = 0;
+        iteration_ = 0;
+        phase_ = ILLINOIS;
+        nextIllinois();
+        return;
+
+    case ILLINOIS: {
+        const float mid = pending_;
+        iteration_++;
+        if (!std::isfinite(f)) {
+            lo_ = mid;
+            f_lo_ = NAN;
+            retained_ = 0;
+        } else if (std::fabs(f) < BCE_ZERO_TOLERANCE_M) {
+            finish(mid);
+            return;
+        } else if (f > 0.0f) {
+            hi_ = mid;
+            f_hi_ = f;
+            if (retained_ == -1 && std::isfinite(f_lo_)) f_lo_ *= 0.5f;
+            retained_ = -1;
+        } else {
+            lo_ = mid;
+            f_lo_ = f;
+            if (retained_ == +1) f_hi_ *= 0.5f;
+            retained_ = +1;
+        }
+        nextIllinois();
+        return;
+    }
+
+    case DONE:
+        return;
+    }
+
+    // The secant phase left the bracket or stalled
+    startBracket();
+}
+
+void ZeroSearch::finish(float angle) {
+    result_ = angle;
+    phase_ = DONE;
+}
+
+void ZeroSearch::startBracket() {
+    lo_ = lo_bound_;
+    hi_ = hi_bound_;
+    phase_ = UPPER;
+    pending_ = hi_;
+}
+
+void ZeroSearch::nextIllinois() {
+    if (iteration_ >= BCE_ZERO_MAX_ITERATIONS) {
+        finish(NAN);
+        return;
+    }
+    pending_ = std::isfinite(f_lo_) ? (lo_ * f_hi_ - hi_ * f_lo_) / (f_hi_ - f_lo_)
+                                    : (lo_ + hi_) * 0.5f;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file zero_search.h
+ * @brief Zero-angle root search with the residual evaluated by the caller.
+ *
+ * The warm-started secant / Illinois search behind
+ * BallisticSolver::solveZeroAngle(), turned inside out: angle() names the
+ * launch angle to integrate next and feed() takes its residual, so the
+ * integrations can run in one go or spread over several time slices.
+ */
+
+#pragma once
+
+#include "bce/bce_config.h"
+#include <cmath>
+#include <cstdint>
+
+class ZeroSearch {
+public:
+    /**
+     * Start a search on [lo_bound, hi_bound] from initial_guess_rad; NAN or
+     * out-of-bracket guesses start at 0. A finite slope_hint (residual per
+     * radian, e.g. getSlope() of a coarser search) replaces the fixed
+     * secant probe with a Newton step.
+     */
+    void start(float lo_bound, float hi_bound, float initial_guess_rad, float slope_hint = NAN);
+
+    /** True once result() is final. */
+    bool done() const { return phase_ == DONE; }
+
+    /** Launch angle whose residual feed() expects next. */
+    float angle() const { return pending_; }
+
+    /**
+     * Accept the residual at angle(): drop at the zero range minus the
+     * target drop, positive when the bullet lands high, NAN if it never got
+     * there.
+     */
+    void feed(float residual);
+
+    /** Zero angle, or NAN if unsolvable. */
+    float result() const { return result_; }
+
+    /** Residuals fed since start(). */
+    uint32_t getEvaluations() const { return evaluations_; }
+
+    /** Residual per radian from the last secant step, or NAN if none was taken. */
+    float getSlope() const { return slope_; }
+
+private:
+    enum Phase : uint8_t { FIRST, SECANT, UPPER, LOWER, ILLINOIS, DONE };
+
+    Phase phase_ = DONE;
+    float pending_ = 0.0f;
+    float result_ = NAN;
+    uint32_t evaluations_ = 0;
+    uint32_t iteration_ = 0;
+    float slope_hint_ = NAN;
+    float slope_ = NAN;
+
+    float lo_bound_ = 0.0f, hi_bound_ = 0.0f;
+    float a0_ = 0.0f, f0_ = 0.0f, a1_ = 0.0f; // secant
+    float lo_ = 0.0f, hi_ = 0.0f;              // bracket
+    float f_lo_ = 0.0f, f_hi_ = 0.0f;
+    int retained_ = 0; // +1 if hi was retained last step, -1 if lo
+
+    void finish(float angle);
+    void startBracket();
+    void nextIllinois();
+};
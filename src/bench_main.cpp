@@ -0,0 +1,503 @@
+/**
+ * @file bench_main.cpp
+ * @brief Solver benchmark runner for the bench / bench_esp32p4 environments.
+ *
+ * Times the hot paths of the engine on canonical cartridge workloads and
+ * prints one JSON document so results can be diffed across releases:
+ *
+ *   pio run -e bench && .pio/build/bench/program > bench_output.txt
+ *
+ * On ESP32-P4 the RISC-V cycle counter is read (unit "cycles"); on native
+ * std::chrono::steady_clock is used (unit "ns"). The "memory" object is the
+ * build's static RAM per engine instance (BCE_GetMemoryReport), in bytes.
+ */
+
+#include "bce/bce_api.h"
+#include "bce/bce_config.h"
+#include "ahrs/ahrs_manager.h"
+#include "drag/drag_model.h"
+#include "parallel/sweep_executor.h"
+#include "solver/batch_solver.h"
+#include "solver/solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef BCE_PLATFORM_ESP32
+#include "esp_cpu.h"
+#else
+#include <chrono>
+#endif
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Timing
+// ---------------------------------------------------------------------------
+
+#ifdef BCE_PLATFORM_ESP32
+constexpr const char* kPlatform = "esp32p4";
+constexpr const char* kUnit = "cycles";
+
+inline uint64_t benchNow() {
+    return static_cast<uint64_t>(esp_cpu_get_cycle_count());
+}
+
+inline uint64_t benchElapsed(uint64_t start, uint64_t end) {
+    // 32-bit counter; unsigned subtraction handles a single wrap
+    return static_cast<uint32_t>(static_cast<uint32_t>(end) - static_cast<uint32_t>(start));
+}
+#else
+constexpr const char* kPlatform = "native";
+constexpr const char* kUnit = "ns";
+
+inline uint64_t benchNow() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline uint64_t benchElapsed(uint64_t start, uint64_t end) {
+    return end - start;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Canonical workloads — mirror test_cartridges.cpp and bce_gui_preset.json
+// ---------------------------------------------------------------------------
+
+struct Workload {
+    const char* name;
+    float bc;
+    DragModel drag_model;
+    float muzzle_velocity_ms;
+    float mass_grains;
+    float caliber_inches;
+    float twist_rate_inches;
+    float zero_range_m;
+};
+
+constexpr Workload kWorkloads[] = {
+    {"308_150gr_gui_preset", 0.414f, DragModel::G1, 859.536f, 150.0f, 0.308f, 10.0f, 91.44f},
+    {"223_55gr",             0.245f, DragModel::G1, 990.0f,   55.0f,  0.224f, 12.0f, 100.0f},
+    {"65cm_140gr",           0.326f, DragModel::G7, 823.0f,   140.0f, 0.264f, 8.0f,  100.0f},
+    {"300wm_190gr",          0.533f, DragModel::G1, 884.0f,   190.0f, 0.308f, 10.0f, 100.0f},
+    {"9mm_124gr",            0.150f, DragModel::G1, 365.0f,   124.0f, 0.355f, 10.0f, 25.0f},
+};
+
+constexpr float kIntegrateRanges[] = {100.0f, 500.0f, 1000.0f, 2500.0f};
+
+SolverParams makeParams(const Workload& w, float range_m) {
+    SolverParams p;
+    std::memset(&p, 0, sizeof(p));
+    p.bc = w.bc;
+    p.drag_model = w.drag_model;
+    p.muzzle_velocity_ms = w.muzzle_velocity_ms;
+    p.bullet_mass_kg = w.mass_grains * BCE_GRAINS_TO_KG;
+    p.sight_height_m = 0.0381f;
+    p.air_density = BCE_STD_AIR_DENSITY;
+    p.speed_of_sound = BCE_SPEED_OF_SOUND_15C;
+    p.drag_reference_scale = BCE_DEFAULT_DRAG_REFERENCE_SCALE;
+    p.target_range_m = range_m;
+    p.crosswind_ms = 4.0f;
+    p.twist_rate_inches = w.twist_rate_inches;
+    p.caliber_m = w.caliber_inches * BCE_INCHES_TO_M;
+    p.spin_drift_enabled = true;
+    return p;
+}
+
+// ---------------------------------------------------------------------------
+// Sample collection and JSON output
+// ---------------------------------------------------------------------------
+
+constexpr int kMaxSamples = 64;
+
+struct Samples {
+    uint64_t v[kMaxSamples];
+    int n = 0;
+};
+
+bool s_first_result = true;
+
+const char* integratorName(IntegratorMethod m) {
+    if (m == IntegratorMethod::DORMAND_PRINCE) return "dormand_prince";
+    if (m == IntegratorMethod::RK4_RANGE) return "rk4_range";
+    return "rk4";
+}
+
+void emit(const char* name, const char* workload, const char* integrator, float range_m,
+          Samples& s, uint32_t steps, uint64_t ops_per_sample) {
+    if (s.n == 0) return;
+    std::sort(s.v, s.v + s.n);
+    uint64_t sum = 0;
+    for (int i = 0; i < s.n; ++i) sum += s.v[i];
+
+    const double scale = 1.0 / static_cast<double>(ops_per_sample);
+    std::printf("%s\n    {\"name\": \"%s\", \"workload\": \"%s\", \"integrator\": \"%s\", "
+                "\"range_m\": %.0f, \"samples\": %d, \"ops_per_sample\": %llu, "
+                "\"min\": %.1f, \"median\": %.1f, \"mean\": %.1f, \"max\": %.1f, "
+                "\"steps\": %lu}",
+                s_first_result ? "" : ",", name, workload, integrator, range_m, s.n,
+                static_cast<unsigned long long>(ops_per_sample),
+                static_cast<double>(s.v[0]) * scale,
+                static_cast<double>(s.v[s.n / 2]) * scale,
+                static_cast<double>(sum) * scale / static_cast<double>(s.n),
+                static_cast<double>(s.v[s.n - 1]) * scale,
+                static_cast<unsigned long>(steps));
+    s_first_result = false;
+}
+
+// Repetition counts scale down for the long integrations so a full run
+// stays within a few seconds on device
+int samplesForRange(float range_m, IntegratorMethod m) {
+    if (m != IntegratorMethod::RK4) return 32;
+    return (range_m >= 1000.0f) ? 8 : 32;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+BallisticSolver s_solver; // static: holds the trajectory table
+
+void benchSolver(const Workload& w, IntegratorMethod method) {
+    const char* integ = integratorName(method);
+
+    // Cold zero solve (no warm start) and warm re-solve after a small
+    // density change, the path taken by baro-driven zero recomputes
+    {
+        SolverParams p = makeParams(w, w.zero_range_m);
+        p.integrator = method;
+        Samples cold;
+        Samples warm;
+        uint32_t cold_iters = 0;
+        uint32_t warm_iters = 0;
+        for (int i = 0; i < 16; ++i) {
+            uint64_t t0 = benchNow();
+            float angle = s_solver.solveZeroAngle(p, w.zero_range_m);
+            uint64_t t1 = benchNow();
+            cold.v[cold.n++] = benchElapsed(t0, t1);
+            cold_iters = s_solver.getLastZeroIterations();
+
+            SolverParams q = p;
+            q.air_density *= 0.98f;
+            t0 = benchNow();
+            s_solver.solveZeroAngle(q, w.zero_range_m, angle);
+            t1 = benchNow();
+            warm.v[warm.n++] = benchElapsed(t0, t1);
+            warm_iters = s_solver.getLastZeroIterations();
+        }
+        emit("solve_zero_cold", w.name, integ, w.zero_range_m, cold, cold_iters, 1);
+        emit("solve_zero_warm", w.name, integ, w.zero_range_m, warm, warm_iters, 1);
+    }
+
+    SolverParams zp = makeParams(w, w.zero_range_m);
+    zp.integrator = method;
+    float zero_angle = s_solver.solveZeroAngle(zp, w.zero_range_m);
+    if (!std::isfinite(zero_angle)) zero_angle = 0.0f;
+
+    for (float range : kIntegrateRanges) {
+        SolverParams p = makeParams(w, range);
+        p.integrator = method;
+        p.launch_angle_rad = zero_angle;
+
+        Samples s;
+        uint32_t steps = 0;
+        int n = samplesForRange(range, method);
+        for (int i = 0; i < n; ++i) {
+            uint64_t t0 = benchNow();
+            s_solver.integrate(p);
+            uint64_t t1 = benchNow();
+            s.v[s.n++] = benchElapsed(t0, t1);
+            steps = s_solver.getLastStepCount();
+        }
+        emit("integrate", w.name, integ, range, s, steps, 1);
+    }
+}
+
+// Per-step cost of each integrator specialization. Calm air runs the
+// two-axis kernel; any wind selects the three-axis one. Reported per step
+// (ops_per_sample = steps) so the variants compare despite different step
+// counts.
+void benchSolverVariants(const Workload& w) {
+    constexpr float kRange = 1000.0f;
+    const IntegratorMethod methods[] = {IntegratorMethod::RK4, IntegratorMethod::DORMAND_PRINCE,
+                                        IntegratorMethod::RK4_RANGE};
+    for (IntegratorMethod method : methods) {
+        for (int windy = 0; windy < 2; ++windy) {
+            SolverParams p = makeParams(w, kRange);
+            p.integrator = method;
+            p.crosswind_ms = windy ? 4.0f : 0.0f;
+            p.launch_angle_rad = s_solver.solveZeroAngle(p, w.zero_range_m);
+            if (!std::isfinite(p.launch_angle_rad)) p.launch_angle_rad = 0.0f;
+
+            s_solver.integrate(p);
+            const uint32_t steps = s_solver.getLastStepCount();
+            if (steps == 0) continue;
+
+            Samples s;
+            int n = samplesForRange(kRange, method);
+            for (int i = 0; i < n; ++i) {
+                uint64_t t0 = benchNow();
+                s_solver.integrate(p);
+                uint64_t t1 = benchNow();
+                s.v[s.n++] = benchElapsed(t0, t1);
+            }
+            emit(windy ? "integrate_step_wind" : "integrate_step_calm", w.name,
+                 integratorName(method), kRange, s, steps, steps);
+        }
+    }
+}
+
+// Per-trajectory cost of an MV/BC spread solved one at a time versus in
+// lockstep lanes
+void benchBatch(const Workload& w) {
+    constexpr int kCount = 4 * BCE_BATCH_LANES;
+    constexpr float kRange = 1000.0f;
+    static SolverParams params[kCount];
+    static SolverResult results[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        params[i] = makeParams(w, kRange);
+        params[i].muzzle_velocity_ms += 2.0f * static_cast<float>(i - kCount / 2);
+        params[i].bc *= 1.0f + 0.002f * static_cast<float>(i % 5);
+    }
+
+    Samples scalar;
+    Samples batch;
+    for (int n = 0; n < 8; ++n) {
+        uint64_t t0 = benchNow();
+        for (int i = 0; i < kCount; ++i) results[i] = s_solver.integrate(params[i]);
+        uint64_t t1 = benchNow();
+        scalar.v[scalar.n++] = benchElapsed(t0, t1);
+
+        t0 = benchNow();
+        BatchSolver::solve(params, kCount, results);
+        t1 = benchNow();
+        batch.v[batch.n++] = benchElapsed(t0, t1);
+    }
+    emit("integrate_scalar_loop", w.name, "rk4", kRange, scalar, 0, kCount);
+    emit("integrate_batch", w.name, "rk4", kRange, batch, 0, kCount);
+}
+
+#ifdef BCE_PLATFORM_NATIVE
+// Per-trajectory cost of the same spread on the work-stealing pool
+void benchSweep(const Workload& w) {
+    constexpr int kCount = 64;
+    constexpr float kRange = 1000.0f;
+    static SolverParams params[kCount];
+    static SolverResult results[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        params[i] = makeParams(w, kRange);
+        params[i].muzzle_velocity_ms += 2.0f * static_cast<float>(i - kCount / 2);
+    }
+
+    SweepExecutor exec;
+    Samples s;
+    for (int n = 0; n < 8; ++n) {
+        uint64_t t0 = benchNow();
+        exec.solve(params, kCount, results);
+        uint64_t t1 = benchNow();
+        s.v[s.n++] = benchElapsed(t0, t1);
+    }
+    emit("integrate_sweep_parallel", w.name, "rk4", kRange, s, 0, kCount);
+}
+#endif
+
+void benchDragLookup() {
+    constexpr int kOps = 4096;
+    const DragModel models[] = {DragModel::G1, DragModel::G7};
+    for (DragModel model : models) {
+        Samples fast;
+        Samples ref;
+        volatile float sink = 0.0f;
+        for (int i = 0; i < 32; ++i) {
+            uint64_t t0 = benchNow();
+            for (int k = 0; k < kOps; ++k) {
+                sink = sink + DragModelLookup::getCd(model, 0.001f * static_cast<float>(k));
+            }
+            uint64_t t1 = benchNow();
+            fast.v[fast.n++] = benchElapsed(t0, t1);
+
+            t0 = benchNow();
+            for (int k = 0; k < kOps; ++k) {
+                sink = sink + DragModelLookup::getCdReference(model, 0.001f * static_cast<float>(k));
+            }
+            t1 = benchNow();
+            ref.v[ref.n++] = benchElapsed(t0, t1);
+        }
+        const char* name = (model == DragModel::G7) ? "G7" : "G1";
+        emit("drag_get_cd", name, "-", 0.0f, fast, 0, kOps);
+        emit("drag_get_cd_reference", name, "-", 0.0f, ref, 0, kOps);
+    }
+}
+
+void benchAHRS() {
+    static AHRSManager ahrs;
+    constexpr int kOps = 1000;
+    const AHRS_Algorithm algos[] = {AHRS_Algorithm::MADGWICK, AHRS_Algorithm::MAHONY};
+    for (AHRS_Algorithm algo : algos) {
+        ahrs.init();
+        ahrs.setAlgorithm(algo);
+        Samples s;
+        for (int i = 0; i < 32; ++i) {
+            uint64_t t0 = benchNow();
+            for (int k = 0; k < kOps; ++k) {
+                float wobble = 0.01f * static_cast<float>(k & 7);
+                ahrs.update(wobble, 0.0f, 9.81f, 0.001f, -0.002f, 0.0005f,
+                            20.0f, 0.0f, -40.0f, true, 0.001f);
+            }
+            uint64_t t1 = benchNow();
+            s.v[s.n++] = benchElapsed(t0, t1);
+        }
+        emit("ahrs_update", (algo == AHRS_Algorithm::MAHONY) ? "mahony" : "madgwick", "-", 0.0f,
+             s, 0, kOps);
+    }
+}
+
+SensorFrame makeFrame(uint64_t timestamp_us, float range_m) {
+    SensorFrame f;
+    std::memset(&f, 0, sizeof(f));
+    f.timestamp_us = timestamp_us;
+    f.accel_z = 9.81f;
+    f.imu_valid = true;
+    f.baro_pressure_pa = 101325.0f;
+    f.baro_temperature_c = 15.0f;
+    f.baro_humidity = 0.5f;
+    f.baro_valid = true;
+    f.baro_humidity_valid = true;
+    f.lrf_range_m = range_m;
+    f.lrf_timestamp_us = timestamp_us;
+    f.lrf_confidence = 1.0f;
+    f.lrf_valid = true;
+    return f;
+}
+
+void benchEngineFrame(const Workload& w, IntegratorMethod method) {
+    BCE_Init();
+    BCE_SetIntegrator(method, 0.0f);
+
+    BulletProfile bullet;
+    std::memset(&bullet, 0, sizeof(bullet));
+    bullet.bc = w.bc;
+    bullet.drag_model = w.drag_model;
+    bullet.muzzle_velocity_ms = w.muzzle_velocity_ms;
+    bullet.barrel_length_in = 24.0f;
+    bullet.mass_grains = w.mass_grains;
+    bullet.caliber_inches = w.caliber_inches;
+    bullet.twist_rate_inches = w.twist_rate_inches;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {w.zero_range_m, 38.1f};
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    for (int i = 0; i < 200; ++i) {
+        t += 10000;
+        SensorFrame f = makeFrame(t, 500.0f);
+        BCE_Update(&f);
+    }
+
+    // Steady inputs (solution cache), a moving LRF range (trajectory table)
+    // and hand-held IMU noise, which moves the quantized pitch nearly every
+    // frame and so re-integrates to the tabulation horizon each time
+    Samples steady;
+    Samples ranging;
+    Samples jitter;
+    for (int i = 0; i < 32; ++i) {
+        t += 10000;
+        SensorFrame f = makeFrame(t, 500.0f);
+        uint64_t t0 = benchNow();
+        BCE_Update(&f);
+        uint64_t t1 = benchNow();
+        steady.v[steady.n++] = benchElapsed(t0, t1);
+    }
+    for (int i = 0; i < 32; ++i) {
+        t += 10000;
+        SensorFrame f = makeFrame(t, 500.0f + 10.0f * static_cast<float>(i));
+        uint64_t t0 = benchNow();
+        BCE_Update(&f);
+        uint64_t t1 = benchNow();
+        ranging.v[ranging.n++] = benchElapsed(t0, t1);
+    }
+    for (int i = 0; i < 32; ++i) {
+        t += 10000;
+        SensorFrame f = makeFrame(t, 500.0f);
+        f.accel_x = (i & 1) ? 0.02f : -0.02f;
+        uint64_t t0 = benchNow();
+        BCE_Update(&f);
+        uint64_t t1 = benchNow();
+        jitter.v[jitter.n++] = benchElapsed(t0, t1);
+    }
+
+    const char* integ = integratorName(method);
+    emit("bce_update_steady", w.name, integ, 500.0f, steady, 0, 1);
+    emit("bce_update_ranging", w.name, integ, 500.0f, ranging, 0, 1);
+    emit("bce_update_jitter", w.name, integ, 500.0f, jitter, 0, 1);
+}
+
+void emitMemoryReport() {
+    BCE_MemoryReport m;
+    BCE_GetMemoryReport(&m);
+    const struct {
+        const char* key;
+        uint32_t value;
+    } fields[] = {
+        {"max_range_m", m.max_range_m},       {"instance", m.instance_bytes},
+        {"trajectory_table", m.trajectory_table_bytes}, {"solver", m.solver_bytes},
+        {"angle_cache", m.angle_cache_bytes}, {"ahrs", m.ahrs_bytes},
+        {"sensors", m.sensor_bytes},          {"dispersion", m.dispersion_bytes},
+        {"recorder", m.recorder_bytes},       {"engine", m.engine_bytes},
+        {"shared", m.shared_bytes},
+    };
+    std::printf("  \"memory\": {");
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i) {
+        std::printf("%s\"%s\": %lu", (i > 0) ? ", " : "", fields[i].key,
+                    static_cast<unsigned long>(fields[i].value));
+    }
+    std::printf("},\n");
+}
+
+void runAll() {
+    s_solver.init();
+
+    std::printf("{\n  \"bench\": \"bce\", \"version\": \"%d.%d\", \"platform\": \"%s\", "
+                "\"unit\": \"%s\", \"fast_math\": %d,\n",
+                BCE_VERSION_MAJOR, BCE_VERSION_MINOR, kPlatform, kUnit, BCE_FAST_MATH);
+    emitMemoryReport();
+    std::printf("  \"results\": [");
+
+    const IntegratorMethod methods[] = {IntegratorMethod::RK4, IntegratorMethod::DORMAND_PRINCE,
+                                        IntegratorMethod::RK4_RANGE};
+    for (const Workload& w : kWorkloads) {
+        for (IntegratorMethod m : methods) {
+            benchSolver(w, m);
+        }
+    }
+    benchSolverVariants(kWorkloads[0]);
+    benchBatch(kWorkloads[0]);
+#ifdef BCE_PLATFORM_NATIVE
+    benchSweep(kWorkloads[0]);
+#endif
+    benchDragLookup();
+    benchAHRS();
+    for (IntegratorMethod m : methods) {
+        benchEngineFrame(kWorkloads[0], m);
+    }
+
+    std::printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+#ifdef BCE_PLATFORM_ESP32
+extern "C" void app_main(void) {
+    runAll();
+}
+#else
+int main() {
+    runAll();
+    return 0;
+}
+#endif
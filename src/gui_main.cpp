@@ -4,20 +4,26 @@
  *
  * This executable is a manual test console around the BCE C API.
  * It owns window/device setup, editable presets, synthetic SensorFrame input,
- * and live rendering of solution output/target hold visualization.
+ * and live rendering of solution output/target hold visualization. Engine
+ * calls run on a solve worker thread so the render loop never waits on them.
  */
 
 #include <d3d11.h>
 #include <tchar.h>
 #include <windows.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "imgui.h"
@@ -60,6 +66,9 @@ constexpr uint64_t FRAME_STEP_US = 10000;
 constexpr int TARGET_RING_COUNT = 4;
 constexpr float TARGET_CANVAS_MIN = 160.0f;
 constexpr float TARGET_CANVAS_MAX = 560.0f;
+constexpr int DISPERSION_SAMPLES_PER_FRAME = 32;
+constexpr int DISPERSION_INTERVAL_MS = 16; // worker's sampling cadence while idle
+constexpr int DISPERSION_ELLIPSE_SEGMENTS = 48;
 
 enum class UnitSystem : int {
     IMPERIAL = 0,
@@ -127,6 +136,8 @@ struct GuiState {
     float lrf_range = 500.0f;
     float lrf_conf = 1.0f;
 
+    BCE_UncertaintyConfig uncertainty = {};
+
     bool imu_valid = true;
     bool mag_valid = true;
     bool baro_valid = true;
@@ -134,7 +145,6 @@ struct GuiState {
     bool lrf_valid = true;
 
     int drag_model_index = 0;
-    uint64_t now_us = 0;
 
     char preset_path[260] = "bce_gui_preset.json";
     char profile_library_path[260] = "bce_gui_profile_library.json";
@@ -146,6 +156,7 @@ struct GuiState {
     bool top_down_show_required_angle = false;
     std::string output_text;
     std::string last_action;
+    FiringSolution solution = {}; // re-read whenever OnSolutionChanged fires
 };
 
 GuiState g_state;
@@ -337,6 +348,26 @@ float ClampValue(float value, float lo, float hi) {
     return value;
 }
 
+// Linearly interpolated record of the engine's trajectory table at range_m
+bool SampleTrajectoryView(const TrajectoryPoint* points, int count, float range_m,
+                          TrajectoryPoint& out) {
+    const float pos = range_m / static_cast<float>(BCE_TRAJ_TABLE_STRIDE_M);
+    if (!points || count < 2 || !(pos >= 0.0f) || pos > static_cast<float>(count - 1)) {
+        return false;
+    }
+    int i = static_cast<int>(pos);
+    if (i > count - 2) i = count - 2;
+    const float f = pos - static_cast<float>(i);
+    const TrajectoryPoint& a = points[i];
+    const TrajectoryPoint& b = points[i + 1];
+    out.drop_m = a.drop_m + (b.drop_m - a.drop_m) * f;
+    out.windage_m = a.windage_m + (b.windage_m - a.windage_m) * f;
+    out.velocity_ms = a.velocity_ms + (b.velocity_ms - a.velocity_ms) * f;
+    out.tof_s = a.tof_s + (b.tof_s - a.tof_s) * f;
+    out.energy_j = a.energy_j + (b.energy_j - a.energy_j) * f;
+    return true;
+}
+
 void SanitizeCartridgePreset(CartridgePreset& preset) {
     if (preset.name.empty()) {
         preset.name = "Unnamed Cartridge";
@@ -549,6 +580,14 @@ void ResetStateDefaults() {
     g_state.lrf_range = 500.0f;
     g_state.lrf_conf = 1.0f;
 
+    g_state.uncertainty.mv_sigma_ms = 3.0f;
+    g_state.uncertainty.bc_sigma_fraction = 0.01f;
+    g_state.uncertainty.wind_speed_sigma_ms = 0.5f;
+    g_state.uncertainty.wind_heading_sigma_deg = 10.0f;
+    g_state.uncertainty.range_sigma_m = 0.0f;
+    g_state.uncertainty.density_sigma_fraction = 0.005f;
+    g_state.uncertainty.target_radius_m = 0.1f;
+
     g_state.imu_valid = true;
     g_state.mag_valid = true;
     g_state.baro_valid = true;
@@ -556,7 +595,6 @@ void ResetStateDefaults() {
     g_state.lrf_valid = true;
 
     g_state.drag_model_index = 0;
-    g_state.now_us = 0;
     g_state.last_action = "Startup";
     std::snprintf(g_state.preset_path, sizeof(g_state.preset_path), "%s", "bce_gui_preset.json");
     std::snprintf(g_state.profile_library_path, sizeof(g_state.profile_library_path), "%s", "bce_gui_profile_library.json");
@@ -570,25 +608,64 @@ void ResetStateDefaults() {
     EnsureProfileDefaults();
 }
 
-void ApplyConfig() {
-    // Push current GUI inputs into the BCE engine.
-    g_state.bullet.drag_model = kDragModels[g_state.drag_model_index];
-    g_state.bullet.bc = g_state.override_drag_coefficient
-        ? ClampValue(g_state.manual_drag_coefficient, 0.001f, 1.20f)
-        : ComputeAutoDragCoefficient(g_state.bullet);
-    BCE_SetBulletProfile(&g_state.bullet);
-    BCE_SetZeroConfig(&g_state.zero);
-    BCE_SetWindManual(g_state.wind_speed_ms, g_state.wind_heading);
-    BCE_SetLatitude(g_state.latitude);
+// -----------------------------------------------------------------------------
+// Solve worker
+// -----------------------------------------------------------------------------
+// The worker thread makes every engine call that can solve, so zero solves,
+// long-range integrations and Run 100 never stall the ImGui frame. The UI
+// thread posts its inputs; posts that arrive while the worker is busy
+// coalesce into one. The UI reads results back through BCE_GetSolution,
+// which is safe from any thread, and a snapshot of what is not.
+
+// Everything the worker pushes into the engine or into a synthetic frame
+struct EngineInputs {
+    BulletProfile bullet = {};
+    ZeroConfig zero = {};
+    float wind_speed_ms = 0.0f;
+    float wind_heading = 0.0f;
+    float latitude = 0.0f;
+    BCE_UncertaintyConfig uncertainty = {};
+
+    float baro_pressure = 101325.0f;
+    float baro_temp = 15.0f;
+    float baro_humidity = 0.5f;
+    float lrf_range = 500.0f;
+    float lrf_conf = 1.0f;
+    bool imu_valid = true;
+    bool mag_valid = true;
+    bool baro_valid = true;
+    bool baro_humidity_valid = true;
+    bool lrf_valid = true;
+};
+
+// Worker results the UI cannot read from the engine directly
+struct WorkerOutput {
+    BCE_DispersionStats dispersion = {};
+    std::vector<TrajectoryPoint> trajectory; // copy of BCE_GetTrajectoryView
+    uint32_t trajectory_generation = 0;
+    uint32_t version = 0;                    // advances with every publish
+};
+
+std::atomic<bool> g_solution_changed{false};
+
+// Runs on the worker, inside the engine call that published the solution
+void OnSolutionChanged(const FiringSolution*, void*) {
+    g_solution_changed.store(true, std::memory_order_release);
 }
 
-SensorFrame BuildFrame() {
+void ApplyInputs(const EngineInputs& inputs) {
+    BCE_SetBulletProfile(&inputs.bullet);
+    BCE_SetZeroConfig(&inputs.zero);
+    BCE_SetWindManual(inputs.wind_speed_ms, inputs.wind_heading);
+    BCE_SetLatitude(inputs.latitude);
+    BCE_SetUncertainty(&inputs.uncertainty);
+}
+
+SensorFrame BuildFrame(const EngineInputs& inputs, uint64_t now_us) {
     // Build a synthetic sensor frame for the desktop harness.
     // Inputs mirror fields from the "Sensor Frame" panel.
     SensorFrame frame = {};
-    g_state.now_us += FRAME_STEP_US;
-
-    frame.timestamp_us = g_state.now_us;
+    frame.timestamp_us = now_us;
 
     frame.accel_x = 0.0f;
     frame.accel_y = 0.0f;
@@ -596,44 +673,204 @@ SensorFrame BuildFrame() {
     frame.gyro_x = 0.0f;
     frame.gyro_y = 0.0f;
     frame.gyro_z = 0.0f;
-    frame.imu_valid = g_state.imu_valid;
+    frame.imu_valid = inputs.imu_valid;
 
     frame.mag_x = 25.0f;
     frame.mag_y = 0.0f;
     frame.mag_z = 40.0f;
-    frame.mag_valid = g_state.mag_valid;
+    frame.mag_valid = inputs.mag_valid;
 
-    frame.baro_pressure_pa = g_state.baro_pressure;
-    frame.baro_temperature_c = g_state.baro_temp;
-    frame.baro_humidity = g_state.baro_humidity;
-    frame.baro_valid = g_state.baro_valid;
-    frame.baro_humidity_valid = g_state.baro_humidity_valid;
+    frame.baro_pressure_pa = inputs.baro_pressure;
+    frame.baro_temperature_c = inputs.baro_temp;
+    frame.baro_humidity = inputs.baro_humidity;
+    frame.baro_valid = inputs.baro_valid;
+    frame.baro_humidity_valid = inputs.baro_humidity_valid;
 
-    frame.lrf_range_m = g_state.lrf_range;
-    frame.lrf_timestamp_us = g_state.now_us;
-    frame.lrf_confidence = g_state.lrf_conf;
-    frame.lrf_valid = g_state.lrf_valid;
+    frame.lrf_range_m = inputs.lrf_range;
+    frame.lrf_timestamp_us = now_us;
+    frame.lrf_confidence = inputs.lrf_conf;
+    frame.lrf_valid = inputs.lrf_valid;
 
     frame.encoder_focal_length_mm = 0.0f;
     frame.encoder_valid = false;
     return frame;
 }
 
-void RunFrameUpdates(int frame_count) {
-    for (int i = 0; i < frame_count; ++i) {
-        SensorFrame frame = BuildFrame();
-        BCE_Update(&frame);
+class SolveWorker {
+public:
+    void start() {
+        stop_ = false;
+        thread_ = std::thread(&SolveWorker::run, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        if (thread_.joinable()) thread_.join();
     }
+
+    /**
+     * Queue inputs for the worker. Only the latest inputs are kept: frame
+     * counts of coalesced posts add up, and a reset drops the frames queued
+     * before it.
+     */
+    void post(const EngineInputs& inputs, int frame_count, bool reset) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (reset) {
+                reset_ = true;
+                frames_ = 0;
+            }
+            inputs_ = inputs;
+            frames_ += frame_count;
+            pending_ = true;
+        }
+        wake_.notify_one();
+    }
+
+    /** Bring out up to date. @return false if nothing changed since the last read */
+    bool read(WorkerOutput& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (out.version == output_.version) return false;
+        out.dispersion = output_.dispersion;
+        if (out.trajectory_generation != output_.trajectory_generation ||
+            out.trajectory.size() != output_.trajectory.size()) {
+            out.trajectory = output_.trajectory;
+            out.trajectory_generation = output_.trajectory_generation;
+        }
+        out.version = output_.version;
+        return true;
+    }
+
+private:
+    void run() {
+        uint64_t now_us = 0;
+        bool ready = false;
+        for (;;) {
+            EngineInputs inputs;
+            int frames = 0;
+            bool reset = false;
+            bool posted = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                auto woken = [this] { return pending_ || stop_; };
+                if (ready) {
+                    // Keep streaming dispersion samples while nothing is posted
+                    wake_.wait_for(lock, std::chrono::milliseconds(DISPERSION_INTERVAL_MS), woken);
+                } else {
+                    wake_.wait(lock, woken);
+                }
+                if (stop_) return;
+                if (pending_) {
+                    inputs = inputs_;
+                    frames = frames_;
+                    reset = reset_;
+                    pending_ = false;
+                    frames_ = 0;
+                    reset_ = false;
+                    posted = true;
+                }
+            }
+
+            if (posted) {
+                if (reset) {
+                    BCE_Init();
+                    BCE_SetSolutionCallback(OnSolutionChanged, nullptr, 0.0f);
+                    now_us = 0;
+                }
+                ApplyInputs(inputs);
+                for (int i = 0; i < frames; ++i) {
+                    now_us += FRAME_STEP_US;
+                    SensorFrame frame = BuildFrame(inputs, now_us);
+                    BCE_Update(&frame);
+                }
+            }
+
+            // The ellipse refines while the solution holds still and
+            // restarts when it moves
+            FiringSolution sol = {};
+            BCE_GetSolution(&sol);
+            ready = (sol.solution_mode == static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+            if (ready) {
+                BCE_RunDispersion(DISPERSION_SAMPLES_PER_FRAME);
+            }
+
+            const TrajectoryPoint* points = nullptr;
+            int count = 0;
+            uint32_t generation = 0;
+            BCE_GetTrajectoryView(&points, &count, &generation);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            BCE_GetDispersion(&output_.dispersion);
+            if (generation != output_.trajectory_generation ||
+                static_cast<size_t>(count) != output_.trajectory.size()) {
+                output_.trajectory.assign(points, points + count);
+                output_.trajectory_generation = generation;
+            }
+            output_.version++;
+        }
+    }
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    bool pending_ = false;
+    bool reset_ = false;
+    int frames_ = 0;
+    EngineInputs inputs_;
+    WorkerOutput output_;
+};
+
+SolveWorker g_worker;
+WorkerOutput g_worker_output; // UI thread's copy, refreshed once per frame
+
+EngineInputs CaptureEngineInputs() {
+    // Resolve the drag coefficient the same way the inputs panel shows it.
+    g_state.bullet.drag_model = kDragModels[g_state.drag_model_index];
+    g_state.bullet.bc = g_state.override_drag_coefficient
+        ? ClampValue(g_state.manual_drag_coefficient, 0.001f, 1.20f)
+        : ComputeAutoDragCoefficient(g_state.bullet);
+
+    EngineInputs inputs;
+    inputs.bullet = g_state.bullet;
+    inputs.zero = g_state.zero;
+    inputs.wind_speed_ms = g_state.wind_speed_ms;
+    inputs.wind_heading = g_state.wind_heading;
+    inputs.latitude = g_state.latitude;
+    inputs.uncertainty = g_state.uncertainty;
+    inputs.baro_pressure = g_state.baro_pressure;
+    inputs.baro_temp = g_state.baro_temp;
+    inputs.baro_humidity = g_state.baro_humidity;
+    inputs.lrf_range = g_state.lrf_range;
+    inputs.lrf_conf = g_state.lrf_conf;
+    inputs.imu_valid = g_state.imu_valid;
+    inputs.mag_valid = g_state.mag_valid;
+    inputs.baro_valid = g_state.baro_valid;
+    inputs.baro_humidity_valid = g_state.baro_humidity_valid;
+    inputs.lrf_valid = g_state.lrf_valid;
+    return inputs;
+}
+
+void ApplyConfig() {
+    // Push current GUI inputs into the BCE engine (on the worker).
+    g_worker.post(CaptureEngineInputs(), 0, false);
+}
+
+void RunFrameUpdates(int frame_count) {
+    g_worker.post(CaptureEngineInputs(), frame_count, false);
 }
 
 void RefreshOutput() {
     // Produce the human-readable diagnostics/solution text displayed in "BCE Output".
-    FiringSolution sol = {};
-    BCE_GetSolution(&sol);
+    const FiringSolution& sol = g_state.solution;
 
-    BCE_Mode mode = BCE_GetMode();
-    uint32_t fault = BCE_GetFaultFlags();
-    uint32_t diag = BCE_GetDiagFlags();
+    BCE_Mode mode = static_cast<BCE_Mode>(sol.solution_mode);
+    uint32_t fault = sol.fault_flags;
+    uint32_t diag = sol.defaults_active;
 
     const char* mode_text = "UNKNOWN";
     if (mode == BCE_Mode::IDLE) mode_text = "IDLE";
@@ -662,6 +899,7 @@ void RefreshOutput() {
         if (flags & BCE_Fault::ZERO_UNSOLVABLE) add("ZERO_UNSOLVABLE");
         if (flags & BCE_Fault::AHRS_UNSTABLE) add("AHRS_UNSTABLE");
         if (flags & BCE_Fault::SENSOR_INVALID) add("SENSOR_INVALID");
+        if (flags & BCE_Fault::NO_DRAG_CURVE) add("NO_DRAG_CURVE");
     };
 
     auto appendDiagNames = [&](uint32_t flags) {
@@ -683,6 +921,7 @@ void RefreshOutput() {
         if (flags & BCE_Diag::DEFAULT_WIND) add("DEFAULT_WIND");
         if (flags & BCE_Diag::MAG_SUPPRESSED) add("MAG_SUPPRESSED");
         if (flags & BCE_Diag::LRF_STALE) add("LRF_STALE");
+        if (flags & BCE_Diag::LEAD_UNRESOLVED) add("LEAD_UNRESOLVED");
     };
 
     ss << "Action: " << g_state.last_action << "\n";
@@ -1072,10 +1311,8 @@ void LoadPreset() {
 }
 
 void ResetEngineAndState() {
-    BCE_Init();
-    g_state.now_us = 0;
     g_state.last_action = "Reset Engine";
-    ApplyConfig();
+    g_worker.post(CaptureEngineInputs(), 0, true);
     RefreshOutput();
 }
 
@@ -1157,6 +1394,7 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
     ImGui_ImplWin32_Init(hwnd);
     ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
 
+    g_worker.start();
     ResetEngineAndState();
 
     bool done = false;
@@ -1176,6 +1414,13 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
 
+        // Pick up whatever the worker published since the last frame
+        g_worker.read(g_worker_output);
+        if (g_solution_changed.exchange(false, std::memory_order_acquire)) {
+            BCE_GetSolution(&g_state.solution);
+            RefreshOutput();
+        }
+
         ImGui::Begin("BCE Inputs");
         int unit_mode = static_cast<int>(g_state.unit_system);
         if (ImGui::Combo("Unit System", &unit_mode, kUnitSystemLabels, IM_ARRAYSIZE(kUnitSystemLabels))) {
@@ -1351,6 +1596,16 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         ImGui::InputFloat("Wind Heading (deg)", &g_state.wind_heading, 1.0f, 5.0f, "%.1f");
         ImGui::InputFloat("Latitude (deg)", &g_state.latitude, 0.1f, 1.0f, "%.3f");
 
+        ImGui::Separator();
+        ImGui::TextUnformatted("Dispersion (1 sigma)");
+        ImGui::InputFloat("MV Sigma (m/s)", &g_state.uncertainty.mv_sigma_ms, 0.5f, 2.0f, "%.2f");
+        ImGui::InputFloat("BC Sigma (fraction)", &g_state.uncertainty.bc_sigma_fraction, 0.001f, 0.01f, "%.3f");
+        ImGui::InputFloat("Wind Speed Sigma (m/s)", &g_state.uncertainty.wind_speed_sigma_ms, 0.1f, 0.5f, "%.2f");
+        ImGui::InputFloat("Wind Heading Sigma (deg)", &g_state.uncertainty.wind_heading_sigma_deg, 1.0f, 5.0f, "%.1f");
+        ImGui::InputFloat("Range Sigma (m)", &g_state.uncertainty.range_sigma_m, 0.5f, 2.0f, "%.2f");
+        ImGui::InputFloat("Density Sigma (fraction)", &g_state.uncertainty.density_sigma_fraction, 0.001f, 0.01f, "%.3f");
+        ImGui::InputFloat("Target Radius (m)", &g_state.uncertainty.target_radius_m, 0.01f, 0.05f, "%.3f");
+
         ImGui::Separator();
         ImGui::TextUnformatted("Sensor Frame");
         float pressure_display = g_state.baro_pressure;
@@ -1440,17 +1695,20 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         );
         ImGui::End();
 
+        // One consistent solution per frame, shared by all three views
+        const FiringSolution& sol = g_state.solution;
+
         ImGui::Begin("Target View");
         ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
-        FiringSolution sol = {};
-        BCE_GetSolution(&sol);
-
         const float hold_windage_moa = sol.hold_windage_moa;
         const float hold_elevation_moa = sol.hold_elevation_moa;
         const float impact_distance_moa = std::sqrt(
             hold_windage_moa * hold_windage_moa + hold_elevation_moa * hold_elevation_moa);
-        const float confidence_radius_moa = ClampValue((1.0f - g_state.lrf_conf) * 5.0f, 0.0f, 5.0f);
+
+        // The worker streams the Monte Carlo samples
+        const BCE_DispersionStats& disp = g_worker_output.dispersion;
+        const float confidence_radius_moa = disp.ellipse_major_moa;
 
         // Auto-scale the target so both hold offset and confidence circle fit.
         const float ring_count = static_cast<float>(TARGET_RING_COUNT);
@@ -1499,7 +1757,9 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         ImGui::SameLine();
         ImGui::TextColored(direction_color(sol.cant_windage_moa), "[%s]", direction_label(sol.cant_windage_moa));
         ImGui::Text("Center->Impact: %.2f MOA (%.2f in)", impact_distance_moa, impact_distance_in);
-        ImGui::Text("Confidence Radius: %.2f MOA (%.2f in)", confidence_radius_moa, confidence_radius_in);
+        ImGui::Text("Dispersion 1-sigma: %.2f x %.2f MOA (%.2f in major), %u samples",
+                    disp.ellipse_major_moa, disp.ellipse_minor_moa, confidence_radius_in, disp.sample_count);
+        ImGui::Text("Hit Probability: %.1f%% (radius %.2f MOA)", disp.hit_probability * 100.0f, disp.target_radius_moa);
         ImGui::Separator();
 
         ImVec2 avail = ImGui::GetContentRegionAvail();
@@ -1549,18 +1809,45 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
             center.x + hold_windage_moa * moa_to_px,
             center.y - hold_elevation_moa * moa_to_px
         );
-        const float confidence_radius_px = confidence_radius_moa * moa_to_px;
 
-        draw_list->AddCircle(impact_point, confidence_radius_px, IM_COL32(255, 220, 64, 220), 0, 1.5f);
+        // 1-sigma impact ellipse around the hold, offset by the mean impact
+        if (disp.sample_count >= 2) {
+            const float angle = disp.ellipse_angle_deg * BCE_DEG_TO_RAD;
+            const float ca = std::cos(angle);
+            const float sa = std::sin(angle);
+            const ImVec2 ellipse_center(
+                impact_point.x + disp.mean_windage_moa * moa_to_px,
+                impact_point.y - disp.mean_elevation_moa * moa_to_px
+            );
+            ImVec2 prev;
+            for (int k = 0; k <= DISPERSION_ELLIPSE_SEGMENTS; ++k) {
+                const float theta = 2.0f * BCE_PI * static_cast<float>(k) /
+                                    static_cast<float>(DISPERSION_ELLIPSE_SEGMENTS);
+                const float ex = disp.ellipse_major_moa * std::cos(theta);
+                const float ey = disp.ellipse_minor_moa * std::sin(theta);
+                const ImVec2 pt(
+                    ellipse_center.x + (ex * ca - ey * sa) * moa_to_px,
+                    ellipse_center.y - (ex * sa + ey * ca) * moa_to_px
+                );
+                if (k > 0) {
+                    draw_list->AddLine(prev, pt, IM_COL32(255, 220, 64, 220), 1.5f);
+                }
+                prev = pt;
+            }
+        }
         draw_list->AddCircleFilled(impact_point, 4.0f, IM_COL32(255, 70, 70, 255));
 
         ImGui::End();
 
+        // Both plots draw the engine's own trajectory table (as the worker
+        // last copied it) and fall back to a parabola without one
+        const TrajectoryPoint* traj_points = g_worker_output.trajectory.data();
+        const int traj_count = static_cast<int>(g_worker_output.trajectory.size());
+
         ImGui::Begin("Side View Arc");
         ImDrawList* side_draw_list = ImGui::GetWindowDrawList();
 
-        FiringSolution side_sol = {};
-        BCE_GetSolution(&side_sol);
+        const FiringSolution& side_sol = g_state.solution;
 
         float side_range_m = side_sol.horizontal_range_m;
         if (side_range_m <= 0.0f) {
@@ -1685,12 +1972,19 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 
         const int sample_count = 64;
         ImVec2 arc_points[sample_count + 1];
+        TrajectoryPoint side_impact = {};
+        const bool side_from_table = SampleTrajectoryView(traj_points, traj_count, side_range_m, side_impact);
         if (!g_state.side_view_show_required_angle) {
             const float tan_theta = std::tanf(elevation_angle_rad);
             for (int i = 0; i <= sample_count; ++i) {
                 const float t = static_cast<float>(i) / static_cast<float>(sample_count);
                 const float x_m = t * side_range_m;
-                const float y_m = (tan_theta * x_m) - ((tan_theta / side_range_m) * x_m * x_m);
+                float y_m = (tan_theta * x_m) - ((tan_theta / side_range_m) * x_m * x_m);
+                TrajectoryPoint tp;
+                if (side_from_table && SampleTrajectoryView(traj_points, traj_count, x_m, tp)) {
+                    // Height above the muzzle-to-impact chord
+                    y_m = tp.drop_m - side_impact.drop_m * t;
+                }
                 arc_points[i] = ImVec2(map_x(x_m), map_y(y_m));
             }
             side_draw_list->AddPolyline(arc_points, sample_count + 1, IM_COL32(98, 203, 255, 255), ImDrawFlags_None, 2.0f);
@@ -1734,8 +2028,7 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         ImGui::Begin("Top Down Drift");
         ImDrawList* drift_draw_list = ImGui::GetWindowDrawList();
 
-        FiringSolution drift_sol = {};
-        BCE_GetSolution(&drift_sol);
+        const FiringSolution& drift_sol = g_state.solution;
 
         float drift_range_m = drift_sol.horizontal_range_m;
         if (drift_range_m <= 0.0f) {
@@ -1820,11 +2113,20 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         drift_draw_list->AddLine(ImVec2(drift_plot_left, drift_plot_bottom), ImVec2(drift_plot_right, drift_plot_bottom), IM_COL32(120, 120, 130, 180), 1.0f);
 
         ImVec2 drift_points[sample_count + 1];
+        // The table's wind drift gives the curve its shape; the hold sets
+        // where it ends, since spin drift, Coriolis and offsets are not in it
+        TrajectoryPoint drift_impact = {};
+        const bool drift_from_table = SampleTrajectoryView(traj_points, traj_count, drift_range_m, drift_impact) &&
+                                      std::fabs(drift_impact.windage_m) > 0.001f;
         if (!g_state.top_down_show_required_angle) {
             for (int i = 0; i <= sample_count; ++i) {
                 const float t = static_cast<float>(i) / static_cast<float>(sample_count);
                 const float forward_range_m = t * drift_range_m;
-                const float lateral_offset_m = lateral_m * t * t;
+                float lateral_offset_m = lateral_m * t * t;
+                TrajectoryPoint tp;
+                if (drift_from_table && SampleTrajectoryView(traj_points, traj_count, forward_range_m, tp)) {
+                    lateral_offset_m = lateral_m * (tp.windage_m / drift_impact.windage_m);
+                }
                 drift_points[i] = ImVec2(map_drift_x(lateral_offset_m), map_drift_y(forward_range_m));
             }
             drift_draw_list->AddPolyline(drift_points, sample_count + 1, IM_COL32(255, 180, 90, 255), ImDrawFlags_None, 2.0f);
@@ -1867,6 +2169,8 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
         g_pSwapChain->Present(1, 0);
     }
 
+    g_worker.stop();
+
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,343 @@
+/**
+ * @file integrator_tune_main.cpp
+ * @brief Host auto-tuner for per-cartridge integrator settings.
+ *
+ * For every cartridge in the GUI's JSON profile library, searches a grid of
+ * integrator settings (method, RK4 step scale, step cap and transonic step,
+ * Dormand–Prince tolerance, RK4_RANGE step) for the cheapest one whose holds
+ * stay within a target of a tight Dormand–Prince reference out to a range:
+ *
+ *   pio run -e integrator_tune
+ *   .pio/build/integrator_tune/program library.json
+ *   .pio/build/integrator_tune/program library.json --target-moa 0.05 --max-range 1200 --write library.json
+ *
+ * Each candidate zeroes the rifle itself and tabulates the trajectory to
+ * --max-range in standard atmosphere with a --wind m/s full-value crosswind;
+ * its error is the largest elevation or windage hold difference (MOA) from
+ * the reference at every 25 m, and its cost the derivative evaluations of
+ * the table fill (steps × stages). "reference_error_moa" is how far a ten
+ * times tighter reference moves, the floor below which a target is noise.
+ * The zero and sight height come from
+ * --gun, else 100 m and 38.1 mm. With --write the library is saved with an
+ * "integrator" object on every tuned cartridge, which profile_pack stores
+ * in the profile DB and BCE_SelectProfile applies. Results are printed as
+ * one JSON document.
+ *
+ * The table stride is fixed at build time, so for RK4_RANGE only the step
+ * within a stride is searched. Exit status: 0 every cartridge tuned, 1 some
+ * had no candidate within the target (left untuned), 2 bad arguments or input.
+ */
+
+#include "bce/bce_config.h"
+#include "bce/bce_types.h"
+#include "profile/profile_db.h"
+#include "solver/solver.h"
+#include "profile_json.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using profile_json::json;
+
+constexpr float kSampleStepM = 25.0f;
+
+struct Options {
+    const char* library_path = nullptr;
+    const char* write_path = nullptr;
+    const char* gun = nullptr;
+    const char* cartridge = nullptr;
+    float target_moa = 0.05f;
+    float max_range_m = 1000.0f;
+    float wind_ms = 4.0f;
+};
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: integrator_tune <library.json> [--target-moa <moa>] [--max-range <m>]\n"
+                 "                       [--wind <m/s>] [--gun <name>] [--cartridge <name>]\n"
+                 "                       [--write <out.json>]\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--target-moa") == 0 && has_value) {
+            o.target_moa = std::strtof(argv[++i], nullptr);
+        } else if (std::strcmp(a, "--max-range") == 0 && has_value) {
+            o.max_range_m = std::strtof(argv[++i], nullptr);
+        } else if (std::strcmp(a, "--wind") == 0 && has_value) {
+            o.wind_ms = std::strtof(argv[++i], nullptr);
+        } else if (std::strcmp(a, "--gun") == 0 && has_value) {
+            o.gun = argv[++i];
+        } else if (std::strcmp(a, "--cartridge") == 0 && has_value) {
+            o.cartridge = argv[++i];
+        } else if (std::strcmp(a, "--write") == 0 && has_value) {
+            o.write_path = argv[++i];
+        } else if (a[0] != '-' && o.library_path == nullptr) {
+            o.library_path = a;
+        } else {
+            return false;
+        }
+    }
+    return o.library_path != nullptr && o.target_moa > 0.0f && o.max_range_m >= 2.0f * kSampleStepM &&
+           o.max_range_m <= static_cast<float>(BCE_MAX_RANGE_M);
+}
+
+// ---------------------------------------------------------------------------
+// Candidate evaluation
+// ---------------------------------------------------------------------------
+
+// Holds of one trajectory at every kSampleStepM
+struct Holds {
+    bool valid = false;
+    uint32_t steps = 0;
+    std::vector<float> elevation_moa;
+    std::vector<float> windage_moa;
+};
+
+int stagesPerStep(IntegratorMethod method) {
+    return (method == IntegratorMethod::DORMAND_PRINCE) ? 6 : 4; // FSAL reuses the seventh
+}
+
+// The engine's solver inputs for a bullet and zero in standard atmosphere
+SolverParams makeParams(const BulletProfile& b, const ZeroConfig& zero, float wind_ms) {
+    SolverParams p;
+    std::memset(&p, 0, sizeof(p));
+    p.bc = b.bc;
+    p.drag_model = b.drag_model;
+    for (int i = 0; i < b.bc_band_count && i < BCE_MAX_BC_BANDS; ++i) {
+        p.bc_band_velocity_ms[i] = b.bc_bands[i].below_velocity_ms;
+        p.bc_band_ratio[i] = b.bc_bands[i].bc / b.bc;
+    }
+    p.bc_band_count = (b.bc_band_count < BCE_MAX_BC_BANDS) ? b.bc_band_count : BCE_MAX_BC_BANDS;
+    const float mv_fps = b.muzzle_velocity_ms * 3.28084f +
+                         (b.barrel_length_in - 24.0f) * std::fabs(b.mv_adjustment_factor);
+    p.muzzle_velocity_ms = mv_fps * 0.3048f;
+    p.bullet_mass_kg = b.mass_grains * BCE_GRAINS_TO_KG;
+    p.sight_height_m = zero.sight_height_mm * BCE_MM_TO_M;
+    p.air_density = BCE_STD_AIR_DENSITY;
+    p.speed_of_sound = BCE_SPEED_OF_SOUND_15C;
+    p.drag_reference_scale = BCE_DEFAULT_DRAG_REFERENCE_SCALE;
+    p.crosswind_ms = wind_ms;
+    if (std::fabs(b.twist_rate_inches) > 0.1f) {
+        p.spin_drift_enabled = true;
+        p.twist_rate_inches = b.twist_rate_inches;
+        p.caliber_m = b.caliber_inches * BCE_INCHES_TO_M;
+    }
+    return p;
+}
+
+Holds evaluate(BallisticSolver& solver, SolverParams p, const IntegratorTuning& t,
+               float zero_range_m, float max_range_m) {
+    p.integrator = t.method;
+    p.integrator_tolerance_m = t.tolerance_m;
+    p.integrator_step_scale_m = t.step_scale_m;
+    p.integrator_max_step_m = t.max_step_m;
+    p.integrator_transonic_dt_s = t.transonic_dt_s;
+    p.integrator_range_step_m = t.range_step_m;
+
+    Holds h;
+    SolverParams calm = p;
+    calm.crosswind_ms = 0.0f;
+    p.launch_angle_rad = solver.solveZeroAngle(calm, zero_range_m);
+    if (std::isnan(p.launch_angle_rad) || !solver.integrateTrajectory(p, max_range_m)) return h;
+    h.steps = solver.getLastStepCount();
+    if (static_cast<float>(solver.getMaxValidRange()) < max_range_m) return h;
+
+    for (float r = kSampleStepM; r <= max_range_m + 0.5f; r += kSampleStepM) {
+        SolverResult res = solver.sampleTrajectory(p, r);
+        if (!res.valid) return h;
+        h.elevation_moa.push_back(-(res.drop_at_target_m / r) * BCE_RAD_TO_MOA);
+        h.windage_moa.push_back(-(res.windage_at_target_m / r) * BCE_RAD_TO_MOA + res.spin_drift_moa);
+    }
+    h.valid = true;
+    return h;
+}
+
+float maxError(const Holds& a, const Holds& ref) {
+    float e = 0.0f;
+    for (size_t i = 0; i < ref.elevation_moa.size(); ++i) {
+        e = std::fmax(e, std::fabs(a.elevation_moa[i] - ref.elevation_moa[i]));
+        e = std::fmax(e, std::fabs(a.windage_moa[i] - ref.windage_moa[i]));
+    }
+    return e;
+}
+
+std::vector<IntegratorTuning> candidates() {
+    std::vector<IntegratorTuning> out;
+    IntegratorTuning t = {};
+    t.method = IntegratorMethod::RK4;
+    for (float scale : {0.5f, 1.0f, 2.0f, 4.0f}) {
+        for (float max_step : {0.25f, 0.5f, 1.0f, 2.0f}) {
+            for (float transonic : {BCE_DT_MIN, 1e-4f, 5e-4f, BCE_DT_MAX}) {
+                t.step_scale_m = scale;
+                t.max_step_m = max_step;
+                t.transonic_dt_s = transonic;
+                out.push_back(t);
+            }
+        }
+    }
+    t = {};
+    t.method = IntegratorMethod::DORMAND_PRINCE;
+    for (float tol : {1e-3f, 3e-4f, 1e-4f, 3e-5f, 1e-5f, 3e-6f, 1e-6f}) {
+        t.tolerance_m = tol;
+        out.push_back(t);
+    }
+    t = {};
+    t.method = IntegratorMethod::RK4_RANGE;
+    for (float step : {BCE_RANGE_STEP_M, 2.0f, 1.0f, 0.5f, 0.25f}) {
+        t.range_step_m = step;
+        out.push_back(t);
+    }
+    return out;
+}
+
+json resultJson(const Holds& h, const Holds& ref, IntegratorMethod method) {
+    if (!h.valid) return json{{"valid", false}};
+    return json{{"error_moa", profile_json::tidy(maxError(h, ref))},
+                {"steps", h.steps},
+                {"cost", h.steps * stagesPerStep(method)}};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArgs(argc, argv, o)) {
+        usage();
+        return 2;
+    }
+
+    json root;
+    std::vector<ProfileCartridge> cartridges;
+    std::vector<ProfileGun> guns;
+    if (!profile_json::loadDocument(o.library_path, root) ||
+        !profile_json::readLibrary(root, cartridges, guns)) {
+        return 2;
+    }
+
+    const ProfileGun* gun = nullptr;
+    for (const ProfileGun& g : guns) {
+        if (o.gun != nullptr && std::strncmp(g.name, o.gun, PROFILE_NAME_BYTES) == 0) gun = &g;
+    }
+    if (o.gun != nullptr && gun == nullptr) {
+        std::fprintf(stderr, "integrator_tune: no gun \"%s\" in %s\n", o.gun, o.library_path);
+        return 2;
+    }
+
+    static BallisticSolver solver; // trajectory table is too large for the stack
+    solver.init();
+    const std::vector<IntegratorTuning> grid = candidates();
+
+    int tuned_count = 0;
+    int failed_count = 0;
+    json results = json::array();
+    std::vector<bool> tuned(cartridges.size(), false);
+    std::vector<IntegratorTuning> chosen(cartridges.size());
+    for (size_t c = 0; c < cartridges.size(); ++c) {
+        if (o.cartridge != nullptr && std::strncmp(cartridges[c].name, o.cartridge, PROFILE_NAME_BYTES) != 0) {
+            continue;
+        }
+        BulletProfile bullet = {};
+        bullet.barrel_length_in = 24.0f;
+        bullet.twist_rate_inches = 10.0f;
+        ZeroConfig zero = {100.0f, 38.1f};
+        ProfileDb::applyCartridge(cartridges[c], bullet);
+        if (gun != nullptr) ProfileDb::applyGun(*gun, bullet, zero);
+        const SolverParams base = makeParams(bullet, zero, o.wind_ms);
+
+        // The reference also bounds the range: a bullet that falls below
+        // BCE_MIN_VELOCITY short of --max-range is tuned as far as it flies
+        IntegratorTuning fine = {};
+        fine.method = IntegratorMethod::DORMAND_PRINCE;
+        fine.tolerance_m = 1e-7f;
+        float max_range = o.max_range_m;
+        Holds ref = evaluate(solver, base, fine, zero.zero_range_m, max_range);
+        if (!ref.valid && solver.getMaxValidRange() >= 2 * static_cast<int>(kSampleStepM)) {
+            max_range = std::floor(solver.getMaxValidRange() / kSampleStepM) * kSampleStepM;
+            ref = evaluate(solver, base, fine, zero.zero_range_m, max_range);
+        }
+
+        json entry = {{"name", cartridges[c].name}, {"max_range_m", max_range}};
+        if (!ref.valid) {
+            entry["tuned"] = nullptr;
+            results.push_back(entry);
+            failed_count++;
+            continue;
+        }
+        // Float rounding bounds what the reference itself resolves: a target
+        // near this floor is met only by chance
+        IntegratorTuning finer = fine;
+        finer.tolerance_m = 0.1f * fine.tolerance_m;
+        const Holds check = evaluate(solver, base, finer, zero.zero_range_m, max_range);
+        entry["reference_steps"] = ref.steps;
+        if (check.valid) entry["reference_error_moa"] = profile_json::tidy(maxError(check, ref));
+        entry["default"] = resultJson(evaluate(solver, base, IntegratorTuning{}, zero.zero_range_m,
+                                               max_range), ref, IntegratorMethod::RK4);
+
+        // Cheapest candidate within the target; equal costs go to the smaller error
+        int best = -1;
+        uint32_t best_cost = 0;
+        float best_error = 0.0f;
+        Holds best_holds;
+        for (size_t i = 0; i < grid.size(); ++i) {
+            Holds h = evaluate(solver, base, grid[i], zero.zero_range_m, max_range);
+            if (!h.valid) continue;
+            const float error = maxError(h, ref);
+            const uint32_t cost = h.steps * stagesPerStep(grid[i].method);
+            if (error > o.target_moa) continue;
+            if (best < 0 || cost < best_cost || (cost == best_cost && error < best_error)) {
+                best = static_cast<int>(i);
+                best_cost = cost;
+                best_error = error;
+                best_holds = h;
+            }
+        }
+        if (best < 0) {
+            entry["tuned"] = nullptr;
+            failed_count++;
+        } else {
+            json t = profile_json::integratorJson(grid[best]);
+            t.update(resultJson(best_holds, ref, grid[best].method));
+            entry["tuned"] = t;
+            tuned[c] = true;
+            chosen[c] = grid[best];
+            tuned_count++;
+        }
+        results.push_back(entry);
+    }
+
+    if (o.write_path != nullptr && tuned_count > 0) {
+        // Same walk as readLibrary(), so cartridge c is the c-th named preset
+        size_t c = 0;
+        for (auto& item : root["cartridge_presets"]) {
+            if (!profile_json::hasName(item)) continue;
+            if (tuned[c]) item["integrator"] = profile_json::integratorJson(chosen[c]);
+            c++;
+        }
+        std::ofstream out(o.write_path, std::ios::binary | std::ios::trunc);
+        out << root.dump(4) << '\n';
+        if (!out) {
+            std::fprintf(stderr, "integrator_tune: cannot write %s\n", o.write_path);
+            return 2;
+        }
+    }
+
+    json report = {{"target_moa", profile_json::tidy(o.target_moa)},
+                   {"wind_ms", profile_json::tidy(o.wind_ms)},
+                   {"table_stride_m", BCE_TRAJ_TABLE_STRIDE_M},
+                   {"cartridges", results},
+                   {"tuned", tuned_count},
+                   {"untuned", failed_count}};
+    std::printf("%s\n", report.dump(2).c_str());
+    return (failed_count > 0) ? 1 : 0;
+}
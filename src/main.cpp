@@ -12,7 +12,21 @@
 
 #include "bce/bce_api.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Solver task pinned to core 1; BCE_Update on core 0 only publishes snapshots
+static void solverTask(void*) {
+    for (;;) {
+        if (!BCE_ServiceSolver()) {
+            vTaskDelay(1);
+        }
+    }
+}
+
 extern "C" void app_main(void) {
     BCE_Init();
-    // Application layer would feed SensorFrames here
+    BCE_SetSplitPipelineMode(true);
+    xTaskCreatePinnedToCore(solverTask, "bce_solver", 8192, nullptr, 5, nullptr, 1);
+    // Application layer would feed SensorFrames here (core 0, sensor rate)
 }
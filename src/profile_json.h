@@ -0,0 +1,183 @@
+/**
+ * @file profile_json.h
+ * @brief Readers for the GUI's JSON profile library, shared by the host tools.
+ *
+ * Entries are read the way the GUI loads them: nameless ones are skipped,
+ * missing fields take the GUI defaults and values get the GUI's clamps, so a
+ * profile built from the library solves like the same preset in the GUI. A
+ * cartridge may also carry "bc_bands": [{"bc": x, "below_velocity_ms": v},
+ * ...] (up to 4) and the "integrator" object integrator_tune writes:
+ *
+ *   "integrator": {"method": "rk4" | "dormand_prince" | "rk4_range",
+ *                  "tolerance_m": t, "step_scale_m": s, "max_step_m": m,
+ *                  "transonic_dt_s": d, "range_step_m": r}
+ *
+ * with absent or non-positive values taking the bce_config.h defaults.
+ */
+
+#pragma once
+
+#include "bce/bce_types.h"
+#include "profile/profile_db.h"
+#include "nlohmann/json.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace profile_json {
+
+using json = nlohmann::json;
+
+inline float clampValue(float v, float lo, float hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+inline bool hasName(const json& item) {
+    return item.contains("name") && item["name"].is_string();
+}
+
+inline bool copyName(const json& item, const char* fallback, char (&name)[PROFILE_NAME_BYTES]) {
+    std::string s = item["name"].get<std::string>();
+    if (s.empty()) s = fallback;
+    if (s.size() >= PROFILE_NAME_BYTES) {
+        std::fprintf(stderr, "profile library: name \"%s\" must be 1..%d bytes\n", s.c_str(),
+                     PROFILE_NAME_BYTES - 1);
+        return false;
+    }
+    std::memset(name, 0, sizeof(name));
+    std::memcpy(name, s.data(), s.size());
+    return true;
+}
+
+inline const char* integratorName(IntegratorMethod method) {
+    switch (method) {
+    case IntegratorMethod::DORMAND_PRINCE: return "dormand_prince";
+    case IntegratorMethod::RK4_RANGE: return "rk4_range";
+    default: return "rk4";
+    }
+}
+
+inline bool parseIntegrator(const std::string& name, IntegratorMethod& method) {
+    for (IntegratorMethod m : {IntegratorMethod::RK4, IntegratorMethod::DORMAND_PRINCE,
+                               IntegratorMethod::RK4_RANGE}) {
+        if (name == integratorName(m)) {
+            method = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** v to 6 significant digits, so 1e-3f writes as 0.001 rather than its binary value. */
+inline double tidy(float v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", static_cast<double>(v));
+    return std::strtod(buf, nullptr);
+}
+
+inline json integratorJson(const IntegratorTuning& t) {
+    return json{{"method", integratorName(t.method)},
+                {"tolerance_m", tidy(t.tolerance_m)},
+                {"step_scale_m", tidy(t.step_scale_m)},
+                {"max_step_m", tidy(t.max_step_m)},
+                {"transonic_dt_s", tidy(t.transonic_dt_s)},
+                {"range_step_m", tidy(t.range_step_m)}};
+}
+
+inline bool readCartridge(const json& item, ProfileCartridge& c) {
+    std::memset(&c, 0, sizeof(c));
+    if (!copyName(item, "Unnamed Cartridge", c.name)) return false;
+    c.bc = clampValue(item.value("bc", 0.505f), 0.001f, 1.20f);
+    int model = item.value("drag_model_index", 0);
+    if (model < 0 || model >= 8) model = 0;
+    c.drag_model = static_cast<uint8_t>(static_cast<int>(DragModel::G1) + model);
+    c.muzzle_velocity_ms = clampValue(item.value("muzzle_velocity_ms", 792.0f), 50.0f, 1500.0f);
+    c.mass_grains = clampValue(item.value("mass_grains", 175.0f), 20.0f, 1200.0f);
+    c.caliber_inches = clampValue(std::fabs(item.value("caliber_inches", 0.308f)), 0.10f, 1.00f);
+    c.length_mm = clampValue(item.value("length_mm", 31.2f), 5.0f, 100.0f);
+    if (item.contains("bc_bands") && item["bc_bands"].is_array()) {
+        for (const auto& band : item["bc_bands"]) {
+            if (c.bc_band_count >= PROFILE_BC_BANDS) {
+                std::fprintf(stderr, "profile library: %s has more than %d BC bands\n", c.name,
+                             PROFILE_BC_BANDS);
+                return false;
+            }
+            BCBand& b = c.bc_bands[c.bc_band_count++];
+            b.bc = band.value("bc", 0.0f);
+            b.below_velocity_ms = band.value("below_velocity_ms", 0.0f);
+        }
+    }
+    if (item.contains("integrator") && item["integrator"].is_object()) {
+        const json& in = item["integrator"];
+        IntegratorMethod method = IntegratorMethod::RK4;
+        if (!parseIntegrator(in.value("method", std::string("rk4")), method)) {
+            std::fprintf(stderr, "profile library: %s has an unknown integrator method\n", c.name);
+            return false;
+        }
+        c.integrator_tuned = 1;
+        c.integrator_method = static_cast<uint8_t>(method);
+        c.integrator_tolerance_m = in.value("tolerance_m", 0.0f);
+        c.integrator_step_scale_m = in.value("step_scale_m", 0.0f);
+        c.integrator_max_step_m = in.value("max_step_m", 0.0f);
+        c.integrator_transonic_dt_s = in.value("transonic_dt_s", 0.0f);
+        c.integrator_range_step_m = in.value("range_step_m", 0.0f);
+    }
+    return true;
+}
+
+inline bool readGun(const json& item, ProfileGun& g) {
+    std::memset(&g, 0, sizeof(g));
+    if (!copyName(item, "Unnamed Gun", g.name)) return false;
+    g.caliber_inches = clampValue(std::fabs(item.value("caliber_inches", 0.308f)), 0.10f, 1.00f);
+    g.barrel_length_in = clampValue(item.value("barrel_length_in", 24.0f), 2.0f, 40.0f);
+    g.mv_adjustment_factor = clampValue(std::fabs(item.value("mv_adjustment_factor", 25.0f)), 0.0f, 200.0f);
+    g.twist_rate_inches = clampValue(std::fabs(item.value("twist_rate_inches", 10.0f)), 1.0f, 30.0f);
+    g.zero_range_m = clampValue(item.value("zero_range_m", 100.0f), 10.0f, 2500.0f);
+    g.sight_height_mm = clampValue(item.value("sight_height_mm", 38.1f), 5.0f, 120.0f);
+    return true;
+}
+
+/** Parse the library document at path. */
+inline bool loadDocument(const char* path, json& root) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "profile library: cannot open %s\n", path);
+        return false;
+    }
+    try {
+        in >> root;
+    } catch (const json::parse_error& e) {
+        std::fprintf(stderr, "profile library: %s: %s\n", path, e.what());
+        return false;
+    }
+    return true;
+}
+
+inline bool readLibrary(const json& root, std::vector<ProfileCartridge>& cartridges,
+                        std::vector<ProfileGun>& guns) {
+    if (root.contains("cartridge_presets") && root["cartridge_presets"].is_array()) {
+        for (const auto& item : root["cartridge_presets"]) {
+            if (!hasName(item)) continue;
+            ProfileCartridge c;
+            if (!readCartridge(item, c)) return false;
+            cartridges.push_back(c);
+        }
+    }
+    if (root.contains("gun_presets") && root["gun_presets"].is_array()) {
+        for (const auto& item : root["gun_presets"]) {
+            if (!hasName(item)) continue;
+            ProfileGun g;
+            if (!readGun(item, g)) return false;
+            guns.push_back(g);
+        }
+    }
+    return true;
+}
+
+} // namespace profile_json
@@ -0,0 +1,146 @@
+/**
+ * @file profile_pack_main.cpp
+ * @brief Host converter from the GUI profile library to a packed profile DB.
+ *
+ * Reads the JSON profile library the GUI saves (cartridge_presets,
+ * gun_presets) and writes the binary database BCE_SetProfileDb reads in
+ * place (profile/profile_db.h), optionally also as a C header for linking
+ * the database into firmware flash:
+ *
+ *   pio run -e profile_pack
+ *   .pio/build/profile_pack/program bce_gui_profile_library.json profiles.bcedb
+ *   .pio/build/profile_pack/program library.json profiles.bcedb --header profiles_db.h --symbol kProfileDb
+ *
+ * Entries are read the way the GUI loads them: nameless ones are skipped,
+ * missing fields take the GUI defaults and values get the GUI's clamps, so a
+ * selected profile solves like the same preset in the GUI (profile_json.h,
+ * which also reads BC bands and the integrator settings integrator_tune
+ * stores).
+ * The written database is re-opened and every name looked up before the tool
+ * reports success. Exit status: 0 written, 2 bad arguments, unreadable or
+ * invalid input (names longer than 31 bytes or duplicated within a kind).
+ */
+
+#include "bce/bce_api.h"
+#include "bce/bce_config.h"
+#include "profile/profile_db.h"
+#include "profile_json.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Options {
+    const char* library_path = nullptr;
+    const char* db_path = nullptr;
+    const char* header_path = nullptr;
+    const char* symbol = "kProfileDb";
+};
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: profile_pack <library.json> <out.bcedb> [--header <file.h>] [--symbol <name>]\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--header") == 0 && has_value) {
+            o.header_path = argv[++i];
+        } else if (std::strcmp(a, "--symbol") == 0 && has_value) {
+            o.symbol = argv[++i];
+        } else if (a[0] != '-' && o.library_path == nullptr) {
+            o.library_path = a;
+        } else if (a[0] != '-' && o.db_path == nullptr) {
+            o.db_path = a;
+        } else {
+            return false;
+        }
+    }
+    return o.library_path != nullptr && o.db_path != nullptr;
+}
+
+bool readLibrary(const char* path, std::vector<ProfileCartridge>& cartridges,
+                 std::vector<ProfileGun>& guns) {
+    profile_json::json root;
+    return profile_json::loadDocument(path, root) &&
+           profile_json::readLibrary(root, cartridges, guns);
+}
+
+bool writeHeader(const char* path, const char* symbol, const uint8_t* db, size_t n) {
+    FILE* out = std::fopen(path, "w");
+    if (!out) return false;
+    std::fprintf(out, "// Generated by profile_pack: BCEP v%u, %zu bytes. Do not edit.\n",
+                 static_cast<unsigned>(BCE_PROFILE_DB_VERSION), n);
+    std::fprintf(out, "#pragma once\n#include <cstddef>\n#include <cstdint>\n\n");
+    std::fprintf(out, "alignas(4) static const uint8_t %s[] = {", symbol);
+    for (size_t i = 0; i < n; ++i) {
+        std::fprintf(out, "%s0x%02x,", (i % 16 == 0) ? "\n    " : " ", db[i]);
+    }
+    std::fprintf(out, "\n};\nstatic const size_t %s_size = sizeof(%s);\n", symbol, symbol);
+    return std::fclose(out) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArgs(argc, argv, o)) {
+        usage();
+        return 2;
+    }
+
+    std::vector<ProfileCartridge> cartridges;
+    std::vector<ProfileGun> guns;
+    if (!readLibrary(o.library_path, cartridges, guns)) return 2;
+
+    const int nc = static_cast<int>(cartridges.size());
+    const int ng = static_cast<int>(guns.size());
+    const size_t size = ProfileDb::buildSize(nc, ng);
+    if (size == 0) {
+        std::fprintf(stderr, "profile_pack: too many profiles (%d + %d)\n", nc, ng);
+        return 2;
+    }
+    std::vector<uint32_t> storage((size + 3) / 4); // 4-byte aligned
+    uint8_t* db = reinterpret_cast<uint8_t*>(storage.data());
+    const size_t n = ProfileDb::build(cartridges.data(), nc, guns.data(), ng, db, size);
+    if (n == 0) {
+        std::fprintf(stderr, "profile_pack: %s has duplicate names or invalid drag models\n",
+                     o.library_path);
+        return 2;
+    }
+
+    // Read the result back the way the device will
+    ProfileDb check;
+    bool ok = check.open(db, n);
+    for (int i = 0; ok && i < nc; ++i) {
+        ok = check.findCartridge(cartridges[i].name) == check.getCartridge(i);
+    }
+    for (int i = 0; ok && i < ng; ++i) {
+        ok = check.findGun(guns[i].name) == check.getGun(i);
+    }
+    if (!ok) {
+        std::fprintf(stderr, "profile_pack: built database failed verification\n");
+        return 2;
+    }
+
+    FILE* out = std::fopen(o.db_path, "wb");
+    const bool written = out != nullptr && std::fwrite(db, 1, n, out) == n;
+    if (out != nullptr && std::fclose(out) != 0) ok = false;
+    if (!written || !ok) {
+        std::fprintf(stderr, "profile_pack: cannot write %s\n", o.db_path);
+        return 2;
+    }
+    if (o.header_path != nullptr && !writeHeader(o.header_path, o.symbol, db, n)) {
+        std::fprintf(stderr, "profile_pack: cannot write %s\n", o.header_path);
+        return 2;
+    }
+
+    std::printf("{\"cartridges\": %d, \"guns\": %d, \"bytes\": %zu, \"version\": %u}\n", nc, ng, n,
+                static_cast<unsigned>(BCE_PROFILE_DB_VERSION));
+    return 0;
+}
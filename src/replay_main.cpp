@@ -0,0 +1,642 @@
+/**
+ * @file replay_main.cpp
+ * @brief Sensor replay harness for the replay environment.
+ *
+ * Memory-maps a binary SensorFrame log and feeds every frame through
+ * BCE_Update, either back to back (throughput) or paced by the frame
+ * timestamps (--realtime). Prints one JSON document with frames/s, the
+ * per-frame latency distribution and, with --golden, how far the firing
+ * solutions drifted from a recorded run:
+ *
+ *   pio run -e replay
+ *   .pio/build/replay/program --synth session.bcelog --write-golden session.golden
+ *   .pio/build/replay/program session.bcelog --golden session.golden --max-p99-us 200
+ *
+ * The engine only looks at frame timestamps, never the wall clock, so a log
+ * replays to the same solutions in either mode. Exit status: 0 pass,
+ * 1 solution mismatch, 2 bad arguments or unreadable files, 3 latency over
+ * --max-p99-us.
+ *
+ * Two log formats are accepted. A raw log (native byte order and struct
+ * layout, as written by --synth) is a ReplayLogHeader, then frame_count
+ * SensorFrame records. A packed log is a "BCEF" stream as drained from the
+ * on-device recorder (BCE_ReadRecorder, recorder/frame_codec.h); it is
+ * decoded up front, with its configuration records applied between frames
+ * in stream order. --pack converts any log to the packed format. Golden
+ * files are a ReplayGoldenHeader followed by one FiringSolution per frame.
+ */
+
+#include "bce/bce_api.h"
+#include "bce/bce_config.h"
+#include "recorder/frame_codec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// File formats
+// ---------------------------------------------------------------------------
+
+constexpr char kLogMagic[4] = {'B', 'C', 'E', 'L'};
+constexpr char kGoldenMagic[4] = {'B', 'C', 'E', 'G'};
+constexpr uint16_t kFormatVersion = 1;
+
+// Padded to SensorFrame alignment so the records can be read in place
+struct alignas(8) ReplayLogHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t frame_size;      // sizeof(SensorFrame) of the writer
+    uint32_t frame_count;
+    uint32_t integrator;      // IntegratorMethod
+    BulletProfile bullet;
+    ZeroConfig zero;
+};
+
+static_assert(sizeof(ReplayLogHeader) % alignof(SensorFrame) == 0,
+              "frames must start aligned after the header");
+
+struct ReplayGoldenHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t solution_size;   // sizeof(FiringSolution) of the writer
+    uint32_t frame_count;
+};
+
+// ---------------------------------------------------------------------------
+// Read-only file mapping
+// ---------------------------------------------------------------------------
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const char* path) {
+        close();
+#ifdef _WIN32
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) return false;
+        size_ = static_cast<size_t>(size.QuadPart);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) return false;
+        data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        return data_ != nullptr;
+#else
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) return false;
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || st.st_size == 0) return false;
+        size_ = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) return false;
+        // One sequential pass: let the kernel read ahead
+        madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const uint8_t*>(p);
+        return true;
+#endif
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr) munmap(const_cast<uint8_t*>(data_), size_);
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// ---------------------------------------------------------------------------
+// Synthetic session — the same shape of input the integration tests feed
+// ---------------------------------------------------------------------------
+
+SensorFrame makeFrame(uint64_t timestamp_us) {
+    SensorFrame f;
+    std::memset(&f, 0, sizeof(f));
+    f.timestamp_us = timestamp_us;
+    f.accel_z = 9.81f;
+    f.imu_valid = true;
+    f.mag_x = 25.0f;
+    f.mag_z = -40.0f;
+    f.mag_valid = true;
+    f.baro_pressure_pa = 101325.0f;
+    f.baro_temperature_c = 15.0f;
+    f.baro_humidity = 0.5f;
+    f.baro_valid = true;
+    f.baro_humidity_valid = true;
+    return f;
+}
+
+// 100 Hz for 30 s: settle, range a walking target, drift the baro, tilt the
+// rifle, then one forward timestamp jump and a rollback like
+// IntegrationTest.TimestampJumpsAndRollbackRemainDeterministic
+bool writeSynthLog(const char* path) {
+    constexpr uint32_t kFrames = 3000;
+    constexpr uint64_t kPeriodUs = 10000;
+
+    ReplayLogHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kLogMagic, sizeof(h.magic));
+    h.version = kFormatVersion;
+    h.frame_size = sizeof(SensorFrame);
+    h.frame_count = kFrames;
+    h.integrator = static_cast<uint32_t>(IntegratorMethod::RK4);
+    h.bullet.bc = 0.505f;
+    h.bullet.drag_model = DragModel::G1;
+    h.bullet.muzzle_velocity_ms = 792.0f;
+    h.bullet.barrel_length_in = 24.0f;
+    h.bullet.mass_grains = 175.0f;
+    h.bullet.caliber_inches = 0.308f;
+    h.bullet.twist_rate_inches = 10.0f;
+    h.zero = {100.0f, 38.1f};
+
+    FILE* out = std::fopen(path, "wb");
+    if (out == nullptr) return false;
+    bool ok = std::fwrite(&h, sizeof(h), 1, out) == 1;
+
+    uint64_t t = 0;
+    for (uint32_t i = 0; ok && i < kFrames; ++i) {
+        if (i == 2500) {
+            t += 10ull * 1000ull * 1000ull;   // forward jump
+        } else if (i == 2501) {
+            t -= 9500ull * 1000ull;           // rollback
+        } else {
+            t += kPeriodUs;
+        }
+        SensorFrame f = makeFrame(t);
+        const float s = static_cast<float>(i) * 0.01f; // seconds
+
+        if (i >= 1500 && i < 1800) {
+            // One smooth 3° nod, back to level
+            float tilt = 0.05f * std::sin(3.14159265f * (s - 15.0f) / 3.0f);
+            f.accel_x = 9.81f * std::sin(tilt);
+            f.accel_z = 9.81f * std::cos(tilt);
+        }
+        f.baro_pressure_pa += 150.0f * std::sin(0.05f * s);
+        f.baro_temperature_c += 2.0f * std::sin(0.02f * s);
+
+        if (i >= 200) {
+            f.lrf_valid = true;
+            f.lrf_timestamp_us = t;
+            f.lrf_confidence = 1.0f;
+            f.lrf_range_m = 300.0f + 50.0f * static_cast<float>((i / 250) % 8);
+        }
+        f.encoder_valid = true;
+        f.encoder_focal_length_mm = 50.0f;
+        ok = std::fwrite(&f, sizeof(f), 1, out) == 1;
+    }
+    return (std::fclose(out) == 0) && ok;
+}
+
+// ---------------------------------------------------------------------------
+// Session — frames plus the configuration applied before each of them
+// ---------------------------------------------------------------------------
+
+struct ConfigEvent {
+    uint32_t before_frame;
+    FrameDecoder::Record kind; // BULLET, ZERO or INTEGRATOR
+    BulletProfile bullet;
+    ZeroConfig zero;
+    IntegratorTuning integrator;
+};
+
+struct Session {
+    const SensorFrame* frames = nullptr;
+    uint32_t frame_count = 0;
+    std::vector<SensorFrame> decoded; // backing store for packed logs
+    std::vector<ConfigEvent> config;
+};
+
+bool loadRawLog(const MappedFile& log, Session& s) {
+    ReplayLogHeader h;
+    if (log.size() < sizeof(h)) return false;
+    std::memcpy(&h, log.data(), sizeof(h));
+    if (std::memcmp(h.magic, kLogMagic, sizeof(h.magic)) != 0 || h.version != kFormatVersion ||
+        h.frame_size != sizeof(SensorFrame) ||
+        log.size() < sizeof(h) + static_cast<size_t>(h.frame_count) * sizeof(SensorFrame)) {
+        return false;
+    }
+    s.frames = reinterpret_cast<const SensorFrame*>(log.data() + sizeof(h));
+    s.frame_count = h.frame_count;
+
+    ConfigEvent e;
+    std::memset(&e, 0, sizeof(e));
+    e.kind = FrameDecoder::Record::INTEGRATOR;
+    e.integrator.method = static_cast<IntegratorMethod>(h.integrator);
+    s.config.push_back(e);
+    e.kind = FrameDecoder::Record::BULLET;
+    e.bullet = h.bullet;
+    s.config.push_back(e);
+    e.kind = FrameDecoder::Record::ZERO;
+    e.zero = h.zero;
+    s.config.push_back(e);
+    return true;
+}
+
+bool loadPackedLog(const MappedFile& log, Session& s) {
+    FrameDecoder dec;
+    if (!dec.begin(log.data(), log.size())) return false;
+    for (;;) {
+        const FrameDecoder::Record r = dec.next();
+        if (r == FrameDecoder::Record::END) break;
+        if (r == FrameDecoder::Record::INVALID) {
+            std::fprintf(stderr, "replay: corrupt record at byte %llu\n",
+                         static_cast<unsigned long long>(dec.offset()));
+            return false;
+        }
+        if (r == FrameDecoder::Record::FRAME) {
+            s.decoded.push_back(dec.frame());
+            continue;
+        }
+        ConfigEvent e;
+        std::memset(&e, 0, sizeof(e));
+        e.before_frame = static_cast<uint32_t>(s.decoded.size());
+        e.kind = r;
+        e.bullet = dec.bullet();
+        e.zero = dec.zero();
+        e.integrator = dec.integratorTuning();
+        s.config.push_back(e);
+    }
+    s.frames = s.decoded.data();
+    s.frame_count = static_cast<uint32_t>(s.decoded.size());
+    return true;
+}
+
+void applyConfig(const ConfigEvent& e) {
+    switch (e.kind) {
+    case FrameDecoder::Record::BULLET: BCE_SetBulletProfile(&e.bullet); break;
+    case FrameDecoder::Record::ZERO: BCE_SetZeroConfig(&e.zero); break;
+    case FrameDecoder::Record::INTEGRATOR: BCE_SetIntegratorTuning(&e.integrator); break;
+    default: break;
+    }
+}
+
+bool writePackedLog(const char* path, const Session& s) {
+    FILE* out = std::fopen(path, "wb");
+    if (out == nullptr) return false;
+    uint8_t rec[FRAME_LOG_MAX_RECORD_BYTES];
+    bool ok = std::fwrite(rec, 1, FrameEncoder::writeHeader(rec), out) == FRAME_LOG_HEADER_BYTES;
+
+    FrameEncoder enc;
+    size_t next_config = 0;
+    for (uint32_t i = 0; ok && i <= s.frame_count; ++i) {
+        for (; next_config < s.config.size() && s.config[next_config].before_frame == i;
+             ++next_config) {
+            const ConfigEvent& e = s.config[next_config];
+            size_t n = 0;
+            if (e.kind == FrameDecoder::Record::BULLET) n = FrameEncoder::encodeBullet(e.bullet, rec);
+            if (e.kind == FrameDecoder::Record::ZERO) n = FrameEncoder::encodeZero(e.zero, rec);
+            if (e.kind == FrameDecoder::Record::INTEGRATOR) {
+                n = FrameEncoder::encodeIntegrator(e.integrator, rec);
+            }
+            ok = ok && std::fwrite(rec, 1, n, out) == n;
+        }
+        if (i == s.frame_count) break;
+        const size_t n = enc.encodeFrame(s.frames[i], rec);
+        ok = ok && std::fwrite(rec, 1, n, out) == n;
+    }
+    return (std::fclose(out) == 0) && ok;
+}
+
+// ---------------------------------------------------------------------------
+// Golden comparison
+// ---------------------------------------------------------------------------
+
+struct DiffStats {
+    uint32_t frames_compared = 0;
+    uint32_t frames_mismatched = 0;
+    int64_t first_mismatch = -1;
+    double max_elevation_moa = 0.0;
+    double max_windage_moa = 0.0;
+    double max_range_m = 0.0;
+    double max_tof_ms = 0.0;
+};
+
+double absDiff(float a, float b) {
+    if (std::isnan(a) && std::isnan(b)) return 0.0;
+    if (!std::isfinite(a) || !std::isfinite(b)) return (a == b) ? 0.0 : INFINITY;
+    return std::fabs(static_cast<double>(a) - static_cast<double>(b));
+}
+
+void compareSolution(const FiringSolution& got, const FiringSolution& want, double tol_moa,
+                     uint32_t index, DiffStats& d) {
+    const double de = absDiff(got.hold_elevation_moa, want.hold_elevation_moa);
+    const double dw = absDiff(got.hold_windage_moa, want.hold_windage_moa);
+    const double dr = absDiff(got.range_m, want.range_m);
+    const double dt = absDiff(got.tof_ms, want.tof_ms);
+    d.max_elevation_moa = std::max(d.max_elevation_moa, de);
+    d.max_windage_moa = std::max(d.max_windage_moa, dw);
+    d.max_range_m = std::max(d.max_range_m, dr);
+    d.max_tof_ms = std::max(d.max_tof_ms, dt);
+    d.frames_compared++;
+
+    const bool mismatch = got.solution_mode != want.solution_mode ||
+                          got.fault_flags != want.fault_flags ||
+                          got.defaults_active != want.defaults_active ||
+                          de > tol_moa || dw > tol_moa;
+    if (mismatch) {
+        d.frames_mismatched++;
+        if (d.first_mismatch < 0) d.first_mismatch = index;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Latency distribution
+// ---------------------------------------------------------------------------
+
+// Power-of-two buckets: bucket k counts latencies in [2^(k-1), 2^k) µs,
+// bucket 0 everything under 1 µs, the last one everything above
+constexpr int kHistBuckets = 20;
+
+int histBucket(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    int k = 0;
+    while (us > 0 && k < kHistBuckets - 1) {
+        us >>= 1;
+        k++;
+    }
+    return k;
+}
+
+double percentileUs(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t i = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[i]) * 1.0e-3;
+}
+
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// ---------------------------------------------------------------------------
+// Replay
+// ---------------------------------------------------------------------------
+
+struct Options {
+    const char* log_path = nullptr;
+    const char* golden_path = nullptr;
+    const char* write_golden_path = nullptr;
+    const char* synth_path = nullptr;
+    const char* pack_path = nullptr;
+    bool realtime = false;
+    double tolerance_moa = 1.0e-3;
+    double max_p99_us = 0.0;   // 0 = no latency gate
+};
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: replay <log> [--realtime] [--golden <file>] [--write-golden <file>]\n"
+                 "              [--tolerance-moa <x>] [--max-p99-us <x>] [--pack <file>]\n"
+                 "       replay --synth <log> [options]   (write the synthetic session, then replay it)\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--realtime") == 0) {
+            o.realtime = true;
+        } else if (std::strcmp(a, "--golden") == 0 && has_value) {
+            o.golden_path = argv[++i];
+        } else if (std::strcmp(a, "--write-golden") == 0 && has_value) {
+            o.write_golden_path = argv[++i];
+        } else if (std::strcmp(a, "--pack") == 0 && has_value) {
+            o.pack_path = argv[++i];
+        } else if (std::strcmp(a, "--synth") == 0 && has_value) {
+            o.synth_path = argv[++i];
+        } else if (std::strcmp(a, "--tolerance-moa") == 0 && has_value) {
+            o.tolerance_moa = std::atof(argv[++i]);
+        } else if (std::strcmp(a, "--max-p99-us") == 0 && has_value) {
+            o.max_p99_us = std::atof(argv[++i]);
+        } else if (a[0] != '-' && o.log_path == nullptr) {
+            o.log_path = a;
+        } else {
+            return false;
+        }
+    }
+    return o.synth_path != nullptr || o.log_path != nullptr;
+}
+
+int run(const Options& o) {
+    MappedFile log;
+    if (!log.open(o.log_path)) {
+        std::fprintf(stderr, "replay: cannot map %s\n", o.log_path);
+        return 2;
+    }
+    Session session;
+    if (!loadRawLog(log, session) && !loadPackedLog(log, session)) {
+        std::fprintf(stderr, "replay: %s is not a v%u raw log or v%u packed log for this build\n",
+                     o.log_path, static_cast<unsigned>(kFormatVersion),
+                     static_cast<unsigned>(BCE_FRAME_LOG_VERSION));
+        return 2;
+    }
+    const SensorFrame* frames = session.frames;
+    const uint32_t n = session.frame_count;
+
+    if (o.pack_path != nullptr && !writePackedLog(o.pack_path, session)) {
+        std::fprintf(stderr, "replay: cannot write %s\n", o.pack_path);
+        return 2;
+    }
+
+    MappedFile golden;
+    const FiringSolution* want = nullptr;
+    if (o.golden_path != nullptr) {
+        ReplayGoldenHeader gh;
+        if (!golden.open(o.golden_path) || golden.size() < sizeof(gh)) {
+            std::fprintf(stderr, "replay: cannot map %s\n", o.golden_path);
+            return 2;
+        }
+        std::memcpy(&gh, golden.data(), sizeof(gh));
+        if (std::memcmp(gh.magic, kGoldenMagic, sizeof(gh.magic)) != 0 ||
+            gh.version != kFormatVersion || gh.solution_size != sizeof(FiringSolution) ||
+            gh.frame_count != n ||
+            golden.size() < sizeof(gh) + static_cast<size_t>(n) * sizeof(FiringSolution)) {
+            std::fprintf(stderr, "replay: %s does not match %s\n", o.golden_path, o.log_path);
+            return 2;
+        }
+        want = reinterpret_cast<const FiringSolution*>(golden.data() + sizeof(gh));
+    }
+
+    std::vector<FiringSolution> solutions;
+    if (o.write_golden_path != nullptr) solutions.resize(n);
+    std::vector<uint64_t> latency(n);
+
+    BCE_Init();
+    size_t next_config = 0;
+
+    DiffStats diff;
+    uint64_t hist[kHistBuckets] = {};
+
+    // Real-time pacing follows the frame clock; a jump of more than a
+    // second either way (reboot, rollback) restarts the pacing there
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point pace_origin = Clock::now();
+    uint64_t pace_ts = (n > 0) ? frames[0].timestamp_us : 0;
+
+    const uint64_t t_start = nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        for (; next_config < session.config.size() && session.config[next_config].before_frame == i;
+             ++next_config) {
+            applyConfig(session.config[next_config]);
+        }
+        const SensorFrame& f = frames[i];
+        if (o.realtime) {
+            const int64_t ahead = static_cast<int64_t>(f.timestamp_us - pace_ts);
+            if (ahead < 0 || ahead > 1000000) {
+                pace_origin = Clock::now();
+                pace_ts = f.timestamp_us;
+            } else {
+                std::this_thread::sleep_until(pace_origin + std::chrono::microseconds(ahead));
+            }
+        }
+
+        const uint64_t t0 = nowNs();
+        BCE_Update(&f);
+        const uint64_t t1 = nowNs();
+        latency[i] = t1 - t0;
+        hist[histBucket(latency[i])]++;
+
+        if (want != nullptr || !solutions.empty()) {
+            FiringSolution sol;
+            BCE_GetSolution(&sol);
+            if (want != nullptr) compareSolution(sol, want[i], o.tolerance_moa, i, diff);
+            if (!solutions.empty()) solutions[i] = sol;
+        }
+    }
+    const double wall_s = static_cast<double>(nowNs() - t_start) * 1.0e-9;
+
+    if (o.write_golden_path != nullptr) {
+        ReplayGoldenHeader gh;
+        std::memset(&gh, 0, sizeof(gh));
+        std::memcpy(gh.magic, kGoldenMagic, sizeof(gh.magic));
+        gh.version = kFormatVersion;
+        gh.solution_size = sizeof(FiringSolution);
+        gh.frame_count = n;
+        FILE* out = std::fopen(o.write_golden_path, "wb");
+        bool ok = out != nullptr && std::fwrite(&gh, sizeof(gh), 1, out) == 1 &&
+                  std::fwrite(solutions.data(), sizeof(FiringSolution), n, out) == n;
+        if (out != nullptr) ok = (std::fclose(out) == 0) && ok;
+        if (!ok) {
+            std::fprintf(stderr, "replay: cannot write %s\n", o.write_golden_path);
+            return 2;
+        }
+    }
+
+    uint64_t busy_ns = 0;
+    for (uint64_t v : latency) busy_ns += v;
+    std::vector<uint64_t> sorted = latency;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double p99 = percentileUs(sorted, 0.99);
+    const bool latency_ok = (o.max_p99_us <= 0.0) || (p99 <= o.max_p99_us);
+    const bool golden_ok = (want == nullptr) || (diff.frames_mismatched == 0);
+
+    std::printf("{\n  \"replay\": \"bce\", \"version\": \"%d.%d\", \"fast_math\": %d, "
+                "\"log\": \"%s\", \"mode\": \"%s\",\n",
+                BCE_VERSION_MAJOR, BCE_VERSION_MINOR, BCE_FAST_MATH, o.log_path,
+                o.realtime ? "realtime" : "max");
+    std::printf("  \"frames\": %lu, \"wall_s\": %.3f, \"frames_per_s\": %.0f, "
+                "\"engine_frames_per_s\": %.0f,\n",
+                static_cast<unsigned long>(n), wall_s,
+                (wall_s > 0.0) ? static_cast<double>(n) / wall_s : 0.0,
+                (busy_ns > 0) ? static_cast<double>(n) * 1.0e9 / static_cast<double>(busy_ns) : 0.0);
+    std::printf("  \"latency_us\": {\"p50\": %.2f, \"p99\": %.2f, \"max\": %.2f, "
+                "\"mean\": %.2f},\n",
+                percentileUs(sorted, 0.5), p99, percentileUs(sorted, 1.0),
+                (n > 0) ? static_cast<double>(busy_ns) * 1.0e-3 / static_cast<double>(n) : 0.0);
+
+    // Histogram: upper bound of each occupied bucket (µs) and its count
+    std::printf("  \"histogram_us\": [");
+    bool first = true;
+    for (int k = 0; k < kHistBuckets; ++k) {
+        if (hist[k] == 0) continue;
+        if (k == kHistBuckets - 1) {
+            std::printf("%s{\"le\": null, \"count\": %llu}", first ? "" : ", ",
+                        static_cast<unsigned long long>(hist[k]));
+        } else {
+            std::printf("%s{\"le\": %llu, \"count\": %llu}", first ? "" : ", ",
+                        1ull << k, static_cast<unsigned long long>(hist[k]));
+        }
+        first = false;
+    }
+    std::printf("]");
+
+    if (want != nullptr) {
+        std::printf(",\n  \"golden\": {\"file\": \"%s\", \"tolerance_moa\": %g, "
+                    "\"compared\": %lu, \"mismatched\": %lu, \"first_mismatch\": %lld, "
+                    "\"max_diff\": {\"elevation_moa\": %g, \"windage_moa\": %g, "
+                    "\"range_m\": %g, \"tof_ms\": %g}}",
+                    o.golden_path, o.tolerance_moa,
+                    static_cast<unsigned long>(diff.frames_compared),
+                    static_cast<unsigned long>(diff.frames_mismatched),
+                    static_cast<long long>(diff.first_mismatch), diff.max_elevation_moa,
+                    diff.max_windage_moa, diff.max_range_m, diff.max_tof_ms);
+    }
+    std::printf(",\n  \"pass\": %s\n}\n", (golden_ok && latency_ok) ? "true" : "false");
+
+    if (!golden_ok) return 1;
+    if (!latency_ok) return 3;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArgs(argc, argv, o)) {
+        usage();
+        return 2;
+    }
+    if (o.synth_path != nullptr) {
+        if (!writeSynthLog(o.synth_path)) {
+            std::fprintf(stderr, "replay: cannot write %s\n", o.synth_path);
+            return 2;
+        }
+        if (o.log_path == nullptr) o.log_path = o.synth_path;
+    }
+    return run(o);
+}
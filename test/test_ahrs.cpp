@@ -5,7 +5,9 @@
 
 #include <gtest/gtest.h>
 #include "../lib/bce/src/ahrs/ahrs_manager.h"
+#include "../lib/bce/src/ahrs/sliding_variance.h"
 #include <cmath>
+#include <initializer_list>
 
 class AHRSTest : public ::testing::Test {
 protected:
@@ -143,3 +145,103 @@ TEST_F(AHRSTest, StabilityDropsWhenDynamic) {
 
     EXPECT_FALSE(ahrs.isStable());
 }
+
+// A burst (longer than one chunk and the static window) fuses to the same
+// attitude and static state as feeding the samples one at a time
+TEST_F(AHRSTest, BurstMatchesPerSampleUpdate) {
+    for (AHRS_Algorithm algo : {AHRS_Algorithm::MADGWICK, AHRS_Algorithm::MAHONY}) {
+        AHRSManager sequential;
+        sequential.init();
+        ahrs.init();
+        sequential.setAlgorithm(algo);
+        ahrs.setAlgorithm(algo);
+        const float gyro_bias[3] = {0.01f, -0.02f, 0.005f};
+        sequential.setGyroBias(gyro_bias);
+        ahrs.setGyroBias(gyro_bias);
+
+        ImuSample samples[3 * BCE_AHRS_BURST_MAX - 5];
+        float dt[3 * BCE_AHRS_BURST_MAX - 5];
+        const int count = static_cast<int>(sizeof(samples) / sizeof(samples[0]));
+        for (int i = 0; i < count; ++i) {
+            float t = static_cast<float>(i) * 0.00125f;
+            samples[i] = {static_cast<uint64_t>(i) * 1250u,
+                          0.5f * std::sin(7.0f * t), 0.3f, 9.79f,
+                          0.2f * std::cos(5.0f * t), 0.1f, -0.05f};
+            dt[i] = 0.00125f;
+            sequential.update(samples[i].accel_x, samples[i].accel_y, samples[i].accel_z,
+                              samples[i].gyro_x, samples[i].gyro_y, samples[i].gyro_z,
+                              0.0f, 0.0f, 0.0f, false, dt[i]);
+        }
+        ahrs.updateBurst(samples, dt, count);
+
+        Quaternion a = sequential.getQuaternion();
+        Quaternion b = ahrs.getQuaternion();
+        EXPECT_NEAR(a.w, b.w, 1e-6f);
+        EXPECT_NEAR(a.x, b.x, 1e-6f);
+        EXPECT_NEAR(a.y, b.y, 1e-6f);
+        EXPECT_NEAR(a.z, b.z, 1e-6f);
+        EXPECT_EQ(sequential.isStatic(), ahrs.isStatic());
+        EXPECT_EQ(sequential.isStable(), ahrs.isStable());
+    }
+}
+
+// The O(1) sliding estimator tracks a two-pass scan of the same window over
+// many ring wraps, for the default window and a high-rate one
+template <int N>
+static void checkSlidingVariance() {
+    static SlidingVariance<N> stats;
+    static float window[N];
+    stats.reset();
+    uint32_t seed = 12345u;
+    for (int i = 0; i < 40 * N; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f);
+        // Quiet and noisy stretches around a gravity-sized offset
+        float amp = ((i / N) % 3 == 0) ? 2.0f : 0.05f;
+        float x = 9.81f + amp * noise;
+        stats.push(x);
+        window[i % N] = x;
+
+        if (i % 37 == 0 && i >= N) {
+            double mean = 0.0;
+            for (float w : window) mean += w;
+            mean /= N;
+            double var = 0.0;
+            for (float w : window) var += (w - mean) * (w - mean);
+            var /= N;
+            EXPECT_NEAR(stats.mean(), mean, 1e-5) << N << " " << i;
+            EXPECT_NEAR(stats.variance(), var, 1e-6 + 1e-3 * var) << N << " " << i;
+        }
+    }
+    EXPECT_TRUE(stats.full());
+}
+
+TEST(SlidingVarianceTest, MatchesTwoPassWindow) {
+    checkSlidingVariance<BCE_AHRS_STATIC_WINDOW>();
+    checkSlidingVariance<512>();
+}
+
+// With the gyro channel enabled a steady pan is not static, though the
+// accel magnitude stays perfectly constant
+TEST_F(AHRSTest, GyroChannelRejectsSteadyPan) {
+    auto feed = [&]() {
+        for (int i = 0; i < BCE_AHRS_STATIC_WINDOW + 10; ++i) {
+            ahrs.update(0.0f, 0.0f, 9.81f,
+                        0.0f, 0.0f, 0.2f,   // 0.2 rad/s yaw pan
+                        0.0f, 0.0f, 0.0f,
+                        false, 0.01f);
+        }
+    };
+    feed();
+    EXPECT_TRUE(ahrs.isStatic());
+
+    ahrs.init();
+    ahrs.setStaticGyroThreshold(0.05f);
+    feed();
+    EXPECT_FALSE(ahrs.isStatic());
+
+    ahrs.init();
+    ahrs.setStaticGyroThreshold(0.5f);
+    feed();
+    EXPECT_TRUE(ahrs.isStatic());
+}
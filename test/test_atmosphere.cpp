@@ -7,6 +7,7 @@
 #include "../lib/bce/src/atmo/atmosphere.h"
 #include "bce/bce_config.h"
 #include <cmath>
+#include <initializer_list>
 
 class AtmosphereTest : public ::testing::Test {
 protected:
@@ -124,3 +125,62 @@ TEST_F(AtmosphereTest, InvalidHumidityIsClamped) {
     EXPECT_GE(atmo.getHumidity(), 0.0f);
     EXPECT_LE(atmo.getHumidity(), 1.0f);
 }
+
+// Readings inside the deadbands are noise: nothing changes, nothing rederives
+TEST_F(AtmosphereTest, DeadbandIgnoresSensorNoise) {
+    atmo.updateFromBaro(95000.0f, 20.0f, 0.4f);
+    uint32_t generation = atmo.getGeneration();
+    float density = atmo.getAirDensity();
+
+    atmo.updateFromBaro(95001.0f, 20.01f, 0.401f);
+    EXPECT_EQ(atmo.getGeneration(), generation);
+    EXPECT_EQ(atmo.getAirDensity(), density);
+    EXPECT_EQ(atmo.getPressure(), 95000.0f);
+
+    atmo.updateFromBaro(95010.0f, 20.0f, 0.4f);
+    EXPECT_NE(atmo.getGeneration(), generation);
+    EXPECT_NE(atmo.getAirDensity(), density);
+}
+
+// Small drift is accepted once it accumulates past the deadband
+TEST_F(AtmosphereTest, DeadbandComparesAgainstAcceptedReading) {
+    atmo.updateFromBaro(95000.0f, 20.0f, 0.4f);
+    uint32_t generation = atmo.getGeneration();
+    atmo.updateFromBaro(95001.5f, 20.0f, 0.4f);
+    EXPECT_EQ(atmo.getGeneration(), generation);
+    atmo.updateFromBaro(95003.0f, 20.0f, 0.4f);
+    EXPECT_EQ(atmo.getGeneration(), generation + 1);
+    EXPECT_EQ(atmo.getPressure(), 95003.0f);
+}
+
+// Zero deadbands accept every distinct reading
+TEST_F(AtmosphereTest, ZeroDeadbandAcceptsAnyChange) {
+    atmo.setDeadbands(0.0f, 0.0f, 0.0f);
+    atmo.updateFromBaro(95000.0f, 20.0f, 0.4f);
+    uint32_t generation = atmo.getGeneration();
+    atmo.updateFromBaro(95000.5f, 20.0f, 0.4f);
+    EXPECT_EQ(atmo.getGeneration(), generation + 1);
+    EXPECT_EQ(atmo.getPressure(), 95000.5f);
+}
+
+// The cached BC factor reproduces the 4-factor formula for any BC
+TEST_F(AtmosphereTest, CachedBCFactorMatchesFormula) {
+    BCE_DefaultOverrides ovr = {};
+    ovr.use_altitude = true;
+    ovr.altitude_m = 1500.0f;
+    atmo.applyDefaults(ovr);
+    atmo.updateFromBaro(84000.0f, 5.0f, 0.7f);
+
+    const float alt_ft = 1500.0f * 3.28084f;
+    const float press_inhg = 84000.0f * 0.00029530f;
+    const float temp_f = 5.0f * 1.8f + 32.0f;
+    const float FA = 1.0f - 3.158e-5f * alt_ft;
+    const float FT = (temp_f - 59.0f) / (59.0f + 460.0f);
+    const float FP = (29.53f - press_inhg) / 29.53f;
+    const float FR = 1.0f + 0.00002f * (70.0f - 50.0f);
+
+    for (float bc : {0.2f, 0.475f, 0.9f}) {
+        float expected = bc * FA * (1.0f + FT - FP) * FR;
+        EXPECT_NEAR(atmo.correctBC(bc), expected, 1e-5f * bc);
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test_dispersion.cpp
+ * @brief Unit tests for the Monte Carlo sampler and streaming statistics.
+ */
+
+#include <gtest/gtest.h>
+#include "../lib/bce/src/dispersion/dispersion.h"
+#include "bce/bce_config.h"
+#include <cmath>
+
+// Gaussian deviates have unit variance and zero mean
+TEST(DispersionTest, GaussianMoments) {
+    DispersionSampler rng;
+    rng.seed(1234);
+    const int n = 20000;
+    double sum = 0.0;
+    double sum2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double g = rng.gaussian();
+        ASSERT_TRUE(std::isfinite(g));
+        sum += g;
+        sum2 += g * g;
+    }
+    double mean = sum / n;
+    double var = sum2 / n - mean * mean;
+    EXPECT_NEAR(mean, 0.0, 0.03);
+    EXPECT_NEAR(var, 1.0, 0.05);
+}
+
+// The same seed reproduces the same sequence
+TEST(DispersionTest, SeedIsReproducible) {
+    DispersionSampler a;
+    DispersionSampler b;
+    a.seed(42);
+    b.seed(42);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(a.gaussian(), b.gaussian());
+    }
+    b.seed(0); // default seed, still well defined
+    EXPECT_TRUE(std::isfinite(b.gaussian()));
+}
+
+// Streaming statistics match a two-pass computation
+TEST(DispersionTest, AccumulatorMatchesTwoPass) {
+    const float elev[] = {0.5f, -1.2f, 0.3f, 2.0f, -0.4f, 0.9f};
+    const float wind[] = {1.0f, -0.6f, 0.4f, 1.7f, -0.1f, 0.5f};
+    const int n = 6;
+
+    DispersionAccumulator acc;
+    acc.reset();
+    for (int i = 0; i < n; ++i) acc.add(elev[i], wind[i], i % 2 == 0);
+
+    float me = 0.0f, mw = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        me += elev[i] / n;
+        mw += wind[i] / n;
+    }
+    float ve = 0.0f, vw = 0.0f, c = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        ve += (elev[i] - me) * (elev[i] - me) / (n - 1);
+        vw += (wind[i] - mw) * (wind[i] - mw) / (n - 1);
+        c += (elev[i] - me) * (wind[i] - mw) / (n - 1);
+    }
+
+    BCE_DispersionStats s;
+    acc.getStats(&s);
+    EXPECT_EQ(s.sample_count, 6u);
+    EXPECT_NEAR(s.mean_elevation_moa, me, 1e-5f);
+    EXPECT_NEAR(s.mean_windage_moa, mw, 1e-5f);
+    EXPECT_NEAR(s.sigma_elevation_moa, std::sqrt(ve), 1e-5f);
+    EXPECT_NEAR(s.sigma_windage_moa, std::sqrt(vw), 1e-5f);
+    EXPECT_NEAR(s.hit_probability, 0.5f, 1e-6f);
+
+    // Ellipse axes preserve the total variance and the determinant
+    float major2 = s.ellipse_major_moa * s.ellipse_major_moa;
+    float minor2 = s.ellipse_minor_moa * s.ellipse_minor_moa;
+    EXPECT_NEAR(major2 + minor2, ve + vw, 1e-4f);
+    EXPECT_NEAR(major2 * minor2, ve * vw - c * c, 1e-4f);
+    EXPECT_GE(s.ellipse_major_moa, s.ellipse_minor_moa);
+}
+
+// Perfectly correlated impacts give a degenerate ellipse along the diagonal
+TEST(DispersionTest, EllipseOrientation) {
+    DispersionAccumulator acc;
+    acc.reset();
+    for (int i = -5; i <= 5; ++i) {
+        acc.add(0.1f * i, 0.1f * i, true);
+    }
+    BCE_DispersionStats s;
+    acc.getStats(&s);
+    EXPECT_NEAR(s.ellipse_angle_deg, 45.0f, 1e-3f);
+    EXPECT_NEAR(s.ellipse_minor_moa, 0.0f, 1e-3f);
+    EXPECT_FLOAT_EQ(s.hit_probability, 1.0f);
+}
@@ -5,7 +5,10 @@
 
 #include <gtest/gtest.h>
 #include "../lib/bce/src/drag/drag_model.h"
+#include "../lib/bce/src/drag/drag_tables.h"
 #include "bce/bce_config.h"
+#include <cmath>
+#include <initializer_list>
 
 // G1 Cd at Mach 0 should match the first table entry
 TEST(DragTest, G1CdAtMachZero) {
@@ -90,3 +93,150 @@ TEST(DragTest, HighMachClamps) {
     float cd = DragModelLookup::getCd(DragModel::G1, 10.0f);
     EXPECT_GT(cd, 0.0f);
 }
+
+// Uniform-Mach tables must track the reference interpolation across the grid
+TEST(DragTest, UniformTablesMatchReference) {
+    // Stated tolerance: every source breakpoint is on the uniform grid, so the
+    // only difference is float rounding in the lerp.
+    constexpr float kCdTolerance = 1e-5f;
+
+    DragModel models[] = {DragModel::G1, DragModel::G2, DragModel::G3, DragModel::G4,
+                          DragModel::G5, DragModel::G6, DragModel::G7, DragModel::G8};
+
+    for (auto model : models) {
+        float worst = 0.0f;
+        for (int i = 0; i <= 60000; ++i) {
+            float mach = 0.0001f * static_cast<float>(i); // Mach 0–6, off-grid samples
+            float err = std::fabs(DragModelLookup::getCd(model, mach) -
+                                  DragModelLookup::getCdReference(model, mach));
+            if (err > worst) worst = err;
+        }
+        EXPECT_LT(worst, kCdTolerance) << "Model " << static_cast<int>(model);
+    }
+}
+
+// Uniform curves span the source tables at BCE_DRAG_MACH_STEP spacing
+TEST(DragTest, UniformCurveCoversSourceRange) {
+    DragCurve g1 = DragModelLookup::getCurve(DragModel::G1);
+    ASSERT_NE(g1.cd, nullptr);
+    EXPECT_NEAR((g1.size - 1) * BCE_DRAG_MACH_STEP, 5.0f, 1e-4f);
+    EXPECT_NEAR(g1.cd[0], 0.2629f, 1e-6f);
+    EXPECT_NEAR(DragModelLookup::lookupCd(g1, 10.0f), g1.cd[g1.size - 1], 1e-6f);
+}
+
+// Per-solve context must reproduce the standalone deceleration formula
+TEST(DragTest, ContextMatchesDeceleration) {
+    DragContext ctx = DragModelLookup::makeContext(DragModel::G7, 340.0f, 0.243f, 1.10f);
+    for (float v = 50.0f; v < 1200.0f; v += 37.0f) {
+        float expected = DragModelLookup::getDeceleration(v, 340.0f, 0.243f, DragModel::G7, 1.10f);
+        EXPECT_NEAR(DragModelLookup::getDeceleration(ctx, v), expected, expected * 1e-5f);
+    }
+
+    // Drag scale folds into the coefficient
+    DragContext scaled = DragModelLookup::makeContext(DragModel::G7, 340.0f, 0.243f, 1.10f, 0.5f);
+    EXPECT_NEAR(DragModelLookup::getDeceleration(scaled, 800.0f),
+                0.5f * DragModelLookup::getDeceleration(ctx, 800.0f), 1e-4f);
+
+    // Degenerate BC disables drag, as in the standalone path
+    DragContext no_bc = DragModelLookup::makeContext(DragModel::G1, 340.0f, 0.0f, 1.225f);
+    EXPECT_EQ(DragModelLookup::getDeceleration(no_bc, 800.0f), 0.0f);
+}
+
+// Loading a built-in table as the custom curve reproduces that model exactly
+TEST(DragTest, CustomCurveReproducesBuiltInTable) {
+    ASSERT_TRUE(DragModelLookup::setCustomCurve(G7_TABLE, G7_TABLE_SIZE));
+    DragCurve custom = DragModelLookup::getCurve(DragModel::CUSTOM);
+    DragCurve g7 = DragModelLookup::getCurve(DragModel::G7);
+    ASSERT_EQ(custom.size, g7.size);
+    for (int i = 0; i < g7.size; ++i) {
+        ASSERT_EQ(custom.cd[i], g7.cd[i]) << i;
+    }
+    for (float mach = 0.0f; mach <= 5.5f; mach += 0.0137f) {
+        EXPECT_EQ(DragModelLookup::getCd(DragModel::CUSTOM, mach),
+                  DragModelLookup::getCd(DragModel::G7, mach)) << mach;
+    }
+    EXPECT_NE(DragModelLookup::getCustomCurveId(), 0u);
+    DragModelLookup::clearCustomCurve();
+}
+
+// Breakpoints off the uniform grid are resampled to within the grid's
+// linear-interpolation error of the reference path
+TEST(DragTest, CustomCurveOffGridMatchesReference) {
+    const DragPoint doppler[] = {
+        {0.113f, 0.151f}, {0.517f, 0.149f}, {0.783f, 0.155f}, {0.911f, 0.201f},
+        {0.987f, 0.342f}, {1.043f, 0.371f}, {1.291f, 0.352f}, {2.173f, 0.281f},
+        {3.337f, 0.229f},
+    };
+    ASSERT_TRUE(DragModelLookup::setCustomCurve(doppler, 9));
+    for (float mach = 0.0f; mach <= 4.0f; mach += 0.001f) {
+        float ref = DragModelLookup::getCdReference(DragModel::CUSTOM, mach);
+        EXPECT_NEAR(DragModelLookup::getCd(DragModel::CUSTOM, mach), ref, 0.01f) << mach;
+    }
+    // Clamped outside the source span, like the built-in tables
+    EXPECT_FLOAT_EQ(DragModelLookup::getCd(DragModel::CUSTOM, 0.0f), 0.151f);
+    EXPECT_FLOAT_EQ(DragModelLookup::getCd(DragModel::CUSTOM, 4.5f), 0.229f);
+    DragModelLookup::clearCustomCurve();
+}
+
+// Invalid curves are rejected without replacing the loaded one
+TEST(DragTest, CustomCurveRejectsInvalidPoints) {
+    const DragPoint good[] = {{0.0f, 0.2f}, {1.0f, 0.4f}, {2.0f, 0.3f}};
+    ASSERT_TRUE(DragModelLookup::setCustomCurve(good, 3));
+    const uint32_t id = DragModelLookup::getCustomCurveId();
+
+    const DragPoint descending[] = {{0.0f, 0.2f}, {1.0f, 0.4f}, {0.9f, 0.3f}};
+    const DragPoint repeated[] = {{0.0f, 0.2f}, {1.0f, 0.4f}, {1.0f, 0.3f}};
+    const DragPoint negative[] = {{-0.1f, 0.2f}, {1.0f, 0.4f}};
+    const DragPoint nan_cd[] = {{0.0f, 0.2f}, {1.0f, NAN}};
+    static DragPoint too_many[BCE_CUSTOM_DRAG_MAX_POINTS + 1];
+    for (int i = 0; i <= BCE_CUSTOM_DRAG_MAX_POINTS; ++i) {
+        too_many[i] = {0.01f * static_cast<float>(i), 0.3f};
+    }
+
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(nullptr, 3));
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(good, 1));
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(descending, 3));
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(repeated, 3));
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(negative, 2));
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(nan_cd, 2));
+    EXPECT_FALSE(DragModelLookup::setCustomCurve(too_many, BCE_CUSTOM_DRAG_MAX_POINTS + 1));
+    EXPECT_TRUE(DragModelLookup::setCustomCurve(too_many, BCE_CUSTOM_DRAG_MAX_POINTS));
+
+    ASSERT_TRUE(DragModelLookup::setCustomCurve(good, 3));
+    EXPECT_EQ(DragModelLookup::getCustomCurveId(), id);
+    EXPECT_FLOAT_EQ(DragModelLookup::getCd(DragModel::CUSTOM, 1.0f), 0.4f);
+
+    // Without a curve CUSTOM falls back to G1
+    DragModelLookup::clearCustomCurve();
+    EXPECT_EQ(DragModelLookup::getCustomCurveId(), 0u);
+    EXPECT_EQ(DragModelLookup::getCd(DragModel::CUSTOM, 1.3f),
+              DragModelLookup::getCd(DragModel::G1, 1.3f));
+}
+
+// A banded context switches coefficient at each threshold, in either
+// direction, and drops bands from the first invalid one on
+TEST(DragTest, BandedContextFollowsVelocity) {
+    DragContext ctx = DragModelLookup::makeContext(DragModel::G1, 340.0f, 0.5f, 1.225f);
+    const float primary = ctx.coefficient;
+    const float velocity[] = {700.0f, 500.0f, 600.0f};  // third is not descending
+    const float ratio[] = {0.8f, 0.5f, 0.25f};
+    DragModelLookup::setBands(ctx, velocity, ratio, 3);
+    ASSERT_EQ(ctx.band_count, 2);
+
+    auto coefficientAt = [&](float v) {
+        float decel = DragModelLookup::getBandedDeceleration(ctx, v);
+        return decel / (DragModelLookup::lookupCd(ctx.curve, v * ctx.inv_speed_of_sound) * v * v);
+    };
+    for (float v : {900.0f, 650.0f, 300.0f, 700.0f, 699.0f, 100.0f, 500.0f, 800.0f}) {
+        float expected = primary;
+        if (v < 700.0f) expected = primary / 0.8f;
+        if (v < 500.0f) expected = primary / 0.5f;
+        EXPECT_NEAR(coefficientAt(v), expected, 1e-6f * expected) << v;
+    }
+
+    // Without bands the context never leaves the primary coefficient
+    DragContext plain = DragModelLookup::makeContext(DragModel::G1, 340.0f, 0.5f, 1.225f);
+    EXPECT_EQ(DragModelLookup::getBandedDeceleration(plain, 250.0f),
+              DragModelLookup::getDeceleration(plain, 250.0f));
+    EXPECT_EQ(plain.band, 0);
+}
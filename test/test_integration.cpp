@@ -8,9 +8,13 @@
 #include <gtest/gtest.h>
 #include "bce/bce_api.h"
 #include "bce/bce_config.h"
+#include "../lib/bce/src/drag/drag_model.h"
 #include <cmath>
 #include <cstring>
+#include <atomic>
+#include <initializer_list>
 #include <limits>
+#include <thread>
 
 namespace {
 constexpr float kMoaPerMil = 3.43774677f;
@@ -832,6 +836,12 @@ TEST_F(IntegrationTest, AtmosphericDeltaTriggersZeroRecompute) {
 
     // If zero is recomputed for the new atmosphere, hold at zero range should remain near zero.
     EXPECT_LT(std::fabs(after.hold_elevation_moa), 0.75f);
+
+    // The recompute warm-starts from the previous zero
+    BCE_SolverDiagnostics diag = {};
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_GE(diag.zero_iterations, 1u);
+    EXPECT_LE(diag.zero_iterations, 4u);
 }
 
 // .308 Win 168gr @ 2650 fps benchmark envelope at 600m and 800m
@@ -932,3 +942,2087 @@ TEST_F(IntegrationTest, ExternalReferenceModeReducesDropAndTof) {
     EXPECT_LT(external_mode.tof_ms, legacy.tof_ms);
     EXPECT_GT(external_mode.velocity_at_target_ms, legacy.velocity_at_target_ms);
 }
+
+// Steady inputs should be answered from the solution cache after the first solve
+TEST_F(IntegrationTest, SteadyInputsHitSolutionCache) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    for (int i = 0; i < 100; ++i) {
+        SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+        f.lrf_valid = true;
+        f.lrf_range_m = 500.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    }
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    BCE_SolverDiagnostics diag = {};
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_GE(diag.solution_cache_misses, 1u);
+    EXPECT_GT(diag.solution_cache_hits, diag.solution_cache_misses);
+
+    FiringSolution cached;
+    BCE_GetSolution(&cached);
+
+    // A range-only change within the automatic margin is answered from the
+    // trajectory table
+    SensorFrame f = makeDefaultFrame(101 * 10000);
+    f.lrf_valid = true;
+    f.lrf_range_m = 500.0f + 0.5f * BCE_TRAJ_HORIZON_MARGIN_M;
+    f.lrf_timestamp_us = f.timestamp_us;
+    BCE_Update(&f);
+
+    BCE_SolverDiagnostics after = {};
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_EQ(after.solution_cache_misses, diag.solution_cache_misses);
+    EXPECT_EQ(after.trajectory_table_hits, diag.trajectory_table_hits + 1);
+
+    FiringSolution moved;
+    BCE_GetSolution(&moved);
+    EXPECT_GT(moved.tof_ms, cached.tof_ms);
+
+    // Re-init resets counters
+    BCE_Init();
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_EQ(after.solution_cache_hits, 0u);
+    EXPECT_EQ(after.solution_cache_misses, 0u);
+    EXPECT_EQ(after.trajectory_table_hits, 0u);
+}
+
+// Range sweeps reuse one integration; a shorter horizon forces re-integration
+TEST_F(IntegrationTest, RangeSweepReusesTrajectoryTable) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetTrajectoryHorizon(1000.0f);
+
+    uint64_t t = 0;
+    auto feed = [&](float range_m) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = range_m;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    };
+
+    for (int i = 0; i < 100; ++i) feed(300.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    BCE_SolverDiagnostics before = {};
+    BCE_GetSolverDiagnostics(&before);
+
+    FiringSolution prev;
+    BCE_GetSolution(&prev);
+    for (int i = 1; i <= 20; ++i) {
+        feed(300.0f + 25.0f * i);
+        FiringSolution sol;
+        BCE_GetSolution(&sol);
+        EXPECT_GT(sol.tof_ms, prev.tof_ms);
+        prev = sol;
+    }
+
+    BCE_SolverDiagnostics after = {};
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_EQ(after.solution_cache_misses, before.solution_cache_misses);
+    EXPECT_EQ(after.trajectory_table_hits, before.trajectory_table_hits + 20);
+
+    // Ranges past the tabulated horizon extend the trajectory once
+    for (int i = 0; i < 200; ++i) feed(1500.0f);
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_EQ(after.solution_cache_misses, before.solution_cache_misses + 1);
+}
+
+// The automatic horizon integrates to about the target while IMU noise moves
+// the pitch, and widens once range-only changes run past the table
+TEST_F(IntegrationTest, AutomaticHorizonTracksTarget) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto feed = [&](float range_m, float accel_x) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.accel_x = accel_x;
+        f.lrf_valid = true;
+        f.lrf_range_m = range_m;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    };
+
+    for (int i = 0; i < 100; ++i) feed(500.0f, 0.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    BCE_SolverDiagnostics before = {};
+    BCE_GetSolverDiagnostics(&before);
+    for (int i = 0; i < 32; ++i) feed(500.0f, (i & 1) ? 0.02f : -0.02f);
+
+    BCE_SolverDiagnostics after = {};
+    BCE_GetSolverDiagnostics(&after);
+    ASSERT_GT(after.solution_cache_misses, before.solution_cache_misses);
+    EXPECT_GE(after.trajectory_extent_m, 500u);
+    EXPECT_LE(after.trajectory_extent_m, static_cast<uint32_t>(500.0f + BCE_TRAJ_HORIZON_MARGIN_M));
+
+    // Each range-only overrun doubles the margin, so a climbing LRF reading
+    // re-integrates ever less often
+    for (int i = 0; i < 100; ++i) feed(500.0f, 0.0f);
+    BCE_GetSolverDiagnostics(&before);
+    for (int i = 1; i <= 40; ++i) feed(500.0f + 25.0f * i, 0.0f);
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_LE(after.solution_cache_misses, before.solution_cache_misses + 4);
+    EXPECT_GT(after.trajectory_extent_m, static_cast<uint32_t>(1500.0f + BCE_TRAJ_HORIZON_MARGIN_M));
+
+    // An explicit horizon restores fixed tabulation
+    BCE_SetTrajectoryHorizon(1000.0f);
+    for (int i = 0; i < 8; ++i) feed(500.0f, (i & 1) ? 0.02f : -0.02f);
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_EQ(after.trajectory_extent_m, 1000u);
+}
+
+// A per-engine range limit rejects ranges and zeros past it and bounds the table
+TEST_F(IntegrationTest, MaxRangeBoundsRangesZeroAndTable) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetMaxRange(800.0f);
+
+    uint64_t t = 0;
+    auto feed = [&](float range_m) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = range_m;
+        f.lrf_timestamp_us = t;
+        BCE_Update(&f);
+    };
+
+    // Readings past the limit are rejected like any out-of-range reading
+    for (int i = 0; i < 100; ++i) feed(1200.0f);
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::FAULT);
+    EXPECT_NE(BCE_GetFaultFlags() & BCE_Fault::NO_RANGE, 0u);
+
+    for (int i = 0; i < 100; ++i) feed(790.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+#if !BCE_TRAJ_TABLE_COMPACT
+    int count = 0;
+    ASSERT_TRUE(BCE_GetTrajectoryView(nullptr, &count, nullptr));
+    EXPECT_EQ(count, 800 / BCE_TRAJ_TABLE_STRIDE_M + 1);
+#endif
+
+    float ranges[2] = {600.0f, 900.0f};
+    FiringSolution table[2];
+    EXPECT_EQ(BCE_ComputeHoldTable(ranges, 2, table), 1);
+    EXPECT_EQ(table[0].solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    EXPECT_EQ(table[1].solution_mode, static_cast<uint32_t>(BCE_Mode::FAULT));
+
+    // A zero past the limit cannot be solved
+    zero.zero_range_m = 900.0f;
+    BCE_SetZeroConfig(&zero);
+    feed(790.0f);
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::FAULT);
+    EXPECT_NE(BCE_GetFaultFlags() & BCE_Fault::ZERO_UNSOLVABLE, 0u);
+    zero.zero_range_m = 100.0f;
+    BCE_SetZeroConfig(&zero);
+
+    // Values < 1 m restore BCE_MAX_RANGE_M, as does BCE_Init
+    BCE_SetMaxRange(0.0f);
+    for (int i = 0; i < 200; ++i) feed(1200.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution sol;
+    BCE_GetSolution(&sol);
+    EXPECT_GT(sol.range_m, 1000.0f);
+
+    BCE_Init();
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetZeroConfig(&zero);
+    for (int i = 0; i < 100; ++i) feed(1200.0f);
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+}
+
+// Target motion leads the holds from the stored table, without re-solving
+TEST_F(IntegrationTest, TargetMotionLeadsFromTrajectoryTable) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto feed = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 500.0f;
+            f.lrf_timestamp_us = t;
+            BCE_Update(&f);
+        }
+    };
+
+    feed(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution still;
+    BCE_GetSolution(&still);
+    EXPECT_FLOAT_EQ(still.lead_elevation_moa, 0.0f);
+    EXPECT_FLOAT_EQ(still.lead_windage_moa, 0.0f);
+    EXPECT_FLOAT_EQ(still.lead_range_m, still.range_m);
+    BCE_SolverDiagnostics before;
+    BCE_GetSolverDiagnostics(&before);
+
+    // Crossing left to right at 5 m/s: hold right by about the distance the
+    // target covers during flight
+    const float speed = 5.0f;
+    BCE_SetTargetMotion(speed, still.heading_deg_true + 90.0f);
+    feed(5);
+    FiringSolution crossing;
+    BCE_GetSolution(&crossing);
+    const float tof_s = still.tof_ms * 0.001f;
+    const float expected_moa = std::atan(speed * tof_s / still.range_m) * BCE_RAD_TO_MOA;
+    EXPECT_GT(crossing.lead_windage_moa, 0.0f);
+    EXPECT_NEAR(crossing.lead_windage_moa, expected_moa, 0.05f * expected_moa);
+    EXPECT_NEAR(crossing.hold_windage_moa - still.hold_windage_moa, crossing.lead_windage_moa, 0.01f);
+    EXPECT_NEAR(crossing.lead_range_m, still.range_m, 0.01f);
+
+    BCE_SetTargetMotion(speed, still.heading_deg_true - 90.0f);
+    feed(5);
+    FiringSolution left;
+    BCE_GetSolution(&left);
+    EXPECT_NEAR(left.lead_windage_moa, -crossing.lead_windage_moa, 0.01f);
+
+    // Receding: the bullet meets the target farther out, so it needs more
+    // elevation, and the TOF fixed point settles in a few iterations
+    BCE_SetTargetMotion(speed, still.heading_deg_true);
+    feed(5);
+    FiringSolution receding;
+    BCE_GetSolution(&receding);
+    EXPECT_GT(receding.lead_elevation_moa, 0.0f);
+    EXPECT_NEAR(receding.hold_elevation_moa - still.hold_elevation_moa, receding.lead_elevation_moa, 0.01f);
+    EXPECT_GT(receding.lead_range_m, still.range_m + speed * tof_s);
+    EXPECT_LT(receding.lead_range_m, still.range_m + 1.5f * speed * tof_s);
+    EXPECT_NEAR(receding.lead_windage_moa, 0.0f, 0.05f);
+
+    EXPECT_EQ(receding.defaults_active & BCE_Diag::LEAD_UNRESOLVED, 0u);
+
+    BCE_SolverDiagnostics after;
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_EQ(after.solution_cache_misses, before.solution_cache_misses);
+    EXPECT_GE(after.lead_iterations, 1u);
+    EXPECT_LE(after.lead_iterations, BCE_LEAD_MAX_ITERATIONS);
+
+    // Non-finite input and BCE_Init both mean stationary
+    BCE_SetTargetMotion(NAN, 0.0f);
+    feed(5);
+    FiringSolution cleared;
+    BCE_GetSolution(&cleared);
+    EXPECT_FLOAT_EQ(cleared.lead_windage_moa, 0.0f);
+    EXPECT_FLOAT_EQ(cleared.lead_range_m, cleared.range_m);
+
+    BCE_SetTargetMotion(speed, still.heading_deg_true + 90.0f);
+    BCE_Init();
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetZeroConfig(&zero);
+    feed(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    BCE_GetSolution(&cleared);
+    EXPECT_FLOAT_EQ(cleared.lead_windage_moa, 0.0f);
+}
+
+// A lead past the tabulated extent, or one whose TOF never settles, is flagged
+TEST_F(IntegrationTest, TargetMotionFlagsUnresolvedLead) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+
+    uint64_t t = 0;
+    auto feed = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 500.0f;
+            f.lrf_timestamp_us = t;
+            BCE_Update(&f);
+        }
+    };
+    auto boot = [&](float horizon_m) {
+        BCE_Init();
+        BCE_SetBulletProfile(&bullet);
+        BCE_SetZeroConfig(&zero);
+        BCE_SetTrajectoryHorizon(horizon_m);
+        t = 0;
+        feed(100);
+    };
+
+    // The table ends at the target, so a receding target's impact point is
+    // clamped to it
+    boot(500.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution still;
+    BCE_GetSolution(&still);
+    EXPECT_EQ(still.defaults_active & BCE_Diag::LEAD_UNRESOLVED, 0u);
+    BCE_SetTargetMotion(10.0f, still.heading_deg_true);
+    feed(5);
+    FiringSolution clamped;
+    BCE_GetSolution(&clamped);
+    EXPECT_NE(clamped.defaults_active & BCE_Diag::LEAD_UNRESOLVED, 0u);
+    EXPECT_LE(clamped.lead_range_m, 500.0f);
+
+    // At a good fraction of the bullet's speed the fixed point contracts too
+    // slowly to settle within BCE_LEAD_MAX_ITERATIONS, even with room in the
+    // table
+    boot(BCE_MAX_RANGE_M);
+    BCE_SetTargetMotion(200.0f, still.heading_deg_true);
+    feed(5);
+    FiringSolution fast;
+    BCE_GetSolution(&fast);
+    BCE_SolverDiagnostics diag;
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_EQ(diag.lead_iterations, BCE_LEAD_MAX_ITERATIONS);
+    EXPECT_NE(fast.defaults_active & BCE_Diag::LEAD_UNRESOLVED, 0u);
+    EXPECT_GT(fast.lead_range_m, 500.0f);
+    EXPECT_LT(fast.lead_range_m, static_cast<float>(BCE_MAX_RANGE_M));
+
+    // Stationary again: nothing to flag
+    BCE_SetTargetMotion(0.0f, 0.0f);
+    feed(5);
+    BCE_GetSolution(&still);
+    EXPECT_EQ(still.defaults_active & BCE_Diag::LEAD_UNRESOLVED, 0u);
+}
+
+// The streaming magnetometer fit runs off the update path and commits in one swap
+TEST_F(IntegrationTest, StreamingMagCalibrationCommitsFittedIron) {
+    const float distortion[9] = {1.15f, 0.08f, 0.00f,
+                                 0.08f, 0.92f, 0.00f,
+                                 0.00f, 0.00f, 1.00f};
+    const float offset[3] = {25.0f, -10.0f, 15.0f};
+    uint64_t t = 0;
+    auto feed = [&](int n) {
+        for (int j = 0; j < n; ++j) {
+            // Interleaved directions over the sphere, 45 µT field
+            const int i = (j * 7) % n;
+            const float z = 1.0f - 2.0f * (i + 0.5f) / n;
+            const float r = std::sqrt(1.0f - z * z);
+            const float b[3] = {45.0f * r * std::cos(2.39996323f * i),
+                                45.0f * r * std::sin(2.39996323f * i), 45.0f * z};
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.mag_x = distortion[0] * b[0] + distortion[1] * b[1] + distortion[2] * b[2] + offset[0];
+            f.mag_y = distortion[3] * b[0] + distortion[4] * b[1] + distortion[5] * b[2] + offset[1];
+            f.mag_z = distortion[6] * b[0] + distortion[7] * b[1] + distortion[8] * b[2] + offset[2];
+            f.mag_valid = true;
+            BCE_Update(&f);
+        }
+    };
+
+    // Nothing is fitted or committed until a fit is started
+    feed(50);
+    BCE_MagCalStatus status;
+    BCE_GetMagCalibrationStatus(&status);
+    EXPECT_FALSE(status.collecting);
+    EXPECT_EQ(status.samples, 0u);
+    EXPECT_FLOAT_EQ(status.soft_iron[0], 1.0f);
+    EXPECT_FALSE(BCE_CommitMagCalibration());
+
+    BCE_StartMagCalibration();
+    feed(60);
+    BCE_GetMagCalibrationStatus(&status);
+    EXPECT_TRUE(status.collecting);
+    EXPECT_FALSE(status.ready);
+    EXPECT_FALSE(BCE_CommitMagCalibration());
+
+    BCE_StartMagCalibration();
+    feed(400);
+    BCE_GetMagCalibrationStatus(&status);
+    EXPECT_EQ(status.samples, 400u);
+    EXPECT_GE(status.coverage, BCE_MAG_CAL_MIN_COVERAGE);
+    ASSERT_TRUE(status.ready);
+    for (int k = 0; k < 3; ++k) EXPECT_NEAR(status.hard_iron[k], offset[k], 0.5f);
+
+    ASSERT_TRUE(BCE_CommitMagCalibration());
+    BCE_MagCalStatus committed;
+    BCE_GetMagCalibrationStatus(&committed);
+    EXPECT_FALSE(committed.collecting);
+
+    // Fitting has stopped; the committed calibration stays until Init
+    feed(20);
+    BCE_GetMagCalibrationStatus(&committed);
+    EXPECT_EQ(committed.samples, 400u);
+
+    BCE_Init();
+    BCE_GetMagCalibrationStatus(&committed);
+    EXPECT_FALSE(committed.collecting);
+    EXPECT_EQ(committed.samples, 0u);
+    EXPECT_FLOAT_EQ(committed.hard_iron[0], 0.0f);
+}
+
+// The memory report splits the instance size by subsystem
+TEST_F(IntegrationTest, MemoryReportAccountsForInstance) {
+    BCE_MemoryReport m;
+    std::memset(&m, 0xFF, sizeof(m));
+    BCE_GetMemoryReport(&m);
+    BCE_GetMemoryReport(nullptr);
+
+    EXPECT_EQ(m.instance_bytes, BCE_InstanceSize());
+    EXPECT_EQ(m.max_range_m, static_cast<uint32_t>(BCE_MAX_RANGE_M));
+    EXPECT_EQ(m.trajectory_table_bytes + m.solver_bytes + m.angle_cache_bytes + m.ahrs_bytes +
+                  m.sensor_bytes + m.dispersion_bytes + m.recorder_bytes + m.engine_bytes,
+              m.instance_bytes);
+#if BCE_TRAJ_TABLE_COMPACT
+    EXPECT_GE(m.trajectory_table_bytes, BCE_TRAJ_TABLE_SIZE * 8u);
+#else
+    EXPECT_EQ(m.trajectory_table_bytes, BCE_TRAJ_TABLE_SIZE * sizeof(TrajectoryPoint));
+#endif
+    EXPECT_GE(m.angle_cache_bytes,
+              BCE_ANGLE_CACHE_SLOTS * BCE_ANGLE_CACHE_TABLE_SIZE * sizeof(TrajectoryPoint));
+    EXPECT_GE(m.recorder_bytes, static_cast<uint32_t>(BCE_RECORDER_BUFFER_BYTES));
+    EXPECT_GT(m.ahrs_bytes, 0u);
+    EXPECT_GT(m.engine_bytes, sizeof(FiringSolution));
+    EXPECT_GE(m.shared_bytes, BCE_CUSTOM_DRAG_MAX_POINTS * sizeof(DragPoint));
+}
+
+// A holdover table matches per-range live solutions and integrates once
+TEST_F(IntegrationTest, HoldTableMatchesLiveSolutions) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetLatitude(45.0f);
+
+    uint64_t t = 0;
+    auto feed = [&](float range_m) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = range_m;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    };
+    for (int i = 0; i < 100; ++i) feed(300.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    const float ranges[] = {100.0f, 250.0f, 475.0f, 800.0f, 1200.0f, 0.0f};
+    const int n = static_cast<int>(sizeof(ranges) / sizeof(ranges[0]));
+    FiringSolution table[n];
+
+    BCE_SolverDiagnostics before = {};
+    BCE_GetSolverDiagnostics(&before);
+    EXPECT_EQ(BCE_ComputeHoldTable(ranges, n, table), n - 1);
+    BCE_SolverDiagnostics after = {};
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_LE(after.solution_cache_misses, before.solution_cache_misses + 1);
+
+    EXPECT_EQ(table[n - 1].solution_mode, static_cast<uint32_t>(BCE_Mode::FAULT));
+    EXPECT_NE(table[n - 1].fault_flags & BCE_Fault::NO_RANGE, 0u);
+
+    // The live solve samples the filtered LRF range, so allow for the few
+    // centimeters it has not yet settled by
+    for (int i = 0; i < n - 1; ++i) {
+        for (int k = 0; k < 100; ++k) feed(ranges[i]);
+        FiringSolution live;
+        BCE_GetSolution(&live);
+        ASSERT_EQ(table[i].solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+        EXPECT_FLOAT_EQ(table[i].range_m, ranges[i]);
+        EXPECT_NEAR(table[i].hold_elevation_moa, live.hold_elevation_moa, 0.01f) << ranges[i];
+        EXPECT_NEAR(table[i].hold_windage_moa, live.hold_windage_moa, 0.01f) << ranges[i];
+        EXPECT_NEAR(table[i].tof_ms, live.tof_ms, 0.5f) << ranges[i];
+        EXPECT_NEAR(table[i].coriolis_elevation_moa, live.coriolis_elevation_moa, 0.001f);
+        EXPECT_NEAR(table[i].spin_drift_moa, live.spin_drift_moa, 0.001f);
+    }
+}
+
+// Without a bullet every hold table entry reports the fault
+TEST_F(IntegrationTest, HoldTableReportsFaults) {
+    const float ranges[] = {100.0f, 500.0f};
+    FiringSolution table[2];
+    EXPECT_EQ(BCE_ComputeHoldTable(ranges, 2, table), 0);
+    for (const FiringSolution& entry : table) {
+        EXPECT_EQ(entry.solution_mode, static_cast<uint32_t>(BCE_Mode::FAULT));
+        EXPECT_NE(entry.fault_flags & BCE_Fault::NO_BULLET, 0u);
+    }
+    EXPECT_EQ(BCE_ComputeHoldTable(nullptr, 2, table), 0);
+}
+
+// Instances created in caller storage are independent of each other and of
+// the default instance behind the legacy API
+TEST_F(IntegrationTest, HandleInstancesAreIndependent) {
+    alignas(16) static unsigned char storage_a[128 * 1024];
+    alignas(16) static unsigned char storage_b[128 * 1024];
+    ASSERT_LE(BCE_InstanceSize(), sizeof(storage_a));
+    ASSERT_LE(BCE_InstanceAlign(), 16u);
+
+    EXPECT_EQ(BCE_Create(storage_a, BCE_InstanceSize() - 1), nullptr);
+    EXPECT_EQ(BCE_Create(nullptr, sizeof(storage_a)), nullptr);
+
+    BCE_Handle a = BCE_Create(storage_a, sizeof(storage_a));
+    BCE_Handle b = BCE_Create(storage_b, sizeof(storage_b));
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_NE(a, BCE_GetDefaultHandle());
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+
+    BCE_SetBulletProfileH(a, &bullet);
+    BCE_SetZeroConfigH(a, &zero);
+    BCE_SetBulletProfileH(b, &bullet);
+    BCE_SetZeroConfigH(b, &zero);
+    BCE_SetWindManualH(b, 5.0f, 90.0f);
+
+    uint64_t t = 0;
+    for (int i = 0; i < 100; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = 500.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_UpdateH(a, &f);
+        BCE_UpdateH(b, &f);
+    }
+
+    ASSERT_EQ(BCE_GetModeH(a), BCE_Mode::SOLUTION_READY);
+    ASSERT_EQ(BCE_GetModeH(b), BCE_Mode::SOLUTION_READY);
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::IDLE);
+
+    FiringSolution sa, sb;
+    BCE_GetSolutionH(a, &sa);
+    BCE_GetSolutionH(b, &sb);
+    EXPECT_NEAR(sa.hold_elevation_moa, sb.hold_elevation_moa, 1e-4f);
+    EXPECT_GT(std::fabs(sb.hold_windage_moa - sa.hold_windage_moa), 1.0f);
+
+    // The default handle aliases the legacy API
+    EXPECT_EQ(BCE_GetModeH(BCE_GetDefaultHandle()), BCE_GetMode());
+    EXPECT_EQ(BCE_GetModeH(nullptr), BCE_Mode::IDLE);
+
+    BCE_Destroy(a);
+    BCE_Destroy(b);
+}
+
+// Monte Carlo dispersion streams statistics that refine with more samples
+TEST_F(IntegrationTest, DispersionStreamsImpactStatistics) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetWindManual(3.0f, 90.0f);
+
+    uint64_t t = 0;
+    for (int i = 0; i < 100; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = 600.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    }
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    // Zero sigmas: every sample lands on the point of aim
+    BCE_UncertaintyConfig cfg = {};
+    cfg.target_radius_m = 0.15f;
+    BCE_SetUncertainty(&cfg);
+    EXPECT_EQ(BCE_RunDispersion(16), 16u);
+    BCE_DispersionStats stats;
+    BCE_GetDispersion(&stats);
+    EXPECT_NEAR(stats.mean_elevation_moa, 0.0f, 1e-3f);
+    EXPECT_NEAR(stats.sigma_windage_moa, 0.0f, 1e-3f);
+    EXPECT_FLOAT_EQ(stats.hit_probability, 1.0f);
+    EXPECT_NEAR(stats.target_radius_moa, (0.15f / 600.0f) * BCE_RAD_TO_MOA, 1e-3f);
+
+    // MV spread is mostly vertical, wind speed spread mostly horizontal
+    cfg.mv_sigma_ms = 5.0f;
+    cfg.seed = 7;
+    BCE_SetUncertainty(&cfg);
+    BCE_RunDispersion(64);
+    BCE_GetDispersion(&stats);
+    EXPECT_EQ(stats.sample_count, 64u);
+    EXPECT_GT(stats.sigma_elevation_moa, 0.1f);
+    EXPECT_LT(stats.sigma_windage_moa, stats.sigma_elevation_moa);
+
+    cfg.mv_sigma_ms = 0.0f;
+    cfg.wind_speed_sigma_ms = 1.5f;
+    BCE_SetUncertainty(&cfg);
+    BCE_RunDispersion(64);
+    BCE_GetDispersion(&stats);
+    EXPECT_GT(stats.sigma_windage_moa, 0.2f);
+    EXPECT_GT(stats.sigma_windage_moa, stats.sigma_elevation_moa);
+    EXPECT_NEAR(stats.ellipse_major_moa, stats.sigma_windage_moa, 0.1f);
+    EXPECT_GT(stats.hit_probability, 0.0f);
+    EXPECT_LT(stats.hit_probability, 1.0f);
+
+    // Incremental calls keep accumulating for an unchanged solution, and
+    // through hand-held pitch noise that re-keys the solution cache ...
+    EXPECT_EQ(BCE_RunDispersion(10), 74u);
+    BCE_SolverDiagnostics before = {};
+    BCE_GetSolverDiagnostics(&before);
+    for (int i = 0; i < 8; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.accel_x = (i & 1) ? 0.005f : -0.005f;
+        f.lrf_valid = true;
+        f.lrf_range_m = 600.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+        BCE_RunDispersion(2);
+    }
+    BCE_SolverDiagnostics after = {};
+    BCE_GetSolverDiagnostics(&after);
+    EXPECT_GT(after.solution_cache_misses, before.solution_cache_misses);
+    EXPECT_EQ(BCE_RunDispersion(10), 100u);
+
+    // ... and restart once the nominal inputs move
+    for (int i = 0; i < 50; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = 800.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    }
+    EXPECT_EQ(BCE_RunDispersion(8), 8u);
+}
+
+// Without a solution no samples are drawn
+TEST_F(IntegrationTest, DispersionRequiresSolution) {
+    BCE_UncertaintyConfig cfg = {};
+    cfg.mv_sigma_ms = 5.0f;
+    BCE_SetUncertainty(&cfg);
+    EXPECT_EQ(BCE_RunDispersion(32), 0u);
+    BCE_DispersionStats stats;
+    BCE_GetDispersion(&stats);
+    EXPECT_EQ(stats.sample_count, 0u);
+}
+
+// Hold sensitivities agree with differenced holds: range through the hold
+// table, crosswind through the manual wind (blowing straight across)
+TEST_F(IntegrationTest, SensitivityMatchesDifferencedHolds) {
+    BCE_Sensitivity sens;
+    EXPECT_FALSE(BCE_GetSensitivity(&sens));
+    EXPECT_EQ(sens.range.elevation_moa, 0.0f);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto settle = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 700.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+    auto windage = [&](float speed_ms) {
+        BCE_SetWindManual(speed_ms, 90.0f);
+        settle(2);
+        FiringSolution sol;
+        BCE_GetSolution(&sol);
+        return sol.hold_windage_moa;
+    };
+
+    BCE_SetWindManual(3.0f, 90.0f);
+    settle(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    ASSERT_TRUE(BCE_GetSensitivity(&sens));
+
+    const float ranges[2] = {695.0f, 705.0f};
+    FiringSolution table[2];
+    ASSERT_EQ(BCE_ComputeHoldTable(ranges, 2, table), 2);
+    float fd_elev = (table[1].hold_elevation_moa - table[0].hold_elevation_moa) / 10.0f;
+    float fd_wind = (table[1].hold_windage_moa - table[0].hold_windage_moa) / 10.0f;
+    float fd_tof = (table[1].tof_ms - table[0].tof_ms) / 10.0f;
+    EXPECT_NEAR(sens.range.elevation_moa, fd_elev, 0.03f * std::fabs(fd_elev) + 1e-3f);
+    EXPECT_NEAR(sens.range.windage_moa, fd_wind, 0.03f * std::fabs(fd_wind) + 1e-3f);
+    EXPECT_NEAR(sens.range.tof_ms, fd_tof, 0.03f * std::fabs(fd_tof));
+
+    float fd_cross = (windage(3.5f) - windage(2.5f)) / 1.0f;
+    EXPECT_NEAR(sens.crosswind.windage_moa, fd_cross, 0.03f * std::fabs(fd_cross));
+    EXPECT_NEAR(sens.crosswind.elevation_moa, 0.0f, 0.01f);
+
+    // Faster or slicker bullets drop less, so need less elevation
+    EXPECT_LT(sens.muzzle_velocity.elevation_moa, 0.0f);
+    EXPECT_LT(sens.bc.elevation_moa, 0.0f);
+    EXPECT_GT(sens.range.elevation_moa, 0.0f);
+}
+
+// Switching to the Dormand–Prince or range-domain integrator keeps holds
+// consistent
+TEST_F(IntegrationTest, DormandPrinceIntegratorMatchesDefault) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 700.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution rk4;
+    BCE_GetSolution(&rk4);
+
+    BCE_SetIntegrator(IntegratorMethod::DORMAND_PRINCE, 0.0f);
+    run(5);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution dp;
+    BCE_GetSolution(&dp);
+
+    EXPECT_NEAR(dp.hold_elevation_moa, rk4.hold_elevation_moa, 0.05f);
+    EXPECT_NEAR(dp.hold_windage_moa, rk4.hold_windage_moa, 0.05f);
+    EXPECT_NEAR(dp.tof_ms, rk4.tof_ms, 2.0f);
+
+    BCE_SetIntegrator(IntegratorMethod::RK4_RANGE, 0.0f);
+    run(5);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution range_domain;
+    BCE_GetSolution(&range_domain);
+    EXPECT_NEAR(range_domain.hold_elevation_moa, dp.hold_elevation_moa, 0.01f);
+    EXPECT_NEAR(range_domain.hold_windage_moa, dp.hold_windage_moa, 0.01f);
+    EXPECT_NEAR(range_domain.tof_ms, dp.tof_ms, 0.1f);
+}
+
+// A custom drag curve drives the solution, and reloading it with different
+// data re-zeros and invalidates the cached solution
+TEST_F(IntegrationTest, CustomDragCurveReZerosOnChange) {
+    DragPoint curve[] = {
+        {0.00f, 0.120f}, {0.80f, 0.125f}, {0.95f, 0.180f}, {1.05f, 0.390f},
+        {1.20f, 0.400f}, {1.60f, 0.350f}, {2.20f, 0.300f}, {3.00f, 0.260f},
+    };
+    const int n = static_cast<int>(sizeof(curve) / sizeof(curve[0]));
+    ASSERT_TRUE(BCE_SetCustomDragCurve(curve, n));
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.25f;
+    bullet.drag_model = DragModel::CUSTOM;
+    bullet.muzzle_velocity_ms = 800.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 800.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution base;
+    BCE_GetSolution(&base);
+
+    for (DragPoint& p : curve) p.cd *= 1.1f;
+    ASSERT_TRUE(BCE_SetCustomDragCurve(curve, n));
+    run(5);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    BCE_SolverDiagnostics diag;
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_GT(diag.zero_iterations, 0u);
+    FiringSolution draggier;
+    BCE_GetSolution(&draggier);
+    EXPECT_GT(draggier.hold_elevation_moa, base.hold_elevation_moa + 1.0f);
+    EXPECT_GT(draggier.tof_ms, base.tof_ms);
+
+    // Rejected points leave the loaded curve, and the solution, unchanged
+    curve[3].mach = curve[2].mach;
+    EXPECT_FALSE(BCE_SetCustomDragCurve(curve, n));
+    run(5);
+    FiringSolution kept;
+    BCE_GetSolution(&kept);
+    EXPECT_FLOAT_EQ(kept.hold_elevation_moa, draggier.hold_elevation_moa);
+
+    DragModelLookup::clearCustomCurve();
+}
+
+// The curve is process-wide, so no instance may be solving split while it loads
+TEST_F(IntegrationTest, CustomDragCurveRefusedWhileSplit) {
+    const DragPoint curve[] = {
+        {0.00f, 0.120f}, {0.80f, 0.125f}, {0.95f, 0.180f}, {1.05f, 0.390f},
+        {1.20f, 0.400f}, {1.60f, 0.350f}, {2.20f, 0.300f}, {3.00f, 0.260f},
+    };
+    const int n = static_cast<int>(sizeof(curve) / sizeof(curve[0]));
+
+    BCE_SetSplitPipelineMode(true);
+    EXPECT_FALSE(BCE_SetCustomDragCurve(curve, n));
+    EXPECT_EQ(DragModelLookup::getCustomCurveId(), 0u);
+    BCE_SetSplitPipelineMode(false);
+
+    // Another instance running split blocks the load just the same
+    alignas(16) static unsigned char storage[128 * 1024];
+    ASSERT_LE(BCE_InstanceSize(), sizeof(storage));
+    BCE_Handle h = BCE_Create(storage, sizeof(storage));
+    ASSERT_NE(h, nullptr);
+    BCE_SetSplitPipelineModeH(h, true);
+    EXPECT_FALSE(BCE_SetCustomDragCurve(curve, n));
+    BCE_Destroy(h);
+
+    EXPECT_TRUE(BCE_SetCustomDragCurve(curve, n));
+    EXPECT_NE(DragModelLookup::getCustomCurveId(), 0u);
+
+    DragModelLookup::clearCustomCurve();
+}
+
+// CUSTOM without a loaded curve faults rather than quietly flying G1
+TEST_F(IntegrationTest, CustomDragModelWithoutCurveFaults) {
+    DragModelLookup::clearCustomCurve();
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.25f;
+    bullet.drag_model = DragModel::CUSTOM;
+    bullet.muzzle_velocity_ms = 800.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 500.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+
+    run(100);
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::FAULT);
+    FiringSolution sol;
+    BCE_GetSolution(&sol);
+    EXPECT_TRUE(sol.fault_flags & BCE_Fault::NO_DRAG_CURVE);
+
+    const float ranges[] = {300.0f, 600.0f};
+    FiringSolution table[2];
+    EXPECT_EQ(BCE_ComputeHoldTable(ranges, 2, table), 0);
+    EXPECT_TRUE(table[0].fault_flags & BCE_Fault::NO_DRAG_CURVE);
+
+    // Loading a curve clears the fault
+    const DragPoint curve[] = {{0.0f, 0.12f}, {1.0f, 0.38f}, {3.0f, 0.26f}};
+    ASSERT_TRUE(BCE_SetCustomDragCurve(curve, 3));
+    run(5);
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    EXPECT_EQ(BCE_ComputeHoldTable(ranges, 2, table), 2);
+
+    DragModelLookup::clearCustomCurve();
+}
+
+// Velocity bands below the zero-range velocity leave the zero alone but must
+// still change (not reuse) the cached long-range solution
+TEST_F(IntegrationTest, BCBandsReshapeLongRangeSolution) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            t += 10000;
+            SensorFrame f = makeDefaultFrame(t);
+            f.lrf_valid = true;
+            f.lrf_range_m = 900.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution single;
+    BCE_GetSolution(&single);
+
+    bullet.bc_band_count = 2;
+    bullet.bc_bands[0] = {0.496f, 600.0f};
+    bullet.bc_bands[1] = {0.485f, 450.0f};
+    BCE_SetBulletProfile(&bullet);
+    run(5);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution banded;
+    BCE_GetSolution(&banded);
+
+    EXPECT_GT(banded.hold_elevation_moa, single.hold_elevation_moa + 0.1f);
+    EXPECT_GT(banded.tof_ms, single.tof_ms);
+}
+
+// Perf stats report per-stage effort in profiling builds and zeros otherwise
+TEST_F(IntegrationTest, PerfStatsReflectProfilingBuild) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    BCE_PerfStats first = {};
+    for (int i = 0; i < 100; ++i) {
+        SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+        f.lrf_valid = true;
+        f.lrf_range_m = 600.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+        if (BCE_GetMode() == BCE_Mode::SOLUTION_READY && first.frame_count == 0) {
+            BCE_GetPerfStats(&first);
+        }
+    }
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    BCE_PerfStats steady = {};
+    BCE_GetPerfStats(&steady);
+
+#if BCE_ENABLE_PROFILING
+    EXPECT_EQ(steady.enabled, 1u);
+    EXPECT_GT(steady.tick_hz, 0u);
+    EXPECT_EQ(steady.frame_count, 100u);
+
+    // The first solving frame recomputes the zero and integrates
+    EXPECT_GT(first.zero_iterations, 0u);
+    EXPECT_GT(first.integration_steps, 0u);
+    EXPECT_GE(first.drag_lookups, first.integration_steps);
+    EXPECT_GT(first.stage_ticks[BCE_PerfStage::ZERO], 0u);
+
+    // Steady frames hit the solution cache
+    EXPECT_EQ(steady.zero_iterations, 0u);
+    EXPECT_EQ(steady.integration_steps, 0u);
+    EXPECT_EQ(steady.drag_lookups, 0u);
+    EXPECT_GE(steady.frame_ticks_max, steady.frame_ticks);
+    EXPECT_GE(steady.stage_ticks_max[BCE_PerfStage::ZERO],
+              first.stage_ticks[BCE_PerfStage::ZERO]);
+#else
+    EXPECT_EQ(steady.enabled, 0u);
+    EXPECT_EQ(steady.frame_count, 0u);
+    EXPECT_EQ(steady.frame_ticks_max, 0u);
+#endif
+}
+
+// Split mode — ingestion and solving on separate calls — reproduces the
+// combined pipeline frame for frame, including zero recomputes and LRF loss
+TEST_F(IntegrationTest, SplitPipelineMatchesCombined) {
+    alignas(16) static unsigned char storage_a[128 * 1024];
+    alignas(16) static unsigned char storage_b[128 * 1024];
+    BCE_Handle combined = BCE_Create(storage_a, sizeof(storage_a));
+    BCE_Handle split = BCE_Create(storage_b, sizeof(storage_b));
+    ASSERT_NE(combined, nullptr);
+    ASSERT_NE(split, nullptr);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+
+    BCE_Handle handles[2] = {combined, split};
+    for (BCE_Handle h : handles) {
+        BCE_SetBulletProfileH(h, &bullet);
+        BCE_SetZeroConfigH(h, &zero);
+        BCE_SetWindManualH(h, 4.0f, 270.0f);
+        BCE_SetLatitudeH(h, 45.0f);
+    }
+    BCE_SetSplitPipelineModeH(split, true);
+    EXPECT_FALSE(BCE_ServiceSolverH(split));
+    EXPECT_FALSE(BCE_ServiceSolverH(combined));
+
+    int ready_frames = 0;
+    uint64_t t = 0;
+    for (int i = 0; i < 300; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.gyro_z = 0.02f;
+        f.baro_temperature_c = (i < 150) ? 15.0f : 35.0f; // moves the zero
+        if (i < 250) {
+            f.lrf_valid = true;
+            f.lrf_range_m = 400.0f + static_cast<float>(i);
+            f.lrf_timestamp_us = f.timestamp_us;
+        } else if (i == 250) {
+            f.timestamp_us = t += BCE_LRF_STALE_US + 10000;
+        }
+
+        BCE_UpdateH(combined, &f);
+        BCE_UpdateH(split, &f);
+        ASSERT_TRUE(BCE_ServiceSolverH(split));
+        EXPECT_FALSE(BCE_ServiceSolverH(split));
+
+        FiringSolution a, b;
+        BCE_GetSolutionH(combined, &a);
+        BCE_GetSolutionH(split, &b);
+        ASSERT_EQ(BCE_GetModeH(combined), BCE_GetModeH(split)) << "frame " << i;
+        EXPECT_EQ(BCE_GetDiagFlagsH(combined), BCE_GetDiagFlagsH(split));
+        EXPECT_EQ(a.solution_mode, b.solution_mode);
+        EXPECT_EQ(a.fault_flags, b.fault_flags);
+        EXPECT_EQ(a.defaults_active, b.defaults_active);
+        EXPECT_EQ(a.hold_elevation_moa, b.hold_elevation_moa);
+        EXPECT_EQ(a.hold_windage_moa, b.hold_windage_moa);
+        EXPECT_EQ(a.range_m, b.range_m);
+        EXPECT_EQ(a.tof_ms, b.tof_ms);
+        EXPECT_EQ(a.heading_deg_true, b.heading_deg_true);
+        EXPECT_EQ(a.air_density_kgm3, b.air_density_kgm3);
+        if (a.solution_mode == static_cast<uint32_t>(BCE_Mode::SOLUTION_READY)) ready_frames++;
+    }
+    EXPECT_GT(ready_frames, 100);
+    EXPECT_NE(BCE_GetModeH(split), BCE_Mode::SOLUTION_READY);
+
+    BCE_Destroy(combined);
+    BCE_Destroy(split);
+}
+
+// In split mode BCE_Update never touches the published solution; the solver
+// jumps straight to the newest snapshot
+TEST_F(IntegrationTest, SplitPipelineSolvesLatestSnapshot) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetSplitPipelineMode(true);
+
+    for (int i = 0; i < 100; ++i) {
+        SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+        f.lrf_valid = true;
+        f.lrf_range_m = 500.0f + static_cast<float>(i);
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    }
+
+    FiringSolution sol;
+    BCE_GetSolution(&sol);
+    EXPECT_EQ(sol.solution_mode, static_cast<uint32_t>(BCE_Mode::IDLE));
+    EXPECT_EQ(BCE_GetMode(), BCE_Mode::IDLE);
+
+    EXPECT_TRUE(BCE_ServiceSolver());
+    EXPECT_FALSE(BCE_ServiceSolver());
+    BCE_GetSolution(&sol);
+    EXPECT_EQ(sol.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    EXPECT_FLOAT_EQ(sol.range_m, 599.0f);
+
+    // Leaving split mode returns to solving inside BCE_Update
+    BCE_SetSplitPipelineMode(false);
+    SensorFrame f = makeDefaultFrame(101 * 10000);
+    f.lrf_valid = true;
+    f.lrf_range_m = 650.0f;
+    f.lrf_timestamp_us = f.timestamp_us;
+    BCE_Update(&f);
+    EXPECT_FALSE(BCE_ServiceSolver());
+    BCE_GetSolution(&sol);
+    EXPECT_FLOAT_EQ(sol.range_m, 650.0f);
+}
+
+// Time-sliced solving reaches the same solutions as BCE_ServiceSolver, with
+// the previous solution published as pending in between
+TEST_F(IntegrationTest, StepSolveMatchesServiceSolver) {
+    alignas(16) static unsigned char storage_a[128 * 1024];
+    alignas(16) static unsigned char storage_b[128 * 1024];
+    BCE_Handle whole = BCE_Create(storage_a, sizeof(storage_a));
+    BCE_Handle sliced = BCE_Create(storage_b, sizeof(storage_b));
+    ASSERT_NE(whole, nullptr);
+    ASSERT_NE(sliced, nullptr);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 300.0f;
+    zero.sight_height_mm = 38.1f;
+
+    BCE_Handle handles[2] = {whole, sliced};
+    for (BCE_Handle h : handles) {
+        BCE_SetBulletProfileH(h, &bullet);
+        BCE_SetZeroConfigH(h, &zero);
+        BCE_SetWindManualH(h, 4.0f, 270.0f);
+        BCE_SetTrajectoryHorizonH(h, 800.0f);
+        BCE_SetSplitPipelineModeH(h, true);
+    }
+    EXPECT_FALSE(BCE_StepSolveH(sliced, 0));
+
+    int max_calls = 0;
+    uint64_t t = 0;
+    for (int i = 0; i < 150; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.baro_temperature_c = (i < 110) ? 15.0f : 35.0f; // moves the zero
+        f.lrf_valid = true;
+        f.lrf_range_m = (i < 130) ? 500.0f + static_cast<float>(i) : 1800.0f; // past the horizon
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_UpdateH(whole, &f);
+        BCE_UpdateH(sliced, &f);
+        ASSERT_TRUE(BCE_ServiceSolverH(whole));
+
+        // A zero budget still runs one slice per call
+        uint32_t before = BCE_GetSolutionGenerationH(sliced);
+        int calls = 1;
+        while (!BCE_StepSolveH(sliced, 0)) {
+            ASSERT_LT(++calls, 5000) << "frame " << i;
+            EXPECT_NE(BCE_GetDiagFlagsH(sliced) & BCE_Diag::SOLUTION_PENDING, 0u);
+            FiringSolution pending;
+            BCE_GetSolutionH(sliced, &pending);
+            EXPECT_NE(pending.defaults_active & BCE_Diag::SOLUTION_PENDING, 0u);
+            EXPECT_NE(BCE_GetSolutionGenerationH(sliced), before);
+        }
+        if (calls > max_calls) max_calls = calls;
+        EXPECT_FALSE(BCE_StepSolveH(sliced, 0));
+
+        FiringSolution a, b;
+        BCE_GetSolutionH(whole, &a);
+        BCE_GetSolutionH(sliced, &b);
+        ASSERT_EQ(BCE_GetModeH(whole), BCE_GetModeH(sliced)) << "frame " << i;
+        EXPECT_EQ(BCE_GetDiagFlagsH(whole), BCE_GetDiagFlagsH(sliced));
+        EXPECT_EQ(std::memcmp(&a, &b, sizeof(a)), 0) << "frame " << i;
+    }
+    EXPECT_EQ(BCE_GetModeH(sliced), BCE_Mode::SOLUTION_READY);
+    EXPECT_GT(max_calls, 10);
+
+    BCE_SolverDiagnostics da, db;
+    BCE_GetSolverDiagnosticsH(whole, &da);
+    BCE_GetSolverDiagnosticsH(sliced, &db);
+    EXPECT_EQ(da.solution_cache_misses, db.solution_cache_misses);
+    EXPECT_EQ(da.trajectory_table_hits, db.trajectory_table_hits);
+    EXPECT_EQ(da.zero_iterations, db.zero_iterations);
+
+    BCE_Destroy(whole);
+    BCE_Destroy(sliced);
+}
+
+// A blocking integration between slices cancels the trajectory job; the next
+// call starts over instead of finishing a table the hold table overwrote
+TEST_F(IntegrationTest, StepSolveRecoversFromInterleavedHoldTable) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    BCE_SetBulletProfile(&bullet);
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    EXPECT_FALSE(BCE_StepSolve(0)); // split mode off
+
+    BCE_SetSplitPipelineMode(true);
+    SensorFrame f = makeDefaultFrame(0);
+    f.lrf_valid = true;
+    f.lrf_range_m = 900.0f;
+    for (int i = 0; i < 100; ++i) {
+        f.timestamp_us = (uint64_t)(i + 1) * 10000;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f); // AHRS settles
+    }
+
+    // Run into the trajectory integration, then interleave a hold table
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_FALSE(BCE_StepSolve(0));
+    }
+    const float ranges[2] = {300.0f, 600.0f};
+    FiringSolution table[2];
+    EXPECT_EQ(BCE_ComputeHoldTable(ranges, 2, table), 2);
+
+    int calls = 0;
+    while (!BCE_StepSolve(0)) {
+        ASSERT_LT(++calls, 5000);
+    }
+    FiringSolution sliced;
+    BCE_GetSolution(&sliced);
+    ASSERT_EQ(sliced.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    EXPECT_EQ(sliced.defaults_active & BCE_Diag::SOLUTION_PENDING, 0u);
+
+    // Same frame solved in one go
+    f.timestamp_us += 10000;
+    f.lrf_timestamp_us = f.timestamp_us;
+    BCE_Update(&f);
+    ASSERT_TRUE(BCE_ServiceSolver());
+    FiringSolution whole;
+    BCE_GetSolution(&whole);
+    EXPECT_EQ(sliced.hold_elevation_moa, whole.hold_elevation_moa);
+    EXPECT_EQ(sliced.hold_windage_moa, whole.hold_windage_moa);
+    EXPECT_EQ(sliced.tof_ms, whole.tof_ms);
+}
+
+// Ingestion, solving and readers on three threads; every published solution
+// a reader sees is complete
+TEST_F(IntegrationTest, SplitPipelineRunsConcurrently) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetSplitPipelineMode(true);
+
+    std::atomic<bool> done{false};
+    std::thread ingest([&] {
+        for (int i = 0; i < 2000; ++i) {
+            SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+            f.lrf_valid = true;
+            f.lrf_range_m = 300.0f + static_cast<float>(i % 500);
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+        done.store(true);
+    });
+    std::thread solver([&] {
+        while (!done.load()) {
+            BCE_ServiceSolver();
+        }
+        BCE_ServiceSolver();
+    });
+
+    while (!done.load()) {
+        // Status getters are safe from this thread too
+        BCE_Mode mode = BCE_GetMode();
+        ASSERT_TRUE(mode == BCE_Mode::IDLE || mode == BCE_Mode::SOLUTION_READY ||
+                    mode == BCE_Mode::FAULT);
+        if (mode == BCE_Mode::SOLUTION_READY) {
+            ASSERT_EQ(BCE_GetFaultFlags() & BCE_Fault::NO_BULLET, 0u);
+        }
+        (void)BCE_GetDiagFlags();
+
+        FiringSolution sol;
+        BCE_GetSolution(&sol);
+        if (sol.solution_mode != static_cast<uint32_t>(BCE_Mode::SOLUTION_READY)) continue;
+        // Range and the energy it implies come from the same solve
+        ASSERT_GE(sol.range_m, 300.0f);
+        ASSERT_LT(sol.range_m, 800.0f);
+        ASSERT_GT(sol.tof_ms, 0.0f);
+        ASSERT_NEAR(sol.energy_at_target_j,
+                    0.5f * 175.0f * BCE_GRAINS_TO_KG *
+                        sol.velocity_at_target_ms * sol.velocity_at_target_ms,
+                    0.01f * sol.energy_at_target_j);
+    }
+    ingest.join();
+    solver.join();
+
+    FiringSolution last;
+    BCE_GetSolution(&last);
+    EXPECT_EQ(last.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    EXPECT_FLOAT_EQ(last.range_m, 799.0f);
+}
+
+// The solution generation advances only when the published contents change
+TEST_F(IntegrationTest, SolutionGenerationSkipsUnchangedFrames) {
+    uint32_t initial = BCE_GetSolutionGeneration();
+    EXPECT_GT(initial, 0u);
+    FiringSolution sol;
+    EXPECT_EQ(BCE_GetSolution(&sol), initial);
+    EXPECT_EQ(BCE_GetSolution(nullptr), initial);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    for (int i = 0; i < 100; ++i) {
+        SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+        f.lrf_valid = true;
+        f.lrf_range_m = 500.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    }
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    uint32_t solved = BCE_GetSolution(&sol);
+    EXPECT_GT(solved, initial);
+
+    // Steady inputs republish an identical solution: generation holds
+    for (int i = 100; i < 110; ++i) {
+        SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+        f.lrf_valid = true;
+        f.lrf_range_m = 500.0f;
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_Update(&f);
+    }
+    EXPECT_EQ(BCE_GetSolutionGeneration(), solved);
+
+    // A new range changes the holds and advances it
+    SensorFrame f = makeDefaultFrame(111 * 10000);
+    f.lrf_valid = true;
+    f.lrf_range_m = 600.0f;
+    f.lrf_timestamp_us = f.timestamp_us;
+    BCE_Update(&f);
+    FiringSolution moved;
+    EXPECT_GT(BCE_GetSolution(&moved), solved);
+    EXPECT_NE(moved.range_m, sol.range_m);
+
+    // Re-init publishes a new generation rather than starting over
+    uint32_t before_init = BCE_GetSolutionGeneration();
+    BCE_Init();
+    EXPECT_GT(BCE_GetSolutionGeneration(), before_init);
+    EXPECT_EQ(BCE_GetSolutionGenerationH(nullptr), 0u);
+}
+
+// The solution callback fires on mode transitions and hold moves past the
+// epsilon, not on every republished solution
+TEST_F(IntegrationTest, SolutionCallbackFiresOnMaterialChanges) {
+    struct Listener {
+        int calls = 0;
+        FiringSolution last = {};
+    } listener;
+    auto onSolution = [](const FiringSolution* sol, void* user) {
+        Listener* l = static_cast<Listener*>(user);
+        l->calls++;
+        l->last = *sol;
+    };
+    BCE_SetSolutionCallback(onSolution, &listener, 0.5f);
+    EXPECT_EQ(listener.calls, 1);
+    EXPECT_EQ(listener.last.solution_mode, static_cast<uint32_t>(BCE_Mode::IDLE));
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+
+    uint64_t t = 0;
+    auto feed = [&](float range_m) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = range_m;
+        f.lrf_timestamp_us = t;
+        BCE_Update(&f);
+    };
+    for (int i = 0; i < 100; ++i) feed(500.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    EXPECT_GE(listener.calls, 2);
+    EXPECT_EQ(listener.last.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    FiringSolution sol;
+    BCE_GetSolution(&sol);
+    EXPECT_NEAR(listener.last.hold_elevation_moa, sol.hold_elevation_moa, 0.5f);
+
+    // Steady frames and a sub-epsilon range change stay quiet
+    int calls = listener.calls;
+    for (int i = 0; i < 10; ++i) feed(500.0f);
+    uint32_t generation = BCE_GetSolutionGeneration();
+    feed(500.5f);
+    EXPECT_GT(BCE_GetSolutionGeneration(), generation);
+    EXPECT_EQ(listener.calls, calls);
+
+    // A new target moves the holds well past it
+    feed(800.0f);
+    EXPECT_EQ(listener.calls, calls + 1);
+    BCE_GetSolution(&sol);
+    EXPECT_EQ(listener.last.hold_elevation_moa, sol.hold_elevation_moa);
+
+    // NULL and BCE_Init() both unregister
+    BCE_SetSolutionCallback(nullptr, nullptr, 0.0f);
+    feed(300.0f);
+    EXPECT_EQ(listener.calls, calls + 1);
+    BCE_SetSolutionCallback(onSolution, &listener, 0.0f);
+    EXPECT_EQ(listener.calls, calls + 2);
+    BCE_Init();
+    feed(300.0f);
+    EXPECT_EQ(listener.calls, calls + 2);
+    BCE_SetSolutionCallbackH(nullptr, onSolution, &listener, 0.0f);
+}
+
+// The trajectory view exposes the live table in place and its generation
+// advances only when a solve re-integrates it
+TEST_F(IntegrationTest, TrajectoryViewTracksLiveTable) {
+    const TrajectoryPoint* points = nullptr;
+    int count = -1;
+    uint32_t generation = 0;
+    EXPECT_FALSE(BCE_GetTrajectoryView(&points, &count, &generation));
+    EXPECT_EQ(points, nullptr);
+    EXPECT_EQ(count, 0);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetZeroConfig(&zero);
+    BCE_SetTrajectoryHorizon(1000.0f);
+
+    uint64_t t = 0;
+    auto feed = [&](float range_m) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        f.lrf_valid = true;
+        f.lrf_range_m = range_m;
+        f.lrf_timestamp_us = t;
+        BCE_Update(&f);
+    };
+    for (int i = 0; i < 100; ++i) feed(500.0f);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+#if BCE_TRAJ_TABLE_COMPACT
+    // Encoded records cannot be handed out in place
+    EXPECT_FALSE(BCE_GetTrajectoryView(&points, &count, &generation));
+    EXPECT_EQ(points, nullptr);
+    EXPECT_EQ(count, 0);
+#else
+    ASSERT_TRUE(BCE_GetTrajectoryView(&points, &count, &generation));
+    ASSERT_NE(points, nullptr);
+    EXPECT_EQ(count, 1000 / BCE_TRAJ_TABLE_STRIDE_M + 1);
+    EXPECT_EQ(points[0].tof_s, 0.0f);
+    for (int i = 1; i < count; ++i) {
+        EXPECT_GT(points[i].tof_s, points[i - 1].tof_s);
+        EXPECT_LT(points[i].velocity_ms, points[i - 1].velocity_ms);
+    }
+    FiringSolution sol;
+    BCE_GetSolution(&sol);
+    EXPECT_NEAR(points[500 / BCE_TRAJ_TABLE_STRIDE_M].tof_s * 1000.0f, sol.tof_ms, 0.5f);
+
+    // Ranges inside the table reuse it; one past the horizon re-integrates
+    const TrajectoryPoint* same = nullptr;
+    uint32_t reused = 0;
+    feed(700.0f);
+    ASSERT_TRUE(BCE_GetTrajectoryView(&same, nullptr, &reused));
+    EXPECT_EQ(same, points);
+    EXPECT_EQ(reused, generation);
+
+    for (int i = 0; i < 200; ++i) feed(1500.0f);
+    uint32_t extended = 0;
+    ASSERT_TRUE(BCE_GetTrajectoryView(nullptr, &count, &extended));
+    EXPECT_NE(extended, generation);
+    EXPECT_GT(count, 1500 / BCE_TRAJ_TABLE_STRIDE_M);
+#endif
+
+    EXPECT_FALSE(BCE_GetTrajectoryViewH(nullptr, &points, &count, &generation));
+}
+
+// Tilting the bore with the launch-angle cache enabled tracks the direct
+// solve and integrates only when the bore reaches new grid angles
+TEST_F(IntegrationTest, AngleCacheTracksDirectSolveUnderTilt) {
+    alignas(16) static unsigned char storage_a[128 * 1024];
+    alignas(16) static unsigned char storage_b[128 * 1024];
+    BCE_Handle direct = BCE_Create(storage_a, sizeof(storage_a));
+    BCE_Handle cached = BCE_Create(storage_b, sizeof(storage_b));
+    ASSERT_NE(direct, nullptr);
+    ASSERT_NE(cached, nullptr);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+
+    BCE_Handle handles[2] = {direct, cached};
+    for (BCE_Handle h : handles) {
+        BCE_SetBulletProfileH(h, &bullet);
+        BCE_SetZeroConfigH(h, &zero);
+        BCE_SetWindManualH(h, 4.0f, 270.0f);
+        BCE_SetLatitudeH(h, 45.0f);
+        BCE_SetIntegratorH(h, IntegratorMethod::DORMAND_PRINCE, 0.0f);
+    }
+    BCE_SetAngleCacheModeH(cached, true);
+
+    // Settle level, then tilt slowly nose-up to about 6° while ranging
+    float max_elev_err = 0.0f, max_wind_err = 0.0f, max_tof_err = 0.0f;
+    int compared = 0;
+    uint64_t t = 0;
+    for (int i = 0; i < 700; ++i) {
+        t += 10000;
+        SensorFrame f = makeDefaultFrame(t);
+        float tilt = (i < 100) ? 0.0f : 0.00015f * static_cast<float>(i - 100);
+        f.accel_x = -9.81f * std::sin(tilt);
+        f.accel_z = 9.81f * std::cos(tilt);
+        f.lrf_valid = true;
+        f.lrf_range_m = 300.0f + 1.5f * static_cast<float>(i);
+        f.lrf_timestamp_us = f.timestamp_us;
+        BCE_UpdateH(direct, &f);
+        BCE_UpdateH(cached, &f);
+
+        ASSERT_EQ(BCE_GetModeH(direct), BCE_GetModeH(cached)) << "frame " << i;
+        if (BCE_GetModeH(direct) != BCE_Mode::SOLUTION_READY) continue;
+        FiringSolution a, b;
+        BCE_GetSolutionH(direct, &a);
+        BCE_GetSolutionH(cached, &b);
+        max_elev_err = std::fmax(max_elev_err, std::fabs(a.hold_elevation_moa - b.hold_elevation_moa));
+        max_wind_err = std::fmax(max_wind_err, std::fabs(a.hold_windage_moa - b.hold_windage_moa));
+        max_tof_err = std::fmax(max_tof_err, std::fabs(a.tof_ms - b.tof_ms));
+        compared++;
+    }
+    // Both sides reuse results within one solution-cache angle bucket
+    const float bucket_moa = BCE_SOLUTION_CACHE_ANGLE_QUANT_RAD * BCE_RAD_TO_MOA;
+    EXPECT_GT(compared, 500);
+    EXPECT_LT(max_elev_err, bucket_moa);
+    EXPECT_LT(max_wind_err, bucket_moa);
+    EXPECT_LT(max_tof_err, 0.1f);
+
+    BCE_SolverDiagnostics d = {}, c = {};
+    BCE_GetSolverDiagnosticsH(direct, &d);
+    BCE_GetSolverDiagnosticsH(cached, &c);
+    EXPECT_GT(c.angle_cache_hits, 400u);
+    EXPECT_LT(c.angle_cache_fills, d.solution_cache_misses / 10);
+    EXPECT_EQ(d.angle_cache_hits, 0u);
+
+    BCE_Destroy(direct);
+    BCE_Destroy(cached);
+}
+
+// A saved zero and trajectory are adopted after a reboot with unchanged
+// inputs, so the first solution needs neither a zero solve nor an integration
+TEST_F(IntegrationTest, SavedStateSkipsZeroSolveAfterReboot) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+
+    auto boot = [&] {
+        BCE_Init();
+        BCE_SetBulletProfile(&bullet);
+        BCE_SetZeroConfig(&zero);
+    };
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+            f.lrf_valid = true;
+            f.lrf_range_m = 600.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+
+    alignas(4) static uint8_t blob[16 * 1024];
+    ASSERT_LE(BCE_GetStateSize(true), sizeof(blob));
+    EXPECT_LT(BCE_GetStateSize(false), BCE_GetStateSize(true));
+
+    boot();
+    EXPECT_EQ(BCE_SaveState(blob, sizeof(blob), true), 0u); // nothing solved yet
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution before;
+    BCE_GetSolution(&before);
+
+    size_t zero_only = BCE_SaveState(blob, sizeof(blob), false);
+    EXPECT_EQ(zero_only, BCE_GetStateSize(false));
+    size_t written = BCE_SaveState(blob, sizeof(blob), true);
+    ASSERT_GT(written, zero_only);
+    ASSERT_LE(written, BCE_GetStateSize(true));
+    EXPECT_EQ(BCE_SaveState(blob, written - 1, true), 0u);
+
+    // Blobs read back from flash into a byte buffer are often unaligned
+    static uint8_t shifted[16 * 1024 + 3];
+    std::memcpy(shifted + 3, blob, written);
+
+    boot();
+    ASSERT_TRUE(BCE_RestoreState(shifted + 3, written));
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    BCE_SolverDiagnostics diag = {};
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_EQ(diag.zero_iterations, 0u);
+    EXPECT_EQ(diag.solution_cache_misses, 0u);
+
+    // The restored table is rebuilt from BCE_STATE_TRAJ_STEP_M records
+    FiringSolution after;
+    BCE_GetSolution(&after);
+    EXPECT_NEAR(after.hold_elevation_moa, before.hold_elevation_moa, 0.01f);
+    EXPECT_NEAR(after.hold_windage_moa, before.hold_windage_moa, 0.01f);
+    EXPECT_NEAR(after.tof_ms, before.tof_ms, 0.1f);
+}
+
+// The restored zero survives a heading change: azimuth only reaches the
+// trajectory cache, not the zero fingerprint
+TEST_F(IntegrationTest, SavedZeroSurvivesHeadingChange) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+
+    auto boot = [&](float declination_deg) {
+        BCE_Init();
+        BCE_SetBulletProfile(&bullet);
+        BCE_SetZeroConfig(&zero);
+        BCE_SetLatitude(45.0f);
+        BCE_SetMagDeclination(declination_deg);
+    };
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+            f.lrf_valid = true;
+            f.lrf_range_m = 600.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+
+    boot(0.0f);
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    alignas(4) static uint8_t blob[16 * 1024];
+    size_t written = BCE_SaveState(blob, sizeof(blob), true);
+    ASSERT_GT(written, 0u);
+
+    boot(90.0f);
+    ASSERT_TRUE(BCE_RestoreState(blob, written));
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    BCE_SolverDiagnostics diag = {};
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_EQ(diag.zero_iterations, 0u);
+    EXPECT_GE(diag.solution_cache_misses, 1u); // the saved table was for the old azimuth
+}
+
+// Changed inputs fall back to a (warm-started) zero solve; damaged blobs are
+// rejected outright
+TEST_F(IntegrationTest, SavedStateValidatesFingerprintAndBlob) {
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetZeroConfig(&zero);
+
+    auto run = [&](int frames) {
+        for (int i = 0; i < frames; ++i) {
+            SensorFrame f = makeDefaultFrame((uint64_t)(i + 1) * 10000);
+            f.lrf_valid = true;
+            f.lrf_range_m = 400.0f;
+            f.lrf_timestamp_us = f.timestamp_us;
+            BCE_Update(&f);
+        }
+    };
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+
+    alignas(4) static uint8_t blob[16 * 1024];
+    size_t written = BCE_SaveState(blob, sizeof(blob), true);
+    ASSERT_GT(written, 0u);
+
+    // Truncated, corrupted or foreign blobs
+    EXPECT_FALSE(BCE_RestoreState(blob, written - 4));
+    blob[written / 2] ^= 0x01;
+    EXPECT_FALSE(BCE_RestoreState(blob, written));
+    blob[written / 2] ^= 0x01;
+    EXPECT_FALSE(BCE_RestoreState(nullptr, written));
+    uint32_t magic = 0;
+    std::memcpy(blob, &magic, sizeof(magic));
+    EXPECT_FALSE(BCE_RestoreState(blob, written));
+
+    // A heavier bullet no longer matches the saved zero
+    written = BCE_SaveState(blob, sizeof(blob), true);
+    ASSERT_GT(written, 0u);
+    BCE_Init();
+    bullet.mass_grains = 190.0f;
+    bullet.muzzle_velocity_ms = 760.0f;
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetZeroConfig(&zero);
+    ASSERT_TRUE(BCE_RestoreState(blob, written));
+    run(100);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    BCE_SolverDiagnostics diag = {};
+    BCE_GetSolverDiagnostics(&diag);
+    EXPECT_GT(diag.zero_iterations, 0u);
+    EXPECT_GE(diag.solution_cache_misses, 1u);
+    FiringSolution restored;
+    BCE_GetSolution(&restored);
+
+    BCE_Init();
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetZeroConfig(&zero);
+    run(100);
+    FiringSolution fresh;
+    BCE_GetSolution(&fresh);
+    // Different warm starts converge anywhere within the zero tolerance
+    const float zero_tol_moa = 2.0f * BCE_ZERO_TOLERANCE_M / zero.zero_range_m * BCE_RAD_TO_MOA;
+    EXPECT_NEAR(restored.hold_elevation_moa, fresh.hold_elevation_moa, zero_tol_moa);
+    EXPECT_NEAR(restored.tof_ms, fresh.tof_ms, 0.1f);
+}
+
+// An 800 Hz IMU fed in FIFO bursts steers the solution as the same samples
+// fed frame by frame, with one solve per burst instead of per sample
+TEST_F(IntegrationTest, IMUBurstMatchesPerSampleFrames) {
+    alignas(16) static unsigned char storage_a[128 * 1024];
+    alignas(16) static unsigned char storage_b[128 * 1024];
+    BCE_Handle frames = BCE_Create(storage_a, sizeof(storage_a));
+    BCE_Handle burst = BCE_Create(storage_b, sizeof(storage_b));
+    ASSERT_NE(frames, nullptr);
+    ASSERT_NE(burst, nullptr);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    for (BCE_Handle h : {frames, burst}) {
+        BCE_SetBulletProfileH(h, &bullet);
+        BCE_SetZeroConfigH(h, &zero);
+        BCE_SetWindManualH(h, 3.0f, 90.0f);
+    }
+
+    constexpr int kBurst = 16;
+    uint64_t t = 0;
+    int ready = 0;
+    for (int cycle = 0; cycle < 60; ++cycle) {
+        ImuSample samples[kBurst];
+        for (int j = 0; j < kBurst; ++j) {
+            t += 1250; // 800 Hz
+            float tilt = 0.05f * std::sin(static_cast<float>(t) * 2e-6f);
+            samples[j] = {t, 0.0f, 9.81f * tilt, 9.81f, 0.0f, tilt, 0.0f};
+
+            SensorFrame f = makeDefaultFrame(t);
+            f.baro_valid = false;
+            f.accel_y = samples[j].accel_y;
+            f.gyro_y = samples[j].gyro_y;
+            BCE_UpdateH(frames, &f);
+        }
+        BCE_UpdateIMUBurstH(burst, samples, kBurst);
+
+        // Baro and LRF arrive once per cycle through the frame path
+        SensorFrame tail = makeDefaultFrame(t);
+        tail.imu_valid = false;
+        tail.lrf_valid = true;
+        tail.lrf_range_m = 600.0f;
+        tail.lrf_timestamp_us = t;
+        BCE_UpdateH(frames, &tail);
+        BCE_UpdateH(burst, &tail);
+
+        FiringSolution a, b;
+        BCE_GetSolutionH(frames, &a);
+        BCE_GetSolutionH(burst, &b);
+        ASSERT_EQ(a.solution_mode, b.solution_mode) << "cycle " << cycle;
+        EXPECT_NEAR(a.cant_angle_deg, b.cant_angle_deg, 1e-4f) << "cycle " << cycle;
+        // The per-frame handle may serve a solution-cache hit from a launch
+        // angle up to one cache quantum away
+        const float tol = BCE_SOLUTION_CACHE_ANGLE_QUANT_RAD * BCE_RAD_TO_MOA;
+        EXPECT_NEAR(a.hold_elevation_moa, b.hold_elevation_moa, tol) << "cycle " << cycle;
+        EXPECT_NEAR(a.hold_windage_moa, b.hold_windage_moa, tol);
+        if (b.solution_mode == static_cast<uint32_t>(BCE_Mode::SOLUTION_READY)) ready++;
+    }
+    EXPECT_GT(ready, 30);
+
+    // A non-finite sample is skipped but flagged
+    ImuSample bad[2] = {{t + 1250, 0.0f, 0.0f, 9.81f, 0.0f, 0.0f, 0.0f},
+                        {t + 2500, std::numeric_limits<float>::quiet_NaN(), 0.0f, 9.81f,
+                         0.0f, 0.0f, 0.0f}};
+    BCE_UpdateIMUBurstH(burst, bad, 2);
+    EXPECT_NE(BCE_GetFaultFlagsH(burst) & BCE_Fault::SENSOR_INVALID, 0u);
+    BCE_UpdateIMUBurstH(burst, nullptr, 4);
+    BCE_UpdateIMUBurstH(nullptr, bad, 2);
+
+    BCE_Destroy(frames);
+    BCE_Destroy(burst);
+}
+
+// Per-sensor events fed the same readings as full frames steer the AHRS,
+// atmosphere and range identically, but only solve when something moved
+TEST_F(IntegrationTest, EventIngestionSolvesOnlyOnRelevantEvents) {
+    alignas(16) static unsigned char storage_a[128 * 1024];
+    alignas(16) static unsigned char storage_b[128 * 1024];
+    BCE_Handle frames = BCE_Create(storage_a, sizeof(storage_a));
+    BCE_Handle events = BCE_Create(storage_b, sizeof(storage_b));
+    ASSERT_NE(frames, nullptr);
+    ASSERT_NE(events, nullptr);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {};
+    zero.zero_range_m = 100.0f;
+    zero.sight_height_mm = 38.1f;
+    for (BCE_Handle h : {frames, events}) {
+        BCE_SetBulletProfileH(h, &bullet);
+        BCE_SetZeroConfigH(h, &zero);
+        BCE_SetWindManualH(h, 3.0f, 90.0f);
+    }
+
+    auto solves = [](BCE_Handle h) {
+        BCE_SolverDiagnostics d;
+        BCE_GetSolverDiagnosticsH(h, &d);
+        return d.solution_cache_hits + d.solution_cache_misses + d.trajectory_table_hits;
+    };
+
+    // 400 Hz IMU, 10 Hz baro, an LRF reading every second
+    uint64_t t = 0;
+    for (int i = 1; i <= 1600; ++i) {
+        t += 2500;
+        SensorFrame f = makeDefaultFrame(t);
+        f.baro_valid = (i % 40 == 0);
+        f.baro_temperature_c = 15.0f + 0.001f * static_cast<float>(i);
+        f.lrf_valid = (i % 400 == 1);
+        f.lrf_range_m = 550.0f + 0.1f * static_cast<float>(i);
+        f.lrf_timestamp_us = t;
+        BCE_UpdateH(frames, &f);
+
+        ImuSample imu = {t, f.accel_x, f.accel_y, f.accel_z, f.gyro_x, f.gyro_y, f.gyro_z};
+        BCE_UpdateIMUH(events, &imu, nullptr);
+        if (f.baro_valid) {
+            BCE_UpdateBaroH(events, t, f.baro_pressure_pa, f.baro_temperature_c, f.baro_humidity);
+        }
+        if (f.lrf_valid) {
+            BCE_UpdateLRFH(events, t, f.lrf_range_m, f.lrf_confidence);
+        }
+    }
+    ASSERT_EQ(BCE_GetModeH(frames), BCE_Mode::SOLUTION_READY);
+    ASSERT_EQ(BCE_GetModeH(events), BCE_Mode::SOLUTION_READY);
+    EXPECT_LT(solves(events) * 10u, solves(frames));
+
+    // The next LRF reading solves both on identical inputs
+    BCE_UpdateLRFH(events, t, 800.0f, 0.0f);
+    SensorFrame f = makeDefaultFrame(t);
+    f.imu_valid = false;
+    f.baro_valid = false;
+    f.lrf_valid = true;
+    f.lrf_range_m = 800.0f;
+    f.lrf_timestamp_us = t;
+    BCE_UpdateH(frames, &f);
+    FiringSolution a, b;
+    BCE_GetSolutionH(frames, &a);
+    BCE_GetSolutionH(events, &b);
+    const float tol = BCE_SOLUTION_CACHE_ANGLE_QUANT_RAD * BCE_RAD_TO_MOA;
+    EXPECT_NEAR(a.hold_elevation_moa, b.hold_elevation_moa, tol);
+    EXPECT_NEAR(a.hold_windage_moa, b.hold_windage_moa, tol);
+    EXPECT_EQ(a.range_m, b.range_m);
+    EXPECT_EQ(a.air_density_kgm3, b.air_density_kgm3);
+
+    // A still IMU sample leaves the solution alone; rolling past the
+    // threshold, a configuration change or a bad sample re-solves
+    uint32_t before = solves(events);
+    t += 2500;
+    ImuSample still = {t, 0.0f, 0.0f, 9.81f, 0.0f, 0.0f, 0.0f};
+    BCE_UpdateIMUH(events, &still, nullptr);
+    EXPECT_EQ(solves(events), before);
+
+    for (int i = 0; i < 20 && solves(events) == before; ++i) {
+        t += 2500;
+        ImuSample roll = {t, 0.0f, 0.0f, 9.81f, 0.5f, 0.0f, 0.0f};
+        BCE_UpdateIMUH(events, &roll, nullptr);
+    }
+    EXPECT_GT(solves(events), before);
+
+    before = solves(events);
+    BCE_SetWindManualH(events, 5.0f, 90.0f);
+    t += 2500;
+    still.timestamp_us = t;
+    BCE_UpdateIMUH(events, &still, nullptr);
+    EXPECT_GT(solves(events), before);
+
+    t += 2500;
+    ImuSample bad = {t, std::numeric_limits<float>::quiet_NaN(), 0.0f, 9.81f, 0.0f, 0.0f, 0.0f};
+    BCE_UpdateIMUH(events, &bad, nullptr);
+    EXPECT_NE(BCE_GetFaultFlagsH(events) & BCE_Fault::SENSOR_INVALID, 0u);
+    t += 2500;
+    still.timestamp_us = t;
+    BCE_UpdateIMUH(events, &still, nullptr);
+    EXPECT_EQ(BCE_GetFaultFlagsH(events) & BCE_Fault::SENSOR_INVALID, 0u);
+
+    BCE_UpdateIMUH(events, nullptr, nullptr);
+    BCE_UpdateIMUH(nullptr, &still, nullptr);
+    BCE_UpdateLRFH(nullptr, t, 500.0f, 0.0f);
+    BCE_UpdateBaroH(nullptr, t, 101325.0f, 15.0f, -1.0f);
+
+    BCE_Destroy(frames);
+    BCE_Destroy(events);
+}
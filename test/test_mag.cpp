@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 #include "../lib/bce/src/mag/mag_calibration.h"
+#include "../lib/bce/src/mag/mag_ellipsoid_fit.h"
 #include "bce/bce_config.h"
 #include <cmath>
 
@@ -80,3 +81,109 @@ TEST_F(MagTest, HeadingWraps) {
     EXPECT_GE(heading, 0.0f);
     EXPECT_LT(heading, 360.0f);
 }
+
+// ---------------------------------------------------------------------------
+// Streaming ellipsoid fit
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Raw reading of a field_ut field from direction i of n (Fibonacci sphere,
+// visited in an interleaved order as waving the device does), distorted by
+// soft iron (symmetric, row-major) and shifted by hard iron
+void distortedReading(int i, int n, float field_ut, const float distortion[9],
+                      const float offset[3], float out[3]) {
+    const float golden = 2.39996323f;
+    i = (i * 7) % n;
+    const float z = 1.0f - 2.0f * (i + 0.5f) / n;
+    const float r = std::sqrt(1.0f - z * z);
+    const float b[3] = {r * std::cos(golden * i) * field_ut, r * std::sin(golden * i) * field_ut,
+                        z * field_ut};
+    for (int k = 0; k < 3; ++k) {
+        out[k] = distortion[k * 3 + 0] * b[0] + distortion[k * 3 + 1] * b[1] +
+                 distortion[k * 3 + 2] * b[2] + offset[k];
+    }
+}
+
+const float kDistortion[9] = {1.20f, 0.10f, 0.00f,
+                              0.10f, 0.90f, 0.05f,
+                              0.00f, 0.05f, 1.05f};
+const float kOffset[3] = {12.0f, -8.0f, 20.0f};
+
+} // namespace
+
+// The fit recovers the offset and maps readings back to a sphere
+TEST(MagEllipsoidFitTest, RecoversHardAndSoftIron) {
+    MagEllipsoidFit fit;
+    fit.reset();
+    const int n = 400;
+    for (int i = 0; i < n; ++i) {
+        float m[3];
+        distortedReading(i, n, 48.0f, kDistortion, kOffset, m);
+        EXPECT_TRUE(fit.addSample(m[0], m[1], m[2]));
+    }
+    EXPECT_EQ(fit.getState().samples, static_cast<uint32_t>(n));
+    EXPECT_EQ(fit.getState().rejected, 0u);
+
+    MagEllipsoidFit::Result result;
+    ASSERT_TRUE(MagEllipsoidFit::solve(fit.getState(), result));
+    EXPECT_GE(result.coverage, 0.99f);
+    for (int k = 0; k < 3; ++k) EXPECT_NEAR(result.hard_iron[k], kOffset[k], 0.5f);
+    EXPECT_LT(result.residual_ut, 0.5f);
+
+    MagCalibration mag;
+    mag.setCalibration(result.hard_iron, result.soft_iron);
+    for (int i = 0; i < n; i += 7) {
+        float m[3];
+        distortedReading(i, n, 48.0f, kDistortion, kOffset, m);
+        EXPECT_TRUE(mag.apply(m[0], m[1], m[2]));
+        EXPECT_NEAR(std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]), result.field_ut,
+                    0.01f * result.field_ut);
+    }
+    // Soft iron keeps the mean radius: det(distortion) ≈ 1.07
+    EXPECT_NEAR(result.field_ut, 48.0f * std::cbrt(1.0713f), 1.0f);
+}
+
+// Readings from one plane do not constrain the fit across it
+TEST(MagEllipsoidFitTest, PlanarRotationIsNotReady) {
+    MagEllipsoidFit fit;
+    fit.reset();
+    for (int i = 0; i < 360; ++i) {
+        const float a = i * BCE_DEG_TO_RAD;
+        fit.addSample(40.0f * std::cos(a) + kOffset[0], 40.0f * std::sin(a) + kOffset[1],
+                      20.0f + kOffset[2]);
+    }
+    MagEllipsoidFit::Result result;
+    EXPECT_FALSE(MagEllipsoidFit::solve(fit.getState(), result));
+    EXPECT_LT(result.coverage, BCE_MAG_CAL_MIN_COVERAGE);
+}
+
+// Holding still adds nothing; once the fit is constrained, a reading far
+// off the ellipsoid is rejected as a disturbance
+TEST(MagEllipsoidFitTest, SkipsRepeatsAndRejectsDisturbance) {
+    MagEllipsoidFit fit;
+    fit.reset();
+    float m[3];
+    distortedReading(0, 400, 48.0f, kDistortion, kOffset, m);
+    EXPECT_TRUE(fit.addSample(m[0], m[1], m[2]));
+    EXPECT_FALSE(fit.addSample(m[0] + 0.5f, m[1], m[2]));
+    EXPECT_EQ(fit.getState().samples, 1u);
+    EXPECT_EQ(fit.getState().rejected, 0u);
+
+    for (int i = 1; i < 400; ++i) {
+        distortedReading(i, 400, 48.0f, kDistortion, kOffset, m);
+        fit.addSample(m[0], m[1], m[2]);
+    }
+    MagEllipsoidFit::Result before;
+    ASSERT_TRUE(MagEllipsoidFit::solve(fit.getState(), before));
+
+    distortedReading(123, 400, 48.0f * 1.5f, kDistortion, kOffset, m);
+    EXPECT_FALSE(fit.addSample(m[0], m[1], m[2]));
+    EXPECT_EQ(fit.getState().rejected, 1u);
+    EXPECT_FALSE(fit.addSample(1000.0f, 0.0f, 0.0f));
+    EXPECT_EQ(fit.getState().rejected, 2u);
+
+    MagEllipsoidFit::Result after;
+    ASSERT_TRUE(MagEllipsoidFit::solve(fit.getState(), after));
+    EXPECT_FLOAT_EQ(after.field_ut, before.field_ut);
+}
@@ -0,0 +1,309 @@
+/**
+ * @file test_profile_db.cpp
+ * @brief Unit tests for the packed profile database and profile selection.
+ */
+
+#include <gtest/gtest.h>
+#include "bce/bce_api.h"
+#include "bce/bce_config.h"
+#include "../lib/bce/src/profile/profile_db.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+ProfileCartridge makeCartridge(const char* name, float bc, float mv) {
+    ProfileCartridge c;
+    std::memset(&c, 0, sizeof(c));
+    std::snprintf(c.name, sizeof(c.name), "%s", name);
+    c.bc = bc;
+    c.drag_model = static_cast<uint8_t>(DragModel::G1);
+    c.muzzle_velocity_ms = mv;
+    c.mass_grains = 175.0f;
+    c.caliber_inches = 0.308f;
+    c.length_mm = 31.2f;
+    return c;
+}
+
+ProfileGun makeGun(const char* name, float zero_range_m) {
+    ProfileGun g;
+    std::memset(&g, 0, sizeof(g));
+    std::snprintf(g.name, sizeof(g.name), "%s", name);
+    g.caliber_inches = 0.308f;
+    g.barrel_length_in = 24.0f;
+    g.mv_adjustment_factor = 25.0f;
+    g.twist_rate_inches = 10.0f;
+    g.zero_range_m = zero_range_m;
+    g.sight_height_mm = 38.1f;
+    return g;
+}
+
+alignas(4) uint8_t g_db[32 * 1024];
+
+SensorFrame makeFrame(uint64_t timestamp_us, float range_m) {
+    SensorFrame f;
+    std::memset(&f, 0, sizeof(f));
+    f.timestamp_us = timestamp_us;
+    f.accel_z = 9.81f;
+    f.imu_valid = true;
+    f.baro_pressure_pa = 101325.0f;
+    f.baro_temperature_c = 15.0f;
+    f.baro_humidity = 0.5f;
+    f.baro_valid = true;
+    f.baro_humidity_valid = true;
+    f.lrf_valid = true;
+    f.lrf_range_m = range_m;
+    f.lrf_timestamp_us = timestamp_us;
+    return f;
+}
+
+FiringSolution solveAt(float range_m) {
+    for (int i = 0; i < 100; ++i) {
+        SensorFrame f = makeFrame(static_cast<uint64_t>(i + 1) * 10000, range_m);
+        BCE_Update(&f);
+    }
+    FiringSolution sol;
+    BCE_GetSolution(&sol);
+    return sol;
+}
+
+} // namespace
+
+TEST(ProfileDb, BuildOpenAndFindRoundTrip) {
+    ProfileCartridge carts[3] = {makeCartridge(".308 175 SMK", 0.505f, 792.0f),
+                                 makeCartridge(".308 168 ELD", 0.523f, 810.0f),
+                                 makeCartridge("Shared name", 0.400f, 850.0f)};
+    ProfileGun guns[2] = {makeGun("Bolt 24", 100.0f), makeGun("Shared name", 300.0f)};
+
+    size_t size = ProfileDb::buildSize(3, 2);
+    ASSERT_GT(size, 0u);
+    ASSERT_LE(size, sizeof(g_db));
+    EXPECT_EQ(ProfileDb::build(carts, 3, guns, 2, g_db, size - 1), 0u);
+    ASSERT_EQ(ProfileDb::build(carts, 3, guns, 2, g_db, sizeof(g_db)), size);
+
+    ProfileDb db;
+    EXPECT_FALSE(db.isOpen());
+    EXPECT_EQ(db.findCartridge(".308 175 SMK"), nullptr);
+    ASSERT_TRUE(db.open(g_db, size));
+    EXPECT_EQ(db.getCartridgeCount(), 3);
+    EXPECT_EQ(db.getGunCount(), 2);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(db.findCartridge(carts[i].name), db.getCartridge(i));
+    }
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(db.findGun(guns[i].name), db.getGun(i));
+    }
+    // One name may be both a cartridge and a gun; kinds are looked up apart
+    ASSERT_NE(db.findCartridge("Shared name"), nullptr);
+    EXPECT_FLOAT_EQ(db.findCartridge("Shared name")->bc, 0.400f);
+    ASSERT_NE(db.findGun("Shared name"), nullptr);
+    EXPECT_FLOAT_EQ(db.findGun("Shared name")->zero_range_m, 300.0f);
+
+    EXPECT_EQ(db.findCartridge("Bolt 24"), nullptr);
+    EXPECT_EQ(db.findGun(".308 175 SMK"), nullptr);
+    EXPECT_EQ(db.findCartridge(".308 175"), nullptr);
+    EXPECT_EQ(db.findCartridge(nullptr), nullptr);
+    EXPECT_EQ(db.getCartridge(3), nullptr);
+    EXPECT_EQ(db.getGun(-1), nullptr);
+
+    // Same records, same bytes
+    alignas(4) static uint8_t again[32 * 1024];
+    ASSERT_EQ(ProfileDb::build(carts, 3, guns, 2, again, sizeof(again)), size);
+    EXPECT_EQ(std::memcmp(g_db, again, size), 0);
+
+    db.close();
+    EXPECT_FALSE(db.isOpen());
+    EXPECT_EQ(db.getCartridgeCount(), 0);
+}
+
+TEST(ProfileDb, LookupStaysExactAcrossManyNames) {
+    static ProfileCartridge carts[200];
+    char name[PROFILE_NAME_BYTES];
+    for (int i = 0; i < 200; ++i) {
+        std::snprintf(name, sizeof(name), "load-%03d", i);
+        carts[i] = makeCartridge(name, 0.3f + 0.001f * static_cast<float>(i), 800.0f);
+    }
+    size_t size = ProfileDb::buildSize(200, 0);
+    ASSERT_LE(size, sizeof(g_db));
+    ASSERT_EQ(ProfileDb::build(carts, 200, nullptr, 0, g_db, sizeof(g_db)), size);
+
+    ProfileDb db;
+    ASSERT_TRUE(db.open(g_db, size));
+    for (int i = 0; i < 200; ++i) {
+        const ProfileCartridge* c = db.findCartridge(carts[i].name);
+        ASSERT_NE(c, nullptr) << carts[i].name;
+        EXPECT_EQ(c, db.getCartridge(i));
+    }
+    EXPECT_EQ(db.findCartridge("load-200"), nullptr);
+}
+
+TEST(ProfileDb, BuildRejectsInvalidRecords) {
+    ProfileCartridge carts[2] = {makeCartridge("A", 0.5f, 800.0f), makeCartridge("A", 0.4f, 800.0f)};
+    ProfileGun gun = makeGun("Gun", 100.0f);
+
+    EXPECT_EQ(ProfileDb::build(carts, 2, &gun, 1, g_db, sizeof(g_db)), 0u); // duplicate
+    EXPECT_GT(ProfileDb::build(carts, 1, &gun, 1, g_db, sizeof(g_db)), 0u);
+
+    ProfileCartridge bad = makeCartridge("", 0.5f, 800.0f);
+    EXPECT_EQ(ProfileDb::build(&bad, 1, nullptr, 0, g_db, sizeof(g_db)), 0u); // empty name
+    bad = makeCartridge("Long", 0.5f, 800.0f);
+    std::memset(bad.name, 'x', PROFILE_NAME_BYTES); // no terminator
+    EXPECT_EQ(ProfileDb::build(&bad, 1, nullptr, 0, g_db, sizeof(g_db)), 0u);
+    bad = makeCartridge("Custom", 0.5f, 800.0f);
+    bad.drag_model = static_cast<uint8_t>(DragModel::CUSTOM);
+    EXPECT_EQ(ProfileDb::build(&bad, 1, nullptr, 0, g_db, sizeof(g_db)), 0u);
+    bad = makeCartridge("Bands", 0.5f, 800.0f);
+    bad.bc_band_count = PROFILE_BC_BANDS + 1;
+    EXPECT_EQ(ProfileDb::build(&bad, 1, nullptr, 0, g_db, sizeof(g_db)), 0u);
+    bad = makeCartridge("Tuned", 0.5f, 800.0f);
+    bad.integrator_tuned = 1;
+    bad.integrator_method = static_cast<uint8_t>(IntegratorMethod::RK4_RANGE) + 1;
+    EXPECT_EQ(ProfileDb::build(&bad, 1, nullptr, 0, g_db, sizeof(g_db)), 0u);
+
+    EXPECT_EQ(ProfileDb::build(carts, 1, nullptr, 0, g_db + 1, sizeof(g_db) - 1), 0u); // unaligned
+    EXPECT_EQ(ProfileDb::buildSize(ProfileDb::MAX_INDEX_SLOTS, 0), 0u);
+}
+
+TEST(ProfileDb, OpenRejectsDamagedBlobs) {
+    ProfileCartridge cart = makeCartridge("A", 0.5f, 800.0f);
+    ProfileGun gun = makeGun("Gun", 100.0f);
+    size_t size = ProfileDb::build(&cart, 1, &gun, 1, g_db, sizeof(g_db));
+    ASSERT_GT(size, 0u);
+
+    ProfileDb db;
+    EXPECT_FALSE(db.open(g_db, size - 4)); // truncated
+    EXPECT_FALSE(db.open(nullptr, size));
+
+    g_db[size - 1] ^= 0x01; // corrupted index
+    EXPECT_FALSE(db.open(g_db, size));
+    g_db[size - 1] ^= 0x01;
+
+    ProfileDbHeader h;
+    std::memcpy(&h, g_db, sizeof(h));
+    ProfileDbHeader changed = h;
+    changed.version = BCE_PROFILE_DB_VERSION + 1;
+    std::memcpy(g_db, &changed, sizeof(changed));
+    EXPECT_FALSE(db.open(g_db, size));
+    changed = h;
+    changed.index_slots = 3;
+    std::memcpy(g_db, &changed, sizeof(changed));
+    EXPECT_FALSE(db.open(g_db, size));
+    changed = h;
+    changed.gun_offset = static_cast<uint32_t>(size);
+    std::memcpy(g_db, &changed, sizeof(changed));
+    EXPECT_FALSE(db.open(g_db, size));
+    std::memcpy(g_db, &h, sizeof(h));
+
+    alignas(4) static uint8_t shifted[32 * 1024 + 4];
+    std::memcpy(shifted + 1, g_db, size);
+    EXPECT_FALSE(db.open(shifted + 1, size));
+
+    // A failed open keeps the previous database
+    ASSERT_TRUE(db.open(g_db, size));
+    EXPECT_FALSE(db.open(shifted + 1, size));
+    EXPECT_NE(db.findGun("Gun"), nullptr);
+}
+
+TEST(ProfileDb, SelectProfileMatchesManualSetup) {
+    ProfileCartridge carts[2] = {makeCartridge(".308 175 SMK", 0.505f, 792.0f),
+                                 makeCartridge("Fast", 0.450f, 900.0f)};
+    carts[1].bc_bands[0] = {0.44f, 700.0f};
+    carts[1].bc_band_count = 1;
+    ProfileGun gun = makeGun("Bolt 24", 100.0f);
+    size_t size = ProfileDb::build(carts, 2, &gun, 1, g_db, sizeof(g_db));
+    ASSERT_GT(size, 0u);
+
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.barrel_length_in = 24.0f;
+    bullet.mv_adjustment_factor = 25.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.length_mm = 31.2f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    ZeroConfig zero = {100.0f, 38.1f};
+
+    BCE_Init();
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetZeroConfig(&zero);
+    FiringSolution manual = solveAt(600.0f);
+    ASSERT_EQ(manual.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+
+    BCE_Init();
+    EXPECT_FALSE(BCE_SelectProfile(".308 175 SMK", "Bolt 24")); // nothing bound
+    EXPECT_FALSE(BCE_SetProfileDb(g_db + 1, size));
+    ASSERT_TRUE(BCE_SetProfileDb(g_db, size));
+    EXPECT_FALSE(BCE_SelectProfile(nullptr, nullptr));
+    EXPECT_FALSE(BCE_SelectProfile("Missing", "Bolt 24"));
+    EXPECT_FALSE(BCE_SelectProfile(".308 175 SMK", "Missing"));
+    ASSERT_TRUE(BCE_SelectProfile(".308 175 SMK", "Bolt 24"));
+    FiringSolution selected = solveAt(600.0f);
+    ASSERT_EQ(selected.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    EXPECT_FLOAT_EQ(selected.hold_elevation_moa, manual.hold_elevation_moa);
+    EXPECT_FLOAT_EQ(selected.hold_windage_moa, manual.hold_windage_moa);
+    EXPECT_FLOAT_EQ(selected.tof_ms, manual.tof_ms);
+
+    // A cartridge swap keeps the gun and zero and changes the solution
+    ASSERT_TRUE(BCE_SelectProfile("Fast", nullptr));
+    FiringSolution fast = solveAt(600.0f);
+    ASSERT_EQ(fast.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+    EXPECT_LT(fast.tof_ms, selected.tof_ms);
+
+    // Init unbinds the database
+    BCE_Init();
+    EXPECT_FALSE(BCE_SelectProfile(".308 175 SMK", nullptr));
+    ASSERT_TRUE(BCE_SetProfileDb(g_db, size));
+    EXPECT_TRUE(BCE_SetProfileDb(nullptr, 0));
+    EXPECT_FALSE(BCE_SelectProfile(".308 175 SMK", nullptr));
+}
+
+TEST(ProfileDb, SelectProfileAppliesStoredIntegratorTuning) {
+    ProfileCartridge carts[2] = {makeCartridge("Tuned", 0.505f, 792.0f),
+                                 makeCartridge("Untuned", 0.450f, 900.0f)};
+    carts[0].integrator_tuned = 1;
+    carts[0].integrator_method = static_cast<uint8_t>(IntegratorMethod::RK4);
+    carts[0].integrator_step_scale_m = 1.5f;
+    carts[0].integrator_max_step_m = 4.0f;
+    carts[0].integrator_transonic_dt_s = 0.002f;
+    carts[1].integrator_step_scale_m = 9.0f; // ignored without the flag
+    ProfileGun gun = makeGun("Bolt 24", 100.0f);
+    size_t size = ProfileDb::build(carts, 2, &gun, 1, g_db, sizeof(g_db));
+    ASSERT_GT(size, 0u);
+
+    ProfileDb db;
+    ASSERT_TRUE(db.open(g_db, size));
+    IntegratorTuning tuning = {};
+    EXPECT_FALSE(ProfileDb::applyIntegrator(*db.findCartridge("Untuned"), tuning));
+    EXPECT_EQ(db.findCartridge("Untuned")->integrator_step_scale_m, 0.0f);
+    ASSERT_TRUE(ProfileDb::applyIntegrator(*db.findCartridge("Tuned"), tuning));
+    EXPECT_EQ(tuning.method, IntegratorMethod::RK4);
+    EXPECT_EQ(tuning.step_scale_m, 1.5f);
+    EXPECT_EQ(tuning.max_step_m, 4.0f);
+    EXPECT_EQ(tuning.transonic_dt_s, 0.002f);
+
+    // Selecting the tuned cartridge solves like setting the tuning by hand
+    BCE_Init();
+    ASSERT_TRUE(BCE_SetProfileDb(g_db, size));
+    ASSERT_TRUE(BCE_SelectProfile("Tuned", "Bolt 24"));
+    FiringSolution selected = solveAt(600.0f);
+    ASSERT_EQ(selected.solution_mode, static_cast<uint32_t>(BCE_Mode::SOLUTION_READY));
+
+    BCE_Init();
+    ASSERT_TRUE(BCE_SetProfileDb(g_db, size));
+    ASSERT_TRUE(BCE_SelectProfile(nullptr, "Bolt 24"));
+    BCE_SetIntegratorTuning(&tuning);
+    ASSERT_TRUE(BCE_SelectProfile("Untuned", nullptr)); // keeps the tuning set
+    ASSERT_TRUE(BCE_SelectProfile("Tuned", nullptr));
+    FiringSolution manual = solveAt(600.0f);
+    EXPECT_FLOAT_EQ(manual.hold_elevation_moa, selected.hold_elevation_moa);
+    EXPECT_FLOAT_EQ(manual.tof_ms, selected.tof_ms);
+
+    BCE_SetIntegratorTuning(nullptr);
+    FiringSolution fallback = solveAt(600.0f);
+    EXPECT_NE(fallback.tof_ms, selected.tof_ms);
+    EXPECT_NEAR(fallback.hold_elevation_moa, selected.hold_elevation_moa, 0.5f);
+}
@@ -0,0 +1,370 @@
+/**
+ * @file test_recorder.cpp
+ * @brief Unit tests for the packed SensorFrame stream and input recorder.
+ */
+
+#include <gtest/gtest.h>
+#include "bce/bce_api.h"
+#include "../lib/bce/src/recorder/frame_codec.h"
+#include "../lib/bce/src/recorder/frame_recorder.h"
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+SensorFrame makeFrame(uint64_t timestamp_us, int i) {
+    SensorFrame f;
+    std::memset(&f, 0, sizeof(f));
+    f.timestamp_us = timestamp_us;
+    f.accel_x = 0.01f * static_cast<float>(i % 7);
+    f.accel_z = 9.81f;
+    f.gyro_y = -0.002f * static_cast<float>(i % 3);
+    f.imu_valid = true;
+    f.mag_x = 25.0f;
+    f.mag_z = -40.0f;
+    f.mag_valid = (i % 2) == 0;
+    f.baro_pressure_pa = 101325.0f + static_cast<float>(i / 10);
+    f.baro_temperature_c = 15.0f;
+    f.baro_humidity = 0.5f;
+    f.baro_valid = true;
+    f.baro_humidity_valid = (i % 5) != 0;
+    if (i % 4 == 0) {
+        f.lrf_valid = true;
+        f.lrf_range_m = 500.0f;
+        f.lrf_timestamp_us = timestamp_us - 3000;
+        f.lrf_confidence = 0.9f;
+    }
+    f.encoder_valid = true;
+    f.encoder_focal_length_mm = 50.0f;
+    return f;
+}
+
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+void expectSameFrame(const SensorFrame& a, const SensorFrame& b) {
+    EXPECT_EQ(a.timestamp_us, b.timestamp_us);
+    EXPECT_TRUE(sameBits(a.accel_x, b.accel_x) && sameBits(a.accel_y, b.accel_y) &&
+                sameBits(a.accel_z, b.accel_z));
+    EXPECT_TRUE(sameBits(a.gyro_x, b.gyro_x) && sameBits(a.gyro_y, b.gyro_y) &&
+                sameBits(a.gyro_z, b.gyro_z));
+    EXPECT_EQ(a.imu_valid, b.imu_valid);
+    EXPECT_TRUE(sameBits(a.mag_x, b.mag_x) && sameBits(a.mag_y, b.mag_y) &&
+                sameBits(a.mag_z, b.mag_z));
+    EXPECT_EQ(a.mag_valid, b.mag_valid);
+    EXPECT_TRUE(sameBits(a.baro_pressure_pa, b.baro_pressure_pa));
+    EXPECT_TRUE(sameBits(a.baro_temperature_c, b.baro_temperature_c));
+    EXPECT_TRUE(sameBits(a.baro_humidity, b.baro_humidity));
+    EXPECT_EQ(a.baro_valid, b.baro_valid);
+    EXPECT_EQ(a.baro_humidity_valid, b.baro_humidity_valid);
+    EXPECT_TRUE(sameBits(a.lrf_range_m, b.lrf_range_m));
+    EXPECT_EQ(a.lrf_timestamp_us, b.lrf_timestamp_us);
+    EXPECT_TRUE(sameBits(a.lrf_confidence, b.lrf_confidence));
+    EXPECT_EQ(a.lrf_valid, b.lrf_valid);
+    EXPECT_TRUE(sameBits(a.encoder_focal_length_mm, b.encoder_focal_length_mm));
+    EXPECT_EQ(a.encoder_valid, b.encoder_valid);
+}
+
+// Fields of invalid sensors are not recorded
+SensorFrame recordable(SensorFrame f) {
+    if (!f.imu_valid) f.accel_x = f.accel_y = f.accel_z = f.gyro_x = f.gyro_y = f.gyro_z = 0.0f;
+    if (!f.mag_valid) f.mag_x = f.mag_y = f.mag_z = 0.0f;
+    if (!f.baro_valid) f.baro_pressure_pa = f.baro_temperature_c = 0.0f;
+    if (!f.baro_valid || !f.baro_humidity_valid) f.baro_humidity = 0.0f;
+    if (!f.lrf_valid) {
+        f.lrf_range_m = f.lrf_confidence = 0.0f;
+        f.lrf_timestamp_us = 0;
+    }
+    if (!f.encoder_valid) f.encoder_focal_length_mm = 0.0f;
+    return f;
+}
+
+std::vector<uint8_t> drain(FrameRecorder& rec) {
+    std::vector<uint8_t> out;
+    uint8_t buf[97]; // odd size: reads split records
+    size_t n;
+    while ((n = rec.read(buf, sizeof(buf))) > 0) out.insert(out.end(), buf, buf + n);
+    return out;
+}
+
+} // namespace
+
+// Every encodable value, including NaN payloads, a rollback and an LRF
+// reading older than its frame, survives bit for bit
+TEST(FrameCodecTest, RoundTripIsBitExact) {
+    std::vector<SensorFrame> frames;
+    uint64_t t = 1000;
+    for (int i = 0; i < 200; ++i) {
+        t += (i == 120) ? 5000000 : 10000;
+        if (i == 121) t -= 4000000;
+        SensorFrame f = makeFrame(t, i);
+        if (i == 50) f.baro_pressure_pa = NAN;
+        if (i == 51) f.gyro_x = -INFINITY;
+        if (i == 80) f.imu_valid = false;
+        if (i == 90) f.baro_valid = false;
+        frames.push_back(f);
+    }
+
+    std::vector<uint8_t> stream(FRAME_LOG_HEADER_BYTES + frames.size() * FRAME_LOG_MAX_RECORD_BYTES);
+    FrameEncoder enc;
+    size_t n = FrameEncoder::writeHeader(stream.data());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (i == 150) enc.resync();
+        n += enc.encodeFrame(frames[i], stream.data() + n);
+    }
+
+    FrameDecoder dec;
+    ASSERT_TRUE(dec.begin(stream.data(), n));
+    for (const SensorFrame& f : frames) {
+        ASSERT_EQ(dec.next(), FrameDecoder::Record::FRAME);
+        expectSameFrame(dec.frame(), recordable(f));
+    }
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::END);
+    EXPECT_EQ(dec.offset(), n);
+}
+
+TEST(FrameCodecTest, PackedFramesAreSmallerThanTheStruct) {
+    FrameEncoder enc;
+    uint8_t rec[FRAME_LOG_MAX_RECORD_BYTES];
+    size_t total = 0;
+    constexpr int kFrames = 100;
+    for (int i = 0; i < kFrames; ++i) {
+        total += enc.encodeFrame(makeFrame(10000ull * (i + 1), i), rec);
+    }
+    EXPECT_LT(total / kFrames, sizeof(SensorFrame) * 6 / 10);
+
+    // A repeated baro reading costs one byte per field
+    SensorFrame a = makeFrame(1000000, 1);
+    a.mag_valid = a.lrf_valid = a.encoder_valid = a.baro_humidity_valid = false;
+    SensorFrame b = a;
+    b.timestamp_us += 10000;
+    enc.encodeFrame(a, rec);
+    size_t delta = enc.encodeFrame(b, rec);
+    EXPECT_EQ(delta, 2u + 1u + 3u + 24u + 2u); // record, flags, 10 ms, IMU, baro
+}
+
+TEST(FrameCodecTest, DecoderSkipsUnknownRecordsAndRejectsOrphanDeltas) {
+    uint8_t stream[3 * FRAME_LOG_MAX_RECORD_BYTES];
+    FrameEncoder enc;
+    size_t n = FrameEncoder::writeHeader(stream);
+    stream[n++] = 0x7F; // record type from a newer writer
+    stream[n++] = 3;
+    stream[n++] = 1;
+    stream[n++] = 2;
+    stream[n++] = 3;
+    n += enc.encodeFrame(makeFrame(10000, 0), stream + n);
+    n += enc.encodeFrame(makeFrame(20000, 1), stream + n);
+
+    FrameDecoder dec;
+    ASSERT_TRUE(dec.begin(stream, n));
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::FRAME);
+    EXPECT_EQ(dec.frame().timestamp_us, 10000u);
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::FRAME);
+    EXPECT_EQ(dec.frame().timestamp_us, 20000u);
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::END);
+
+    // Without its key frame a delta frame cannot be decoded
+    uint8_t orphan[FRAME_LOG_HEADER_BYTES + FRAME_LOG_MAX_RECORD_BYTES];
+    size_t m = FrameEncoder::writeHeader(orphan);
+    m += enc.encodeFrame(makeFrame(30000, 2), orphan + m);
+    ASSERT_TRUE(dec.begin(orphan, m));
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::INVALID);
+
+    // Another format version is refused
+    stream[4] ^= 0xFF;
+    EXPECT_FALSE(dec.begin(stream, n));
+}
+
+TEST(FrameCodecTest, IntegratorRecordCarriesTuningAndReadsOlderRecords) {
+    uint8_t stream[FRAME_LOG_HEADER_BYTES + 2 * FRAME_LOG_MAX_RECORD_BYTES];
+    size_t n = FrameEncoder::writeHeader(stream);
+    IntegratorTuning t = {IntegratorMethod::RK4, 0.0f, 1.5f, 4.0f, 0.002f, 0.0f};
+    n += FrameEncoder::encodeIntegrator(t, stream + n);
+    // Record written before the step parameters existed: method and tolerance
+    stream[n++] = 0x12;
+    stream[n++] = 5;
+    stream[n++] = static_cast<uint8_t>(IntegratorMethod::DORMAND_PRINCE);
+    const float tol = 0.01f;
+    std::memcpy(stream + n, &tol, sizeof(tol));
+    n += sizeof(tol);
+
+    FrameDecoder dec;
+    ASSERT_TRUE(dec.begin(stream, n));
+    ASSERT_EQ(dec.next(), FrameDecoder::Record::INTEGRATOR);
+    EXPECT_EQ(dec.integratorTuning().method, IntegratorMethod::RK4);
+    EXPECT_EQ(dec.integratorTuning().step_scale_m, 1.5f);
+    EXPECT_EQ(dec.integratorTuning().max_step_m, 4.0f);
+    EXPECT_EQ(dec.integratorTuning().transonic_dt_s, 0.002f);
+    ASSERT_EQ(dec.next(), FrameDecoder::Record::INTEGRATOR);
+    EXPECT_EQ(dec.integratorMethod(), IntegratorMethod::DORMAND_PRINCE);
+    EXPECT_EQ(dec.integratorTolerance(), 0.01f);
+    EXPECT_EQ(dec.integratorTuning().step_scale_m, 0.0f);
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::END);
+
+    // A record cut inside the step parameters is malformed
+    size_t m = FrameEncoder::writeHeader(stream);
+    stream[m++] = 0x12;
+    stream[m++] = 9;
+    std::memset(stream + m, 0, 9);
+    m += 9;
+    ASSERT_TRUE(dec.begin(stream, m));
+    EXPECT_EQ(dec.next(), FrameDecoder::Record::INVALID);
+}
+
+TEST(FrameRecorderTest, FullRingDropsWholeRecordsAndResyncs) {
+    static FrameRecorder rec;
+    rec.reset();
+    BulletProfile bullet = {};
+    bullet.bc = 0.475f;
+    bullet.drag_model = DragModel::G7;
+    rec.recordBullet(bullet);
+    rec.start();
+
+    // Record far more than the ring holds without draining, then a tail
+    // after draining
+    std::vector<SensorFrame> sent;
+    int i = 0;
+    for (; i < 400; ++i) {
+        sent.push_back(makeFrame(10000ull * (i + 1), i));
+        rec.recordFrame(sent.back());
+    }
+    const uint32_t dropped = rec.getDropped();
+    EXPECT_GT(dropped, 0u);
+    std::vector<uint8_t> stream = drain(rec);
+    for (; i < 420; ++i) {
+        sent.push_back(makeFrame(10000ull * (i + 1), i));
+        rec.recordFrame(sent.back());
+    }
+    EXPECT_EQ(rec.getDropped(), dropped);
+    std::vector<uint8_t> more = drain(rec);
+    stream.insert(stream.end(), more.begin(), more.end());
+
+    FrameDecoder dec;
+    ASSERT_TRUE(dec.begin(stream.data(), stream.size()));
+    int frames = 0;
+    int bullets = 0;
+    size_t next_sent = 0;
+    for (;;) {
+        FrameDecoder::Record r = dec.next();
+        if (r == FrameDecoder::Record::END) break;
+        ASSERT_NE(r, FrameDecoder::Record::INVALID);
+        if (r == FrameDecoder::Record::BULLET) {
+            bullets++;
+            EXPECT_EQ(dec.bullet().drag_model, DragModel::G7);
+        } else if (r == FrameDecoder::Record::FRAME) {
+            frames++;
+            while (next_sent < sent.size() && sent[next_sent].timestamp_us != dec.frame().timestamp_us) {
+                next_sent++;
+            }
+            ASSERT_LT(next_sent, sent.size());
+            expectSameFrame(dec.frame(), recordable(sent[next_sent]));
+        }
+    }
+    EXPECT_EQ(static_cast<uint32_t>(frames) + dropped, sent.size());
+    EXPECT_EQ(bullets, 2); // at start, and again after the gap
+}
+
+TEST(FrameRecorderTest, ConcurrentDrainKeepsStreamIntact) {
+    static FrameRecorder rec;
+    rec.reset();
+    rec.start();
+
+    constexpr int kFrames = 20000;
+    std::atomic<bool> done{false};
+    std::vector<uint8_t> stream;
+    std::thread reader([&] {
+        uint8_t buf[256];
+        for (;;) {
+            bool finished = done.load(std::memory_order_acquire);
+            size_t n = rec.read(buf, sizeof(buf));
+            stream.insert(stream.end(), buf, buf + n);
+            if (n == 0 && finished) break;
+        }
+    });
+    for (int i = 0; i < kFrames; ++i) rec.recordFrame(makeFrame(10000ull * (i + 1), i));
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    FrameDecoder dec;
+    ASSERT_TRUE(dec.begin(stream.data(), stream.size()));
+    uint32_t frames = 0;
+    uint64_t last_ts = 0;
+    FrameDecoder::Record r;
+    while ((r = dec.next()) != FrameDecoder::Record::END) {
+        ASSERT_NE(r, FrameDecoder::Record::INVALID);
+        if (r != FrameDecoder::Record::FRAME) continue;
+        const uint64_t ts = dec.frame().timestamp_us;
+        ASSERT_GT(ts, last_ts);
+        expectSameFrame(dec.frame(), recordable(makeFrame(ts, static_cast<int>(ts / 10000) - 1)));
+        last_ts = ts;
+        frames++;
+    }
+    EXPECT_EQ(frames + rec.getDropped(), static_cast<uint32_t>(kFrames));
+    EXPECT_EQ(dec.offset(), stream.size());
+}
+
+// A recorded session replays through a fresh engine to the same solution
+TEST(FrameRecorderTest, EngineRecordingReplaysToSameSolution) {
+    BCE_Init();
+    BulletProfile bullet = {};
+    bullet.bc = 0.505f;
+    bullet.drag_model = DragModel::G1;
+    bullet.muzzle_velocity_ms = 792.0f;
+    bullet.mass_grains = 175.0f;
+    bullet.caliber_inches = 0.308f;
+    bullet.twist_rate_inches = 10.0f;
+    BCE_SetBulletProfile(&bullet);
+    BCE_SetRecorderMode(true);
+
+    std::vector<uint8_t> stream;
+    uint8_t buf[512];
+    for (int i = 0; i < 150; ++i) {
+        if (i == 40) {
+            ZeroConfig zero = {100.0f, 38.1f};
+            BCE_SetZeroConfig(&zero);
+        }
+        SensorFrame f = makeFrame(10000ull * (i + 1), i);
+        f.mag_valid = false; // keep the AHRS on gravity alone
+        f.lrf_valid = true;
+        f.lrf_range_m = 400.0f + static_cast<float>(i);
+        f.lrf_timestamp_us = f.timestamp_us;
+        f.lrf_confidence = 1.0f;
+        BCE_Update(&f);
+        size_t n;
+        while ((n = BCE_ReadRecorder(buf, sizeof(buf))) > 0) stream.insert(stream.end(), buf, buf + n);
+    }
+    EXPECT_EQ(BCE_GetRecorderDropped(), 0u);
+    ASSERT_EQ(BCE_GetMode(), BCE_Mode::SOLUTION_READY);
+    FiringSolution live;
+    BCE_GetSolution(&live);
+
+    BCE_Init();
+    FrameDecoder dec;
+    ASSERT_TRUE(dec.begin(stream.data(), stream.size()));
+    int frames = 0;
+    FrameDecoder::Record r;
+    while ((r = dec.next()) != FrameDecoder::Record::END) {
+        ASSERT_NE(r, FrameDecoder::Record::INVALID);
+        switch (r) {
+        case FrameDecoder::Record::FRAME: BCE_Update(&dec.frame()); frames++; break;
+        case FrameDecoder::Record::BULLET: BCE_SetBulletProfile(&dec.bullet()); break;
+        case FrameDecoder::Record::ZERO: BCE_SetZeroConfig(&dec.zero()); break;
+        case FrameDecoder::Record::INTEGRATOR:
+            BCE_SetIntegratorTuning(&dec.integratorTuning());
+            break;
+        default: break;
+        }
+    }
+    EXPECT_EQ(frames, 150);
+    FiringSolution replayed;
+    BCE_GetSolution(&replayed);
+    EXPECT_EQ(replayed.solution_mode, live.solution_mode);
+    EXPECT_EQ(std::memcmp(&replayed.hold_elevation_moa, &live.hold_elevation_moa,
+                          sizeof(FiringSolution) - offsetof(FiringSolution, hold_elevation_moa)),
+              0);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_seqlock.cpp
+ * @brief Unit tests for the single-writer sequence lock.
+ */
+
+#include <gtest/gtest.h>
+#include "../lib/bce/src/engine/bce_seqlock.h"
+#include <atomic>
+#include <thread>
+
+namespace {
+
+struct Payload {
+    uint32_t words[24];
+    uint16_t tail; // size not a multiple of 4
+};
+
+Payload makePayload(uint32_t value) {
+    Payload p = {};
+    for (uint32_t& w : p.words) w = value;
+    p.tail = static_cast<uint16_t>(value);
+    return p;
+}
+
+} // namespace
+
+TEST(SeqLockTest, StoreLoadRoundTrip) {
+    static SeqLock<Payload> lock;
+    lock.reset();
+    EXPECT_EQ(lock.version(), 0u);
+
+    Payload out;
+    EXPECT_EQ(lock.load(out), 0u);
+    EXPECT_EQ(out.words[0], 0u);
+
+    lock.store(makePayload(7));
+    lock.store(makePayload(9));
+    EXPECT_EQ(lock.version(), 2u);
+    EXPECT_EQ(lock.load(out), 2u);
+    for (uint32_t w : out.words) EXPECT_EQ(w, 9u);
+    EXPECT_EQ(out.tail, 9u);
+}
+
+TEST(SeqLockTest, ConcurrentReadsNeverTear) {
+    static SeqLock<Payload> lock;
+    lock.reset();
+    constexpr uint32_t kStores = 20000;
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint32_t i = 1; i <= kStores; ++i) {
+            lock.store(makePayload(i));
+        }
+        done.store(true);
+    });
+
+    uint32_t last_version = 0;
+    while (!done.load()) {
+        Payload p;
+        uint32_t version = lock.load(p);
+        ASSERT_GE(version, last_version);
+        last_version = version;
+        for (uint32_t w : p.words) ASSERT_EQ(w, p.words[0]);
+        ASSERT_EQ(p.tail, static_cast<uint16_t>(p.words[0]));
+        ASSERT_EQ(p.words[0], version);
+    }
+    writer.join();
+
+    Payload p;
+    EXPECT_EQ(lock.load(p), kStores);
+    EXPECT_EQ(p.words[0], kStores);
+}
+
+TEST(SeqLockTest, DoubleBufferAlternatesSlotsAndCountsGenerations) {
+    static DoubleBufferedSeqLock<Payload> lock;
+    lock.reset();
+    EXPECT_EQ(lock.generation(), 0u);
+
+    Payload out;
+    EXPECT_EQ(lock.load(out), 0u);
+
+    for (uint32_t i = 1; i <= 5; ++i) {
+        lock.store(makePayload(100 + i));
+        EXPECT_EQ(lock.generation(), i);
+        EXPECT_EQ(lock.load(out), i);
+        for (uint32_t w : out.words) EXPECT_EQ(w, 100 + i);
+    }
+}
+
+TEST(SeqLockTest, DoubleBufferConcurrentReadsNeverTear) {
+    static DoubleBufferedSeqLock<Payload> lock;
+    lock.reset();
+    constexpr uint32_t kStores = 20000;
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint32_t i = 1; i <= kStores; ++i) {
+            lock.store(makePayload(i));
+        }
+        done.store(true);
+    });
+
+    uint32_t last_generation = 0;
+    while (!done.load()) {
+        Payload p;
+        uint32_t generation = lock.load(p);
+        ASSERT_GE(generation, last_generation);
+        last_generation = generation;
+        for (uint32_t w : p.words) ASSERT_EQ(w, p.words[0]);
+        ASSERT_EQ(p.tail, static_cast<uint16_t>(p.words[0]));
+        ASSERT_EQ(p.words[0], generation);
+    }
+    writer.join();
+
+    Payload p;
+    EXPECT_EQ(lock.load(p), kStores);
+    EXPECT_EQ(p.words[0], kStores);
+}
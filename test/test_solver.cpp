@@ -5,8 +5,21 @@
 
 #include <gtest/gtest.h>
 #include "../lib/bce/src/solver/solver.h"
+#include "../lib/bce/src/solver/batch_solver.h"
+#include "../lib/bce/src/solver/angle_cache.h"
+#include "../lib/bce/src/solver/compact_table.h"
+#include "../lib/bce/src/math/fast_math.h"
 #include "bce/bce_config.h"
 #include <cmath>
+#include <initializer_list>
+
+// Extra TOF allowance for results read back from the trajectory table: the
+// fixed-point table resolves TOF to ~3e-5 s over a full 2500 m table
+#if BCE_TRAJ_TABLE_COMPACT
+constexpr float TABLE_TOF_QUANT_S = 3e-5f;
+#else
+constexpr float TABLE_TOF_QUANT_S = 0.0f;
+#endif
 
 class SolverTest : public ::testing::Test {
 protected:
@@ -45,6 +58,69 @@ TEST_F(SolverTest, ZeroAngleSmallPositive) {
     EXPECT_LT(angle, 1.0f * BCE_DEG_TO_RAD); // less than 1 degree for 100m
 }
 
+// Zero solution should put the bullet on the line of sight at the zero range
+TEST_F(SolverTest, ZeroAngleHitsLineOfSight) {
+    SolverParams p = make308Params(100.0f);
+    float angle = solver.solveZeroAngle(p, 100.0f);
+    ASSERT_FALSE(std::isnan(angle));
+
+    p.launch_angle_rad = angle;
+    SolverResult r = solver.integrate(p);
+    ASSERT_TRUE(r.valid);
+    EXPECT_NEAR(r.drop_at_target_m, -p.sight_height_m, 2.0f * BCE_ZERO_TOLERANCE_M);
+}
+
+// Warm-started zero solves converge in a handful of integrations
+TEST_F(SolverTest, ZeroAngleWarmStartConvergesQuickly) {
+    SolverParams p = make308Params(100.0f);
+    float cold = solver.solveZeroAngle(p, 100.0f);
+    ASSERT_FALSE(std::isnan(cold));
+    EXPECT_LE(solver.getLastZeroIterations(), 6u);
+
+    // Small atmosphere change, as from a baro update
+    p.air_density *= 0.98f;
+    float warm = solver.solveZeroAngle(p, 100.0f, cold);
+    ASSERT_FALSE(std::isnan(warm));
+    EXPECT_LE(solver.getLastZeroIterations(), 4u);
+    EXPECT_NEAR(warm, cold, 0.0005f);
+
+    // A bad warm start still converges via the bracketed fallback
+    float recovered = solver.solveZeroAngle(p, 100.0f, 4.9f * BCE_DEG_TO_RAD);
+    EXPECT_NEAR(recovered, warm, 0.0001f);
+}
+
+#if BCE_ZERO_COARSE_PASS
+// The coarse pass leaves one or two full-fidelity integrations, and the
+// refined zero still meets the tolerance on the fine integrator
+TEST_F(SolverTest, ZeroCoarsePassRefinesInFewIntegrations) {
+    {
+        SolverParams p = make308Params(300.0f);
+        float cold = solver.solveZeroAngle(p, 300.0f);
+        ASSERT_FALSE(std::isnan(cold));
+        EXPECT_GT(solver.getLastZeroCoarseIterations(), 0u);
+        EXPECT_LE(solver.getLastZeroIterations(), 2u);
+
+        p.air_density *= 0.98f;
+        float warm = solver.solveZeroAngle(p, 300.0f, cold);
+        ASSERT_FALSE(std::isnan(warm));
+        EXPECT_LE(solver.getLastZeroIterations(), 2u);
+
+        p.launch_angle_rad = warm;
+        SolverResult r = solver.integrate(p);
+        ASSERT_TRUE(r.valid);
+        EXPECT_NEAR(r.drop_at_target_m, -p.sight_height_m, 2.0f * BCE_ZERO_TOLERANCE_M);
+    }
+
+    // The adaptive and range-domain integrators solve in a single pass
+    for (IntegratorMethod method : {IntegratorMethod::DORMAND_PRINCE, IntegratorMethod::RK4_RANGE}) {
+        SolverParams p = make308Params(300.0f);
+        p.integrator = method;
+        ASSERT_FALSE(std::isnan(solver.solveZeroAngle(p, 300.0f)));
+        EXPECT_EQ(solver.getLastZeroCoarseIterations(), 0u);
+    }
+}
+#endif
+
 // Zero angle at 200m should be larger than at 100m
 TEST_F(SolverTest, ZeroAngleIncreasesWithRange) {
     SolverParams p = make308Params(100.0f);
@@ -153,6 +229,41 @@ TEST_F(SolverTest, TrajectoryTableOutOfRange) {
     EXPECT_EQ(pt, nullptr);
 }
 
+// Sub-meter lookups reproduce stored records and stay between neighbours
+TEST_F(SolverTest, PointAtRangeInterpolatesBetweenRecords) {
+    SolverParams p = make308Params(1000.0f);
+    p.launch_angle_rad = 0.003f;
+    p.crosswind_ms = 4.0f;
+    ASSERT_TRUE(solver.integrate(p).valid);
+
+    const TrajectoryPoint* node = solver.getPointAt(500);
+    ASSERT_NE(node, nullptr);
+    TrajectoryPoint at_node;
+    ASSERT_TRUE(solver.getPointAtRange(500.0f, at_node));
+    EXPECT_FLOAT_EQ(at_node.drop_m, node->drop_m);
+    EXPECT_FLOAT_EQ(at_node.tof_s, node->tof_s);
+
+    TrajectoryPoint lo, mid, hi;
+    ASSERT_TRUE(solver.getPointAtRange(700.0f, lo));
+    ASSERT_TRUE(solver.getPointAtRange(700.5f, mid));
+    ASSERT_TRUE(solver.getPointAtRange(701.0f, hi));
+    EXPECT_LT(mid.drop_m, lo.drop_m);
+    EXPECT_GT(mid.drop_m, hi.drop_m);
+    EXPECT_GT(mid.windage_m, lo.windage_m);
+    EXPECT_LT(mid.windage_m, hi.windage_m);
+    EXPECT_GT(mid.tof_s, lo.tof_s);
+    EXPECT_LT(mid.tof_s, hi.tof_s);
+    EXPECT_LT(mid.velocity_ms, lo.velocity_ms);
+    EXPECT_GT(mid.velocity_ms, hi.velocity_ms);
+
+    // Half a meter of flight at ~420 m/s is ~1.2 ms
+    EXPECT_NEAR(mid.tof_s - lo.tof_s, 0.5f / lo.velocity_ms, 0.0001f);
+
+    TrajectoryPoint beyond;
+    EXPECT_FALSE(solver.getPointAtRange(1500.0f, beyond));
+    EXPECT_FALSE(solver.getPointAtRange(-1.0f, beyond));
+}
+
 // Crosswind should produce lateral deflection
 TEST_F(SolverTest, CrosswindProducesWindage) {
     SolverParams p = make308Params(500.0f);
@@ -277,3 +388,580 @@ TEST_F(SolverTest, UnsolvableZeroReturnsNAN) {
     float angle = solver.solveZeroAngle(p, 2000.0f); // Very long range
     EXPECT_TRUE(std::isnan(angle));
 }
+
+// Sampling a horizon-length trajectory should match a per-range integration
+TEST_F(SolverTest, SampleTrajectoryMatchesIntegrate) {
+    SolverParams p = make308Params(0.0f);
+    p.launch_angle_rad = 0.003f;
+    p.crosswind_ms = 3.0f;
+
+    ASSERT_TRUE(solver.integrateTrajectory(p, 1200.0f));
+    EXPECT_GE(solver.getMaxValidRange(), 1200);
+
+    const float ranges[] = {100.0f, 437.0f, 800.0f, 1200.0f};
+    SolverResult sampled[4];
+    for (int i = 0; i < 4; ++i) {
+        sampled[i] = solver.sampleTrajectory(p, ranges[i]);
+    }
+
+    BallisticSolver reference;
+    reference.init();
+    for (int i = 0; i < 4; ++i) {
+        SolverParams q = p;
+        q.target_range_m = ranges[i];
+        SolverResult direct = reference.integrate(q);
+        ASSERT_TRUE(sampled[i].valid);
+        ASSERT_TRUE(direct.valid);
+        EXPECT_NEAR(sampled[i].drop_at_target_m, direct.drop_at_target_m, 0.001f);
+        EXPECT_NEAR(sampled[i].windage_at_target_m, direct.windage_at_target_m, 0.001f);
+        EXPECT_NEAR(sampled[i].tof_s, direct.tof_s, 0.0001f);
+    }
+
+    // Beyond the tabulated horizon there is no answer
+    SolverResult beyond = solver.sampleTrajectory(p, 1300.0f);
+    EXPECT_FALSE(beyond.valid);
+}
+
+// Dormand–Prince mode should match RK4 with an order of magnitude fewer steps
+TEST_F(SolverTest, DormandPrinceMatchesRK4WithFewerSteps) {
+    const float ranges[] = {300.0f, 800.0f, 1200.0f};
+    for (float range : ranges) {
+        SolverParams p = make308Params(range);
+        p.launch_angle_rad = 0.005f;
+        p.crosswind_ms = 4.0f;
+
+        SolverResult rk4 = solver.integrate(p);
+        uint32_t rk4_steps = solver.getLastStepCount();
+
+        p.integrator = IntegratorMethod::DORMAND_PRINCE;
+        SolverResult dp = solver.integrate(p);
+        uint32_t dp_steps = solver.getLastStepCount();
+
+        // The legacy RK4 path accumulates float rounding over ~10^5 transonic
+        // steps, so agreement is bounded by its error (~1 cm per km)
+        ASSERT_TRUE(rk4.valid);
+        ASSERT_TRUE(dp.valid);
+        EXPECT_NEAR(dp.drop_at_target_m, rk4.drop_at_target_m, 0.02f) << range;
+        EXPECT_NEAR(dp.windage_at_target_m, rk4.windage_at_target_m, 0.02f) << range;
+        EXPECT_NEAR(dp.tof_s, rk4.tof_s, 0.002f) << range;
+        EXPECT_NEAR(dp.velocity_at_target_ms, rk4.velocity_at_target_ms, 0.1f) << range;
+        EXPECT_LT(dp_steps * 10u, rk4_steps) << range;
+    }
+}
+
+// The calm-air kernel (two axes, no wind terms) must agree with the wind
+// kernel run with a negligible crosswind, for both integrators
+TEST_F(SolverTest, CalmKernelMatchesWindKernel) {
+    for (IntegratorMethod method : {IntegratorMethod::RK4, IntegratorMethod::DORMAND_PRINCE}) {
+        for (float range : {300.0f, 800.0f}) {
+            SolverParams p = make308Params(range);
+            p.launch_angle_rad = 0.005f;
+            p.integrator = method;
+
+            SolverResult calm = solver.integrate(p);
+            TrajectoryPoint calm_mid;
+            ASSERT_TRUE(solver.getPointAtRange(0.5f * range, calm_mid));
+
+            p.crosswind_ms = 1e-4f;
+            SolverResult wind = solver.integrate(p);
+            TrajectoryPoint wind_mid;
+            ASSERT_TRUE(solver.getPointAtRange(0.5f * range, wind_mid));
+
+            ASSERT_TRUE(calm.valid);
+            ASSERT_TRUE(wind.valid);
+            EXPECT_NEAR(calm.windage_at_target_m, 0.0f, 1e-4f); // exact 0 unless the table is compact
+            EXPECT_NEAR(wind.windage_at_target_m, 0.0f, 1e-3f);
+            EXPECT_NEAR(calm.drop_at_target_m, wind.drop_at_target_m, 1e-3f) << range;
+            EXPECT_NEAR(calm.tof_s, wind.tof_s, 1e-5f + TABLE_TOF_QUANT_S) << range;
+            EXPECT_NEAR(calm.velocity_at_target_ms, wind.velocity_at_target_ms, 0.01f) << range;
+            EXPECT_NEAR(calm_mid.drop_m, wind_mid.drop_m, 1e-3f) << range;
+        }
+    }
+}
+
+// Sliced jobs take the same steps as the blocking calls, whatever the slice
+TEST_F(SolverTest, SlicedJobsMatchBlockingSolves) {
+    for (IntegratorMethod method : {IntegratorMethod::RK4, IntegratorMethod::DORMAND_PRINCE,
+                                    IntegratorMethod::RK4_RANGE}) {
+        SolverParams p = make308Params(1000.0f);
+        p.integrator = method;
+        p.crosswind_ms = 3.0f;
+        float zero = solver.solveZeroAngle(p, 300.0f);
+        uint32_t zero_iterations = solver.getLastZeroIterations();
+        uint32_t coarse_iterations = solver.getLastZeroCoarseIterations();
+        ASSERT_FALSE(std::isnan(zero));
+
+        p.launch_angle_rad = zero;
+        ASSERT_TRUE(solver.integrateTrajectory(p, 1500.0f));
+        const int extent = solver.getMaxValidRange();
+        TrajectoryPoint whole[3];
+        for (int k = 0; k < 3; ++k) {
+            ASSERT_TRUE(solver.getPointAtRange(123.4f + 500.0f * k, whole[k]));
+        }
+
+        for (uint32_t slice : {1u, 37u, 100000u}) {
+            EXPECT_FALSE(solver.hasJob());
+            solver.beginZeroSolve(p, 300.0f, NAN);
+            int calls = 1;
+            while (!solver.stepJob(slice)) {
+                ASSERT_TRUE(solver.hasJob());
+                ASSERT_LT(++calls, 1000000);
+            }
+            EXPECT_EQ(solver.getJobZeroAngle(), zero) << slice;
+            EXPECT_EQ(solver.getLastZeroIterations(), zero_iterations);
+            EXPECT_EQ(solver.getLastZeroCoarseIterations(), coarse_iterations);
+
+            solver.beginTrajectory(p, 1500.0f);
+            while (!solver.stepJob(slice)) {
+                ASSERT_TRUE(solver.hasJob());
+            }
+            EXPECT_EQ(solver.getMaxValidRange(), extent);
+            for (int k = 0; k < 3; ++k) {
+                TrajectoryPoint sliced;
+                ASSERT_TRUE(solver.getPointAtRange(123.4f + 500.0f * k, sliced));
+                EXPECT_EQ(sliced.drop_m, whole[k].drop_m) << slice;
+                EXPECT_EQ(sliced.windage_m, whole[k].windage_m);
+                EXPECT_EQ(sliced.tof_s, whole[k].tof_s);
+                EXPECT_EQ(sliced.velocity_ms, whole[k].velocity_ms);
+            }
+        }
+    }
+
+    // A blocking table fill cancels a pending trajectory job
+    SolverParams p = make308Params(1000.0f);
+    solver.beginTrajectory(p, 1500.0f);
+    EXPECT_FALSE(solver.stepJob(10));
+    solver.integrateTrajectory(p, 500.0f);
+    EXPECT_FALSE(solver.hasJob());
+    EXPECT_FALSE(solver.stepJob(10));
+}
+
+// Dormand–Prince mode must produce a usable zero and trajectory table
+TEST_F(SolverTest, DormandPrinceZeroAndTable) {
+    SolverParams p = make308Params(100.0f);
+    p.integrator = IntegratorMethod::DORMAND_PRINCE;
+    float angle = solver.solveZeroAngle(p, 100.0f);
+    ASSERT_FALSE(std::isnan(angle));
+
+    p.launch_angle_rad = angle;
+    ASSERT_TRUE(solver.integrateTrajectory(p, 1000.0f));
+    TrajectoryPoint at_zero;
+    ASSERT_TRUE(solver.getPointAtRange(100.0f, at_zero));
+    EXPECT_NEAR(at_zero.drop_m, -p.sight_height_m, 2.0f * BCE_ZERO_TOLERANCE_M);
+
+    // Table records are monotonic even though steps span many meters
+    float prev_tof = 0.0f;
+    for (int r = 10; r <= 1000; r += 10) {
+        const TrajectoryPoint* pt = solver.getPointAt(r);
+        ASSERT_NE(pt, nullptr);
+        EXPECT_GT(pt->tof_s, prev_tof);
+        prev_tof = pt->tof_s;
+    }
+}
+
+// Range-domain RK4 lands on every record and the target without crossing
+// reconstruction, in range / step steps, and tracks a tight Dormand–Prince
+// reference to the millimeter
+TEST_F(SolverTest, RangeDomainMatchesReference) {
+    const float stride = static_cast<float>(BCE_TRAJ_TABLE_STRIDE_M);
+    const float step_m = stride / std::ceil(stride / BCE_RANGE_STEP_M);
+    for (float range : {100.0f, 537.5f, 1200.0f, 1800.0f}) {
+        SolverParams p = make308Params(range);
+        p.launch_angle_rad = 0.005f;
+        p.crosswind_ms = 3.0f;
+        p.integrator = IntegratorMethod::DORMAND_PRINCE;
+        p.integrator_tolerance_m = 1e-7f;
+        SolverResult ref = solver.integrate(p);
+
+        p.integrator = IntegratorMethod::RK4_RANGE;
+        p.integrator_tolerance_m = 0.0f;
+        SolverResult res = solver.integrate(p);
+        ASSERT_TRUE(res.valid);
+        const float node = std::ceil(range / stride) * stride;
+        EXPECT_EQ(solver.getLastStepCount(), static_cast<uint32_t>(std::ceil(node / step_m - 1e-3f)))
+            << range;
+        EXPECT_NEAR(res.drop_at_target_m, ref.drop_at_target_m, 1e-3f) << range;
+        EXPECT_NEAR(res.windage_at_target_m, ref.windage_at_target_m, 1e-3f) << range;
+        EXPECT_NEAR(res.tof_s, ref.tof_s, 1e-5f + 2.0f * TABLE_TOF_QUANT_S) << range; // both tabled
+        EXPECT_NEAR(res.velocity_at_target_ms, ref.velocity_at_target_ms, 0.02f) << range;
+    }
+
+    // The zero solve ends its last step on the zero range itself
+    SolverParams p = make308Params(100.0f);
+    p.integrator = IntegratorMethod::RK4_RANGE;
+    float angle = solver.solveZeroAngle(p, 91.44f);
+    ASSERT_FALSE(std::isnan(angle));
+    p.integrator = IntegratorMethod::DORMAND_PRINCE;
+    EXPECT_NEAR(angle, solver.solveZeroAngle(p, 91.44f), 1e-6f);
+
+    // A bullet slowing below the floor short of the target is not a solution
+    p.integrator = IntegratorMethod::RK4_RANGE;
+    p.muzzle_velocity_ms = 40.0f;
+    p.target_range_m = 1500.0f;
+    p.launch_angle_rad = 0.0f;
+    EXPECT_FALSE(solver.integrate(p).valid);
+}
+
+// Run-time step controls: coarser RK4 steps cut the step count while staying
+// close to a tight Dormand–Prince reference, the batch path follows the same
+// controls, and the range step sets the RK4_RANGE step count
+TEST_F(SolverTest, IntegratorTuningTradesStepsForAccuracy) {
+    for (float range : {600.0f, 1200.0f}) {
+        SolverParams p = make308Params(range);
+        p.launch_angle_rad = 0.005f;
+        p.crosswind_ms = 4.0f;
+        p.integrator = IntegratorMethod::DORMAND_PRINCE;
+        p.integrator_tolerance_m = 1e-7f;
+        SolverResult ref = solver.integrate(p);
+
+        p.integrator = IntegratorMethod::RK4;
+        p.integrator_tolerance_m = 0.0f;
+        SolverResult legacy = solver.integrate(p);
+        const uint32_t legacy_steps = solver.getLastStepCount();
+
+        p.integrator_step_scale_m = 1.0f;
+        p.integrator_max_step_m = 1.0f;
+        p.integrator_transonic_dt_s = 2e-4f;
+        SolverResult tuned = solver.integrate(p);
+        const uint32_t tuned_steps = solver.getLastStepCount();
+        ASSERT_TRUE(legacy.valid);
+        ASSERT_TRUE(tuned.valid);
+        EXPECT_LT(tuned_steps * 2u, legacy_steps) << range;
+        EXPECT_NEAR(tuned.drop_at_target_m, ref.drop_at_target_m, 0.02f) << range;
+        EXPECT_NEAR(tuned.windage_at_target_m, ref.windage_at_target_m, 0.02f) << range;
+        EXPECT_NEAR(tuned.tof_s, ref.tof_s, 0.002f) << range;
+
+        SolverResult batch;
+        ASSERT_EQ(BatchSolver::solve(&p, 1, &batch), 1);
+        EXPECT_NEAR(batch.drop_at_target_m, tuned.drop_at_target_m, 1e-3f) << range;
+        EXPECT_NEAR(batch.tof_s, tuned.tof_s, 1e-5f + TABLE_TOF_QUANT_S) << range;
+    }
+
+    SolverParams p = make308Params(800.0f);
+    p.integrator = IntegratorMethod::RK4_RANGE;
+    solver.integrate(p);
+    const uint32_t default_steps = solver.getLastStepCount();
+    p.integrator_range_step_m = 0.25f * static_cast<float>(BCE_TRAJ_TABLE_STRIDE_M);
+    ASSERT_TRUE(solver.integrate(p).valid);
+    EXPECT_GT(solver.getLastStepCount(), default_steps);
+}
+
+// Batch lanes reproduce the scalar RK4 solve across mixed parameters,
+// including a partial final chunk and lanes that terminate early
+TEST_F(SolverTest, BatchMatchesScalarIntegrate) {
+    const int n = BCE_BATCH_LANES + 3;
+    SolverParams params[n];
+    for (int i = 0; i < n; ++i) {
+        params[i] = make308Params(100.0f + 97.0f * i);
+        params[i].muzzle_velocity_ms = 760.0f + 6.0f * i;
+        params[i].bc = 0.45f + 0.01f * i;
+        params[i].crosswind_ms = (i % 3) * 2.0f;
+        params[i].drag_model = (i % 2) ? DragModel::G7 : DragModel::G1;
+        params[i].launch_angle_rad = 0.001f * (i % 4);
+        params[i].spin_drift_enabled = true;
+        params[i].twist_rate_inches = 10.0f;
+    }
+    // Out of bounds, and a bullet falling below BCE_MIN_VELOCITY short of target
+    params[2].target_range_m = 0.0f;
+    params[5].muzzle_velocity_ms = 40.0f;
+    params[5].target_range_m = 1500.0f;
+
+    SolverResult batch[n];
+    int valid = BatchSolver::solve(params, n, batch);
+
+    // The batch reconstructs each target crossing directly, the scalar path
+    // interpolates its table between stride records, hence the 1 mm slack
+
+    int expected = 0;
+    for (int i = 0; i < n; ++i) {
+        SolverResult ref = solver.integrate(params[i]);
+        ASSERT_EQ(batch[i].valid, ref.valid) << i;
+        if (!ref.valid) continue;
+        expected++;
+        EXPECT_NEAR(batch[i].drop_at_target_m, ref.drop_at_target_m, 1e-3f) << i;
+        EXPECT_NEAR(batch[i].windage_at_target_m, ref.windage_at_target_m, 1e-3f) << i;
+        EXPECT_NEAR(batch[i].tof_s, ref.tof_s, 1e-5f + TABLE_TOF_QUANT_S) << i;
+        EXPECT_NEAR(batch[i].velocity_at_target_ms, ref.velocity_at_target_ms, 1e-2f) << i;
+        EXPECT_NEAR(batch[i].spin_drift_moa, ref.spin_drift_moa, 1e-4f) << i;
+    }
+    EXPECT_EQ(valid, expected);
+    EXPECT_FALSE(batch[2].valid);
+    EXPECT_FALSE(batch[5].valid);
+}
+
+// Velocity-banded BC: unit ratios change nothing, one band covering the whole
+// flight acts like its BC, and real bands land between the single-BC
+// extremes, identically in the scalar and batch paths
+TEST_F(SolverTest, BandedBCSelectsBandByVelocity) {
+    SolverParams single = make308Params(1000.0f);
+    single.launch_angle_rad = 0.008f;
+    single.crosswind_ms = 3.0f;
+    SolverResult base = solver.integrate(single);
+
+    SolverParams unit = single;
+    unit.bc_band_count = 2;
+    unit.bc_band_velocity_ms[0] = 600.0f;
+    unit.bc_band_velocity_ms[1] = 450.0f;
+    unit.bc_band_ratio[0] = unit.bc_band_ratio[1] = 1.0f;
+    SolverResult same = solver.integrate(unit);
+    EXPECT_EQ(same.drop_at_target_m, base.drop_at_target_m);
+    EXPECT_EQ(same.tof_s, base.tof_s);
+
+    SolverParams low = single;
+    low.bc *= 0.9f;
+    SolverResult low_bc = solver.integrate(low);
+    SolverParams whole = single;
+    whole.bc_band_count = 1;
+    whole.bc_band_velocity_ms[0] = 2.0f * single.muzzle_velocity_ms;
+    whole.bc_band_ratio[0] = 0.9f;
+    SolverResult whole_band = solver.integrate(whole);
+    EXPECT_NEAR(whole_band.drop_at_target_m, low_bc.drop_at_target_m, 1e-3f);
+    EXPECT_NEAR(whole_band.tof_s, low_bc.tof_s, 1e-5f + TABLE_TOF_QUANT_S);
+
+    // Sierra-style steps: the BC falls as the bullet slows
+    SolverParams banded = single;
+    banded.bc_band_count = 2;
+    banded.bc_band_velocity_ms[0] = 600.0f;
+    banded.bc_band_velocity_ms[1] = 450.0f;
+    banded.bc_band_ratio[0] = 0.95f;
+    banded.bc_band_ratio[1] = 0.9f;
+    SolverResult stepped = solver.integrate(banded);
+    ASSERT_TRUE(stepped.valid);
+    EXPECT_LT(stepped.drop_at_target_m, base.drop_at_target_m - 0.01f);
+    EXPECT_GT(stepped.drop_at_target_m, low_bc.drop_at_target_m + 0.01f);
+
+    SolverResult batch;
+    ASSERT_EQ(BatchSolver::solve(&banded, 1, &batch), 1);
+    EXPECT_NEAR(batch.drop_at_target_m, stepped.drop_at_target_m, 1e-3f);
+    EXPECT_NEAR(batch.windage_at_target_m, stepped.windage_at_target_m, 1e-3f);
+    EXPECT_NEAR(batch.tof_s, stepped.tof_s, 1e-5f + TABLE_TOF_QUANT_S);
+}
+
+// Interpolating across the launch-angle grid reproduces a direct solve at
+// the requested angle. Dormand–Prince keeps the reference free of the
+// step-count noise RK4 accumulates in float over long flights.
+TEST_F(SolverTest, LaunchAngleCacheMatchesDirectIntegrate) {
+    static BallisticSolver fill_solver;
+    static LaunchAngleCache cache;
+    fill_solver.init();
+    cache.reset();
+
+    SolverParams p = make308Params(100.0f);
+    p.integrator = IntegratorMethod::DORMAND_PRINCE;
+    p.crosswind_ms = 3.0f;
+    p.spin_drift_enabled = true;
+    p.twist_rate_inches = 10.0f;
+
+    uint32_t fills = 0;
+    for (float angle : {-0.05f, 0.0012f, 0.0031f, 0.0187f, 0.2f}) {
+        for (float range = 50.0f; range <= 1500.0f; range += 37.0f) {
+            p.launch_angle_rad = angle;
+            p.target_range_m = range;
+            SolverResult cached;
+            ASSERT_TRUE(cache.sample(fill_solver, p, 1500.0f, cached)) << angle << " " << range;
+            fills += cache.getLastFills();
+
+            SolverResult ref = solver.integrate(p);
+            ASSERT_TRUE(ref.valid);
+            float moa_per_m = BCE_RAD_TO_MOA / range;
+            EXPECT_NEAR(cached.drop_at_target_m * moa_per_m, ref.drop_at_target_m * moa_per_m, 0.01f)
+                << angle << " " << range;
+            EXPECT_NEAR(cached.windage_at_target_m * moa_per_m,
+                        ref.windage_at_target_m * moa_per_m, 0.01f) << angle << " " << range;
+            EXPECT_NEAR(cached.tof_s, ref.tof_s, 2e-5f + TABLE_TOF_QUANT_S) << angle << " " << range;
+            EXPECT_NEAR(cached.velocity_at_target_ms, ref.velocity_at_target_ms, 0.1f);
+            EXPECT_NEAR(cached.spin_drift_moa, ref.spin_drift_moa, 1e-3f);
+            EXPECT_FLOAT_EQ(cached.horizontal_range_m, ref.horizontal_range_m);
+        }
+    }
+    // Four grid angles per stencil; the two nearby angles share theirs
+    EXPECT_LE(fills, 4u * 4u);
+
+    // Revisiting a still-tabulated angle integrates nothing
+    p.launch_angle_rad = 0.1995f;
+    p.target_range_m = 640.0f;
+    SolverResult again;
+    ASSERT_TRUE(cache.sample(fill_solver, p, 1500.0f, again));
+    EXPECT_EQ(cache.getLastFills(), 0u);
+
+    // Grid angles that fall below BCE_MIN_VELOCITY short of the target are
+    // left to the direct solve
+    cache.reset();
+    p.muzzle_velocity_ms = 40.0f;
+    p.target_range_m = 1500.0f;
+    EXPECT_FALSE(cache.sample(fill_solver, p, 1500.0f, again));
+}
+
+// Fixed-point records against the float table they were encoded from, flat
+// and steeply uphill, with the table reused between fills
+TEST_F(SolverTest, CompactTableMatchesFloatTable) {
+    static CompactTrajectoryTable compact;
+    compact.clear();
+
+    SolverParams p = make308Params(100.0f);
+    p.crosswind_ms = 5.0f;
+    for (float angle : {0.0025f, 0.35f}) {
+        p.launch_angle_rad = angle;
+        ASSERT_TRUE(solver.integrateTrajectory(p, static_cast<float>(BCE_MAX_RANGE_M)));
+        const int last = solver.getMaxValidRange() / BCE_TRAJ_TABLE_STRIDE_M;
+        ASSERT_GT(last, 1);
+        for (int i = 0; i <= last; ++i) {
+            compact.store(i, *solver.getPointAt(i * BCE_TRAJ_TABLE_STRIDE_M));
+        }
+
+        for (int i = 0; i <= last; ++i) {
+            const TrajectoryPoint ref = *solver.getPointAt(i * BCE_TRAJ_TABLE_STRIDE_M);
+            const TrajectoryPoint tp = compact.load(i);
+            const float range = static_cast<float>(i * BCE_TRAJ_TABLE_STRIDE_M);
+            float moa_per_m = (i > 0) ? BCE_RAD_TO_MOA / range : 0.0f;
+            EXPECT_NEAR(tp.drop_m * moa_per_m, ref.drop_m * moa_per_m, 0.015f) << angle << " " << i;
+            EXPECT_NEAR(tp.windage_m * moa_per_m, ref.windage_m * moa_per_m, 0.015f)
+                << angle << " " << i;
+            EXPECT_NEAR(tp.velocity_ms, ref.velocity_ms, 0.05f) << angle << " " << i;
+            // TOF resolves to well under 0.1 µs per meter of range
+            EXPECT_NEAR(tp.tof_s, ref.tof_s, 1e-6f + 6e-8f * range) << angle << " " << i;
+            EXPECT_NEAR(tp.energy_j, ref.energy_j, 1e-3f * ref.energy_j) << angle << " " << i;
+        }
+        EXPECT_FLOAT_EQ(compact.load(0).velocity_ms, p.muzzle_velocity_ms);
+        EXPECT_EQ(compact.load(0).drop_m, 0.0f);
+    }
+    EXPECT_LE(sizeof(CompactTrajectoryTable), 8u * BCE_TRAJ_TABLE_SIZE + 128u);
+}
+
+// Forward sensitivities agree with central differences of the same
+// integration, for both integrators, and the nominal matches integrate()
+TEST_F(SolverTest, SensitivitiesMatchFiniteDifferences) {
+    for (IntegratorMethod method : {IntegratorMethod::RK4, IntegratorMethod::DORMAND_PRINCE}) {
+        for (float range : {300.0f, 800.0f, 1200.0f}) {
+            SolverParams p = make308Params(range);
+            p.launch_angle_rad = 0.005f;
+            p.crosswind_ms = 3.0f;
+            p.headwind_ms = 2.0f;
+            p.integrator = method;
+
+            SolverSensitivity sens;
+            SolverResult nominal = solver.integrateWithSensitivity(p, sens);
+            ASSERT_TRUE(nominal.valid);
+            SolverResult tabled = solver.integrate(p);
+            EXPECT_NEAR(nominal.drop_at_target_m, tabled.drop_at_target_m, 1e-3f) << range;
+            EXPECT_NEAR(nominal.tof_s, tabled.tof_s, 1e-5f + TABLE_TOF_QUANT_S) << range;
+
+            auto check = [&](const SolverPartials& d, float SolverParams::*field, float delta,
+                             const char* name) {
+                SolverParams hi = p;
+                SolverParams lo = p;
+                hi.*field += delta;
+                lo.*field -= delta;
+                SolverSensitivity unused;
+                SolverResult a = solver.integrateWithSensitivity(hi, unused);
+                SolverResult b = solver.integrateWithSensitivity(lo, unused);
+                ASSERT_TRUE(a.valid && b.valid);
+                float fd_drop = (a.drop_at_target_m - b.drop_at_target_m) / (2.0f * delta);
+                float fd_wind = (a.windage_at_target_m - b.windage_at_target_m) / (2.0f * delta);
+                float fd_tof = (a.tof_s - b.tof_s) / (2.0f * delta);
+                float fd_vel = (a.velocity_at_target_ms - b.velocity_at_target_ms) / (2.0f * delta);
+                // RK4 step sizes follow the speed, which leaves ~1 % of noise
+                // in the differences; the cross terms are near zero
+                EXPECT_NEAR(d.drop_m, fd_drop, 0.03f * std::fabs(fd_drop) + 1e-4f) << name << range;
+                EXPECT_NEAR(d.windage_m, fd_wind, 0.03f * std::fabs(fd_wind) + 1e-4f) << name << range;
+                EXPECT_NEAR(d.tof_s, fd_tof, 0.03f * std::fabs(fd_tof) + 1e-5f) << name << range;
+                EXPECT_NEAR(d.velocity_ms, fd_vel, 0.03f * std::fabs(fd_vel) + 0.01f) << name << range;
+            };
+            check(sens.range, &SolverParams::target_range_m, 1.0f, "range ");
+            check(sens.muzzle_velocity, &SolverParams::muzzle_velocity_ms, 2.0f, "mv ");
+            check(sens.crosswind, &SolverParams::crosswind_ms, 0.5f, "crosswind ");
+            check(sens.headwind, &SolverParams::headwind_ms, 0.5f, "headwind ");
+
+            // BC partials are per fractional change: perturb by ±1 %
+            SolverParams hi = p;
+            SolverParams lo = p;
+            hi.bc *= 1.01f;
+            lo.bc *= 0.99f;
+            SolverSensitivity unused;
+            SolverResult a = solver.integrateWithSensitivity(hi, unused);
+            SolverResult b = solver.integrateWithSensitivity(lo, unused);
+            float fd_drop = (a.drop_at_target_m - b.drop_at_target_m) / 0.02f;
+            float fd_wind = (a.windage_at_target_m - b.windage_at_target_m) / 0.02f;
+            EXPECT_NEAR(sens.bc.drop_m, fd_drop, 0.03f * std::fabs(fd_drop)) << range;
+            EXPECT_NEAR(sens.bc.windage_m, fd_wind, 0.03f * std::fabs(fd_wind)) << range;
+            EXPECT_GT(sens.bc.drop_m, 0.0f); // more BC, less drop
+        }
+    }
+
+    SolverParams p = make308Params(static_cast<float>(BCE_MAX_RANGE_M) + 1.0f);
+    SolverSensitivity sens;
+    EXPECT_FALSE(solver.integrateWithSensitivity(p, sens).valid);
+}
+
+// Reduced-cost math against the std:: path, over every input range the
+// solver, atmosphere and AHRS feed it (bounds documented in fast_math.h)
+TEST(FastMathTest, ApproximationsMatchStdAcrossEnvelope) {
+    double err = 0.0;
+
+    // Squared speeds from 1 m/s to well past any muzzle velocity; quaternion
+    // and sensor norms down to 1e-6
+    for (double x = 1e-6; x < 1e8; x *= 1.001) {
+        float xf = static_cast<float>(x);
+        double ref = std::sqrt(static_cast<double>(xf));
+        err = std::fmax(err, std::fabs(FastMath::sqrt(xf) - ref) / ref);
+        err = std::fmax(err, std::fabs(FastMath::rsqrt(xf) - 1.0 / ref) * ref);
+    }
+    EXPECT_LT(err, 5e-6);
+
+    // Exponent span of the Buck vapour-pressure term and beyond
+    err = 0.0;
+    for (double x = -20.0; x <= 20.0; x += 1e-3) {
+        float xf = static_cast<float>(x);
+        double ref = std::exp(static_cast<double>(xf));
+        err = std::fmax(err, std::fabs(FastMath::exp(xf) - ref) / ref);
+    }
+    EXPECT_LT(err, 2e-6);
+
+    err = 0.0;
+    for (double x = 1e-6; x < 1e6; x *= 1.001) {
+        float xf = static_cast<float>(x);
+        err = std::fmax(err, std::fabs(FastMath::log(xf) - std::log(static_cast<double>(xf))));
+    }
+    EXPECT_LT(err, 1e-6);
+
+    // Spin drift TOF^1.83 out to 10 s; Dormand–Prince step ratios
+    err = 0.0;
+    for (double t = 1e-3; t < 10.0; t *= 1.001) {
+        float tf = static_cast<float>(t);
+        double ref = std::pow(static_cast<double>(tf), 1.83);
+        err = std::fmax(err, std::fabs(FastMath::pow(tf, 1.83f) - ref) / ref);
+    }
+    for (double r = 1e-6; r < 1e6; r *= 1.001) {
+        float rf = static_cast<float>(r);
+        for (float e : {-0.2f, -0.25f}) {
+            double ref = std::pow(static_cast<double>(rf), static_cast<double>(e));
+            err = std::fmax(err, std::fabs(FastMath::pow(rf, e) - ref) / ref);
+        }
+    }
+    EXPECT_LT(err, 2e-6);
+
+    // Full circle for roll/yaw, at several magnitudes
+    err = 0.0;
+    for (double a = -BCE_PI; a < BCE_PI; a += 1e-4) {
+        for (double m : {1e-3, 1.0, 1e3}) {
+            float y = static_cast<float>(m * std::sin(a));
+            float x = static_cast<float>(m * std::cos(a));
+            double d = std::fabs(FastMath::atan2(y, x) - std::atan2(static_cast<double>(y),
+                                                                    static_cast<double>(x)));
+            if (d > BCE_PI) d = 2.0 * BCE_PI - d;
+            err = std::fmax(err, d);
+        }
+    }
+    EXPECT_LT(err, 5e-7);
+    EXPECT_FLOAT_EQ(FastMath::atan2(0.0f, 0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(FastMath::atan2(0.0f, -1.0f), static_cast<float>(BCE_PI));
+
+    // Pitch: the full [-1, 1] domain, clamped beyond
+    err = 0.0;
+    for (double x = -1.0; x <= 1.0; x += 1e-5) {
+        float xf = static_cast<float>(x);
+        err = std::fmax(err, std::fabs(FastMath::asin(xf) - std::asin(static_cast<double>(xf))));
+    }
+    EXPECT_LT(err, 5e-7);
+    EXPECT_FLOAT_EQ(FastMath::asin(1.5f), FastMath::asin(1.0f));
+}
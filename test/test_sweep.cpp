@@ -0,0 +1,110 @@
+/**
+ * @file test_sweep.cpp
+ * @brief Unit tests for the native work-stealing sweep executor.
+ */
+
+#include <gtest/gtest.h>
+#include "../lib/bce/src/parallel/sweep_executor.h"
+#include "bce/bce_config.h"
+#include <atomic>
+#include <vector>
+
+#ifdef BCE_PLATFORM_NATIVE
+
+namespace {
+
+SolverParams makeSweepParams(int i) {
+    SolverParams p = {};
+    p.bc = 0.45f + 0.002f * static_cast<float>(i % 25);
+    p.drag_model = (i % 2) ? DragModel::G7 : DragModel::G1;
+    p.muzzle_velocity_ms = 760.0f + 1.5f * static_cast<float>(i % 40);
+    p.bullet_mass_kg = 175.0f * BCE_GRAINS_TO_KG;
+    p.sight_height_m = 0.0381f;
+    p.air_density = BCE_STD_AIR_DENSITY;
+    p.speed_of_sound = BCE_SPEED_OF_SOUND_15C;
+    p.target_range_m = 100.0f + 7.0f * static_cast<float>(i % 50);
+    p.crosswind_ms = 0.25f * static_cast<float>(i % 9);
+    return p;
+}
+
+bool sameResult(const SolverResult& a, const SolverResult& b) {
+    return a.valid == b.valid && a.drop_at_target_m == b.drop_at_target_m &&
+           a.windage_at_target_m == b.windage_at_target_m && a.tof_s == b.tof_s &&
+           a.velocity_at_target_ms == b.velocity_at_target_ms &&
+           a.energy_at_target_j == b.energy_at_target_j &&
+           a.horizontal_range_m == b.horizontal_range_m &&
+           a.coriolis_elev_moa == b.coriolis_elev_moa &&
+           a.coriolis_wind_moa == b.coriolis_wind_moa && a.spin_drift_moa == b.spin_drift_moa;
+}
+
+} // namespace
+
+// Every index is processed exactly once, however the work is stolen
+TEST(SweepTest, ParallelForCoversEachIndexOnce) {
+    SweepExecutor exec(4);
+    EXPECT_EQ(exec.getThreadCount(), 4);
+
+    const int n = 1000;
+    std::vector<std::atomic<int>> hits(n);
+    for (auto& h : hits) h = 0;
+    exec.parallelFor(n, 7, [&](int worker, int begin, int end) {
+        EXPECT_GE(worker, 0);
+        EXPECT_LT(worker, 4);
+        for (int i = begin; i < end; ++i) hits[i]++;
+    });
+    for (int i = 0; i < n; ++i) ASSERT_EQ(hits[i].load(), 1) << i;
+
+    // The pool is reusable across jobs
+    exec.parallelFor(n, 0, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) hits[i]++;
+    });
+    for (int i = 0; i < n; ++i) ASSERT_EQ(hits[i].load(), 2) << i;
+}
+
+// Results are bit-identical to a serial solve for any thread count
+TEST(SweepTest, SolveIsDeterministicAcrossThreadCounts) {
+    const int n = 48;
+    std::vector<SolverParams> params(n);
+    for (int i = 0; i < n; ++i) params[i] = makeSweepParams(i);
+    params[5].target_range_m = 0.0f; // invalid entry stays invalid
+
+    static BallisticSolver serial;
+    serial.init();
+    std::vector<SolverResult> reference(n);
+    for (int i = 0; i < n; ++i) reference[i] = serial.integrate(params[i]);
+
+    for (int threads : {1, 3, 8}) {
+        SweepExecutor exec(threads);
+        std::vector<SolverResult> out(n);
+        int valid = exec.solve(params.data(), n, out.data());
+        EXPECT_EQ(valid, n - 1) << threads;
+        for (int i = 0; i < n; ++i) {
+            ASSERT_TRUE(sameResult(out[i], reference[i])) << "threads " << threads << " item " << i;
+        }
+    }
+}
+
+// Grid sweeps integrate each parameter set once and sample every range
+TEST(SweepTest, GridMatchesPerRangeSampling) {
+    const int np = 6;
+    const float ranges[] = {100.0f, 250.5f, 600.0f, 1000.0f};
+    const int nr = 4;
+    std::vector<SolverParams> params(np);
+    for (int i = 0; i < np; ++i) params[i] = makeSweepParams(i * 3);
+
+    SweepExecutor exec(3);
+    std::vector<SolverResult> out(np * nr);
+    EXPECT_EQ(exec.solveGrid(params.data(), np, ranges, nr, out.data()), np * nr);
+
+    static BallisticSolver serial;
+    serial.init();
+    for (int p = 0; p < np; ++p) {
+        ASSERT_TRUE(serial.integrateTrajectory(params[p], 1000.0f));
+        for (int r = 0; r < nr; ++r) {
+            SolverResult ref = serial.sampleTrajectory(params[p], ranges[r]);
+            EXPECT_TRUE(sameResult(out[p * nr + r], ref)) << p << "," << r;
+        }
+    }
+}
+
+#endif // BCE_PLATFORM_NATIVE